@@ -14,8 +14,11 @@
 #include "ILP/ILPDebug.h"
 #include "ILP/ILPUtil.h"
 #include "Logger.h"
+#include "MetricsRegistry.h"
 #include "PassUtil.h"
 #include "ProfileHandler.h"
+#include "ProgressReporter.h"
+#include "SelfEnergyMeter.h"
 
 nlohmann::json ClusteredAnalysis::run(std::shared_ptr<HLAC::hlac> graph, bool showTimings, bool showAllTimings) {
     Logger::getInstance().log("Running Clustered ILP Analysis for Energy", LOGLEVEL::INFO);
@@ -39,7 +42,11 @@ nlohmann::json ClusteredAnalysis::run(std::shared_ptr<HLAC::hlac> graph, bool sh
 
     // ================= Clustered ILP  =================
 
+    ProgressPhase progress("clustered ilp", "functions", graph->functions.size());
+    SelfEnergyPhase selfEnergyPhase("clustered_ilp");
     for (auto &funcNode : graph->functions) {
+        ProgressReporter::getInstance().advance();
+        SelfEnergyFunction selfEnergyFunction(funcNode->name);
         auto getEnergyInitStart = std::chrono::high_resolution_clock::now();
         funcNode->nodeEnergy = funcNode->baseNodeEnergy;
 
@@ -171,6 +178,13 @@ nlohmann::json ClusteredAnalysis::run(std::shared_ptr<HLAC::hlac> graph, bool sh
     auto clusteredTotalDuration = std::chrono::duration_cast<std::chrono::microseconds>(
         clusteredTotalEnd - clusteredTotalStart);
 
+    auto &metrics = MetricsRegistry::getInstance();
+    metrics.recordPhaseDuration("clustered_energy_init", totalGetEnergyInitDuration);
+    metrics.recordPhaseDuration("clustered_build", totalBuildDuration);
+    metrics.recordPhaseDuration("clustered_solve", totalSolveDuration);
+    metrics.recordPhaseDuration("clustered_dag", totalDagDuration);
+    metrics.recordPhaseDuration("clustered_total", clusteredTotalDuration);
+
     if (showTimings) {
         auto &logger = Logger::getInstance();
         if (showAllTimings) {
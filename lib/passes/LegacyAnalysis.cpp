@@ -13,8 +13,10 @@
 #include "EnergyFunction.h"
 #include "LLVMHandler.h"
 #include "Logger.h"
+#include "MetricsRegistry.h"
 #include "PassUtil.h"
 #include "ProfileHandler.h"
+#include "SelfEnergyMeter.h"
 #include "LegacyAnalysis.h"
 
 nlohmann::json LegacyAnalysis::run(
@@ -24,6 +26,7 @@ nlohmann::json LegacyAnalysis::run(
 
     if (functionTree != nullptr) {
         auto legacyTotalStart = std::chrono::high_resolution_clock::now();
+        SelfEnergyPhase selfEnergyPhase("legacy");
 
         std::vector<llvm::StringRef> names;
         for (auto function : functionTree->getPreOrderVector()) {
@@ -94,6 +97,12 @@ nlohmann::json LegacyAnalysis::run(
         auto legacyTotalDuration = std::chrono::duration_cast<std::chrono::microseconds>(
             legacyTotalEnd - legacyTotalStart);
 
+        auto &metrics = MetricsRegistry::getInstance();
+        metrics.recordPhaseDuration("legacy_preparation", legacyPreparationDuration);
+        metrics.recordPhaseDuration("legacy_handler_init", legacyHandlerInitDuration);
+        metrics.recordPhaseDuration("legacy_analysis", legacyAnalysisDuration);
+        metrics.recordPhaseDuration("legacy_total", legacyTotalDuration);
+
         if (showTimings) {
             auto &logger = Logger::getInstance();
             if (showAllTimings) {
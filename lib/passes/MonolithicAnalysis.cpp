@@ -13,16 +13,25 @@
 #include "HLAC/hlac.h"
 #include "HLAC/util.h"
 #include "ILP/ILPBuilder.h"
+#include "ILP/ILPSolver.h"
+#include "ILP/ILPSweep.h"
 #include "ILP/ILPUtil.h"
 #include "Logger.h"
+#include "MetricsRegistry.h"
 #include "PassUtil.h"
 #include "ProfileHandler.h"
+#include "ProgressReporter.h"
+#include "SelfEnergyMeter.h"
 #include "ILP/ILPDebug.h"
 #include "nlohmann/json.hpp"
 
 nlohmann::json MonolithicAnalysis::run(std::shared_ptr<HLAC::hlac> graph, bool showTimings, bool showAllTimings) {
     Logger::getInstance().log("Running Monolithic ILP Analysis for Energy", LOGLEVEL::INFO);
     std::unordered_map<std::string, std::optional<ILPModel>> functionILPCache;
+    std::unordered_map<std::string, nlohmann::json> functionSweepTables;
+    ILPSweepEnergies functionSweepEnergies;
+    std::unordered_map<std::string, nlohmann::json> functionSensitivityReports;
+    const auto sweepConfiguration = ConfigParser::getAnalysisConfiguration().sweepconfig;
 
     // ================= Monolithic ILP =================
 
@@ -32,7 +41,11 @@ nlohmann::json MonolithicAnalysis::run(std::shared_ptr<HLAC::hlac> graph, bool s
     auto totalBuildDuration = std::chrono::microseconds::zero();
     auto totalSolveDuration = std::chrono::microseconds::zero();
 
+    ProgressPhase progress("monolithic ilp", "functions", graph->functions.size());
+    SelfEnergyPhase selfEnergyPhase("monolithic_ilp");
     for (auto &funcNode : graph->functions) {
+        ProgressReporter::getInstance().advance();
+        SelfEnergyFunction selfEnergyFunction(funcNode->name);
         auto getEnergyInitStart = std::chrono::high_resolution_clock::now();
         funcNode->nodeEnergy = funcNode->baseNodeEnergy;
 
@@ -183,6 +196,90 @@ nlohmann::json MonolithicAnalysis::run(std::shared_ptr<HLAC::hlac> graph, bool s
                     resultPair.variableValues,
                     "monolithic");
             }
+
+            // Extract the marginal energy per loop iteration from the duals of the loop bound rows
+            if (ConfigParser::getAnalysisConfiguration().sensitivityReportEnabled && !ilp->loopBoundRows.empty()) {
+                auto sensitivityStart = std::chrono::high_resolution_clock::now();
+                auto sensitivities = ILPSolver::calculateLoopBoundSensitivity(ilp.value(), resultPair);
+                auto sensitivityEnd = std::chrono::high_resolution_clock::now();
+                auto sensitivityDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+                    sensitivityEnd - sensitivityStart);
+
+                nlohmann::json sensitivityReport = nlohmann::json::object();
+                sensitivityReport["duration"] = sensitivityDuration.count();
+                sensitivityReport["rows"] = nlohmann::json::array();
+
+                for (const auto &sensitivity : sensitivities) {
+                    sensitivityReport["rows"].push_back({
+                        {"loop", sensitivity.loopNode->getDotName()},
+                        {"bound", sensitivity.isUpperBound ? "upper" : "lower"},
+                        {"binding", sensitivity.binding},
+                        {"marginalEnergy", sensitivity.marginalEnergy},
+                        {"validFrom", sensitivity.validFrom},
+                        {"validTo", sensitivity.validTo},
+                        {"exact", sensitivity.exact},
+                    });
+                }
+
+                functionSensitivityReports[funcName] = sensitivityReport;
+
+                if (showTimings) {
+                    Logger::getInstance().log(
+                        "Loop bound sensitivity of " + funcName + ": " +
+                        std::to_string(sensitivityDuration.count()) + " µs (solve " +
+                        std::to_string(monoSolveDuration.count()) + " µs)",
+                        LOGLEVEL::INFO);
+                }
+            }
+
+            // Re-evaluate the already built model over the configured loop bound grid. Functions are visited callees
+            // first, so the swept energies of all callees are known
+            if (sweepConfiguration.enabled && ILPSweep::isAffectedBySweep(ilp.value(), functionSweepEnergies)) {
+                auto sweepPoints = ILPSweep::sweepLoopBounds(ilp.value(), sweepConfiguration.grid,
+                                                             sweepConfiguration.mode, functionSweepEnergies);
+
+                auto &sweepEnergies = functionSweepEnergies[funcName];
+                for (const auto &sweepPoint : sweepPoints) {
+                    sweepEnergies.push_back(sweepPoint.energy);
+                }
+
+                auto sweepTable = nlohmann::json::array();
+                int64_t totalSweepDuration = 0;
+
+                for (const auto &sweepPoint : sweepPoints) {
+                    nlohmann::json sweepEntry = nlohmann::json::object();
+                    sweepEntry["grid"] = sweepPoint.gridValue;
+                    sweepEntry["duration"] = sweepPoint.duration;
+
+                    if (sweepPoint.energy.has_value()) {
+                        double sweepEnergy = sweepPoint.energy.value();
+
+                        if (funcName == "main") {
+                            auto offsetCost = ProfileHandler::get_instance().getProgramOffset();
+                            if (offsetCost.has_value()) {
+                                sweepEnergy += offsetCost.value();
+                            }
+                        }
+
+                        sweepEntry["energy"] = sweepEnergy;
+                    } else {
+                        sweepEntry["energy"] = nullptr;
+                    }
+
+                    totalSweepDuration += sweepPoint.duration;
+                    sweepTable.push_back(sweepEntry);
+                }
+
+                functionSweepTables[funcName] = sweepTable;
+
+                if (showTimings && !sweepPoints.empty()) {
+                    Logger::getInstance().log(
+                        "Loop bound sweep of " + funcName + ": " + std::to_string(sweepPoints.size()) +
+                        " points, " + std::to_string(totalSweepDuration / static_cast<int64_t>(sweepPoints.size())) +
+                        " µs per point (full solve " + std::to_string(monoSolveDuration.count()) + " µs)",
+                        LOGLEVEL::INFO);
+                }
+            }
         }
     }
 
@@ -191,6 +288,12 @@ nlohmann::json MonolithicAnalysis::run(std::shared_ptr<HLAC::hlac> graph, bool s
     auto monoTotalDuration = std::chrono::duration_cast<std::chrono::microseconds>(
         monoTotalEnd - monoTotalStart);
 
+    auto &metrics = MetricsRegistry::getInstance();
+    metrics.recordPhaseDuration("monolithic_energy_init", totalGetEnergyInitDuration);
+    metrics.recordPhaseDuration("monolithic_build", totalBuildDuration);
+    metrics.recordPhaseDuration("monolithic_solve", totalSolveDuration);
+    metrics.recordPhaseDuration("monolithic_total", monoTotalDuration);
+
     if (showTimings) {
         auto &logger = Logger::getInstance();
         if (showAllTimings) {
@@ -242,6 +345,16 @@ nlohmann::json MonolithicAnalysis::run(std::shared_ptr<HLAC::hlac> graph, bool s
 
         outputObject["functions"][functionName]["illformatted"] = functionNode->isIllFormatted;
 
+        auto sensitivityIterator = functionSensitivityReports.find(functionName);
+        if (sensitivityIterator != functionSensitivityReports.end()) {
+            outputObject["functions"][functionName]["loopBoundSensitivity"] = sensitivityIterator->second;
+        }
+
+        auto sweepIterator = functionSweepTables.find(functionName);
+        if (sweepIterator != functionSweepTables.end()) {
+            outputObject["functions"][functionName]["sweep"] = sweepIterator->second;
+        }
+
         for (auto &node : functionNode->Nodes) {
             PassUtil::appendGraphContent(outputObject["functions"][functionName], node.get());
         }
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include "OfflineAnalysis.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ConfigParser.h"
+#include "HLAC/hlac.h"
+#include "HLAC/util.h"
+#include "ILP/ILPBuilder.h"
+#include "ILP/ILPUtil.h"
+#include "Logger.h"
+#include "MetricsRegistry.h"
+#include "PassUtil.h"
+#include "ProfileHandler.h"
+#include "ProgressReporter.h"
+#include "SelfEnergyMeter.h"
+
+nlohmann::json OfflineAnalysis::run(const HLAC::HLACSnapshot &snapshot, bool showTimings) {
+    Logger::getInstance().log("Running Offline ILP Analysis on HLAC snapshot", LOGLEVEL::INFO);
+
+    auto offlineTotalStart = std::chrono::high_resolution_clock::now();
+
+    // Resolve the energy of every opcode once, blocks are then costed by their opcode counts
+    auto &profileHandler = ProfileHandler::get_instance();
+    const double unknownCost = profileHandler.getUnknownCost().value_or(0.0);
+    std::vector<double> instructionEnergy;
+    instructionEnergy.reserve(snapshot.opcodeNames.size());
+
+    for (const auto &opcodeName : snapshot.opcodeNames) {
+        instructionEnergy.push_back(profileHandler.getEnergyForInstruction(opcodeName).value_or(unknownCost));
+    }
+
+    std::map<std::string, double> functionEnergyCache;
+    std::unordered_map<std::string, ILPModel> functionILPCache;
+
+    // The functions are stored callees first, so the energy of all callees is known when a caller is built
+    ProgressPhase progress("offline ilp", "functions", snapshot.functions.size());
+    SelfEnergyPhase selfEnergyPhase("offline_ilp");
+    for (const auto &snapshotFunction : snapshot.functions) {
+        ProgressReporter::getInstance().advance();
+        SelfEnergyFunction selfEnergyFunction(snapshotFunction.name);
+        const std::string &funcName = snapshotFunction.name;
+
+        if (HLAC::Util::starts_with(funcName, "__psr") || HLAC::Util::starts_with(funcName, "__clang")) {
+            functionEnergyCache[funcName] = getFallbackEnergy(funcName);
+            continue;
+        }
+
+        if (snapshotFunction.isGotoFunction || snapshotFunction.isIncomplete || snapshotFunction.scopes.empty()) {
+            const double fallbackEnergy = getFallbackEnergy(funcName);
+            functionEnergyCache[funcName] = fallbackEnergy;
+
+            Logger::getInstance().log(
+                "Fallback Energy of " + funcName + ": " + PassUtil::formatScientific(fallbackEnergy) + " J",
+                LOGLEVEL::HIGHLIGHT);
+            continue;
+        }
+
+        ILPModel model = buildModel(snapshotFunction, instructionEnergy, functionEnergyCache);
+        auto solvedResults = ILPBuilder::solveModel(model);
+
+        if (!solvedResults.has_value()) {
+            Logger::getInstance().log("Failed to solve offline ILP for function " + funcName, LOGLEVEL::ERROR);
+            functionEnergyCache[funcName] = getFallbackEnergy(funcName);
+            continue;
+        }
+
+        double funcEnergy = solvedResults->optimalValue;
+
+        // If we encounter the main function add the additional program start offset cost to it!
+        if (funcName == "main") {
+            funcEnergy += profileHandler.getProgramOffset().value_or(0.0);
+        }
+
+        functionEnergyCache[funcName] = funcEnergy;
+        functionILPCache[funcName] = std::move(model);
+
+        Logger::getInstance().log(
+            "Offline Energy of " + funcName + ": " + PassUtil::formatScientific(funcEnergy) + " J" +
+            (snapshotFunction.isIllFormatted ? " (ILL)" : ""),
+            LOGLEVEL::HIGHLIGHT);
+    }
+
+    auto offlineTotalEnd = std::chrono::high_resolution_clock::now();
+    auto offlineTotalDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+        offlineTotalEnd - offlineTotalStart);
+    MetricsRegistry::getInstance().recordPhaseDuration("offline_total", offlineTotalDuration);
+
+    if (showTimings) {
+        Logger::getInstance().log("Offline Total Time: " + std::to_string(offlineTotalDuration.count()) + " µs",
+                                  LOGLEVEL::INFO);
+    }
+
+    nlohmann::json outputObject = nlohmann::json::object();
+    outputObject["analysis"] = "offline";
+    outputObject["duration"] = offlineTotalDuration.count();
+    outputObject["functions"] = {};
+
+    for (const auto &snapshotFunction : snapshot.functions) {
+        const std::string &funcName = snapshotFunction.name;
+
+        auto ilpObj = nlohmann::json::object();
+        auto ilpIterator = functionILPCache.find(funcName);
+
+        if (ilpIterator != functionILPCache.end()) {
+            ilpObj["numVariables"] = ilpIterator->second.col_lb.size();
+            ilpObj["numConstrains"] = ilpIterator->second.row_lb.size();
+            ilpObj["status"] = "solved";
+        } else {
+            ilpObj["numVariables"] = 0;
+            ilpObj["numConstrains"] = 0;
+            ilpObj["status"] = "fallback";
+        }
+
+        outputObject["functions"][funcName] = {
+            {"energy", functionEnergyCache[funcName]},
+            {"ILPS", nlohmann::json::array({ilpObj})},
+            {"illformatted", snapshotFunction.isIllFormatted},
+        };
+    }
+
+    return outputObject;
+}
+
+ILPModel OfflineAnalysis::buildModel(const HLAC::SnapshotFunction &snapshotFunction,
+                                     const std::vector<double> &instructionEnergy,
+                                     const std::map<std::string, double> &functionEnergyCache) {
+    // Scopes are stored in the order ILPUtil::assignEdgeIndicesFunction assigns the columns
+    std::vector<int> scopeColumns;
+    scopeColumns.reserve(snapshotFunction.scopes.size());
+    int variableCount = 0;
+
+    for (const auto &scope : snapshotFunction.scopes) {
+        scopeColumns.push_back(variableCount);
+        variableCount += static_cast<int>(scope.edges.size());
+    }
+
+    ILPModel model{.matrix = CoinPackedMatrix(false, 0, 0),
+                   .row_lb = {},
+                   .row_ub = {},
+                   .col_lb = std::vector<double>(variableCount, 0.0),
+                   .col_ub = std::vector<double>(variableCount, COIN_DBL_MAX),
+                   .obj = std::vector<double>(variableCount, 0.0)};
+
+    // Apply the feasibility bounds and fill the objective function with the energy of the edge destinations
+    for (std::size_t scopeIndex = 0; scopeIndex < snapshotFunction.scopes.size(); ++scopeIndex) {
+        const auto &scope = snapshotFunction.scopes[scopeIndex];
+
+        for (std::size_t edgeIndex = 0; edgeIndex < scope.edges.size(); ++edgeIndex) {
+            const auto &edge = scope.edges[edgeIndex];
+            const int column = scopeColumns[scopeIndex] + static_cast<int>(edgeIndex);
+
+            if (!edge.feasibility) {
+                model.col_lb[column] = 0.0;
+                model.col_ub[column] = 0.0;
+            }
+
+            model.obj[column] = getNodeEnergy(scope.nodes[edge.destination], snapshotFunction.isRecursive,
+                                              instructionEnergy, functionEnergyCache);
+        }
+    }
+
+    // The flow and loop bound rows are the ones of the monolithic analysis
+    ILPBuilder::appendFlowConstraints(model, buildFlowGraph(snapshotFunction, scopeColumns), 0, nullptr);
+
+    return model;
+}
+
+ILPFlowGraph OfflineAnalysis::buildFlowGraph(const HLAC::SnapshotFunction &snapshotFunction,
+                                             const std::vector<int> &scopeColumns) {
+    ILPFlowGraph graph;
+    graph.scopes.resize(snapshotFunction.scopes.size());
+
+    for (std::size_t scopeIndex = 0; scopeIndex < snapshotFunction.scopes.size(); ++scopeIndex) {
+        const auto &scope = snapshotFunction.scopes[scopeIndex];
+        auto &flowScope = graph.scopes[scopeIndex];
+        flowScope.nodes.resize(scope.nodes.size());
+
+        for (std::size_t edgeIndex = 0; edgeIndex < scope.edges.size(); ++edgeIndex) {
+            const auto &edge = scope.edges[edgeIndex];
+            const int column = scopeColumns[scopeIndex] + static_cast<int>(edgeIndex);
+
+            flowScope.nodes[edge.destination].incomingColumns.push_back(column);
+            flowScope.nodes[edge.source].outgoingColumns.push_back(column);
+
+            // The loop is invoked by all incoming edges that do not originate from the loop itself
+            if (edge.source != edge.destination) {
+                flowScope.nodes[edge.destination].invocationColumns.push_back(column);
+            }
+
+            if (edge.isBackEdge) {
+                flowScope.backEdgeColumns.push_back(column);
+            }
+        }
+
+        for (std::size_t nodeIndex = 0; nodeIndex < scope.nodes.size(); ++nodeIndex) {
+            const auto &node = scope.nodes[nodeIndex];
+            auto &flowNode = flowScope.nodes[nodeIndex];
+            const auto nodeType = static_cast<HLAC::NodeType>(node.nodeType);
+            const auto virtualNodeKind = static_cast<HLAC::VirtualNodeKind>(node.virtualNodeKind);
+
+            if (nodeType == HLAC::NodeType::VIRTUALNODE && virtualNodeKind == HLAC::VirtualNodeKind::Entry) {
+                flowNode.kind = ILPFlowNodeKind::ENTRY;
+            } else if (nodeType == HLAC::NodeType::VIRTUALNODE &&
+                       virtualNodeKind == HLAC::VirtualNodeKind::NormalExit) {
+                flowNode.kind = ILPFlowNodeKind::EXIT;
+            } else if (nodeType == HLAC::NodeType::LOOPNODE) {
+                flowNode.kind = ILPFlowNodeKind::LOOP;
+                flowNode.bodyScope = node.bodyScope;
+                flowNode.lowerBound = static_cast<double>(node.lowerBound);
+                flowNode.upperBound = static_cast<double>(node.upperBound);
+                flowNode.name = "#" + std::to_string(node.bodyScope) + " of " + snapshotFunction.name;
+            }
+
+            // Invocation columns are only meaningful for loops
+            if (flowNode.kind != ILPFlowNodeKind::LOOP) {
+                flowNode.invocationColumns.clear();
+            }
+        }
+    }
+
+    return graph;
+}
+
+double OfflineAnalysis::getNodeEnergy(const HLAC::SnapshotNode &node, bool isRecursive,
+                                      const std::vector<double> &instructionEnergy,
+                                      const std::map<std::string, double> &functionEnergyCache) {
+    const auto nodeType = static_cast<HLAC::NodeType>(node.nodeType);
+
+    if (nodeType == HLAC::NodeType::NODE) {
+        double energy = 0.0;
+        for (const auto &[opcodeIndex, count] : node.opcodeCounts) {
+            energy += instructionEnergy[opcodeIndex] * static_cast<double>(count);
+        }
+        return energy;
+    }
+
+    if (nodeType != HLAC::NodeType::CALLNODE) {
+        return 0.0;
+    }
+
+    // Calls are priced exactly like HLAC::CallNode::getEnergy prices them
+    const std::optional<size_t> syscallId = node.syscallId >= 0 ? std::optional<size_t>(node.syscallId)
+                                                                 : std::nullopt;
+    auto unanalyzedEnergy = HLAC::CallNode::getUnanalyzedCallEnergy(node.isSyscall, syscallId,
+                                                                    node.isLinkerFunction, node.calleeName);
+    if (unanalyzedEnergy.has_value()) {
+        return unanalyzedEnergy.value();
+    }
+
+    return HLAC::hlac::getEnergyPerFunction(functionEnergyCache, node.calleeName, isRecursive);
+}
+
+double OfflineAnalysis::getFallbackEnergy(const std::string &functionName) {
+    double fallbackEnergy = ConfigParser::getAnalysisConfiguration().fallback["calls"]["UNKNOWN_FUNCTION"];
+
+    if (functionName == "main") {
+        fallbackEnergy += ProfileHandler::get_instance().getProgramOffset().value_or(0.0);
+    }
+
+    return fallbackEnergy;
+}
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <filesystem>
 #include <iomanip>
 #include <memory>
 #include <sstream>
@@ -22,12 +23,18 @@
 #include <vector>
 
 #include "ClusteredAnalysis.h"
+#include "ConfigParser.h"
 #include "FunctionTree.h"
+#include "HLAC/HLACSnapshot.h"
 #include "HLAC/hlacwrapper.h"
 #include "HLAC/util.h"
 #include "LegacyAnalysis.h"
+#include "Logger.h"
+#include "MetricsRegistry.h"
 #include "MonolithicAnalysis.h"
 #include "PassUtil.h"
+#include "ProgressReporter.h"
+#include "SelfEnergyMeter.h"
 
 std::string PassUtil::formatScientific(double value, int precision) {
     std::ostringstream outputStream;
@@ -155,12 +162,19 @@ std::shared_ptr<HLAC::hlac> PassUtil::buildInitializedGraph(llvm::Module &module
 
     auto startConstruction = std::chrono::high_resolution_clock::now();
 
-    for (auto *function : postOrderFunctionList) {
-        sharedGraph->makeFunction(function, &functionAnalysisManager);
+    {
+        ProgressPhase progress("hlac construction", "functions", postOrderFunctionList.size());
+        SelfEnergyPhase selfEnergyPhase("hlac_construction");
+        for (auto *function : postOrderFunctionList) {
+            SelfEnergyFunction selfEnergyFunction(function->getName().str());
+            sharedGraph->makeFunction(function, &functionAnalysisManager);
+            ProgressReporter::getInstance().advance();
+        }
     }
 
     auto endConstruction = std::chrono::high_resolution_clock::now();
     auto constructionTime = std::chrono::duration_cast<std::chrono::microseconds>(endConstruction - startConstruction);
+    MetricsRegistry::getInstance().recordPhaseDuration("hlac_construction", constructionTime);
 
     /*Logger::getInstance().log(
         "HLAC construction took: " + std::to_string(constructionTime.count()) + " µs",
@@ -211,6 +225,19 @@ std::shared_ptr<HLAC::hlac> PassUtil::buildInitializedGraph(llvm::Module &module
 json PassUtil::runMonolithicOnModule(llvm::Module &module, llvm::FunctionAnalysisManager &functionAnalysisManager,
                                      ResultRegistry &resultRegistry) {
     std::shared_ptr<HLAC::hlac> graph = buildInitializedGraph(module, functionAnalysisManager, resultRegistry);
+
+    // Persist the initialized graph, so it can be re-costed offline with other profiles or ELBs
+    if (ConfigParser::getAnalysisConfiguration().writeSnapshot) {
+        const std::filesystem::path outputDirectoryPath(ConfigParser::getAnalysisConfiguration().outputDirectory);
+        const std::filesystem::path snapshotPath =
+                outputDirectoryPath / (extractFileNameWithoutExtension(module.getName().str()) + ".hlac");
+
+        std::filesystem::create_directories(outputDirectoryPath);
+        HLAC::HLACSnapshot::capture(*graph).write(snapshotPath.string());
+
+        Logger::getInstance().log("Wrote HLAC snapshot to " + snapshotPath.string(), LOGLEVEL::INFO);
+    }
+
     return MonolithicAnalysis::run(graph, SHOWTIMINGS);
 }
 
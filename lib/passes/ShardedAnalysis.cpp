@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include "ShardedAnalysis.h"
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <llvm/ADT/SCCIterator.h>
+#include <llvm/Analysis/CallGraph.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "ConfigParser.h"
+#include "ELBs/ELPMapper.h"
+#include "Logger.h"
+#include "MetricsRegistry.h"
+#include "ProgressReporter.h"
+#include "SelfEnergyMeter.h"
+
+static std::string attemptName(ShardAttempt attempt) {
+    switch (attempt) {
+        case ShardAttempt::FULL:
+            return "full";
+        case ShardAttempt::REDUCED:
+            return "reduced";
+        default:
+            return "fallback";
+    }
+}
+
+static std::filesystem::path shardFile(const std::filesystem::path &shardDirectory, std::size_t index,
+                                       const std::string &extension) {
+    return shardDirectory / ("shard_" + std::to_string(index) + extension);
+}
+
+std::vector<Shard> ShardedAnalysis::partition(llvm::Module &module, std::size_t shardCount) {
+    llvm::CallGraph callGraph(module);
+
+    // Collect the SCCs of the defined functions, callees first
+    std::vector<std::vector<llvm::Function *>> components;
+    std::vector<uint64_t> componentCosts;
+    std::unordered_set<const llvm::Function *> visited;
+    uint64_t totalCost = 0;
+
+    auto addComponent = [&](std::vector<llvm::Function *> component) {
+        uint64_t cost = 0;
+        for (llvm::Function *function : component) {
+            cost += function->getInstructionCount() + 1;
+            visited.insert(function);
+        }
+
+        totalCost += cost;
+        components.push_back(std::move(component));
+        componentCosts.push_back(cost);
+    };
+
+    // An SCC reachable from the root is complete, so it is either entirely visited by an earlier traversal or not
+    auto addComponentsFrom = [&](llvm::CallGraphNode *root) {
+        for (auto sccIterator = llvm::scc_begin(root); !sccIterator.isAtEnd(); ++sccIterator) {
+            std::vector<llvm::Function *> component;
+            for (llvm::CallGraphNode *node : *sccIterator) {
+                llvm::Function *function = node->getFunction();
+                if (function != nullptr && !function->isDeclaration() && !visited.contains(function)) {
+                    component.push_back(function);
+                }
+            }
+
+            if (!component.empty()) {
+                addComponent(std::move(component));
+            }
+        }
+    };
+
+    addComponentsFrom(callGraph.getExternalCallingNode());
+
+    // Internal functions nobody calls are not reachable from the external calling node, neither are the internal
+    // functions only they call. Their SCCs are collected callees first as well, after everything reachable
+    for (llvm::Function &function : module) {
+        if (!function.isDeclaration() && !visited.contains(&function)) {
+            addComponentsFrom(callGraph[&function]);
+        }
+    }
+
+    shardCount = std::max<std::size_t>(shardCount, 1);
+    const uint64_t targetCost = (totalCost + shardCount - 1) / shardCount;
+
+    std::vector<Shard> shards;
+    std::unordered_map<const llvm::Function *, std::size_t> shardOfFunction;
+
+    for (std::size_t componentIndex = 0; componentIndex < components.size(); componentIndex++) {
+        // Start a new shard once the current one would exceed the average cost
+        bool exceedsTarget = !shards.empty() && shards.back().cost > 0 &&
+                             shards.back().cost + componentCosts[componentIndex] > targetCost;
+        if (shards.empty() || (exceedsTarget && shards.size() < shardCount)) {
+            Shard shard;
+            shard.index = shards.size();
+            shards.push_back(std::move(shard));
+        }
+
+        Shard &shard = shards.back();
+        for (llvm::Function *function : components[componentIndex]) {
+            shard.functions.push_back(function->getName().str());
+            shardOfFunction[function] = shard.index;
+        }
+        shard.cost += componentCosts[componentIndex];
+    }
+
+    // A shard depends on every other shard it calls into
+    for (auto &[function, index] : shardOfFunction) {
+        std::set<std::size_t> dependencies(shards[index].dependencies.begin(), shards[index].dependencies.end());
+
+        for (const auto &callRecord : *callGraph[function]) {
+            llvm::Function *callee = callRecord.second->getFunction();
+            auto calleeShard = callee != nullptr ? shardOfFunction.find(callee) : shardOfFunction.end();
+
+            if (calleeShard != shardOfFunction.end() && calleeShard->second != index) {
+                dependencies.insert(calleeShard->second);
+            }
+        }
+
+        shards[index].dependencies.assign(dependencies.begin(), dependencies.end());
+    }
+
+    return shards;
+}
+
+std::unique_ptr<llvm::Module> ShardedAnalysis::extractShard(const llvm::Module &module, const Shard &shard) {
+    const std::unordered_set<std::string> functions(shard.functions.begin(), shard.functions.end());
+    llvm::ValueToValueMapTy valueMap;
+
+    // Functions that are not cloned become external declarations
+    return llvm::CloneModule(module, valueMap, [&functions](const llvm::GlobalValue *value) {
+        return !llvm::isa<llvm::Function>(value) || functions.contains(value->getName().str());
+    });
+}
+
+nlohmann::json ShardedAnalysis::fallbackOutput(const Shard &shard) {
+    const double fallbackEnergy = ConfigParser::getAnalysisConfiguration().fallback["calls"]["UNKNOWN_FUNCTION"];
+
+    nlohmann::json output = nlohmann::json::object();
+    output["functions"] = nlohmann::json::object();
+
+    for (const auto &functionName : shard.functions) {
+        auto ilpObj = nlohmann::json::object();
+        ilpObj["numVariables"] = 0;
+        ilpObj["numConstrains"] = 0;
+        ilpObj["status"] = "fallback";
+
+        output["functions"][functionName] = {
+            {"energy", fallbackEnergy},
+            {"ILPS", nlohmann::json::array({ilpObj})},
+        };
+    }
+
+    return output;
+}
+
+void ShardedAnalysis::runWorker(llvm::Module &module, const Shard &shard, ShardAttempt attempt,
+                                const std::vector<std::string> &summaries,
+                                const std::filesystem::path &shardDirectory,
+                                const ShardingConfiguration &configuration, const Worker &worker) {
+    int exitCode = 0;
+    auto &metrics = MetricsRegistry::getInstance();
+    auto &selfEnergyMeter = SelfEnergyMeter::getInstance();
+
+    // The worker reports only its own share, the parent adds it to the values it already holds
+    metrics.reset();
+    selfEnergyMeter.reset();
+
+    try {
+        if (configuration.memoryLimit > 0) {
+            rlimit limit{};
+            limit.rlim_cur = static_cast<rlim_t>(configuration.memoryLimit) << 20;
+            limit.rlim_max = limit.rlim_cur;
+
+            if (setrlimit(RLIMIT_AS, &limit) != 0) {
+                std::cerr << "Shard " << shard.index << " runs without memory limit: " << std::strerror(errno)
+                          << "\n";
+                metrics.counter("spear_shard_memory_limit_failures",
+                                "Workers whose memory limit could not be set").inc();
+            }
+        }
+
+        // Only the parent reports the progress, the lines of the workers would interleave
+        ProgressReporter::getInstance().setEnabled(false);
+
+        auto analysisConfiguration = ConfigParser::getAnalysisConfiguration();
+
+        // ELBs of the configuration are only used if the user enabled the mapping, the summaries always are
+        if (analysisConfiguration.elbMappingActivated) {
+            for (const auto &elbfile : analysisConfiguration.elbfiles) {
+                ELBMapper::getInstance().deferMapping(elbfile);
+            }
+        }
+        for (const auto &summary : summaries) {
+            ELBMapper::getInstance().deferMapping(summary);
+        }
+
+        analysisConfiguration.elbMappingActivated = true;
+        analysisConfiguration.outputDirectory = shardDirectory.string();
+        if (attempt != ShardAttempt::FULL) {
+            analysisConfiguration.feasibilityEnabled = false;
+        }
+        ConfigParser::overrideAnalysisConfiguration(analysisConfiguration);
+
+        auto shardModule = extractShard(module, shard);
+        nlohmann::json output = worker(*shardModule, attempt);
+
+        std::ofstream outputFile(shardFile(shardDirectory, shard.index, ".json"));
+        outputFile << output.dump();
+        outputFile.close();
+
+        if (!outputFile) {
+            exitCode = 1;
+        }
+    } catch (const std::exception &exception) {
+        std::cerr << "Shard " << shard.index << " failed: " << exception.what() << "\n";
+        exitCode = 1;
+    }
+
+    // The metrics and self-energy measurements end with the process, so they are handed to the parent as well
+    try {
+        selfEnergyMeter.stop();
+        metrics.collectProcessMetrics();
+
+        nlohmann::json workerMetrics = nlohmann::json::object();
+        workerMetrics["metrics"] = metrics.toJson();
+        workerMetrics["selfEnergy"] = selfEnergyMeter.isEnabled() ? selfEnergyMeter.toJson() : nlohmann::json();
+
+        std::ofstream(shardFile(shardDirectory, shard.index, ".metrics.json")) << workerMetrics.dump();
+    } catch (const std::exception &exception) {
+        std::cerr << "Shard " << shard.index << " could not write its metrics: " << exception.what() << "\n";
+    }
+
+    // Skip the destructors and exit handlers of the state inherited from the parent
+    std::cout.flush();
+    std::cerr.flush();
+    llvm::outs().flush();
+    _exit(exitCode);
+}
+
+nlohmann::json ShardedAnalysis::run(llvm::Module &module, const ShardingConfiguration &configuration,
+                                    const Worker &worker) {
+    return run(module, partition(module, static_cast<std::size_t>(configuration.shards)), configuration, worker);
+}
+
+nlohmann::json ShardedAnalysis::run(llvm::Module &module, const std::vector<Shard> &shards,
+                                    const ShardingConfiguration &configuration, const Worker &worker) {
+    auto start = std::chrono::high_resolution_clock::now();
+    auto &metrics = MetricsRegistry::getInstance();
+    auto &selfEnergyMeter = SelfEnergyMeter::getInstance();
+    auto &logger = Logger::getInstance();
+
+    const std::size_t workers = static_cast<std::size_t>(std::max(configuration.workers, 1));
+
+    const std::filesystem::path shardDirectory =
+            std::filesystem::path(ConfigParser::getAnalysisConfiguration().outputDirectory) / "shards";
+    std::filesystem::create_directories(shardDirectory);
+
+    metrics.counter("spear_shards", "Shards the call graph was split into").inc(shards.size());
+
+    std::vector<ShardAttempt> attempts(shards.size(), ShardAttempt::FULL);
+    std::vector<nlohmann::json> failures(shards.size(), nlohmann::json::array());
+    std::vector<nlohmann::json> outputs(shards.size());
+    std::vector<bool> scheduled(shards.size(), false);
+    std::vector<bool> finished(shards.size(), false);
+    std::unordered_map<pid_t, std::size_t> running;
+    std::size_t finishedShards = 0;
+
+    ProgressPhase progress("sharded analysis", "shards", shards.size());
+
+    // Store the output of a shard and publish the energies of its functions to the shards calling them
+    auto finish = [&](std::size_t index, nlohmann::json output) {
+        nlohmann::json summary = nlohmann::json::object();
+        if (output.contains("functions") && output["functions"].is_object()) {
+            for (const auto &[functionName, functionObject] : output["functions"].items()) {
+                if (functionObject.contains("energy") && functionObject["energy"].is_number()) {
+                    summary[functionName] = functionObject["energy"];
+                }
+            }
+        }
+
+        std::ofstream(shardFile(shardDirectory, index, ".elb")) << summary.dump(4);
+
+        outputs[index] = std::move(output);
+        finished[index] = true;
+        finishedShards++;
+        ProgressReporter::getInstance().advance();
+    };
+
+    // Add the metrics and self-energy measurements of a finished worker. Workers running at the same time share the
+    // package counter, so their phase energies overlap
+    auto mergeWorkerMetrics = [&](std::size_t index) {
+        std::ifstream metricsFile(shardFile(shardDirectory, index, ".metrics.json"));
+        if (!metricsFile) {
+            return;
+        }
+
+        const nlohmann::json workerMetrics = nlohmann::json::parse(metricsFile, nullptr, false);
+        if (workerMetrics.is_discarded() || !workerMetrics.is_object()) {
+            logger.log("Metrics of shard " + std::to_string(index) + " could not be read", LOGLEVEL::WARNING);
+            return;
+        }
+
+        if (workerMetrics.contains("metrics")) {
+            metrics.merge(workerMetrics["metrics"]);
+        }
+        if (workerMetrics.contains("selfEnergy")) {
+            selfEnergyMeter.merge(workerMetrics["selfEnergy"]);
+        }
+    };
+
+    // Move a shard to the next attempt, shards out of attempts are assigned the fallback energy
+    auto fail = [&](std::size_t index, const std::string &reason) {
+        logger.log("Shard " + std::to_string(index) + " failed on the " + attemptName(attempts[index]) +
+                   " attempt: " + reason, LOGLEVEL::ERROR);
+        metrics.counter("spear_shard_failures", "Failed attempts to analyze a shard",
+                        {{"attempt", attemptName(attempts[index])}}).inc();
+
+        failures[index].push_back({{"attempt", attemptName(attempts[index])}, {"reason", reason}});
+        attempts[index] = attempts[index] == ShardAttempt::FULL ? ShardAttempt::REDUCED : ShardAttempt::FALLBACK;
+        scheduled[index] = false;
+
+        if (attempts[index] == ShardAttempt::FALLBACK) {
+            metrics.counter("spear_shard_fallbacks", "Shards assigned the fallback energy").inc();
+            finish(index, fallbackOutput(shards[index]));
+        }
+    };
+
+    while (finishedShards < shards.size()) {
+        bool forked = false;
+
+        // Start the shards whose callees are analyzed, callees always precede their callers
+        for (const Shard &shard : shards) {
+            if (running.size() >= workers) {
+                break;
+            }
+
+            bool ready = !scheduled[shard.index] && !finished[shard.index] &&
+                         std::all_of(shard.dependencies.begin(), shard.dependencies.end(),
+                                     [&finished](std::size_t dependency) { return finished[dependency]; });
+            if (!ready) {
+                continue;
+            }
+
+            std::vector<std::string> summaries;
+            for (std::size_t dependency : shard.dependencies) {
+                summaries.push_back(shardFile(shardDirectory, dependency, ".elb").string());
+            }
+
+            std::filesystem::remove(shardFile(shardDirectory, shard.index, ".json"));
+            std::filesystem::remove(shardFile(shardDirectory, shard.index, ".metrics.json"));
+
+            // Buffered output would be written by the parent and the worker otherwise
+            std::cout.flush();
+            llvm::outs().flush();
+
+            // Only the forking thread exists in the worker, so the sampler thread is restarted on both sides
+            selfEnergyMeter.suspendSampler();
+            pid_t pid = fork();
+            selfEnergyMeter.resumeSampler();
+            forked = true;
+
+            if (pid == 0) {
+                runWorker(module, shard, attempts[shard.index], summaries, shardDirectory, configuration, worker);
+            } else if (pid > 0) {
+                running[pid] = shard.index;
+                scheduled[shard.index] = true;
+            } else {
+                fail(shard.index, std::string("fork failed: ") + std::strerror(errno));
+            }
+        }
+
+        if (running.empty()) {
+            // A failed fork is retried on the next attempt
+            if (forked) {
+                continue;
+            }
+
+            // No shard is ready and none is running, so the remaining shards wait for each other, e.g. because the
+            // shards depend on each other. They are assigned the fallback energy instead of waiting forever
+            for (const Shard &shard : shards) {
+                if (finished[shard.index]) {
+                    continue;
+                }
+
+                logger.log("Shard " + std::to_string(shard.index) + " waits for shards that can not be analyzed",
+                           LOGLEVEL::ERROR);
+                failures[shard.index].push_back({{"attempt", attemptName(attempts[shard.index])},
+                                                 {"reason", "dependencies can not be analyzed"}});
+                attempts[shard.index] = ShardAttempt::FALLBACK;
+                metrics.counter("spear_shard_fallbacks", "Shards assigned the fallback energy").inc();
+                finish(shard.index, fallbackOutput(shard));
+            }
+            break;
+        }
+
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            // No worker left to wait for, the remaining shards can not be analyzed
+            for (auto &[lostPid, index] : running) {
+                fail(index, std::string("waitpid failed: ") + std::strerror(errno));
+            }
+            running.clear();
+            continue;
+        }
+
+        auto runningIterator = running.find(pid);
+        if (runningIterator == running.end()) {
+            continue;
+        }
+
+        const std::size_t index = runningIterator->second;
+        running.erase(runningIterator);
+        mergeWorkerMetrics(index);
+
+        if (WIFSIGNALED(status)) {
+            fail(index, std::string("killed by signal ") + strsignal(WTERMSIG(status)));
+        } else if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            fail(index, "exited with status " + std::to_string(WEXITSTATUS(status)));
+        } else {
+            std::ifstream outputFile(shardFile(shardDirectory, index, ".json"));
+            nlohmann::json output = nlohmann::json::parse(outputFile, nullptr, false);
+
+            if (output.is_discarded()) {
+                fail(index, "output could not be read");
+            } else {
+                finish(index, std::move(output));
+            }
+        }
+    }
+
+    nlohmann::json merged = nlohmann::json::object();
+    merged["analysis"] = nullptr;
+    merged["functions"] = nlohmann::json::object();
+    merged["shards"] = nlohmann::json::array();
+
+    for (const Shard &shard : shards) {
+        nlohmann::json &output = outputs[shard.index];
+
+        if (merged["analysis"].is_null() && output.contains("analysis")) {
+            merged["analysis"] = output["analysis"];
+        }
+
+        if (output.contains("functions") && output["functions"].is_object()) {
+            for (auto &[functionName, functionObject] : output["functions"].items()) {
+                merged["functions"][functionName] = std::move(functionObject);
+            }
+        }
+
+        merged["shards"].push_back({
+            {"index", shard.index},
+            {"functions", shard.functions.size()},
+            {"cost", shard.cost},
+            {"dependencies", shard.dependencies},
+            {"attempt", attemptName(attempts[shard.index])},
+            {"failures", failures[shard.index]},
+        });
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    merged["duration"] = duration.count();
+    metrics.recordPhaseDuration("sharded_analysis", duration);
+
+    logger.log("Sharded analysis of " + std::to_string(shards.size()) + " shards took: " +
+               std::to_string(duration.count()) + " µs", LOGLEVEL::INFO);
+
+    return merged;
+}
@@ -360,12 +360,11 @@ struct Energy : llvm::PassInfoMixin<Energy> {
         std::unordered_map<std::string, nlohmann::json> output = {};
         bool outputMultiple = false;
 
-        for (auto elbfile : ConfigParser::getAnalysisConfiguration().elbfiles) {
-            ELBMapper::getInstance().useMapping(elbfile);
+        // The ELB files are only parsed once a call to an external function is resolved
+        for (const auto &elbfile : ConfigParser::getAnalysisConfiguration().elbfiles) {
+            ELBMapper::getInstance().deferMapping(elbfile);
         }
 
-        auto mapping = ELBMapper::getInstance().getMapping();
-
         switch (ConfigParser::getAnalysisConfiguration().analysisType) {
             case AnalysisType::LEGACY:
                 output["legacy"] = PassUtil::legacyWrapper(module, functionAnalysisManager);
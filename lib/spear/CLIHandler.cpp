@@ -37,6 +37,10 @@ CLIOptions CLIHandler::parseCLI(int argc, char **argv) {
             if (arg == "profile") {
                 operation = Operation::PROFILE;
             }
+
+            if (arg == "recost") {
+                operation = Operation::RECOST;
+            }
         }
 
         // Check the operations for the subprogram
@@ -131,6 +135,43 @@ CLIOptions CLIHandler::parseCLI(int argc, char **argv) {
                 }
             }
             return AnalysisOptions(profilePath, configPath, programPath);
+        } else if (operation == Operation::RECOST) {
+            std::string profilePath;
+            std::string configPath;
+            std::string snapshotPath;
+
+            for (const auto &arg : arguments) {
+                if (arg == "--profile") {
+                    if (hasOption(arguments, "--profile")) {
+                        const std::string_view profileString = get_option(arguments, "--profile");
+
+                        if (CLIHandler::exists(profileString.data())) {
+                            profilePath = profileString;
+                        }
+                    }
+                }
+
+                if (arg == "--config") {
+                    if (hasOption(arguments, "--config")) {
+                        const std::string_view configLocationString = get_option(arguments, "--config");
+
+                        if (CLIHandler::exists(configLocationString.data())) {
+                            configPath = configLocationString;
+                        }
+                    }
+                }
+
+                if (arg == "--snapshot") {
+                    if (hasOption(arguments, "--snapshot")) {
+                        const std::string_view snapshotString = get_option(arguments, "--snapshot");
+
+                        if (CLIHandler::exists(snapshotString.data())) {
+                            snapshotPath = snapshotString;
+                        }
+                    }
+                }
+            }
+            return RecostOptions(profilePath, configPath, snapshotPath);
         }
     }
 
@@ -23,10 +23,19 @@ AnalysisOptions::AnalysisOptions(std::string profilePath, std::string configPath
     this->operation = Operation::ANALYZE;
 }
 
+RecostOptions::RecostOptions(std::string profilePath, std::string configPath, std::string snapshotPath) {
+    this->profilePath = std::move(profilePath);
+    this->configPath = std::move(configPath);
+    this->snapshotPath = std::move(snapshotPath);
+
+    this->operation = Operation::RECOST;
+}
+
 CLIOptions::CLIOptions() {
     this->codePath = "";
     this->saveLocation = "";
     this->profilePath = "";
     this->operation = Operation::UNDEFINED;
     this->programPath = "";
+    this->snapshotPath = "";
 }
@@ -106,6 +106,219 @@ bool ConfigParser::fallbackValid(json object) {
     return true;
 }
 
+bool ConfigParser::sweepValid(json object) {
+    // The sweep section is optional
+    if (!object.contains("sweep")) {
+        return true;
+    }
+
+    auto sweep = object["sweep"];
+
+    if (!sweep.is_object()) {
+        std::cout << "Invalid analysis.sweep: not an object." << std::endl;
+        return false;
+    }
+
+    if (!sweep.contains("enabled") || !sweep["enabled"].is_boolean()) {
+        std::cout << "Invalid analysis.sweep.enabled: missing or not a boolean." << std::endl;
+        return false;
+    }
+
+    if (!sweep.contains("mode") || !sweep["mode"].is_string() ||
+        ConfigurationUtils::strToSweepMode(sweep["mode"].get<std::string>()) == SweepMode::UNDEFINED) {
+        std::cout << "Invalid analysis.sweep.mode: missing or unsupported value." << std::endl;
+        return false;
+    }
+
+    if (!sweep.contains("grid") || !sweep["grid"].is_array()) {
+        std::cout << "Invalid analysis.sweep.grid: missing or not an array." << std::endl;
+        return false;
+    }
+
+    for (const auto& value : sweep["grid"]) {
+        if (!value.is_number() || value.get<double>() <= 0.0) {
+            std::cout << "Invalid analysis.sweep.grid: all values have to be positive numbers." << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ConfigParser::loopboundValid(json object) {
+    // The loop bound section is optional
+    if (!object.contains("loopbound")) {
+        return true;
+    }
+
+    auto loopbound = object["loopbound"];
+
+    if (!loopbound.is_object()) {
+        std::cout << "Invalid analysis.loopbound: not an object." << std::endl;
+        return false;
+    }
+
+    if (loopbound.contains("threads") &&
+        (!loopbound["threads"].is_number_integer() || loopbound["threads"].get<int>() < 1)) {
+        std::cout << "Invalid analysis.loopbound.threads: not a positive integer." << std::endl;
+        return false;
+    }
+
+    if (loopbound.contains("verifyParallel") && !loopbound["verifyParallel"].is_boolean()) {
+        std::cout << "Invalid analysis.loopbound.verifyParallel: not a boolean." << std::endl;
+        return false;
+    }
+
+    if (loopbound.contains("mode") && (!loopbound["mode"].is_string() ||
+        ConfigurationUtils::strToLoopBoundMode(loopbound["mode"].get<std::string>()) == LoopBoundMode::UNDEFINED)) {
+        std::cout << "Invalid analysis.loopbound.mode: unsupported value." << std::endl;
+        return false;
+    }
+
+    if (loopbound.contains("widenAfter") &&
+        (!loopbound["widenAfter"].is_number_integer() || loopbound["widenAfter"].get<int>() < 0)) {
+        std::cout << "Invalid analysis.loopbound.widenAfter: not a non-negative integer." << std::endl;
+        return false;
+    }
+
+    if (loopbound.contains("narrowingRounds") &&
+        (!loopbound["narrowingRounds"].is_number_integer() || loopbound["narrowingRounds"].get<int>() < 0)) {
+        std::cout << "Invalid analysis.loopbound.narrowingRounds: not a non-negative integer." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool ConfigParser::satPortfolioValid(json object) {
+    // The sat portfolio section is optional
+    if (!object.contains("satPortfolio")) {
+        return true;
+    }
+
+    auto satPortfolio = object["satPortfolio"];
+
+    if (!satPortfolio.is_object()) {
+        std::cout << "Invalid analysis.satPortfolio: not an object." << std::endl;
+        return false;
+    }
+
+    if (!satPortfolio.contains("enabled") || !satPortfolio["enabled"].is_boolean()) {
+        std::cout << "Invalid analysis.satPortfolio.enabled: missing or not a boolean." << std::endl;
+        return false;
+    }
+
+    if (!satPortfolio.contains("initialBudget") || !satPortfolio["initialBudget"].is_number_integer() ||
+        satPortfolio["initialBudget"].get<int>() < 1) {
+        std::cout << "Invalid analysis.satPortfolio.initialBudget: missing or not a positive integer." << std::endl;
+        return false;
+    }
+
+    if (satPortfolio.contains("portfolioBudget") &&
+        (!satPortfolio["portfolioBudget"].is_number_integer() || satPortfolio["portfolioBudget"].get<int>() < 1)) {
+        std::cout << "Invalid analysis.satPortfolio.portfolioBudget: not a positive integer." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool ConfigParser::selfEnergyValid(json object) {
+    // The self energy section is optional
+    if (!object.contains("selfEnergy")) {
+        return true;
+    }
+
+    auto selfEnergy = object["selfEnergy"];
+
+    if (!selfEnergy.is_object()) {
+        std::cout << "Invalid analysis.selfEnergy: not an object." << std::endl;
+        return false;
+    }
+
+    if (!selfEnergy.contains("enabled") || !selfEnergy["enabled"].is_boolean()) {
+        std::cout << "Invalid analysis.selfEnergy.enabled: missing or not a boolean." << std::endl;
+        return false;
+    }
+
+    if (selfEnergy.contains("source") && (!selfEnergy["source"].is_string() ||
+        ConfigurationUtils::strToEnergySource(selfEnergy["source"].get<std::string>()) == EnergySource::UNDEFINED)) {
+        std::cout << "Invalid analysis.selfEnergy.source: unsupported value." << std::endl;
+        return false;
+    }
+
+    if (selfEnergy.contains("mockWatts") &&
+        (!selfEnergy["mockWatts"].is_number() || selfEnergy["mockWatts"].get<double>() <= 0)) {
+        std::cout << "Invalid analysis.selfEnergy.mockWatts: not a positive number." << std::endl;
+        return false;
+    }
+
+    if (selfEnergy.contains("samplingRate") &&
+        (!selfEnergy["samplingRate"].is_number_unsigned() || selfEnergy["samplingRate"].get<unsigned>() > 100000)) {
+        std::cout << "Invalid analysis.selfEnergy.samplingRate: not an integer between 0 and 100000." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool ConfigParser::shardingValid(json object) {
+    // The sharding section is optional
+    if (!object.contains("sharding")) {
+        return true;
+    }
+
+    auto sharding = object["sharding"];
+
+    if (!sharding.is_object()) {
+        std::cout << "Invalid analysis.sharding: not an object." << std::endl;
+        return false;
+    }
+
+    if (!sharding.contains("enabled") || !sharding["enabled"].is_boolean()) {
+        std::cout << "Invalid analysis.sharding.enabled: missing or not a boolean." << std::endl;
+        return false;
+    }
+
+    if (sharding.contains("shards") &&
+        (!sharding["shards"].is_number_integer() || sharding["shards"].get<int>() < 1)) {
+        std::cout << "Invalid analysis.sharding.shards: not a positive integer." << std::endl;
+        return false;
+    }
+
+    if (sharding.contains("workers") &&
+        (!sharding["workers"].is_number_integer() || sharding["workers"].get<int>() < 1)) {
+        std::cout << "Invalid analysis.sharding.workers: not a positive integer." << std::endl;
+        return false;
+    }
+
+    if (sharding.contains("memoryLimit") &&
+        (!sharding["memoryLimit"].is_number_integer() || sharding["memoryLimit"].get<int>() < 0)) {
+        std::cout << "Invalid analysis.sharding.memoryLimit: not a non-negative integer." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool ConfigParser::optionalBooleanValid(json object, const std::string& key) {
+    if (!object.contains(key) || object[key].is_boolean()) {
+        return true;
+    }
+
+    std::cout << "Invalid analysis." << key << ": not a boolean." << std::endl;
+    return false;
+}
+
+bool ConfigParser::optionalStringValid(json object, const std::string& key) {
+    if (!object.contains(key) || object[key].is_string()) {
+        return true;
+    }
+
+    std::cout << "Invalid analysis." << key << ": not a string." << std::endl;
+    return false;
+}
+
 bool ConfigParser::strategyValid(json object) {
     if (object.contains("strategy") && object["strategy"].is_string()) {
         std::string strategy = object["strategy"];
@@ -231,6 +444,17 @@ bool ConfigParser::SyscallProfilingConfigValid(json object) {
         if (syscallconfig.contains("runtime") && syscallconfig["runtime"].is_number_unsigned() &&
             syscallconfig.contains("default_energy") && syscallconfig["default_energy"].is_number() &&
             syscallconfig.contains("max_syscall_id") && syscallconfig["max_syscall_id"].is_number_unsigned()) {
+            if (syscallconfig.contains("batch_size") && (!syscallconfig["batch_size"].is_number_unsigned() ||
+                                                         syscallconfig["batch_size"].get<int>() < 1)) {
+                std::cout << "Invalid profiling.syscalls.batch_size: not a positive integer." << std::endl;
+                return false;
+            }
+
+            if (syscallconfig.contains("busy_poll") && !syscallconfig["busy_poll"].is_boolean()) {
+                std::cout << "Invalid profiling.syscalls.busy_poll: not a boolean." << std::endl;
+                return false;
+            }
+
             return true;
         }
         std::cout << "Invalid profiling.syscalls: missing or invalid properties." << std::endl;
@@ -241,6 +465,20 @@ bool ConfigParser::SyscallProfilingConfigValid(json object) {
     return false;
 }
 
+bool ConfigParser::timelineRateValid(json object) {
+    // The energy timeline of the profiling run is optional
+    if (!object.contains("timeline_rate")) {
+        return true;
+    }
+
+    if (object["timeline_rate"].is_number_unsigned() && object["timeline_rate"].get<unsigned>() <= 100000) {
+        return true;
+    }
+
+    std::cout << "Invalid profiling.timeline_rate: not an integer between 0 and 100000." << std::endl;
+    return false;
+}
+
 bool ConfigParser::profilingValid() {
     if (config.contains("profiling")) {
         auto profiling = config["profiling"];
@@ -249,7 +487,8 @@ bool ConfigParser::profilingValid() {
             return minProgramEnergy(profiling) &&
                 minInstructionEnergy(profiling) &&
                 CPURegressionValid(profiling) &&
-                SyscallProfilingConfigValid(profiling);
+                SyscallProfilingConfigValid(profiling) &&
+                timelineRateValid(profiling);
         }
         std::cout << "Invalid profiling: not an object." << std::endl;
         return false;
@@ -323,8 +562,19 @@ bool ConfigParser::analysisValid() {
             bool outputDirOk = outputDirValid(analysis);
             bool fallbackOk = fallbackValid(analysis);
             bool legacyOk = legacyValid(analysis) || analysis["type"] != "legacy";
-
-            if (outputDirOk && fallbackOk && legacyOk) {
+            bool sweepOk = sweepValid(analysis);
+            bool sensitivityOk = optionalBooleanValid(analysis, "sensitivityReport");
+            bool snapshotOk = optionalBooleanValid(analysis, "writeSnapshot");
+            bool progressOk = optionalBooleanValid(analysis, "progress");
+            bool metricsOk = optionalBooleanValid(analysis, "metrics");
+            bool loopboundOk = loopboundValid(analysis);
+            bool satPortfolioOk = satPortfolioValid(analysis);
+            bool selfEnergyOk = selfEnergyValid(analysis);
+            bool coreTypeOk = optionalStringValid(analysis, "coreType");
+            bool shardingOk = shardingValid(analysis);
+
+            if (outputDirOk && fallbackOk && legacyOk && sweepOk && sensitivityOk && snapshotOk && progressOk &&
+                metricsOk && loopboundOk && satPortfolioOk && selfEnergyOk && coreTypeOk && shardingOk) {
                 return true;
             }
             std::cout << "Invalid analysis: one or more properties are invalid." << std::endl;
@@ -343,10 +593,18 @@ AnalysisConfiguration ConfigParser::getAnalysisConfiguration() {
     return analysisConfiguration;
 }
 
+SatPortfolioConfiguration ConfigParser::getSatPortfolioConfiguration() {
+    return analysisConfiguration.satportfolioconfig;
+}
+
 ProfilingConfiguration ConfigParser::getProfilingConfiguration() {
     return profilingConfiguration;
 }
 
+void ConfigParser::overrideAnalysisConfiguration(const AnalysisConfiguration &configuration) {
+    analysisConfiguration = configuration;
+}
+
 void ConfigParser::parse() {
     if (config.empty()) {
         return;
@@ -365,6 +623,11 @@ void ConfigParser::parse() {
         analysisConfiguration.feasibilityEnabled = analysis["feasibilityEnabled"].get<bool>();
         analysisConfiguration.writeDotFiles = analysis["writeDotFiles"].get<bool>();
         analysisConfiguration.elbMappingActivated = analysis["elbMappingActivated"].get<bool>();
+        analysisConfiguration.sensitivityReportEnabled = analysis.value("sensitivityReport", false);
+        analysisConfiguration.writeSnapshot = analysis.value("writeSnapshot", false);
+        analysisConfiguration.progressEnabled = analysis.value("progress", false);
+        analysisConfiguration.metricsEnabled = analysis.value("metrics", false);
+        analysisConfiguration.coreType = analysis.value("coreType", "");
 
         analysisConfiguration.legacyconfig.mode = ConfigurationUtils::strToMode(
             legacyconfig["mode"].get<std::string>());
@@ -398,6 +661,68 @@ void ConfigParser::parse() {
             }
         }
 
+        // The sweep mode is disabled unless configured otherwise
+        analysisConfiguration.sweepconfig = {false, SweepMode::UNDEFINED, {}};
+
+        if (analysis.contains("sweep")) {
+            const auto& sweep = analysis["sweep"];
+
+            analysisConfiguration.sweepconfig.enabled = sweep["enabled"].get<bool>();
+            analysisConfiguration.sweepconfig.mode = ConfigurationUtils::strToSweepMode(
+                sweep["mode"].get<std::string>());
+            analysisConfiguration.sweepconfig.grid = sweep["grid"].get<std::vector<double>>();
+        }
+
+        // The loop bound analysis is solved serially unless configured otherwise
+        analysisConfiguration.loopboundconfig = {1, false, LoopBoundMode::TOPDOWN, 0, 5};
+
+        if (analysis.contains("loopbound")) {
+            const auto& loopbound = analysis["loopbound"];
+
+            analysisConfiguration.loopboundconfig.threads = loopbound.value("threads", 1);
+            analysisConfiguration.loopboundconfig.verifyParallel = loopbound.value("verifyParallel", false);
+            analysisConfiguration.loopboundconfig.mode = ConfigurationUtils::strToLoopBoundMode(
+                loopbound.value("mode", "topdown"));
+            analysisConfiguration.loopboundconfig.widenAfter = loopbound.value("widenAfter", 0);
+            analysisConfiguration.loopboundconfig.narrowingRounds = loopbound.value("narrowingRounds", 5);
+        }
+
+        // Feasibility queries are solved by the default solver only unless configured otherwise
+        analysisConfiguration.satportfolioconfig = {false, 0, 10000};
+
+        if (analysis.contains("satPortfolio")) {
+            const auto& satPortfolio = analysis["satPortfolio"];
+
+            analysisConfiguration.satportfolioconfig.enabled = satPortfolio["enabled"].get<bool>();
+            analysisConfiguration.satportfolioconfig.initialBudget = satPortfolio["initialBudget"].get<unsigned>();
+            analysisConfiguration.satportfolioconfig.portfolioBudget = satPortfolio.value("portfolioBudget", 10000U);
+        }
+
+        // SPEAR does not measure itself unless configured otherwise
+        analysisConfiguration.selfenergyconfig = {false, EnergySource::AUTO, 15.0, 0};
+
+        if (analysis.contains("selfEnergy")) {
+            const auto& selfEnergy = analysis["selfEnergy"];
+
+            analysisConfiguration.selfenergyconfig.enabled = selfEnergy["enabled"].get<bool>();
+            analysisConfiguration.selfenergyconfig.source = ConfigurationUtils::strToEnergySource(
+                selfEnergy.value("source", "auto"));
+            analysisConfiguration.selfenergyconfig.mockWatts = selfEnergy.value("mockWatts", 15.0);
+            analysisConfiguration.selfenergyconfig.samplingRate = selfEnergy.value("samplingRate", 0U);
+        }
+
+        // The module is analyzed in a single process unless configured otherwise
+        analysisConfiguration.shardingconfig = {false, 1, 1, 0};
+
+        if (analysis.contains("sharding")) {
+            const auto& sharding = analysis["sharding"];
+
+            analysisConfiguration.shardingconfig.enabled = sharding["enabled"].get<bool>();
+            analysisConfiguration.shardingconfig.shards = sharding.value("shards", 1);
+            analysisConfiguration.shardingconfig.workers = sharding.value("workers", 1);
+            analysisConfiguration.shardingconfig.memoryLimit = sharding.value("memoryLimit", 0);
+        }
+
         if (analysis.contains("ELBs") && analysis["ELBs"].is_array()) {
             for (const auto& elbFile : analysis["ELBs"]) {
                 if (elbFile.is_string()) {
@@ -417,5 +742,9 @@ void ConfigParser::parse() {
         profilingConfiguration.syscallconfig.runtime = profiling["syscalls"]["runtime"].get<int>();
         profilingConfiguration.syscallconfig.defaultEnergy = profiling["syscalls"]["default_energy"].get<double>();
         profilingConfiguration.syscallconfig.maxSyscallId = profiling["syscalls"]["max_syscall_id"].get<int>();
+        profilingConfiguration.syscallconfig.batchSize = profiling["syscalls"].value("batch_size", 256);
+        profilingConfiguration.syscallconfig.busyPoll = profiling["syscalls"].value("busy_poll", false);
+
+        profilingConfiguration.timelineRate = profiling.value("timeline_rate", 0U);
     }
 }
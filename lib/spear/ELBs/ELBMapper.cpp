@@ -3,8 +3,11 @@
  * All rights reserved.
  */
 
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "ELBs/ELBParser.h"
 #include "ELBs/ELPMapper.h"
@@ -17,16 +20,44 @@ ELBMapper &ELBMapper::getInstance() {
 void ELBMapper::useMapping(const std::string &filename) {
     auto parsedMapping = ELBParser::parseELBFile(filename);
 
+    std::lock_guard<std::mutex> lock(this->loadMutex);
     for (const auto& [key, value] : parsedMapping) {
         this->mapping[key] = value;
     }
 }
 
+void ELBMapper::deferMapping(const std::string &filename) {
+    std::lock_guard<std::mutex> lock(this->loadMutex);
+    this->pendingFiles.push_back(filename);
+    this->hasPendingFiles.store(true, std::memory_order_release);
+}
+
+void ELBMapper::loadPendingFiles() {
+    if (!this->hasPendingFiles.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(this->loadMutex);
+    std::vector<std::string> files = std::move(this->pendingFiles);
+    this->pendingFiles.clear();
+
+    for (const auto &filename : files) {
+        for (const auto& [key, value] : ELBParser::parseELBFile(filename)) {
+            this->mapping[key] = value;
+        }
+    }
+
+    this->hasPendingFiles.store(false, std::memory_order_release);
+}
+
 std::unordered_map<std::string, double> ELBMapper::getMapping() {
+    this->loadPendingFiles();
     return this->mapping;
 }
 
 std::optional<double> ELBMapper::lookup(std::string fname) {
+    this->loadPendingFiles();
+
     if (this->mapping.empty() || this->mapping.find(fname) == this->mapping.end()) {
         return std::nullopt;
     }
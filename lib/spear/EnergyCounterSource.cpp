@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include "EnergyCounterSource.h"
+
+#include <cmath>
+#include <exception>
+#include <memory>
+
+#include "Logger.h"
+
+uint64_t EnergyCounterSource::counterDelta(uint64_t previous, uint64_t current, unsigned counterBits) {
+    const uint64_t mask = counterBits >= 64 ? ~uint64_t{0} : (uint64_t{1} << counterBits) - 1;
+    return (current - previous) & mask;
+}
+
+std::unique_ptr<EnergyCounterSource> EnergyCounterSource::create(EnergySource source, double mockWatts) {
+    if (source == EnergySource::MOCK) {
+        return std::make_unique<MockCounterSource>(mockWatts);
+    }
+
+    if (source == EnergySource::RAPL) {
+        return std::make_unique<RaplCounterSource>();
+    }
+
+    if (RegisterReader::isAccessible(0)) {
+        try {
+            return std::make_unique<RaplCounterSource>();
+        } catch (const std::exception &exception) {
+            Logger::getInstance().log(std::string("RAPL counter unavailable: ") + exception.what(),
+                                      LOGLEVEL::WARNING);
+        }
+    }
+
+    Logger::getInstance().log("RAPL is not accessible, falling back to the mock energy counter", LOGLEVEL::WARNING);
+    return std::make_unique<MockCounterSource>(mockWatts);
+}
+
+RaplCounterSource::RaplCounterSource() : reader(0) {
+    energyUnit = reader.readMultiplier();
+}
+
+uint64_t RaplCounterSource::readCounter() {
+    // Bits 63:32 of the energy status register are reserved
+    return reader.readEnergyCounter() & 0xFFFFFFFFULL;
+}
+
+MockCounterSource::MockCounterSource(double watts, unsigned counterBits, double energyUnit)
+    : watts(watts), counterBits(counterBits), energyUnit(energyUnit), start(std::chrono::steady_clock::now()) {}
+
+uint64_t MockCounterSource::readCounter() {
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double joules = elapsed * watts + injectedJoules.load(std::memory_order_relaxed);
+
+    const auto ticks = static_cast<uint64_t>(std::floor(joules / energyUnit));
+    return counterDelta(0, ticks, counterBits);
+}
+
+void MockCounterSource::addEnergy(double joules) {
+    injectedJoules.fetch_add(joules, std::memory_order_relaxed);
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include "EnergySampler.h"
+
+#include <algorithm>
+#include <vector>
+
+uint64_t CounterExtender::extend(uint64_t raw) {
+    if (!initialized) {
+        initialized = true;
+        lastRaw = raw;
+        return extended;
+    }
+
+    if (counterBits < 64 && raw < lastRaw) {
+        wraparounds++;
+    }
+
+    extended += EnergyCounterSource::counterDelta(lastRaw, raw, counterBits);
+    lastRaw = raw;
+    return extended;
+}
+
+SampleRingBuffer::SampleRingBuffer(size_t capacity) {
+    size_t size = 1;
+    while (size < std::max<size_t>(capacity, 2)) {
+        size <<= 1;
+    }
+
+    slots.resize(size);
+    mask = size - 1;
+}
+
+bool SampleRingBuffer::push(const EnergySample &sample) {
+    const size_t currentHead = head.load(std::memory_order_relaxed);
+    if (currentHead - tail.load(std::memory_order_acquire) == slots.size()) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    slots[currentHead & mask] = sample;
+    head.store(currentHead + 1, std::memory_order_release);
+    return true;
+}
+
+size_t SampleRingBuffer::drain(std::vector<EnergySample> &target) {
+    const size_t currentTail = tail.load(std::memory_order_relaxed);
+    const size_t currentHead = head.load(std::memory_order_acquire);
+
+    for (size_t position = currentTail; position != currentHead; position++) {
+        target.push_back(slots[position & mask]);
+    }
+
+    tail.store(currentHead, std::memory_order_release);
+    return currentHead - currentTail;
+}
+
+EnergySampler::EnergySampler(EnergyCounterSource &source, unsigned rateHz, size_t capacity)
+    : source(source),
+      period(std::chrono::nanoseconds(1000000000ULL / std::max(rateHz, 1U))),
+      startTime(std::chrono::steady_clock::now()),
+      extender(source.getCounterBits()),
+      buffer(capacity) {}
+
+EnergySampler::~EnergySampler() {
+    stop();
+}
+
+void EnergySampler::start() {
+    if (running.exchange(true)) {
+        return;
+    }
+
+    // A restarted sampler continues the timeline of the first start
+    if (!started) {
+        startTime = std::chrono::steady_clock::now();
+        started = true;
+    }
+
+    sample();
+    samplerThread = std::thread(&EnergySampler::run, this);
+}
+
+void EnergySampler::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+
+    samplerThread.join();
+    sample();
+}
+
+void EnergySampler::run() {
+    auto nextSample = std::chrono::steady_clock::now() + period;
+
+    while (running.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_until(nextSample);
+        sample();
+
+        // Empty the buffer long before it is full. A consumer holding the lock is draining it already
+        if (buffer.size() * 2 >= buffer.getCapacity()) {
+            std::unique_lock<std::mutex> lock(timelineMutex, std::try_to_lock);
+            if (lock.owns_lock()) {
+                buffer.drain(timeline);
+            }
+        }
+
+        // Skip missed periods instead of sampling in a burst after the thread was descheduled
+        const auto now = std::chrono::steady_clock::now();
+        nextSample += period;
+        if (nextSample < now) {
+            nextSample = now + period;
+        }
+    }
+}
+
+void EnergySampler::sample() {
+    const uint64_t raw = source.readCounter();
+    const auto now = std::chrono::steady_clock::now();
+
+    const uint64_t ticks = extender.extend(raw);
+    const auto timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now - startTime).count();
+
+    buffer.push({static_cast<uint64_t>(std::max<int64_t>(timeNs, 0)), ticks});
+    latestTicks.store(ticks, std::memory_order_release);
+    wraparounds.store(extender.getWraparounds(), std::memory_order_relaxed);
+}
+
+void EnergySampler::collect() {
+    std::lock_guard<std::mutex> lock(timelineMutex);
+    buffer.drain(timeline);
+}
+
+std::vector<EnergySample> EnergySampler::getTimeline() {
+    collect();
+
+    std::lock_guard<std::mutex> lock(timelineMutex);
+    return timeline;
+}
+
+nlohmann::json EnergySampler::toJson() {
+    const auto samples = getTimeline();
+    const double energyUnit = source.getEnergyUnit();
+
+    nlohmann::json sampleList = nlohmann::json::array();
+    for (size_t index = 0; index < samples.size(); index++) {
+        const double seconds = static_cast<double>(samples[index].timeNs) * 1e-9;
+        const double joules = static_cast<double>(samples[index].ticks) * energyUnit;
+
+        // Average power since the previous sample, the first sample has no predecessor
+        double watts = 0;
+        if (index > 0 && samples[index].timeNs > samples[index - 1].timeNs) {
+            const double previousJoules = static_cast<double>(samples[index - 1].ticks) * energyUnit;
+            const double previousSeconds = static_cast<double>(samples[index - 1].timeNs) * 1e-9;
+            watts = (joules - previousJoules) / (seconds - previousSeconds);
+        }
+
+        sampleList.push_back({seconds, joules, watts});
+    }
+
+    nlohmann::json output = nlohmann::json::object();
+    output["source"] = source.getName();
+    output["rate"] = 1e9 / static_cast<double>(period.count());
+    output["energyUnit"] = energyUnit;
+    output["counterBits"] = source.getCounterBits();
+    output["wraparounds"] = getWraparounds();
+    output["dropped"] = getDroppedSamples();
+    output["columns"] = {"seconds", "joules", "watts"};
+    output["samples"] = sampleList;
+
+    return output;
+}
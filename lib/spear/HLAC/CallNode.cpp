@@ -7,6 +7,7 @@
 #include <iostream>
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -236,48 +237,15 @@ bool CallNode::checkIfIsSyscall() {
 }
 
 double CallNode::getEnergy() {
-    // If we encounter a syscall, we can just return the energy
-    if (this->isSyscall) {
-        if (syscallId.has_value()) {
-            auto candidate =
-                    ProfileHandler::get_instance().getEnergyForSyscall(std::string(getSyscallName(syscallId.value())));
-            if (candidate.has_value()) {
-                return candidate.value();
-            }
-        }
-    }
-
-    // If we have a normal call we need to calculate the energy of the called function and return this as the energy of
-    // the call
-    if (isLinkerFunction) {
-        // if we have a linker function first check if there is a ELB lookup
-        if (ConfigParser::getAnalysisConfiguration().elbMappingActivated) {
-            // Try to resolve the value through the ELBMapper
-            auto lookUpCandidate = ELBMapper::getInstance().lookup(this->calledFunction->getName().str());
-            if (lookUpCandidate.has_value()) {
-                // If we found a value return it
-                this->resolvedByELB = true;
-                return lookUpCandidate.value();
-            }
-        }
-
-        // If the linker function could not be resolved using the ELBMapper, we need to fallback to the config val
-        double fallbackEnergy = ConfigParser::getAnalysisConfiguration().fallback["calls"]["UNKNOWN_FUNCTION"];
-
-        std::ostringstream outputStream;
-        outputStream << std::scientific << std::setprecision(8) << fallbackEnergy;
-
-        /*Logger::getInstance().log("CallNode " + this->calledFunction->getName().str() +
-            " is a linker function. We do not have the body of the function and thus cannot analyze it. Returning energy " +
-            outputStream.str() + " J", LOGLEVEL::WARNING);*/
-
-        return fallbackEnergy;
+    // Syscalls and linker functions are priced without looking at the called function
+    auto unanalyzedEnergy = getUnanalyzedCallEnergy(this->isSyscall, this->syscallId, this->isLinkerFunction,
+                                                    this->calledFunction->getName().str(), &this->resolvedByELB);
+    if (unanalyzedEnergy.has_value()) {
+        return unanalyzedEnergy.value();
     }
 
     // Assume the function has been analyzed beforehand, so we can just look up the energy in the cache of the parent
     // graph
-    // Logger::getInstance().log("Caller:" + this->parentFunctionNode->function->getName().str());
-    auto callername = this->parentFunctionNode->function->getName().str();
     auto calleename = this->calledFunction->getName().str();
 
     auto energyOfCallee = parentFunctionNode->parentGraph->getEnergyPerFunction(calleename,
@@ -286,6 +254,40 @@ double CallNode::getEnergy() {
     return energyOfCallee;
 }
 
+std::optional<double> CallNode::getUnanalyzedCallEnergy(bool isSyscall, std::optional<size_t> syscallId,
+                                                        bool isLinkerFunction, const std::string &calleeName,
+                                                        bool *resolvedByELB) {
+    // If we encounter a syscall, we can just return the energy
+    if (isSyscall && syscallId.has_value()) {
+        auto candidate = ProfileHandler::get_instance().getEnergyForSyscall(
+                std::string(getSyscallName(syscallId.value())));
+        if (candidate.has_value()) {
+            return candidate.value();
+        }
+    }
+
+    if (!isLinkerFunction) {
+        return std::nullopt;
+    }
+
+    // If we have a linker function first check if there is a ELB lookup
+    if (ConfigParser::getAnalysisConfiguration().elbMappingActivated) {
+        // Try to resolve the value through the ELBMapper
+        auto lookUpCandidate = ELBMapper::getInstance().lookup(calleeName);
+        if (lookUpCandidate.has_value()) {
+            // If we found a value return it
+            if (resolvedByELB != nullptr) {
+                *resolvedByELB = true;
+            }
+            return lookUpCandidate.value();
+        }
+    }
+
+    // If the linker function could not be resolved using the ELBMapper, we need to fallback to the config val
+    double fallbackEnergy = ConfigParser::getAnalysisConfiguration().fallback["calls"]["UNKNOWN_FUNCTION"];
+    return fallbackEnergy;
+}
+
 std::string CallNode::calculateHash() {
     return Hasher::getHashForNode(this);
 }
@@ -251,8 +251,11 @@ bool FunctionNode::isFunctionRecursive(llvm::LazyCallGraph &lazyCallGraph) {
 }
 
 void FunctionNode::constructLoopNodes(std::vector<llvm::Loop *> &loops) {
+    // Sort the nodes and edges into their innermost loops once for all loop nodes of the function
+    LoopPartition partition = LoopPartition::build(this, loops);
+
     for (auto &loop : loops) {
-        auto loopNode = LoopNode::makeNode(loop, this, registry, this);
+        auto loopNode = LoopNode::makeNode(loop, this, registry, this, partition);
         loopNode->collapseLoop(this->Edges);
 
         this->Nodes.push_back(std::move(loopNode));
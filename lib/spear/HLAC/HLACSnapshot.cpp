@@ -0,0 +1,444 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include "HLAC/HLACSnapshot.h"
+
+#include <llvm/IR/Instructions.h>
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "HLAC/hlac.h"
+#include "Logger.h"
+#include "ProgressReporter.h"
+
+namespace HLAC {
+
+namespace {
+
+const char snapshotMagic[8] = {'S', 'P', 'E', 'A', 'R', 'H', 'L', 'C'};
+
+/**
+ * Upper limit for any count read from a snapshot. Protects against allocating huge vectors for corrupted files
+ */
+constexpr uint32_t maxSnapshotCount = 1U << 26;
+
+template <typename T>
+void writeValue(std::ostream &outputStream, T value) {
+    outputStream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void writeString(std::ostream &outputStream, const std::string &value) {
+    writeValue<uint32_t>(outputStream, static_cast<uint32_t>(value.size()));
+    outputStream.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+template <typename T>
+bool readValue(std::istream &inputStream, T &value) {
+    inputStream.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return static_cast<bool>(inputStream);
+}
+
+bool readCount(std::istream &inputStream, uint32_t &count) {
+    return readValue(inputStream, count) && count <= maxSnapshotCount;
+}
+
+bool readString(std::istream &inputStream, std::string &value) {
+    uint32_t length = 0;
+    if (!readCount(inputStream, length)) {
+        return false;
+    }
+
+    value.resize(length);
+    inputStream.read(value.data(), static_cast<std::streamsize>(length));
+    return static_cast<bool>(inputStream);
+}
+
+}  // namespace
+
+HLACSnapshot HLACSnapshot::capture(hlac &graph) {
+    HLACSnapshot snapshot;
+
+    for (auto &functionNode : graph.functions) {
+        SnapshotFunction snapshotFunction;
+        snapshotFunction.name = functionNode->name;
+        snapshotFunction.isGotoFunction = functionNode->isGotoFunction;
+        snapshotFunction.isIllFormatted = functionNode->isIllFormatted;
+        snapshotFunction.isRecursive = functionNode->isRecursive;
+
+        snapshot.captureScope(snapshotFunction, functionNode->Nodes, functionNode->Edges, nullptr);
+
+        if (snapshotFunction.isIncomplete) {
+            Logger::getInstance().log("Snapshot of function " + snapshotFunction.name +
+                                              " is incomplete. It will be costed with the fallback energy.",
+                                      LOGLEVEL::WARNING);
+        }
+
+        snapshot.functions.push_back(std::move(snapshotFunction));
+    }
+
+    return snapshot;
+}
+
+uint32_t HLACSnapshot::captureScope(SnapshotFunction &snapshotFunction,
+                                    const std::vector<std::unique_ptr<GenericNode>> &nodes,
+                                    const std::vector<std::unique_ptr<Edge>> &edges,
+                                    const std::vector<Edge *> *backEdges) {
+    const auto scopeIndex = static_cast<uint32_t>(snapshotFunction.scopes.size());
+    snapshotFunction.scopes.emplace_back();
+
+    SnapshotScope scope;
+    std::unordered_map<GenericNode *, uint32_t> nodeIndices;
+
+    for (const auto &nodeUP : nodes) {
+        nodeIndices[nodeUP.get()] = static_cast<uint32_t>(scope.nodes.size());
+        scope.nodes.push_back(captureNode(nodeUP.get()));
+    }
+
+    for (const auto &edgeUP : edges) {
+        Edge *edge = edgeUP.get();
+        if (edge == nullptr) {
+            continue;
+        }
+
+        auto sourceIt = nodeIndices.find(edge->soure);
+        auto destinationIt = nodeIndices.find(edge->destination);
+        if (sourceIt == nodeIndices.end() || destinationIt == nodeIndices.end()) {
+            // Edges leaving the scope cannot be expressed in the snapshot
+            snapshotFunction.isIncomplete = true;
+            continue;
+        }
+
+        SnapshotEdge snapshotEdge;
+        snapshotEdge.source = sourceIt->second;
+        snapshotEdge.destination = destinationIt->second;
+        snapshotEdge.feasibility = edge->feasibility;
+        snapshotEdge.isBackEdge = backEdges != nullptr &&
+                                  std::find(backEdges->begin(), backEdges->end(), edge) != backEdges->end();
+        scope.edges.push_back(snapshotEdge);
+    }
+
+    snapshotFunction.scopes[scopeIndex] = std::move(scope);
+
+    // Loop bodies are captured after the scope itself, in the order ILPUtil assigns the ILP columns
+    for (std::size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex) {
+        auto *loopNode = dynamic_cast<LoopNode *>(nodes[nodeIndex].get());
+        if (loopNode == nullptr) {
+            continue;
+        }
+
+        const uint32_t bodyScope = captureScope(snapshotFunction, loopNode->Nodes, loopNode->Edges,
+                                                &loopNode->backEdges);
+        snapshotFunction.scopes[scopeIndex].nodes[nodeIndex].bodyScope = bodyScope;
+    }
+
+    return scopeIndex;
+}
+
+SnapshotNode HLACSnapshot::captureNode(GenericNode *node) {
+    SnapshotNode snapshotNode;
+    snapshotNode.nodeType = static_cast<uint8_t>(node->nodeType);
+
+    if (auto *normalNode = dynamic_cast<Node *>(node)) {
+        // Count the opcodes with the same names Node::getEnergy uses to query the profile
+        std::unordered_map<uint32_t, uint32_t> opcodeCounts;
+
+        for (const llvm::Instruction &instruction : *normalNode->block) {
+            std::string instname = instruction.getOpcodeName();
+
+            if (auto icmpinst = llvm::dyn_cast<llvm::ICmpInst>(&instruction)) {
+                instname = std::string("icmp ") +
+                           llvm::ICmpInst::getPredicateName(icmpinst->getPredicate()).str();
+            }
+
+            opcodeCounts[getOpcodeIndex(instname)]++;
+        }
+
+        snapshotNode.opcodeCounts.assign(opcodeCounts.begin(), opcodeCounts.end());
+        std::sort(snapshotNode.opcodeCounts.begin(), snapshotNode.opcodeCounts.end());
+    } else if (auto *virtualNode = dynamic_cast<VirtualNode *>(node)) {
+        snapshotNode.virtualNodeKind = static_cast<uint8_t>(virtualNode->virtualNodeKind);
+    } else if (auto *callNode = dynamic_cast<CallNode *>(node)) {
+        snapshotNode.calleeName = callNode->calledFunction->getName().str();
+        snapshotNode.isSyscall = callNode->isSyscall;
+        snapshotNode.isLinkerFunction = callNode->isLinkerFunction;
+        snapshotNode.isDebugFunction = callNode->isDebugFunction;
+        snapshotNode.syscallId = callNode->syscallId.has_value() ? static_cast<int64_t>(callNode->syscallId.value())
+                                                                 : -1;
+    } else if (auto *loopNode = dynamic_cast<LoopNode *>(node)) {
+        snapshotNode.lowerBound = loopNode->bounds.getLowerBound();
+        snapshotNode.upperBound = loopNode->bounds.getUpperBound();
+    }
+
+    return snapshotNode;
+}
+
+uint32_t HLACSnapshot::getOpcodeIndex(const std::string &opcodeName) {
+    auto [opcodeIt, inserted] = opcodeIndices.try_emplace(opcodeName, static_cast<uint32_t>(opcodeNames.size()));
+    if (inserted) {
+        opcodeNames.push_back(opcodeName);
+    }
+
+    return opcodeIt->second;
+}
+
+void HLACSnapshot::write(const std::string &path) const {
+    std::ofstream outputStream(path, std::ios::binary | std::ios::trunc);
+    if (!outputStream.is_open()) {
+        throw std::runtime_error("Failed to open snapshot for writing: " + path);
+    }
+
+    outputStream.write(snapshotMagic, sizeof(snapshotMagic));
+    writeValue<uint32_t>(outputStream, formatVersion);
+
+    writeValue<uint32_t>(outputStream, static_cast<uint32_t>(opcodeNames.size()));
+    for (const auto &opcodeName : opcodeNames) {
+        writeString(outputStream, opcodeName);
+    }
+
+    // The size of the snapshot is not known upfront, so the bytes are reported without a total
+    ProgressPhase progress("snapshot", "bytes", 0);
+    auto writtenBytes = outputStream.tellp();
+
+    writeValue<uint32_t>(outputStream, static_cast<uint32_t>(functions.size()));
+    for (const auto &snapshotFunction : functions) {
+        writeFunction(outputStream, snapshotFunction);
+
+        const auto position = outputStream.tellp();
+        ProgressReporter::getInstance().advance(static_cast<uint64_t>(position - writtenBytes));
+        writtenBytes = position;
+    }
+
+    if (!outputStream) {
+        throw std::runtime_error("Failed to write snapshot: " + path);
+    }
+}
+
+void HLACSnapshot::writeFunction(std::ostream &outputStream, const SnapshotFunction &snapshotFunction) {
+    writeString(outputStream, snapshotFunction.name);
+
+    const uint8_t flags = (snapshotFunction.isGotoFunction ? 1U : 0U) | (snapshotFunction.isIllFormatted ? 2U : 0U) |
+                          (snapshotFunction.isRecursive ? 4U : 0U) | (snapshotFunction.isIncomplete ? 8U : 0U);
+    writeValue<uint8_t>(outputStream, flags);
+
+    writeValue<uint32_t>(outputStream, static_cast<uint32_t>(snapshotFunction.scopes.size()));
+    for (const auto &scope : snapshotFunction.scopes) {
+        writeValue<uint32_t>(outputStream, static_cast<uint32_t>(scope.nodes.size()));
+
+        for (const auto &node : scope.nodes) {
+            writeValue<uint8_t>(outputStream, node.nodeType);
+
+            switch (static_cast<NodeType>(node.nodeType)) {
+                case NodeType::NODE:
+                    writeValue<uint32_t>(outputStream, static_cast<uint32_t>(node.opcodeCounts.size()));
+                    for (const auto &[opcodeIndex, count] : node.opcodeCounts) {
+                        writeValue<uint32_t>(outputStream, opcodeIndex);
+                        writeValue<uint32_t>(outputStream, count);
+                    }
+                    break;
+
+                case NodeType::VIRTUALNODE:
+                    writeValue<uint8_t>(outputStream, node.virtualNodeKind);
+                    break;
+
+                case NodeType::CALLNODE: {
+                    writeString(outputStream, node.calleeName);
+                    const uint8_t callFlags = (node.isSyscall ? 1U : 0U) | (node.isLinkerFunction ? 2U : 0U) |
+                                              (node.isDebugFunction ? 4U : 0U);
+                    writeValue<uint8_t>(outputStream, callFlags);
+                    writeValue<int64_t>(outputStream, node.syscallId);
+                    break;
+                }
+
+                case NodeType::LOOPNODE:
+                    writeValue<int64_t>(outputStream, node.lowerBound);
+                    writeValue<int64_t>(outputStream, node.upperBound);
+                    writeValue<uint32_t>(outputStream, node.bodyScope);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        writeValue<uint32_t>(outputStream, static_cast<uint32_t>(scope.edges.size()));
+        for (const auto &edge : scope.edges) {
+            writeValue<uint32_t>(outputStream, edge.source);
+            writeValue<uint32_t>(outputStream, edge.destination);
+            writeValue<uint8_t>(outputStream, (edge.feasibility ? 1U : 0U) | (edge.isBackEdge ? 2U : 0U));
+        }
+    }
+}
+
+std::optional<HLACSnapshot> HLACSnapshot::read(const std::string &path) {
+    std::ifstream inputStream(path, std::ios::binary);
+    if (!inputStream.is_open()) {
+        Logger::getInstance().log("Failed to open snapshot " + path, LOGLEVEL::ERROR);
+        return std::nullopt;
+    }
+
+    char magic[sizeof(snapshotMagic)];
+    uint32_t version = 0;
+    inputStream.read(magic, sizeof(magic));
+
+    if (!inputStream || !std::equal(std::begin(magic), std::end(magic), std::begin(snapshotMagic)) ||
+        !readValue(inputStream, version) || version != formatVersion) {
+        Logger::getInstance().log("File " + path + " is not a snapshot of format version " +
+                                          std::to_string(formatVersion),
+                                  LOGLEVEL::ERROR);
+        return std::nullopt;
+    }
+
+    HLACSnapshot snapshot;
+    uint32_t opcodeCount = 0;
+    uint32_t functionCount = 0;
+    bool valid = readCount(inputStream, opcodeCount);
+
+    for (uint32_t opcodeIndex = 0; valid && opcodeIndex < opcodeCount; ++opcodeIndex) {
+        std::string opcodeName;
+        valid = readString(inputStream, opcodeName);
+        snapshot.opcodeIndices.try_emplace(opcodeName, opcodeIndex);
+        snapshot.opcodeNames.push_back(std::move(opcodeName));
+    }
+
+    valid = valid && readCount(inputStream, functionCount);
+
+    for (uint32_t functionIndex = 0; valid && functionIndex < functionCount; ++functionIndex) {
+        SnapshotFunction snapshotFunction;
+        valid = readFunction(inputStream, snapshotFunction);
+        snapshot.functions.push_back(std::move(snapshotFunction));
+    }
+
+    if (!valid) {
+        Logger::getInstance().log("Snapshot " + path + " is truncated or corrupted", LOGLEVEL::ERROR);
+        return std::nullopt;
+    }
+
+    // Validate all indices, so the re-costing can access them unchecked
+    for (const auto &snapshotFunction : snapshot.functions) {
+        for (std::size_t scopeIndex = 0; scopeIndex < snapshotFunction.scopes.size(); ++scopeIndex) {
+            const auto &scope = snapshotFunction.scopes[scopeIndex];
+
+            for (const auto &node : scope.nodes) {
+                for (const auto &[opcodeIndex, count] : node.opcodeCounts) {
+                    valid = valid && opcodeIndex < snapshot.opcodeNames.size();
+                }
+
+                // Loop bodies are stored after their parent scope, which also rules out cycles
+                valid = valid && (static_cast<NodeType>(node.nodeType) != NodeType::LOOPNODE ||
+                                  (node.bodyScope > scopeIndex && node.bodyScope < snapshotFunction.scopes.size()));
+            }
+
+            for (const auto &edge : scope.edges) {
+                valid = valid && edge.source < scope.nodes.size() && edge.destination < scope.nodes.size();
+            }
+        }
+    }
+
+    if (!valid) {
+        Logger::getInstance().log("Snapshot " + path + " contains invalid indices", LOGLEVEL::ERROR);
+        return std::nullopt;
+    }
+
+    return snapshot;
+}
+
+bool HLACSnapshot::readFunction(std::istream &inputStream, SnapshotFunction &snapshotFunction) {
+    uint8_t flags = 0;
+    uint32_t scopeCount = 0;
+
+    if (!readString(inputStream, snapshotFunction.name) || !readValue(inputStream, flags) ||
+        !readCount(inputStream, scopeCount)) {
+        return false;
+    }
+
+    snapshotFunction.isGotoFunction = (flags & 1U) != 0;
+    snapshotFunction.isIllFormatted = (flags & 2U) != 0;
+    snapshotFunction.isRecursive = (flags & 4U) != 0;
+    snapshotFunction.isIncomplete = (flags & 8U) != 0;
+    snapshotFunction.scopes.resize(scopeCount);
+
+    for (auto &scope : snapshotFunction.scopes) {
+        uint32_t nodeCount = 0;
+        if (!readCount(inputStream, nodeCount)) {
+            return false;
+        }
+
+        scope.nodes.resize(nodeCount);
+        for (auto &node : scope.nodes) {
+            if (!readValue(inputStream, node.nodeType)) {
+                return false;
+            }
+
+            bool nodeValid = true;
+
+            switch (static_cast<NodeType>(node.nodeType)) {
+                case NodeType::NODE: {
+                    uint32_t opcodeCount = 0;
+                    nodeValid = readCount(inputStream, opcodeCount);
+                    node.opcodeCounts.resize(nodeValid ? opcodeCount : 0);
+
+                    for (auto &[opcodeIndex, count] : node.opcodeCounts) {
+                        nodeValid = nodeValid && readValue(inputStream, opcodeIndex) && readValue(inputStream, count);
+                    }
+                    break;
+                }
+
+                case NodeType::VIRTUALNODE:
+                    nodeValid = readValue(inputStream, node.virtualNodeKind);
+                    break;
+
+                case NodeType::CALLNODE: {
+                    uint8_t callFlags = 0;
+                    nodeValid = readString(inputStream, node.calleeName) && readValue(inputStream, callFlags) &&
+                                readValue(inputStream, node.syscallId);
+                    node.isSyscall = (callFlags & 1U) != 0;
+                    node.isLinkerFunction = (callFlags & 2U) != 0;
+                    node.isDebugFunction = (callFlags & 4U) != 0;
+                    break;
+                }
+
+                case NodeType::LOOPNODE:
+                    nodeValid = readValue(inputStream, node.lowerBound) && readValue(inputStream, node.upperBound) &&
+                                readValue(inputStream, node.bodyScope);
+                    break;
+
+                default:
+                    break;
+            }
+
+            if (!nodeValid) {
+                return false;
+            }
+        }
+
+        uint32_t edgeCount = 0;
+        if (!readCount(inputStream, edgeCount)) {
+            return false;
+        }
+
+        scope.edges.resize(edgeCount);
+        for (auto &edge : scope.edges) {
+            uint8_t edgeFlags = 0;
+            if (!readValue(inputStream, edge.source) || !readValue(inputStream, edge.destination) ||
+                !readValue(inputStream, edgeFlags)) {
+                return false;
+            }
+
+            edge.feasibility = (edgeFlags & 1U) != 0;
+            edge.isBackEdge = (edgeFlags & 2U) != 0;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace HLAC
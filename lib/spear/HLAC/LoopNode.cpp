@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -14,6 +15,7 @@
 #include "HLAC/hlac.h"
 #include "HLAC/util.h"
 #include "Logger.h"
+#include "MetricsRegistry.h"
 #include "analyses/loopbound/LoopBoundEdgeFunction.h"
 
 namespace HLAC {
@@ -49,8 +51,86 @@ static std::string genericNodeTypeToString(const HLAC::GenericNode *genericNode)
     return "GenericNode";
 }
 
+LoopPartition LoopPartition::build(FunctionNode *functionNode, const std::vector<llvm::Loop *> &loops) {
+    LoopPartition partition;
+
+    // Map every basic block to its innermost loop. A loop is visited before its subloops, which overwrite the entries
+    // of their blocks
+    std::unordered_map<const llvm::BasicBlock *, const llvm::Loop *> innermostLoop;
+    std::vector<const llvm::Loop *> worklist(loops.begin(), loops.end());
+
+    while (!worklist.empty()) {
+        const llvm::Loop *loop = worklist.back();
+        worklist.pop_back();
+
+        for (const llvm::BasicBlock *basicBlock : loop->getBlocks()) {
+            innermostLoop[basicBlock] = loop;
+        }
+
+        for (const llvm::Loop *subLoop : loop->getSubLoops()) {
+            worklist.push_back(subLoop);
+        }
+    }
+
+    // Move the nodes of all loop blocks into the partition, keeping the others in place
+    std::unordered_map<const GenericNode *, const llvm::Loop *> nodeOwners;
+    nodeOwners.reserve(innermostLoop.size());
+
+    std::vector<std::unique_ptr<GenericNode>> remainingNodes;
+    remainingNodes.reserve(functionNode->Nodes.size());
+
+    for (auto &nodeUniquePointer : functionNode->Nodes) {
+        const llvm::Loop *owner = nullptr;
+
+        if (auto *normalNode = dynamic_cast<Node *>(nodeUniquePointer.get())) {
+            auto ownerIterator = innermostLoop.find(normalNode->block);
+            if (ownerIterator != innermostLoop.end()) {
+                owner = ownerIterator->second;
+            }
+        }
+
+        if (owner != nullptr) {
+            nodeOwners.emplace(nodeUniquePointer.get(), owner);
+            partition.nodes[owner].push_back(std::move(nodeUniquePointer));
+        } else {
+            remainingNodes.push_back(std::move(nodeUniquePointer));
+        }
+    }
+
+    functionNode->Nodes = std::move(remainingNodes);
+
+    // Edges belong to a loop if both of their endpoints are owned by it
+    std::vector<std::unique_ptr<Edge>> remainingEdges;
+    remainingEdges.reserve(functionNode->Edges.size());
+
+    for (auto &edgeUniquePointer : functionNode->Edges) {
+        const Edge *edge = edgeUniquePointer.get();
+        const llvm::Loop *owner = nullptr;
+
+        if (edge != nullptr) {
+            auto sourceOwner = nodeOwners.find(edge->soure);
+            auto destinationOwner = nodeOwners.find(edge->destination);
+
+            if (sourceOwner != nodeOwners.end() && destinationOwner != nodeOwners.end() &&
+                sourceOwner->second == destinationOwner->second) {
+                owner = sourceOwner->second;
+            }
+        }
+
+        if (owner != nullptr) {
+            partition.edges[owner].push_back(std::move(edgeUniquePointer));
+        } else {
+            remainingEdges.push_back(std::move(edgeUniquePointer));
+        }
+    }
+
+    functionNode->Edges = std::move(remainingEdges);
+
+    return partition;
+}
+
 LoopNode::LoopNode(llvm::Loop *loop, FunctionNode *function_node, ResultRegistry registry,
-                   FunctionNode *parentFunctionNode) {
+                   FunctionNode *parentFunctionNode, LoopPartition &partition) {
     // Store the LLVM loop
     this->registry = registry;
     this->loop = loop;
@@ -80,65 +160,25 @@ LoopNode::LoopNode(llvm::Loop *loop, FunctionNode *function_node, ResultRegistry
 
     // Create loop nodes recursively for subloops
     for (llvm::Loop *subLoop : loop->getSubLoops()) {
-        auto subLoopNode = LoopNode::makeNode(subLoop, function_node, registry, function_node);
+        auto subLoopNode = LoopNode::makeNode(subLoop, function_node, registry, function_node, partition);
         this->Nodes.emplace_back(std::move(subLoopNode));
     }
 
-    // Collect all basicblocks that are contained within our loop
-    std::unordered_set<const llvm::BasicBlock *> loopBasicBlocks;
-    loopBasicBlocks.reserve(loop->getBlocks().size());
-
-    for (auto *basicBlock : loop->getBlocks()) {
-        loopBasicBlocks.insert(basicBlock);
-    }
-
-    this->Nodes.reserve(loopBasicBlocks.size());
-
-    // Move nodes from the given function node to this loop node
-    for (auto functionNodeIterator = function_node->Nodes.begin();
-         functionNodeIterator != function_node->Nodes.end();) {
-        GenericNode *genericNode = functionNodeIterator->get();
-        llvm::BasicBlock *basicBlock = nullptr;
-
-        // Cast the current node to a normal node and extract the contained basic block
-        if (auto *normalNode = dynamic_cast<Node *>(genericNode)) {
-            basicBlock = normalNode->block;
-        }
-
-        if (basicBlock != nullptr && loopBasicBlocks.count(basicBlock) != 0) {
-            this->Nodes.push_back(std::move(*functionNodeIterator));
-            functionNodeIterator = function_node->Nodes.erase(functionNodeIterator);
-        } else {
-            ++functionNodeIterator;
+    // Take the nodes of the blocks directly contained in our loop from the partition
+    auto ownNodes = partition.nodes.find(loop);
+    if (ownNodes != partition.nodes.end()) {
+        this->Nodes.reserve(this->Nodes.size() + ownNodes->second.size());
+        for (auto &nodeUniquePointer : ownNodes->second) {
+            this->Nodes.push_back(std::move(nodeUniquePointer));
         }
+        partition.nodes.erase(ownNodes);
     }
 
-    // Build pointer set of nodes now owned by the loop
-    std::unordered_set<GenericNode *> nodesInLoop;
-    nodesInLoop.reserve(this->Nodes.size());
-
-    for (auto &nodeUniquePointer : this->Nodes) {
-        nodesInLoop.insert(nodeUniquePointer.get());
-    }
-
-    // Move all edges contained entirely inside the loop into the loop node
-    for (auto edgeIterator = function_node->Edges.begin(); edgeIterator != function_node->Edges.end();) {
-        Edge *edge = edgeIterator->get();
-
-        if (edge == nullptr) {
-            ++edgeIterator;
-            continue;
-        }
-
-        const bool sourceIsInLoop = nodesInLoop.count(edge->soure) != 0;
-        const bool destinationIsInLoop = nodesInLoop.count(edge->destination) != 0;
-
-        if (sourceIsInLoop && destinationIsInLoop) {
-            this->Edges.push_back(std::move(*edgeIterator));
-            edgeIterator = function_node->Edges.erase(edgeIterator);
-        } else {
-            ++edgeIterator;
-        }
+    // Take all edges contained entirely inside the loop
+    auto ownEdges = partition.edges.find(loop);
+    if (ownEdges != partition.edges.end()) {
+        this->Edges = std::move(ownEdges->second);
+        partition.edges.erase(ownEdges);
     }
 
     this->hash = LoopNode::calculateHash();
@@ -241,14 +281,17 @@ void LoopNode::collapseLoop(std::vector<std::unique_ptr<Edge>> &edgeList) {
 
     this->Edges.push_back(std::move(entryEdge));
 
-    // Collapse this loop:
+    // Collapse this loop in a single pass over the edge list:
     //    - move edges fully inside this loop into this->Edges
     //    - redirect boundary edges to use this as endpoint
-    for (auto edgeIterator = edgeList.begin(); edgeIterator != edgeList.end();) {
-        Edge *edge = edgeIterator->get();
+    std::vector<std::unique_ptr<Edge>> remainingEdges;
+    remainingEdges.reserve(edgeList.size());
+
+    for (auto &edgeUniquePointer : edgeList) {
+        Edge *edge = edgeUniquePointer.get();
 
         if (edge == nullptr) {
-            ++edgeIterator;
+            remainingEdges.push_back(std::move(edgeUniquePointer));
             continue;
         }
 
@@ -257,8 +300,7 @@ void LoopNode::collapseLoop(std::vector<std::unique_ptr<Edge>> &edgeList) {
 
         // Edge completely inside this loop move it into this->Edges
         if (sourceIsInLoop && destinationIsInLoop) {
-            this->Edges.push_back(std::move(*edgeIterator));
-            edgeIterator = edgeList.erase(edgeIterator);
+            this->Edges.push_back(std::move(edgeUniquePointer));
             continue;
         }
 
@@ -271,9 +313,11 @@ void LoopNode::collapseLoop(std::vector<std::unique_ptr<Edge>> &edgeList) {
             edge->destination = this;
         }
 
-        ++edgeIterator;
+        remainingEdges.push_back(std::move(edgeUniquePointer));
     }
 
+    edgeList = std::move(remainingEdges);
+
     this->refreshBackEdges();
 }
 
@@ -363,8 +407,12 @@ void LoopNode::constructCallNodes(bool considerDebugFunctions) {
 }
 
 std::unique_ptr<LoopNode> LoopNode::makeNode(llvm::Loop *loop, FunctionNode *function_node, ResultRegistry registry,
-                                             FunctionNode *parentFunctionNode) {
-    auto loopNode = std::make_unique<LoopNode>(loop, function_node, registry, parentFunctionNode);
+                                             FunctionNode *parentFunctionNode, LoopPartition &partition) {
+    static Counter &loopCounter =
+        MetricsRegistry::getInstance().counter("spear_hlac_loops", "Loops added to the HLAC graph");
+
+    auto loopNode = std::make_unique<LoopNode>(loop, function_node, registry, parentFunctionNode, partition);
+    loopCounter.inc();
     return loopNode;
 }
 
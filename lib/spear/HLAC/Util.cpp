@@ -301,6 +301,42 @@ std::map<HLAC::GenericNode*, std::vector<HLAC::Edge*>> Util::createIncomingList(
     return adjacentList;
 }
 
+HLAC::EdgeIndex::EdgeIndex(const std::vector<std::unique_ptr<Edge>> &edges) {
+    byEndpoints.reserve(edges.size());
+    for (const auto &edgeUP : edges) {
+        add(edgeUP.get());
+    }
+}
+
+HLAC::EdgeIndex::EdgeIndex(const std::vector<Edge *> &edges) {
+    byEndpoints.reserve(edges.size());
+    for (Edge *edge : edges) {
+        add(edge);
+    }
+}
+
+void HLAC::EdgeIndex::add(Edge *edge) {
+    if (!edge) {
+        return;
+    }
+
+    // emplace keeps the first edge, matching the order of a linear search
+    byEndpoints.emplace(Endpoints{edge->soure, edge->destination}, edge);
+    if (edge->ilpIndex >= 0) {
+        byIlpIndex.emplace(edge->ilpIndex, edge);
+    }
+}
+
+HLAC::Edge *HLAC::EdgeIndex::find(const GenericNode *source, const GenericNode *destination) const {
+    auto foundEdge = byEndpoints.find(Endpoints{source, destination});
+    return foundEdge != byEndpoints.end() ? foundEdge->second : nullptr;
+}
+
+HLAC::Edge *HLAC::EdgeIndex::findByIlpIndex(int ilpIndex) const {
+    auto foundEdge = byIlpIndex.find(ilpIndex);
+    return foundEdge != byIlpIndex.end() ? foundEdge->second : nullptr;
+}
+
 std::vector<HLAC::Edge *> HLAC::Util::findTakenEdges(
     GenericNode *entryNode,
     const std::unordered_map<HLAC::GenericNode *, HLAC::GenericNode *> &predecessors,
@@ -310,6 +346,9 @@ std::vector<HLAC::Edge *> HLAC::Util::findTakenEdges(
     std::vector<HLAC::Edge *> result;
     std::unordered_set<HLAC::Edge *> alreadyAddedEdges;
 
+    // Index the edges of the function once instead of searching them for every step of the path
+    const EdgeIndex edgeIndex(edges);
+
     // Start at the given entry node (in most cases the exit node of the underlying function)
     HLAC::GenericNode *currentNode = entryNode;
 
@@ -325,20 +364,8 @@ std::vector<HLAC::Edge *> HLAC::Util::findTakenEdges(
             break;
         }
 
-        HLAC::Edge *takenEdge = nullptr;
-
         // Find the edge from parentNode to currentNode
-        for (auto &edgeUP : edges) {
-            HLAC::Edge *edge = edgeUP.get();
-            if (!edge) {
-                continue;
-            }
-
-            if (edge->soure == parentNode && edge->destination == currentNode) {
-                takenEdge = edge;
-                break;
-            }
-        }
+        HLAC::Edge *takenEdge = edgeIndex.find(parentNode, currentNode);
 
         if (takenEdge != nullptr && alreadyAddedEdges.insert(takenEdge).second) {
             result.push_back(takenEdge);
@@ -350,12 +377,13 @@ std::vector<HLAC::Edge *> HLAC::Util::findTakenEdges(
             if (loopResultIterator != loopResults.end()) {
                 std::vector<HLAC::Edge *> allContainedEdges;
                 HLAC::Util::collectAllContainedEdges(loopNode, allContainedEdges);
+                const EdgeIndex loopEdgeIndex(allContainedEdges);
 
                 for (int variableIndex = 0;
                      variableIndex < static_cast<int>(loopResultIterator->second.variableValues.size());
                      ++variableIndex) {
                     if (loopResultIterator->second.variableValues[variableIndex] > 0.0) {
-                        HLAC::Edge *innerTakenEdge = HLAC::Util::findEdgeByGlobalId(allContainedEdges, variableIndex);
+                        HLAC::Edge *innerTakenEdge = loopEdgeIndex.findByIlpIndex(variableIndex);
                         if (innerTakenEdge != nullptr && alreadyAddedEdges.insert(innerTakenEdge).second) {
                             result.push_back(innerTakenEdge);
                         }
@@ -422,10 +450,11 @@ void Util::appendLoopContainedEdges(
             // Inser the edges inside the loop to our global edge collection
             std::vector<HLAC::Edge*> allLoopEdges;
             collectAllContainedEdges(LN.first, allLoopEdges);
+            const EdgeIndex loopEdgeIndex(allLoopEdges);
 
             for (int i = 0; i < LN.second.variableValues.size(); i++) {
                 if (LN.second.variableValues[i] > 0.0) {
-                    auto foundEdge = HLAC::Util::findEdgeByGlobalId(allLoopEdges, i);
+                    auto foundEdge = loopEdgeIndex.findByIlpIndex(i);
                     if (foundEdge != nullptr) {
                         resVector.push_back(foundEdge);
                     }
@@ -24,11 +24,16 @@
 #include <OsiClpSolverInterface.hpp>
 
 #include "Logger.h"
+#include "MetricsRegistry.h"
 
 namespace HLAC {
 void hlac::makeFunction(llvm::Function* function, llvm::FunctionAnalysisManager *fam) {
+    static Counter &functionCounter =
+        MetricsRegistry::getInstance().counter("spear_hlac_functions", "Functions added to the HLAC graph");
+
     auto fnptr = FunctionNode::makeNode(function, fam, registry, this);
     functions.emplace_back(std::move(fnptr));
+    functionCounter.inc();
 }
 
 
@@ -110,13 +115,19 @@ std::map<std::string, double> hlac::getEnergy() {
 }
 
 double hlac::getEnergyPerFunction(std::string functionName, bool isRecursive) {
+    return getEnergyPerFunction(FunctionEnergyCache, functionName, isRecursive);
+}
+
+double hlac::getEnergyPerFunction(const std::map<std::string, double> &functionEnergyCache,
+                                  const std::string &functionName, bool isRecursive) {
     if (Util::starts_with(functionName, "__psr") || Util::starts_with(functionName, "__clang")) {
         // We return 0.0 for phasar hooks, as they are not relevant for our analysis and we do not want to log them
         return 0.0;
     }
 
-    if (FunctionEnergyCache.contains(functionName)) {
-        return FunctionEnergyCache[functionName];
+    auto cacheIterator = functionEnergyCache.find(functionName);
+    if (cacheIterator != functionEnergyCache.end()) {
+        return cacheIterator->second;
     }
 
     /**
@@ -296,13 +307,20 @@ ILPClusteredLoopResult hlac::solveClusteredIlps(ILPLoopModelMapping loopModelMap
     std::unordered_map<LoopNode *, ILPResult> loopEnergyMapping;
     loopEnergyMapping.reserve(loopModelMapping.size());
 
+    static Counter &cacheHits = MetricsRegistry::getInstance().counter(
+        "spear_ilp_cluster_cache_lookups", "Lookups in the clustered ILP cache", {{"result", "hit"}});
+    static Counter &cacheMisses = MetricsRegistry::getInstance().counter(
+        "spear_ilp_cluster_cache_lookups", "Lookups in the clustered ILP cache", {{"result", "miss"}});
+
     for (const auto &[loopNode, model] : loopModelMapping) {
         if (cache.entryExists(loopNode->hash)) {
+            cacheHits.inc();
             auto cachedResult = cache.getEntry(loopNode->hash);
             if (cachedResult.has_value()) {
                 loopEnergyMapping.emplace(loopNode, cachedResult.value());
             }
         } else {
+            cacheMisses.inc();
             std::optional<ILPResult> solvedModel = ILPBuilder::solveClusteredLoopModel(model, loopNode);
 
             if (solvedModel.has_value()) {
@@ -3,6 +3,8 @@
  * All rights reserved.
  */
 
+#include <chrono>
+#include <cstddef>
 #include <cmath>
 #include <iostream>
 #include <string>
@@ -18,6 +20,7 @@
 #include "ILP/ILPSolver.h"
 #include "ILP/ILPUtil.h"
 #include "Logger.h"
+#include "MetricsRegistry.h"
 #include "PassUtil.h"
 
 void ILPBuilder::applyEdgeFeasibilityBounds(ILPModel &model, HLAC::FunctionNode *func) {
@@ -78,86 +81,39 @@ void ILPBuilder::applyEdgeFeasibilityBounds(ILPModel &model, HLAC::LoopNode *loo
     }
 }
 
-void ILPBuilder::appendGraphConstraints(ILPModel &model, const std::vector<std::unique_ptr<HLAC::GenericNode>> &nodes,
-                                        const std::vector<std::unique_ptr<HLAC::Edge>> &edges,
-                                        const std::vector<int> *invocationCols) {
-    // Create the incoming and outgoing edge mappings
-    std::unordered_map<HLAC::GenericNode *, std::vector<int>> incomingEdgesPerNode;
-    std::unordered_map<HLAC::GenericNode *, std::vector<int>> outgoingEdgesPerNode;
-
-    // Calculate the incoming and outgoing mappins
-    ILPUtil::buildIncidenceMaps(edges, incomingEdgesPerNode, outgoingEdgesPerNode,
-                                static_cast<int>(model.col_lb.size()));
-
+void ILPBuilder::appendFlowConstraints(ILPModel &model, const ILPFlowGraph &graph, std::size_t scope,
+                                       const std::vector<int> *invocationCols) {
     // For each node in the considered scope...
-    for (const auto &nodeUP : nodes) {
-        auto *node = nodeUP.get();
-
-        const std::vector<int> incomingEdges =
-            incomingEdgesPerNode.contains(node) ? incomingEdgesPerNode[node] : std::vector<int>{};
-
-        const std::vector<int> outgoingEdges =
-                outgoingEdgesPerNode.contains(node) ? outgoingEdgesPerNode[node] : std::vector<int>{};
-
-        // Handle virtual nodes
-        if (auto *virtualNode = dynamic_cast<HLAC::VirtualNode *>(node)) {
-            /**
-             * For entry nodes we want to ensure that outgoing edges are called exactly one time
-             */
-            if (virtualNode->virtualNodeKind == HLAC::VirtualNodeKind::Entry) {
-                std::unordered_map<int, double> coefficientsByColumn;
-
-                // Calculate the coefficient of the outgoing edges
-                for (int column : outgoingEdges) {
-                    ILPUtil::insertOrAccumulate(coefficientsByColumn, column, 1.0);
-                }
-
-                if (invocationCols == nullptr) {
-                    // Case that entry node is not used for loop invocation, e.g. in the function entry node or in a
-                    // loop without external invocation
-                    CoinPackedVector row = ILPUtil::createRowFromCoefficients(coefficientsByColumn);
-                    ILPUtil::appendRow(model, row, 1.0, 1.0);
-                } else {
-                    // Case that the entry node is called multiple times
-                    for (int column : *invocationCols) {
-                        ILPUtil::insertOrAccumulate(coefficientsByColumn, column, -1.0);
-                    }
-
-                    CoinPackedVector row = ILPUtil::createRowFromCoefficients(coefficientsByColumn);
-                    ILPUtil::appendRow(model, row, 0.0, 0.0);
-                }
+    for (const ILPFlowNode &node : graph.scopes[scope].nodes) {
+        /**
+         * For entry nodes we want to ensure that outgoing edges are called exactly one time, for exit nodes we want to
+         * ensure the same for the incoming edges
+         */
+        if (node.kind == ILPFlowNodeKind::ENTRY || node.kind == ILPFlowNodeKind::EXIT) {
+            const std::vector<int> &boundaryColumns =
+                    node.kind == ILPFlowNodeKind::ENTRY ? node.outgoingColumns : node.incomingColumns;
+            std::unordered_map<int, double> coefficientsByColumn;
 
-                continue;
+            for (int column : boundaryColumns) {
+                ILPUtil::insertOrAccumulate(coefficientsByColumn, column, 1.0);
             }
 
-
-            /**
-             * For exit nodes we want to ensure that incoming edges are called exactly one time
-             */
-            if (virtualNode->virtualNodeKind == HLAC::VirtualNodeKind::NormalExit) {
-                std::unordered_map<int, double> coefficientsByColumn;
-
-                for (int column : incomingEdges) {
-                    ILPUtil::insertOrAccumulate(coefficientsByColumn, column, 1.0);
-                }
-
-                if (invocationCols == nullptr) {
-                    // Case that exit node is not used for loop invocation, e.g. in the function exit node or in a
-                    // loop without external invocation
-                    CoinPackedVector row = ILPUtil::createRowFromCoefficients(coefficientsByColumn);
-                    ILPUtil::appendRow(model, row, 1.0, 1.0);
-                } else {
-                    // Case that the exit node is called multiple times
-                    for (int column : *invocationCols) {
-                        ILPUtil::insertOrAccumulate(coefficientsByColumn, column, -1.0);
-                    }
-
-                    CoinPackedVector row = ILPUtil::createRowFromCoefficients(coefficientsByColumn);
-                    ILPUtil::appendRow(model, row, 0.0, 0.0);
+            if (invocationCols == nullptr) {
+                // Case that the node is not used for loop invocation, e.g. in the function entry node or in a loop
+                // without external invocation
+                CoinPackedVector row = ILPUtil::createRowFromCoefficients(coefficientsByColumn);
+                ILPUtil::appendRow(model, row, 1.0, 1.0);
+            } else {
+                // Case that the node is passed once per invocation of the loop
+                for (int column : *invocationCols) {
+                    ILPUtil::insertOrAccumulate(coefficientsByColumn, column, -1.0);
                 }
 
-                continue;
+                CoinPackedVector row = ILPUtil::createRowFromCoefficients(coefficientsByColumn);
+                ILPUtil::appendRow(model, row, 0.0, 0.0);
             }
+
+            continue;
         }
 
         /**
@@ -169,11 +125,11 @@ void ILPBuilder::appendGraphConstraints(ILPModel &model, const std::vector<std::
          */
         std::unordered_map<int, double> coefficientsByColumn;
 
-        for (int column : incomingEdges) {
+        for (int column : node.incomingColumns) {
             ILPUtil::insertOrAccumulate(coefficientsByColumn, column, 1.0);
         }
 
-        for (int column : outgoingEdges) {
+        for (int column : node.outgoingColumns) {
             ILPUtil::insertOrAccumulate(coefficientsByColumn, column, -1.0);
         }
 
@@ -184,32 +140,32 @@ void ILPBuilder::appendGraphConstraints(ILPModel &model, const std::vector<std::
          * For loops we have to create seperate graph constrains for the contained graph
          * additionally we append loop bound constrains
          */
-        if (auto *loopNode = dynamic_cast<HLAC::LoopNode *>(node)) {
-            const std::vector<int> incomingColumns =
-                    incomingEdgesPerNode.contains(node) ? incomingEdgesPerNode[node] : std::vector<int>{};
-
-            const std::vector<int> invocationColumns =
-                    collectExternalLoopInvocationColumns(loopNode, edges, incomingColumns);
-
-            if (invocationColumns.empty()) {
+        if (node.kind == ILPFlowNodeKind::LOOP) {
+            if (node.invocationColumns.empty()) {
                 Logger::getInstance().log("Loop invocation debug: no external invocation columns for loop " +
-                                                  loopNode->getDotName(),
+                                                  node.name,
                                           LOGLEVEL::ERROR);
             }
 
-            appendGraphConstraints(model, loopNode->Nodes, loopNode->Edges, &invocationColumns);
-            appendLoopBoundConstraint(model, loopNode, invocationColumns);
+            appendFlowConstraints(model, graph, node.bodyScope, &node.invocationColumns);
+            appendLoopBoundConstraint(model, graph, node, node.invocationColumns);
         }
     }
 }
 
 std::optional<ILPResult> ILPBuilder::solveClusteredLoopModel(const ILPModel &ilpModel, HLAC::LoopNode *loopNode) {
+    static Histogram &solveTime = MetricsRegistry::getInstance().histogram(
+        "spear_ilp_solve_seconds", "Time to solve a single ILP", Histogram::exponentialBuckets(1e-5, 4, 12),
+        {{"model", "clustered_loop"}});
+
     // Create a new solver
+    auto solveStart = std::chrono::steady_clock::now();
     ILPSolver modelSolver(ilpModel);
 
     // Get the optimal solution and path
     auto optimalSolution = modelSolver.getSolvedModelValue();
     auto optimalPath = modelSolver.getSolvedSolution();
+    solveTime.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - solveStart).count());
 
     // If solution and path exist return it
     if (optimalPath.has_value() && optimalSolution.has_value()) {
@@ -236,53 +192,33 @@ std::optional<ILPResult> ILPBuilder::solveClusteredLoopModel(const ILPModel &ilp
     return std::nullopt;
 }
 
-void ILPBuilder::appendLoopBoundConstraint(ILPModel &model, HLAC::LoopNode *loopNode,
+void ILPBuilder::appendLoopBoundConstraint(ILPModel &model, const ILPFlowGraph &graph, const ILPFlowNode &loop,
                                            const std::vector<int> &invocationCols) {
-    if (loopNode == nullptr) {
-        Logger::getInstance().log("Loop bound debug: loopNode is null.", LOGLEVEL::ERROR);
-        return;
-    }
-
     // If the loop has multiple invocation columns we cannot calculate the value accordingly.
     if (invocationCols.size() != 1) {
-        Logger::getInstance().log("Loop bound fallback: loop " + loopNode->getDotName() + " has " +
+        Logger::getInstance().log("Loop bound fallback: loop " + loop.name + " has " +
                                           std::to_string(invocationCols.size()) +
                                           " invocation columns, expected exactly one.",
                                   LOGLEVEL::WARNING);
         return;
     }
 
-    // Query the bounds of the loop
-    const double lowerBoundAsDouble = static_cast<double>(loopNode->bounds.getLowerBound());
-    const double upperBoundAsDouble = static_cast<double>(loopNode->bounds.getUpperBound());
-
     // Calculate the times the backedges of the loop will be executed. (Bound - 1)
-    const double lowerBackedgeFactor = std::max(0.0, lowerBoundAsDouble - 1.0);
-    const double upperBackedgeFactor = std::max(0.0, upperBoundAsDouble - 1.0);
+    const double lowerBackedgeFactor = std::max(0.0, loop.lowerBound - 1.0);
+    const double upperBackedgeFactor = std::max(0.0, loop.upperBound - 1.0);
 
     // Get the invocation column
     const int invocationColumn = invocationCols.front();
     std::unordered_map<int, double> backedgeCoefficientsByColumn;
 
-    // Iterate over the backedges in the loopnode
-    for (HLAC::Edge *backEdge : loopNode->backEdges) {
-        if (backEdge == nullptr) {
-            continue;
-        }
-
-        if (backEdge->ilpIndex < 0 || backEdge->ilpIndex >= static_cast<int>(model.col_lb.size())) {
-            Logger::getInstance().log("Loop bound debug: invalid backedge ilpIndex in loop " + loopNode->getDotName(),
-                                      LOGLEVEL::ERROR);
-            continue;
-        }
-
-        // Insert the backedge coefficient into the map with a factor of 1.0 as we want to express that the backedge is
-        // executed once per loop iteration
-        ILPUtil::insertOrAccumulate(backedgeCoefficientsByColumn, backEdge->ilpIndex, 1.0);
+    // Insert the backedge coefficients into the map with a factor of 1.0 as we want to express that the backedge is
+    // executed once per loop iteration
+    for (int backEdgeColumn : graph.scopes[loop.bodyScope].backEdgeColumns) {
+        ILPUtil::insertOrAccumulate(backedgeCoefficientsByColumn, backEdgeColumn, 1.0);
     }
 
     if (backedgeCoefficientsByColumn.empty()) {
-        Logger::getInstance().log("Loop bound debug: loop " + loopNode->getDotName() + " has no valid backedges.",
+        Logger::getInstance().log("Loop bound debug: loop " + loop.name + " has no valid backedges.",
                                   LOGLEVEL::ERROR);
         return;
     }
@@ -293,6 +229,7 @@ void ILPBuilder::appendLoopBoundConstraint(ILPModel &model, HLAC::LoopNode *loop
     std::unordered_map<int, double> lowerBoundCoefficientsByColumn = backedgeCoefficientsByColumn;
     ILPUtil::insertOrAccumulate(lowerBoundCoefficientsByColumn, invocationColumn, -lowerBackedgeFactor);
     CoinPackedVector lowerBoundRow = ILPUtil::createRowFromCoefficients(lowerBoundCoefficientsByColumn);
+    model.loopBoundRows.push_back({loop.loopNode, static_cast<int>(model.row_lb.size()), invocationColumn, false});
     ILPUtil::appendRow(model, lowerBoundRow, 0.0, COIN_DBL_MAX);
 
     /**
@@ -301,9 +238,22 @@ void ILPBuilder::appendLoopBoundConstraint(ILPModel &model, HLAC::LoopNode *loop
     std::unordered_map<int, double> upperBoundCoefficientsByColumn = backedgeCoefficientsByColumn;
     ILPUtil::insertOrAccumulate(upperBoundCoefficientsByColumn, invocationColumn, -upperBackedgeFactor);
     CoinPackedVector upperBoundRow = ILPUtil::createRowFromCoefficients(upperBoundCoefficientsByColumn);
+    model.loopBoundRows.push_back({loop.loopNode, static_cast<int>(model.row_lb.size()), invocationColumn, true});
     ILPUtil::appendRow(model, upperBoundRow, -COIN_DBL_MAX, 0.0);
 }
 
+void ILPBuilder::recordCallColumn(ILPModel &model, HLAC::Edge *edge) {
+    auto *callNode = dynamic_cast<HLAC::CallNode *>(edge->destination);
+
+    // Syscalls and linker functions are priced by the profile and the ELBs, not by an analyzed callee
+    if (callNode == nullptr || callNode->calledFunction == nullptr || callNode->isSyscall ||
+        callNode->isLinkerFunction) {
+        return;
+    }
+
+    model.callColumns.push_back({edge->ilpIndex, callNode->calledFunction->getName().str()});
+}
+
 void ILPBuilder::fillObjectiveFunction(ILPModel &model, HLAC::FunctionNode *func) {
     // For each edge
     for (auto &edgeUP : func->Edges) {
@@ -317,6 +267,8 @@ void ILPBuilder::fillObjectiveFunction(ILPModel &model, HLAC::FunctionNode *func
         } else {
             model.obj[edge->ilpIndex] = edge->destination->getEnergy();
         }
+
+        recordCallColumn(model, edge);
     }
 
     // Call the fillObjectiveFunction recursively for contained loop nodes
@@ -331,6 +283,7 @@ void ILPBuilder::fillObjectiveFunction(ILPModel &model, HLAC::LoopNode *loopNode
     for (auto &edgeUP : loopNode->Edges) {
         auto *edge = edgeUP.get();
         model.obj[edge->ilpIndex] = edge->destination->getEnergy();
+        recordCallColumn(model, edge);
     }
 
     // Call the fillObjectiveFunction recursively for contained loop nodes
@@ -342,12 +295,18 @@ void ILPBuilder::fillObjectiveFunction(ILPModel &model, HLAC::LoopNode *loopNode
 }
 
 std::optional<ILPResult> ILPBuilder::solveModel(const ILPModel &ilpModel) {
+    static Histogram &solveTime = MetricsRegistry::getInstance().histogram(
+        "spear_ilp_solve_seconds", "Time to solve a single ILP", Histogram::exponentialBuckets(1e-5, 4, 12),
+        {{"model", "function"}});
+
     // Create a new solver
+    auto solveStart = std::chrono::steady_clock::now();
     ILPSolver modelSolver(ilpModel);
 
     // Get the optimal solution and path
     auto optimalSolution = modelSolver.getSolvedModelValue();
     auto optimalPath = modelSolver.getSolvedSolution();
+    solveTime.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - solveStart).count());
 
     // If solution and path exist return it
     if (optimalPath.has_value() && optimalSolution.has_value()) {
@@ -410,11 +369,12 @@ ILPModel ILPBuilder::buildMonolithicILP(HLAC::LoopNode *loop) {
     // Apply feasibility constrains
     applyEdgeFeasibilityBounds(model, loop);
 
-    // Append graph constrains
-    appendGraphConstraints(model, loop->Nodes, loop->Edges, &invocationColumns);
+    // Append graph constrains, the body of the loop is scope 0 of its flow graph
+    const ILPFlowGraph graph = ILPUtil::buildFlowGraph(loop, variableCount);
+    appendFlowConstraints(model, graph, 0, &invocationColumns);
 
     // Append loop bound constrains
-    appendLoopBoundConstraint(model, loop, invocationColumns);
+    appendLoopBoundConstraint(model, graph, ILPUtil::describeLoop(loop, 0), invocationColumns);
 
     // Append variable constraints so each variable is called once
     appendEqualityConstraint(model, invocationColumn);
@@ -425,49 +385,6 @@ ILPModel ILPBuilder::buildMonolithicILP(HLAC::LoopNode *loop) {
     return model;
 }
 
-std::vector<int>
-ILPBuilder::collectExternalLoopInvocationColumns(HLAC::LoopNode *loopNode,
-                                                 const std::vector<std::unique_ptr<HLAC::Edge>> &parentEdges,
-                                                 const std::vector<int> &incomingColumns) {
-    std::vector<int> invocationColumns;
-
-    // Iterate over the incoming columns
-    for (int incomingColumn : incomingColumns) {
-        HLAC::Edge *matchingEdge = nullptr;
-
-        // Find the parent edge corresponding to the incoming column
-        for (const auto &edgeUniquePointer : parentEdges) {
-            HLAC::Edge *edge = edgeUniquePointer.get();
-
-            if (edge != nullptr && edge->ilpIndex == incomingColumn) {
-                matchingEdge = edge;
-                break;
-            }
-        }
-
-        // Validate the edge
-        if (matchingEdge == nullptr) {
-            continue;
-        }
-
-        // Ignore the edge if the destination is not our loopnode
-        if (matchingEdge->destination != loopNode) {
-            continue;
-        }
-
-        // Ignore the edge if the source is our loopnode
-        if (matchingEdge->soure == loopNode) {
-            continue;
-        }
-
-        // In any other case push the column into the invocation columns vector as it represents an external
-        // invocation of the loop
-        invocationColumns.push_back(incomingColumn);
-    }
-
-    return invocationColumns;
-}
-
 ILPModel ILPBuilder::buildMonolithicILP(HLAC::FunctionNode *func) {
     const int variableCount = ILPUtil::assignEdgeIndicesFunction(func, 0);
 
@@ -482,12 +399,8 @@ ILPModel ILPBuilder::buildMonolithicILP(HLAC::FunctionNode *func) {
     // Apply feasibility constrains to the model
     applyEdgeFeasibilityBounds(model, func);
 
-    if (func->function->getName() == "main") {
-        int i = 10;
-    }
-
     // Apply flow constrains
-    appendGraphConstraints(model, func->Nodes, func->Edges, nullptr);
+    appendFlowConstraints(model, ILPUtil::buildFlowGraph(func, variableCount), 0, nullptr);
 
     // Fill the objective function
     fillObjectiveFunction(model, func);
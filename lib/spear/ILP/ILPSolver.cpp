@@ -3,17 +3,16 @@
  * All rights reserved.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 #include <memory>
 #include <string>
 
 #include "ILP/ILPSolver.h"
 
-/**
- * Scaling factor to the objective function values.
- * Reduces errors where the solver returns a solution that is slightly worse than the optimal solution due to numerical
- */
-constexpr double objectiveScalingFactor = 1.0e15;
+#include "HLAC/hlac.h"
 
 ILPSolver::ILPSolver(const ILPModel& model) : underlyingILPModel(model), solutionModel(nullptr) {
     OsiClpSolverInterface solver;
@@ -143,3 +142,100 @@ std::string ILPSolver::getStatusString() const {
 
     return "Unknown status";
 }
+
+std::vector<ILPLoopBoundSensitivity> ILPSolver::calculateLoopBoundSensitivity(const ILPModel &model,
+                                                                             const ILPResult &integerResult) {
+    std::vector<ILPLoopBoundSensitivity> sensitivities;
+
+    if (model.loopBoundRows.empty()) {
+        return sensitivities;
+    }
+
+    OsiClpSolverInterface relaxation;
+    relaxation.getModelPtr()->setLogLevel(0);
+
+    std::vector<double> scaledObjective = model.obj;
+    for (double &objectiveCoefficient : scaledObjective) {
+        objectiveCoefficient *= objectiveScalingFactor;
+    }
+
+    // Load the relaxation of the model. The columns are not marked as integers, so we can access the duals directly
+    relaxation.loadProblem(model.matrix, model.col_lb.data(), model.col_ub.data(), scaledObjective.data(),
+                           model.row_lb.data(), model.row_ub.data());
+    relaxation.setObjSense(-1.0);
+    relaxation.initialSolve();
+
+    if (!relaxation.isProvenOptimal()) {
+        return sensitivities;
+    }
+
+    // The flow structure of our models usually leads to integral relaxations. If the optimum of the relaxation matches
+    // the integer optimum, the duals are exact for the integer model as well
+    const double relaxationValue = relaxation.getObjValue() / objectiveScalingFactor;
+    const double tolerance = 1e-9 * std::max(1.0, std::abs(integerResult.optimalValue));
+    const bool exact = std::abs(relaxationValue - integerResult.optimalValue) <= tolerance;
+
+    const double *rowPrices = relaxation.getRowPrice();
+    const double *relaxedSolution = relaxation.getColSolution();
+    const int numberOfColumns = relaxation.getNumCols();
+    const int numberOfRows = static_cast<int>(model.loopBoundRows.size());
+
+    // Sequence numbers of the row slacks start behind the structural columns
+    std::vector<int> slackSequences;
+    slackSequences.reserve(numberOfRows);
+    for (const auto &loopBoundRow : model.loopBoundRows) {
+        slackSequences.push_back(numberOfColumns + loopBoundRow.row);
+    }
+
+    std::vector<double> valueIncrease(numberOfRows, COIN_DBL_MAX);
+    std::vector<double> valueDecrease(numberOfRows, COIN_DBL_MAX);
+    std::vector<int> sequenceIncrease(numberOfRows, -1);
+    std::vector<int> sequenceDecrease(numberOfRows, -1);
+
+    relaxation.enableFactorization();
+    const int rangingStatus = relaxation.getModelPtr()->primalRanging(numberOfRows, slackSequences.data(),
+                                                                      valueIncrease.data(), sequenceIncrease.data(),
+                                                                      valueDecrease.data(), sequenceDecrease.data());
+    relaxation.disableFactorization();
+
+    for (int index = 0; index < numberOfRows; ++index) {
+        const auto &loopBoundRow = model.loopBoundRows[index];
+
+        // Rows of models built from a snapshot have no loop node to report the sensitivity for
+        if (loopBoundRow.loopNode == nullptr) {
+            continue;
+        }
+
+        const double dual = std::abs(rowPrices[loopBoundRow.row]) / objectiveScalingFactor;
+        const double invocations = relaxedSolution[loopBoundRow.invocationColumn];
+        const bool binding = dual > 1e-15;
+
+        // Relaxing the upper bound can only increase the worst case energy, raising the lower bound can only decrease
+        // it. One more iteration shifts the row by the amount of invocations of the loop.
+        const double marginalEnergy = (loopBoundRow.isUpperBound ? dual : -dual) * invocations;
+
+        const double nominalBound = loopBoundRow.isUpperBound
+                                        ? static_cast<double>(loopBoundRow.loopNode->bounds.getUpperBound())
+                                        : static_cast<double>(loopBoundRow.loopNode->bounds.getLowerBound());
+
+        // Ranges without limit are reported as infinity
+        double validFrom = 0.0;
+        double validTo = std::numeric_limits<double>::infinity();
+
+        // Convert the range of the row activity into a range of the loop bound
+        if (rangingStatus == 0 && invocations > 1e-9) {
+            if (std::abs(valueDecrease[index]) < COIN_DBL_MAX / 2) {
+                validFrom = nominalBound - std::abs(valueDecrease[index]) / invocations;
+            }
+
+            if (std::abs(valueIncrease[index]) < COIN_DBL_MAX / 2) {
+                validTo = nominalBound + std::abs(valueIncrease[index]) / invocations;
+            }
+        }
+
+        sensitivities.push_back({loopBoundRow.loopNode, loopBoundRow.isUpperBound, binding, marginalEnergy,
+                                 std::max(0.0, validFrom), validTo, exact});
+    }
+
+    return sensitivities;
+}
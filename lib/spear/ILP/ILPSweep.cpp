@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "ILP/ILPSweep.h"
+
+#include <CbcModel.hpp>
+#include <OsiClpSolverInterface.hpp>
+
+#include "HLAC/hlac.h"
+#include "ILP/ILPSolver.h"
+#include "Logger.h"
+
+std::optional<double> ILPSweep::backedgeFactorForGridValue(const ILPLoopBoundRow &loopBoundRow, double gridValue,
+                                                           SweepMode mode) {
+    if (loopBoundRow.loopNode == nullptr) {
+        return std::nullopt;
+    }
+
+    const auto &bounds = loopBoundRow.loopNode->bounds;
+    double bound = 0.0;
+
+    if (mode == SweepMode::FALLBACK) {
+        // Only loops that are bounded by a fallback value are affected
+        if (bounds.valueType != LoopBound::DeltaInterval::ValueType::FALLBACK) {
+            return std::nullopt;
+        }
+
+        bound = gridValue;
+    } else if (mode == SweepMode::SCALE) {
+        const double nominalBound = loopBoundRow.isUpperBound ? static_cast<double>(bounds.getUpperBound())
+                                                              : static_cast<double>(bounds.getLowerBound());
+        bound = nominalBound * gridValue;
+    } else {
+        return std::nullopt;
+    }
+
+    // Calculate the times the backedges of the loop will be executed. (Bound - 1)
+    return std::max(0.0, bound - 1.0);
+}
+
+bool ILPSweep::isAffectedBySweep(const ILPModel &model, const ILPSweepEnergies &calleeEnergies) {
+    if (!model.loopBoundRows.empty()) {
+        return true;
+    }
+
+    return std::any_of(model.callColumns.begin(), model.callColumns.end(), [&calleeEnergies](const auto &callColumn) {
+        return calleeEnergies.contains(callColumn.calleeName);
+    });
+}
+
+std::vector<ILPSweepPoint> ILPSweep::sweepLoopBounds(const ILPModel &model, const std::vector<double> &grid,
+                                                     SweepMode mode, const ILPSweepEnergies &calleeEnergies) {
+    std::vector<ILPSweepPoint> sweepPoints;
+    sweepPoints.reserve(grid.size());
+
+    OsiClpSolverInterface solver;
+    solver.getModelPtr()->setLogLevel(0);
+
+    // Scale the objective function the same way the ILPSolver does
+    std::vector<double> scaledObjective = model.obj;
+    for (double &objectiveCoefficient : scaledObjective) {
+        objectiveCoefficient *= objectiveScalingFactor;
+    }
+
+    // Load the problem into the solver exactly once for the whole sweep
+    solver.loadProblem(model.matrix, model.col_lb.data(), model.col_ub.data(), scaledObjective.data(),
+                       model.row_lb.data(), model.row_ub.data());
+    solver.setObjSense(-1.0);
+
+    const int numberOfColumns = model.matrix.getNumCols();
+    for (int columnIndex = 0; columnIndex < numberOfColumns; ++columnIndex) {
+        solver.setInteger(columnIndex);
+    }
+
+    // Solve the relaxation once to obtain the initial basis. Every following grid point is re-solved from the optimal
+    // basis of its predecessor using the dual simplex
+    solver.initialSolve();
+    solver.setHintParam(OsiDoDualInResolve, true, OsiHintDo);
+
+    for (size_t gridIndex = 0; gridIndex < grid.size(); ++gridIndex) {
+        const double gridValue = grid[gridIndex];
+        auto pointStart = std::chrono::high_resolution_clock::now();
+
+        // Only the coefficients of the invocation columns in the loop bound rows change between grid points
+        for (const auto &loopBoundRow : model.loopBoundRows) {
+            auto backedgeFactor = backedgeFactorForGridValue(loopBoundRow, gridValue, mode);
+            if (!backedgeFactor.has_value()) {
+                continue;
+            }
+
+            solver.modifyCoefficient(loopBoundRow.row, loopBoundRow.invocationColumn, -backedgeFactor.value());
+        }
+
+        // Calls are priced with the energy of the callee at the same grid point
+        bool calleesSolved = true;
+        for (const auto &callColumn : model.callColumns) {
+            auto calleeIterator = calleeEnergies.find(callColumn.calleeName);
+            if (calleeIterator == calleeEnergies.end()) {
+                continue;
+            }
+
+            const auto &calleeEnergy = calleeIterator->second[gridIndex];
+            if (!calleeEnergy.has_value()) {
+                calleesSolved = false;
+                break;
+            }
+
+            solver.setObjCoeff(callColumn.column, calleeEnergy.value() * objectiveScalingFactor);
+        }
+
+        std::optional<double> energy = std::nullopt;
+
+        if (calleesSolved) {
+            solver.resolve();
+        }
+
+        if (calleesSolved && solver.isProvenOptimal()) {
+            // The CbcModel works on a copy of the solver, so the warm start of our solver stays untouched
+            CbcModel integerModel(solver);
+            integerModel.setLogLevel(0);
+            integerModel.branchAndBound();
+
+            if (integerModel.isProvenOptimal()) {
+                energy = integerModel.getObjValue() / objectiveScalingFactor;
+            }
+        }
+
+        if (!energy.has_value()) {
+            Logger::getInstance().log("Loop bound sweep: model could not be solved for grid value " +
+                                              std::to_string(gridValue),
+                                      LOGLEVEL::WARNING);
+        }
+
+        auto pointEnd = std::chrono::high_resolution_clock::now();
+        auto pointDuration = std::chrono::duration_cast<std::chrono::microseconds>(pointEnd - pointStart);
+
+        sweepPoints.push_back({gridValue, energy, pointDuration.count()});
+    }
+
+    return sweepPoints;
+}
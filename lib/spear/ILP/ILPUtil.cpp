@@ -547,6 +547,110 @@ ILPLongestPathDAGSolution ILPUtil::longestPathDAG(HLAC::FunctionNode *func,
     return {std::move(distanceMap), std::move(parentMap)};
 }
 
+ILPFlowGraph ILPUtil::buildFlowGraph(HLAC::FunctionNode *func, int numberOfVariables) {
+    ILPFlowGraph graph;
+    appendFlowScope(graph, func->Nodes, func->Edges, nullptr, numberOfVariables);
+    return graph;
+}
+
+ILPFlowGraph ILPUtil::buildFlowGraph(HLAC::LoopNode *loopNode, int numberOfVariables) {
+    ILPFlowGraph graph;
+    appendFlowScope(graph, loopNode->Nodes, loopNode->Edges, loopNode, numberOfVariables);
+    return graph;
+}
+
+ILPFlowNode ILPUtil::describeLoop(HLAC::LoopNode *loopNode, std::size_t bodyScope) {
+    ILPFlowNode flowNode;
+    flowNode.kind = ILPFlowNodeKind::LOOP;
+    flowNode.bodyScope = bodyScope;
+    flowNode.lowerBound = static_cast<double>(loopNode->bounds.getLowerBound());
+    flowNode.upperBound = static_cast<double>(loopNode->bounds.getUpperBound());
+    flowNode.loopNode = loopNode;
+    flowNode.name = loopNode->getDotName();
+    return flowNode;
+}
+
+std::size_t ILPUtil::appendFlowScope(ILPFlowGraph &graph,
+                                     const std::vector<std::unique_ptr<HLAC::GenericNode>> &nodes,
+                                     const std::vector<std::unique_ptr<HLAC::Edge>> &edges,
+                                     HLAC::LoopNode *loopNode, int numberOfVariables) {
+    const std::size_t scopeIndex = graph.scopes.size();
+    graph.scopes.emplace_back();
+
+    std::unordered_map<HLAC::GenericNode *, std::vector<int>> incomingEdgesPerNode;
+    std::unordered_map<HLAC::GenericNode *, std::vector<int>> outgoingEdgesPerNode;
+    buildIncidenceMaps(edges, incomingEdgesPerNode, outgoingEdgesPerNode, numberOfVariables);
+
+    std::vector<ILPFlowNode> flowNodes;
+    std::vector<std::pair<std::size_t, HLAC::LoopNode *>> innerLoops;
+    flowNodes.reserve(nodes.size());
+
+    for (const auto &nodeUP : nodes) {
+        HLAC::GenericNode *node = nodeUP.get();
+        ILPFlowNode flowNode;
+
+        if (auto *innerLoop = dynamic_cast<HLAC::LoopNode *>(node)) {
+            flowNode = describeLoop(innerLoop, 0);
+            innerLoops.emplace_back(flowNodes.size(), innerLoop);
+
+            // The loop is invoked by all incoming edges that do not originate from the loop itself
+            for (const auto &edgeUP : edges) {
+                if (edgeUP && edgeUP->destination == innerLoop && edgeUP->soure != innerLoop) {
+                    flowNode.invocationColumns.push_back(edgeUP->ilpIndex);
+                }
+            }
+        } else if (auto *virtualNode = dynamic_cast<HLAC::VirtualNode *>(node)) {
+            if (virtualNode->virtualNodeKind == HLAC::VirtualNodeKind::Entry) {
+                flowNode.kind = ILPFlowNodeKind::ENTRY;
+            } else if (virtualNode->virtualNodeKind == HLAC::VirtualNodeKind::NormalExit) {
+                flowNode.kind = ILPFlowNodeKind::EXIT;
+            }
+        }
+
+        auto incomingIterator = incomingEdgesPerNode.find(node);
+        if (incomingIterator != incomingEdgesPerNode.end()) {
+            flowNode.incomingColumns = std::move(incomingIterator->second);
+        }
+
+        auto outgoingIterator = outgoingEdgesPerNode.find(node);
+        if (outgoingIterator != outgoingEdgesPerNode.end()) {
+            flowNode.outgoingColumns = std::move(outgoingIterator->second);
+        }
+
+        flowNodes.push_back(std::move(flowNode));
+    }
+
+    std::vector<int> backEdgeColumns;
+    if (loopNode != nullptr) {
+        for (HLAC::Edge *backEdge : loopNode->backEdges) {
+            if (backEdge == nullptr) {
+                continue;
+            }
+
+            if (backEdge->ilpIndex < 0 || backEdge->ilpIndex >= numberOfVariables) {
+                Logger::getInstance().log("Loop bound debug: invalid backedge ilpIndex in loop " +
+                                                  loopNode->getDotName(),
+                                          LOGLEVEL::ERROR);
+                continue;
+            }
+
+            backEdgeColumns.push_back(backEdge->ilpIndex);
+        }
+    }
+
+    graph.scopes[scopeIndex].nodes = std::move(flowNodes);
+    graph.scopes[scopeIndex].backEdgeColumns = std::move(backEdgeColumns);
+
+    // Loop bodies follow their parent scope. The scopes vector grows, so the nodes are addressed by index
+    for (const auto &[nodeIndex, innerLoop] : innerLoops) {
+        const std::size_t bodyScope = appendFlowScope(graph, innerLoop->Nodes, innerLoop->Edges, innerLoop,
+                                                      numberOfVariables);
+        graph.scopes[scopeIndex].nodes[nodeIndex].bodyScope = bodyScope;
+    }
+
+    return scopeIndex;
+}
+
 int ILPUtil::assignEdgeIndicesFunction(HLAC::FunctionNode *func, int nextIndex) {
     // Iterate over the edges in this function and assign them an index
     for (auto &edgeUP : func->Edges) {
@@ -68,14 +68,6 @@ LoopNode* LoopNode::construct(LoopTree *loopTree, ProgramGraph *parent, Analysis
             // ProgramGraph *SPT = ProgramGraph::construct(subTree->mainloop->getBlocksVector());
             // subLoopNode->subgraphs.push_back(SPT);
 
-            // Init the list of blocks contained in the subloop
-            std::vector<std::string> allblocks;
-
-            // Add the subloops blocks to the list of contained blocks
-            for (auto subBlock : subTree->mainloop->getBlocksVector()) {
-                allblocks.push_back(subBlock->getName().str());
-            }
-
             // LoopNode *subLN = LoopNode::construct(&subTree);
 
             // Replace the nodes in the sub-ProgramGraph
@@ -140,19 +132,9 @@ void LoopNode::removeLoopEdgesFromSubGraphs() {
         // Get the Node the latchblock is contained in
         auto *latchnode = subgraph->findBlock(latchblock);
         // auto lnname = latchblock->getName();
-        // Init the list of edges we want to keep
-        std::vector<Edge *> tempedges;
-
-        // Iterate over the edges contained in the Sub-ProgramGraph
-        for (auto edge : subgraph->edges) {
-            // If the start node is not the latch of the loop, add it to the list of edges we want to keep
-            if (edge->start != latchnode) {
-                tempedges.push_back(edge);
-            }
-        }
 
-        // Set the edges-list of the Sub-ProgramGraph to the calculated list
-        subgraph->edges = tempedges;
+        // Remove the edges starting at the latch of the loop from the Sub-ProgramGraph
+        subgraph->removeEdgesStartingAtNode(latchnode);
 
         // If we have further LoopNodes contained in this LoopNode, remove their loopedges too
         if (subgraph->containsLoopNodes()) {
@@ -13,6 +13,7 @@
 #include <utility>
 #include <string>
 #include <map>
+#include <unordered_set>
 
 #include "../../src/spear/analyses/loopbound/LoopBound.h"
 #include "ConfigParser.h"
@@ -58,8 +59,8 @@ LoopTree::LoopTree(
 std::vector<llvm::BasicBlock *> LoopTree::calcBlocks() {
     // All the blocks present in the loop
     std::vector<llvm::BasicBlock *> initBlocks = this->mainloop->getBlocksVector();
-    // Vector for storing the combined blocks of the subloops
-    std::vector<llvm::BasicBlock *> combined;
+    // Set for storing the combined blocks of the subloops
+    std::unordered_set<llvm::BasicBlock *> combined;
     // Vector for string the calculated difference of this loop and its subloops
     std::vector<llvm::BasicBlock *> difference;
 
@@ -69,14 +70,13 @@ std::vector<llvm::BasicBlock *> LoopTree::calcBlocks() {
         // of all subloops and the initblocks present in this subloop
         for (auto subloop : this->subTrees) {
             // Calculate the union of all subloops
-            combined.insert(combined.end(),
-                subloop->mainloop->getBlocksVector().begin(),
+            combined.insert(subloop->mainloop->getBlocksVector().begin(),
                 subloop->mainloop->getBlocksVector().end());
         }
 
         // Iterate over the blocks in this loop. Find the blocks that are not present in the union but in this loop
         for (auto &basicBlock : initBlocks) {
-            if (std::find(combined.begin(), combined.end(), basicBlock) == combined.end()) {
+            if (combined.count(basicBlock) == 0) {
                 difference.insert(difference.end(), basicBlock);
             }
         }
@@ -284,12 +284,13 @@ std::vector<llvm::BasicBlock *> LoopTree::getLatches() {
         return latches;
     }
     std::vector<llvm::BasicBlock *> latches;
+    std::unordered_set<llvm::BasicBlock *> seenLatches;
 
     for (auto subTree : this->subTrees) {
         std::vector<llvm::BasicBlock *> subTreeLatches = subTree->getLatches();
         subTreeLatches.push_back(this->mainloop->getLoopLatch());
         for (auto &latch : subTreeLatches) {
-            if (std::find(latches.begin(), latches.end(), latch) == latches.end()) {
+            if (seenLatches.insert(latch).second) {
                 latches.push_back(latch);
             }
         }
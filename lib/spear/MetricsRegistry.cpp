@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include "MetricsRegistry.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+std::string escapeLabelValue(const std::string &value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+
+    for (char character : value) {
+        switch (character) {
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '"':
+                escaped += "\\\"";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            default:
+                escaped += character;
+        }
+    }
+
+    return escaped;
+}
+
+std::string metricTypeToStr(MetricType type) {
+    switch (type) {
+        case MetricType::COUNTER:
+            return "counter";
+        case MetricType::GAUGE:
+            return "gauge";
+        case MetricType::HISTOGRAM:
+            return "histogram";
+        default:
+            return "unknown";
+    }
+}
+}  // namespace
+
+void Gauge::setMax(double value) {
+    double current = this->value.load(std::memory_order_relaxed);
+    while (value > current && !this->value.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+Histogram::Histogram(std::vector<double> bounds) : bounds(std::move(bounds)) {
+    std::sort(this->bounds.begin(), this->bounds.end());
+    this->bounds.erase(std::unique(this->bounds.begin(), this->bounds.end()), this->bounds.end());
+
+    bucketCounts = std::make_unique<std::atomic<uint64_t>[]>(this->bounds.size() + 1);
+    for (size_t index = 0; index <= this->bounds.size(); ++index) {
+        bucketCounts[index].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::observe(double value) {
+    // Buckets are inclusive on their upper bound
+    const size_t bucket = std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin();
+
+    bucketCounts[bucket].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+std::vector<uint64_t> Histogram::getCumulativeCounts() const {
+    std::vector<uint64_t> cumulativeCounts(bounds.size() + 1);
+
+    uint64_t runningCount = 0;
+    for (size_t index = 0; index <= bounds.size(); ++index) {
+        runningCount += bucketCounts[index].load(std::memory_order_relaxed);
+        cumulativeCounts[index] = runningCount;
+    }
+
+    return cumulativeCounts;
+}
+
+void Histogram::merge(const std::vector<uint64_t> &cumulativeCounts, double sum, uint64_t count) {
+    uint64_t previousCount = 0;
+    for (size_t index = 0; index <= bounds.size() && index < cumulativeCounts.size(); ++index) {
+        bucketCounts[index].fetch_add(cumulativeCounts[index] - previousCount, std::memory_order_relaxed);
+        previousCount = cumulativeCounts[index];
+    }
+
+    this->count.fetch_add(count, std::memory_order_relaxed);
+    this->sum.fetch_add(sum, std::memory_order_relaxed);
+}
+
+void Histogram::reset() {
+    for (size_t index = 0; index <= bounds.size(); ++index) {
+        bucketCounts[index].store(0, std::memory_order_relaxed);
+    }
+
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+}
+
+std::vector<double> Histogram::exponentialBuckets(double start, double factor, size_t bucketCount) {
+    std::vector<double> bucketBounds;
+    bucketBounds.reserve(bucketCount);
+
+    double bound = start;
+    for (size_t index = 0; index < bucketCount; ++index) {
+        bucketBounds.push_back(bound);
+        bound *= factor;
+    }
+
+    return bucketBounds;
+}
+
+MetricsRegistry &MetricsRegistry::getInstance() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+MetricsRegistry::MetricFamily &MetricsRegistry::getFamily(const std::string &name, const std::string &help,
+                                                          MetricType type) {
+    auto [familyIterator, inserted] = families.try_emplace(name);
+    auto &family = familyIterator->second;
+
+    if (inserted) {
+        family.type = type;
+        family.help = help;
+    } else if (family.type != type) {
+        throw std::runtime_error("Metric " + name + " is already registered as " + metricTypeToStr(family.type));
+    }
+
+    return family;
+}
+
+Counter &MetricsRegistry::counter(const std::string &name, const std::string &help, const MetricLabels &labels) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto &family = getFamily(name, help, MetricType::COUNTER);
+
+    auto &metric = family.counters[labels];
+    if (!metric) {
+        metric = std::make_unique<Counter>();
+    }
+
+    return *metric;
+}
+
+Gauge &MetricsRegistry::gauge(const std::string &name, const std::string &help, const MetricLabels &labels) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto &family = getFamily(name, help, MetricType::GAUGE);
+
+    auto &metric = family.gauges[labels];
+    if (!metric) {
+        metric = std::make_unique<Gauge>();
+    }
+
+    return *metric;
+}
+
+Histogram &MetricsRegistry::histogram(const std::string &name, const std::string &help,
+                                      const std::vector<double> &bounds, const MetricLabels &labels) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto &family = getFamily(name, help, MetricType::HISTOGRAM);
+
+    // All histograms of a family share the bounds of the first registration
+    if (family.histograms.empty() && family.bounds.empty()) {
+        family.bounds = bounds;
+    }
+
+    auto &metric = family.histograms[labels];
+    if (!metric) {
+        metric = std::make_unique<Histogram>(family.bounds);
+    }
+
+    return *metric;
+}
+
+void MetricsRegistry::recordPhaseDuration(const std::string &phase, std::chrono::microseconds duration) {
+    gauge("spear_phase_duration_seconds", "Duration of the analysis phases", {{"phase", phase}})
+        .set(std::chrono::duration<double>(duration).count());
+}
+
+void MetricsRegistry::collectProcessMetrics() {
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        // ru_maxrss is reported in KiB on Linux
+        gauge("spear_peak_rss_bytes", "Peak resident set size of the process")
+            .setMax(static_cast<double>(usage.ru_maxrss) * 1024.0);
+    }
+}
+
+std::string MetricsRegistry::formatLabels(const MetricLabels &labels, const std::string &extraLabel) {
+    if (labels.empty() && extraLabel.empty()) {
+        return "";
+    }
+
+    std::string formatted = "{";
+    for (const auto &[key, value] : labels) {
+        if (formatted.size() > 1) {
+            formatted += ",";
+        }
+        formatted += key + "=\"" + escapeLabelValue(value) + "\"";
+    }
+
+    if (!extraLabel.empty()) {
+        if (formatted.size() > 1) {
+            formatted += ",";
+        }
+        formatted += extraLabel;
+    }
+
+    return formatted + "}";
+}
+
+std::string MetricsRegistry::formatNumber(double value) {
+    if (std::isinf(value)) {
+        return value > 0 ? "+Inf" : "-Inf";
+    }
+    if (std::isnan(value)) {
+        return "NaN";
+    }
+
+    std::ostringstream stream;
+    stream << std::setprecision(15) << value;
+    return stream.str();
+}
+
+void MetricsRegistry::writeOpenMetrics(std::ostream &outputStream) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    for (const auto &[name, family] : families) {
+        outputStream << "# TYPE " << name << " " << metricTypeToStr(family.type) << "\n";
+        outputStream << "# HELP " << name << " " << family.help << "\n";
+
+        for (const auto &[labels, metric] : family.counters) {
+            outputStream << name << "_total" << formatLabels(labels) << " " << metric->get() << "\n";
+        }
+
+        for (const auto &[labels, metric] : family.gauges) {
+            outputStream << name << formatLabels(labels) << " " << formatNumber(metric->get()) << "\n";
+        }
+
+        for (const auto &[labels, metric] : family.histograms) {
+            const auto &bounds = metric->getBounds();
+            const auto cumulativeCounts = metric->getCumulativeCounts();
+
+            for (size_t index = 0; index < cumulativeCounts.size(); ++index) {
+                const std::string bound = index < bounds.size() ? formatNumber(bounds[index]) : "+Inf";
+                outputStream << name << "_bucket" << formatLabels(labels, "le=\"" + bound + "\"") << " "
+                             << cumulativeCounts[index] << "\n";
+            }
+
+            outputStream << name << "_sum" << formatLabels(labels) << " " << formatNumber(metric->getSum()) << "\n";
+            outputStream << name << "_count" << formatLabels(labels) << " " << metric->getCount() << "\n";
+        }
+    }
+
+    outputStream << "# EOF\n";
+}
+
+nlohmann::json MetricsRegistry::toJson() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    nlohmann::json output = nlohmann::json::object();
+
+    for (const auto &[name, family] : families) {
+        nlohmann::json metrics = nlohmann::json::array();
+
+        for (const auto &[labels, metric] : family.counters) {
+            metrics.push_back({{"labels", labels}, {"value", metric->get()}});
+        }
+
+        for (const auto &[labels, metric] : family.gauges) {
+            metrics.push_back({{"labels", labels}, {"value", metric->get()}});
+        }
+
+        for (const auto &[labels, metric] : family.histograms) {
+            const auto &bounds = metric->getBounds();
+            const auto cumulativeCounts = metric->getCumulativeCounts();
+
+            nlohmann::json buckets = nlohmann::json::array();
+            for (size_t index = 0; index < cumulativeCounts.size(); ++index) {
+                nlohmann::json bound = index < bounds.size() ? nlohmann::json(bounds[index]) : nlohmann::json("+Inf");
+                buckets.push_back({{"le", bound}, {"count", cumulativeCounts[index]}});
+            }
+
+            metrics.push_back({{"labels", labels},
+                               {"buckets", buckets},
+                               {"sum", metric->getSum()},
+                               {"count", metric->getCount()}});
+        }
+
+        output[name] = {{"type", metricTypeToStr(family.type)}, {"help", family.help}, {"metrics", metrics}};
+    }
+
+    return output;
+}
+
+void MetricsRegistry::reset() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    for (auto &[name, family] : families) {
+        for (auto &[labels, metric] : family.counters) {
+            metric->reset();
+        }
+        for (auto &[labels, metric] : family.gauges) {
+            metric->reset();
+        }
+        for (auto &[labels, metric] : family.histograms) {
+            metric->reset();
+        }
+    }
+}
+
+void MetricsRegistry::merge(const nlohmann::json &metrics) {
+    if (!metrics.is_object()) {
+        return;
+    }
+
+    for (const auto &[name, family] : metrics.items()) {
+        if (!family.is_object() || !family.contains("metrics") || !family["metrics"].is_array()) {
+            continue;
+        }
+
+        const std::string type = family.value("type", "");
+        const std::string help = family.value("help", "");
+
+        for (const auto &metric : family["metrics"]) {
+            const auto labels = metric.value("labels", MetricLabels{});
+
+            if (type == "counter") {
+                counter(name, help, labels).inc(metric.value("value", uint64_t{0}));
+            } else if (type == "gauge") {
+                gauge(name, help, labels).setMax(metric.value("value", 0.0));
+            } else if (type == "histogram" && metric.contains("buckets")) {
+                std::vector<double> bounds;
+                std::vector<uint64_t> cumulativeCounts;
+                for (const auto &bucket : metric["buckets"]) {
+                    if (bucket["le"].is_number()) {
+                        bounds.push_back(bucket["le"].get<double>());
+                    }
+                    cumulativeCounts.push_back(bucket.value("count", uint64_t{0}));
+                }
+
+                auto &target = histogram(name, help, bounds, labels);
+                if (target.getBounds() == bounds) {
+                    target.merge(cumulativeCounts, metric.value("sum", 0.0), metric.value("count", uint64_t{0}));
+                }
+            }
+        }
+    }
+}
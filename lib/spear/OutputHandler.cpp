@@ -10,6 +10,7 @@
 #include <string>
 
 #include "ConfigParser.h"
+#include "ProgressReporter.h"
 
 void OutputHandler::writeJsonOutput(std::string filename, nlohmann::json content) {
     writeJsonFile(filename + ".json", content);
@@ -34,7 +35,10 @@ void OutputHandler::writeELBFile(std::string filename, nlohmann::json content) {
         }
 
         // Write JSON with indentation (4 spaces)
-        outputFile << content.dump(4);
+        const std::string serializedContent = content.dump(4);
+        ProgressPhase progress("output " + filePath.filename().string(), "bytes", serializedContent.size());
+        outputFile << serializedContent;
+        ProgressReporter::getInstance().advance(serializedContent.size());
 
         outputFile.close();
     }
@@ -58,7 +62,10 @@ void OutputHandler::writeJsonFile(std::string filename, nlohmann::json content)
         }
 
         // Write JSON with indentation (4 spaces)
-        outputFile << content.dump(4);
+        const std::string serializedContent = content.dump(4);
+        ProgressPhase progress("output " + filePath.filename().string(), "bytes", serializedContent.size());
+        outputFile << serializedContent;
+        ProgressReporter::getInstance().advance(serializedContent.size());
 
         outputFile.close();
     }
@@ -9,6 +9,7 @@
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Instruction.h>
 #include <llvm/IR/Module.h>
+#include <llvm/Analysis/LoopInfo.h>
 
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Passes/PassPlugin.h>
@@ -21,6 +22,9 @@
 #include <vector>
 
 #include "Logger.h"
+#include "MetricsRegistry.h"
+#include "ProgressReporter.h"
+#include "analyses/feasibility/FeasibilityPortfolio.h"
 #include "analyses/feasibility/util.h"
 #include "analyses/loopbound/LoopBound.h"
 #include "analyses/loopbound/loopBoundWrapper.h"
@@ -45,9 +49,15 @@ PhasarHandlerPass::PhasarHandlerPass(bool runLoopBoundAnalysis, bool runFeasibil
 
 PreservedAnalyses PhasarHandlerPass::run(Module &M, ModuleAnalysisManager &AM) {
   mod = &M;
-  HA = std::make_shared<psr::HelperAnalyses>(&M, Entrypoints);
+  // The helper analyses are built by the first analysis that needs them
+  HA = nullptr;
   LoopBoundResult.reset();
   FeasibilityResult.reset();
+  loopboundwrapper.reset();
+  loopboundProblem.reset();
+  feasibilitywrapper.reset();
+  feasibilityProblem.reset();
+  feasibilitySkipped = false;
 
   if (config.SHOWDEBUGOUTPUT) {
     llvm::errs() << M << "\n";
@@ -86,20 +96,34 @@ void PhasarHandlerPass::runAnalysis(llvm::Module &M, llvm::FunctionAnalysisManag
     return;
   }
 
-  if (config.RUNFEASIBILITYANALYSIS) {
+  if (config.RUNFEASIBILITYANALYSIS && !moduleHasBranches(M)) {
+    // Neither PhASAR nor Z3 is set up, the trivial result is built on query
+    Logger::getInstance().log("Skipping Feasibility Analysis: no function of the module branches", LOGLEVEL::INFO);
+    MetricsRegistry::getInstance()
+        .counter("spear_phasar_analyses_skipped", "Phasar-based analyses skipped as the module does not need them")
+        .inc(1);
+    feasibilitySkipped = true;
+  } else if (config.RUNFEASIBILITYANALYSIS) {
     if (config.SHOWDEBUGOUTPUT) {
         Logger::getInstance().log("Running Feasibility Analysis...", LOGLEVEL::INFO);
     }
-    feasibilitywrapper = make_unique<Feasibility::FeasibilityWrapper>(HA, FAM);
+    feasibilitywrapper = make_unique<Feasibility::FeasibilityWrapper>(getHelperAnalyses(), FAM);
     feasibilityProblem = feasibilitywrapper->problem;
     FeasibilityResult = feasibilitywrapper->getResults();
   }
 
-  if (config.RUNLOOPBOUNDANALYSIS) {
+  if (config.RUNLOOPBOUNDANALYSIS && !moduleHasLoops(M, FAM)) {
+    // Without loops there is nothing to bound, queryLoopBounds() returns an empty map
+    Logger::getInstance().log("Skipping Loopbound Analysis: no function of the module contains a loop",
+                              LOGLEVEL::INFO);
+    MetricsRegistry::getInstance()
+        .counter("spear_phasar_analyses_skipped", "Phasar-based analyses skipped as the module does not need them")
+        .inc(1);
+  } else if (config.RUNLOOPBOUNDANALYSIS) {
     if (config.SHOWDEBUGOUTPUT) {
         Logger::getInstance().log("Running Loopbound Analysis...", LOGLEVEL::INFO);
     }
-    loopboundwrapper = make_unique<LoopBound::LoopBoundWrapper>(HA, FAM);
+    loopboundwrapper = make_unique<LoopBound::LoopBoundWrapper>(getHelperAnalyses(), FAM);
     loopboundProblem = loopboundwrapper->problem;
     LoopBoundResult = loopboundwrapper->getResults();
   }
@@ -113,10 +137,48 @@ void PhasarHandlerPass::runAnalysis(llvm::Module &M, llvm::FunctionAnalysisManag
   }
 }
 
+std::shared_ptr<psr::HelperAnalyses> PhasarHandlerPass::getHelperAnalyses() {
+  if (!HA) {
+    HA = std::make_shared<psr::HelperAnalyses>(mod, Entrypoints);
+  }
+
+  return HA;
+}
+
+bool PhasarHandlerPass::moduleHasLoops(llvm::Module &M, llvm::FunctionAnalysisManager *FAM) {
+  for (auto &Func : M) {
+    if (Func.isDeclaration()) {
+      continue;
+    }
+
+    // The loop info is cached in the FAM and reused by the loop bound wrapper
+    if (!FAM->getResult<llvm::LoopAnalysis>(Func).empty()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool PhasarHandlerPass::moduleHasBranches(llvm::Module &M) {
+  for (auto &Func : M) {
+    for (auto &BB : Func) {
+      const llvm::Instruction *Term = BB.getTerminator();
+      if (Term && Term->getNumSuccessors() > 1) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
 LoopBound::LoopFunctionMap PhasarHandlerPass::queryLoopBounds() const {
   LoopBound::LoopFunctionMap LoopFunctionInfo;
+  ProgressPhase progress("loopbound query", "functions", mod->size());
 
   for (auto &Func : mod->functions()) {
+    ProgressReporter::getInstance().advance();
     if (!Func.isDeclaration()) {
       auto FuncLoopBoundInfo = queryBoundsOfFunction(&Func);
       if (!FuncLoopBoundInfo.empty()) {
@@ -131,7 +193,7 @@ LoopBound::LoopFunctionMap PhasarHandlerPass::queryLoopBounds() const {
 LoopBound::LoopToBoundMap PhasarHandlerPass::queryBoundsOfFunction(llvm::Function *Func) const {
   LoopBound::LoopToBoundMap ResultMap;
 
-  if (!LoopBoundResult || !Func) {
+  if (!loopboundwrapper || !Func) {
     return ResultMap;
   }
 
@@ -149,8 +211,10 @@ LoopBound::LoopToBoundMap PhasarHandlerPass::queryBoundsOfFunction(llvm::Functio
 
 Feasibility::FunctionFeasibilityMap PhasarHandlerPass::queryFeasibilty() const {
   Feasibility::FunctionFeasibilityMap FeasibilityInfo;
+  ProgressPhase progress("feasibility query", "functions", mod->size());
 
   for (auto &Func : mod->functions()) {
+    ProgressReporter::getInstance().advance();
     if (!Func.isDeclaration()) {
       auto FuncFeasMap = queryFeasibilityOfFunction(&Func);
       if (!FuncFeasMap.empty()) {
@@ -159,18 +223,25 @@ Feasibility::FunctionFeasibilityMap PhasarHandlerPass::queryFeasibilty() const {
     }
   }
 
+  Feasibility::SatPortfolio::logLatencyReport();
+  if (feasibilityProblem) {
+    feasibilityProblem->getManager()->logEnvironmentStatistics();
+  }
+
   return FeasibilityInfo;
 }
 
 Feasibility::BlockFeasibilityMap PhasarHandlerPass::queryFeasibilityOfFunction(llvm::Function *Func) const {
   Feasibility::BlockFeasibilityMap BlockFeasibilityMap;
 
+  if (feasibilitySkipped && Func) {
+    return trivialFeasibilityOfFunction(Func);
+  }
+
   if (!FeasibilityResult || !Func) {
     return BlockFeasibilityMap;
   }
 
-  const llvm::Value *Zero = feasibilityProblem ? feasibilityProblem->getZeroValue() : nullptr;
-
   // Create the worklist and visited set for a simple CFG traversal to query feasibility at block entries.
   auto firstBlock = &Func->getEntryBlock();
   std::deque<llvm::BasicBlock*> worklist{firstBlock};
@@ -204,11 +275,10 @@ Feasibility::BlockFeasibilityMap PhasarHandlerPass::queryFeasibilityOfFunction(l
 
     // Query feasibility
     if (const llvm::Instruction *Term = BB->getTerminator()) {
-      // Query the analysis result for the terminator instruction and check if it contains an entry for the zero value.
-      auto res = FeasibilityResult->resultsAt(Term);
-      auto it = res.find(Zero);
+      // Query the analysis result for the terminator instruction. Only terminators the zero value reached have one
+      auto it = FeasibilityResult->find(Term);
 
-      if (it != res.end()) {
+      if (it != FeasibilityResult->end()) {
         // If it does, we check the kind of the lattice element. If it's not bottom, the block is feasible.
         const auto &entry = it->second;
 
@@ -243,6 +313,27 @@ Feasibility::BlockFeasibilityMap PhasarHandlerPass::queryFeasibilityOfFunction(l
   return BlockFeasibilityMap;
 }
 
+Feasibility::BlockFeasibilityMap PhasarHandlerPass::trivialFeasibilityOfFunction(llvm::Function *Func) {
+  Feasibility::BlockFeasibilityMap BlockFeasibilityMap;
+
+  if (Func->isDeclaration()) {
+    return BlockFeasibilityMap;
+  }
+
+  // Every terminator has at most one successor, so the reachable blocks form a single path from the entry
+  for (const llvm::BasicBlock *BB = &Func->getEntryBlock(); BB != nullptr; BB = BB->getSingleSuccessor()) {
+    auto &Info = BlockFeasibilityMap[blockName(*BB)];
+    if (Info.visited) {
+      break;
+    }
+
+    Info.Feasible = true;
+    Info.HasZeroAtEntry = true;
+    Info.visited = true;
+  }
+
+  return BlockFeasibilityMap;
+}
 
 std::string PhasarHandlerPass::blockName(const llvm::BasicBlock &BB) {
   return BB.hasName()
@@ -27,6 +27,18 @@ void ProfileHandler::read(const std::string& filename) {
     data = json::parse(fileStream);
 
     _profile = data;
+
+    if (!_coreType.empty()) {
+        if (_profile.contains("cpu_types") && _profile["cpu_types"].contains(_coreType)) {
+            _profile["cpu"] = _profile["cpu_types"][_coreType];
+        } else {
+            std::cout << "Core type " << _coreType << " not found in the profile, using the default cost table" << "\n";
+        }
+    }
+}
+
+void ProfileHandler::selectCoreType(const std::string &coreType) {
+    _coreType = coreType;
 }
 
 void ProfileHandler::setOrCreate(std::string key, json &mapping) {
@@ -8,6 +8,7 @@
 #include <iostream>
 
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include "Color.h"
 
@@ -36,16 +37,18 @@ void ProgramGraph::construct(
         node->block = basicBlock;
         // Add the node to the graph
         pGraph->nodes.push_back(node);
+        pGraph->blockIndex[basicBlock] = node;
 
         pGraph->maxEnergy = 0.0;
     }
 
     // Iterate over the blocks to create the edges of the graph
     for (auto basicBlock : blockset) {
+        Node *start = pGraph->findBlock(basicBlock);
+
         // Determine the successors to the current block in the cfg
         for (auto successor : llvm::successors(basicBlock)) {
-            // Get the nodes defining the edge
-            Node *start = pGraph->findBlock(basicBlock);
+            // Get the node the edge ends on
             Node *end = pGraph->findBlock(successor);
 
             // If both of the defining nodes were found
@@ -58,7 +61,7 @@ void ProgramGraph::construct(
         }
     }
 
-    // Return the graph
+    pGraph->indexEdges();
 }
 
 ProgramGraph::~ProgramGraph() {
@@ -106,13 +109,9 @@ std::vector<Node*> ProgramGraph::getNodes() {
 
 // Search for the given block in the graph
 Node* ProgramGraph::findBlock(llvm::BasicBlock *basicBlock) {
-    // Iterate over the nodes
-    for (int i=0; i < nodes.size(); i++) {
-        // Use the standard find method to search the vector
-        if (nodes[i]->block == basicBlock) {
-            // If found return the node
-            return nodes[i];
-        }
+    auto entry = blockIndex.find(basicBlock);
+    if (entry != blockIndex.end()) {
+        return entry->second;
     }
 
     // If nothing was found, return a null pointer
@@ -143,8 +142,8 @@ void ProgramGraph::printEdges() {
 
 // Replaces the given blocks with the given loopnode
 void ProgramGraph::replaceNodesWithLoopNode(const std::vector<llvm::BasicBlock *>& blocks, LoopNode *loopNode) {
-    // Init the list of nodes, that need replacement
-    std::vector<Node *> nodesToReplace;
+    // Init the set of nodes, that need replacement
+    std::unordered_set<Node *> nodesToReplace;
 
     // Iterate over the given blocks
     for (auto basicBlock : blocks) {
@@ -153,8 +152,8 @@ void ProgramGraph::replaceNodesWithLoopNode(const std::vector<llvm::BasicBlock *
 
         // If a Node for the block was found...
         if (toReplace != nullptr) {
-            // Add the node to the list
-            nodesToReplace.push_back(toReplace);
+            // Add the node to the set
+            nodesToReplace.insert(toReplace);
         }
     }
 
@@ -196,9 +195,18 @@ void ProgramGraph::replaceNodesWithLoopNode(const std::vector<llvm::BasicBlock *
             }
         }
 
-        // Remove the nodes encapsulated by the loop
-        for (auto node : nodesToReplace) {
-            this->removeNode(node);
+        // Remove the nodes encapsulated by the loop in a single pass
+        std::vector<Node *> remainingNodes;
+        remainingNodes.reserve(this->nodes.size() - nodesToReplace.size());
+        for (auto node : this->nodes) {
+            if (nodesToReplace.count(node) == 0) {
+                remainingNodes.push_back(node);
+            }
+        }
+        this->nodes = std::move(remainingNodes);
+
+        for (auto basicBlock : blocks) {
+            this->blockIndex.erase(basicBlock);
         }
 
         // Take care of all edges, that may be orphaned after the editing of the graph
@@ -221,18 +229,25 @@ void ProgramGraph::removeNode(Node *nodeToRemove) {
 
     // Set the nodes of the graph to the keep-list
     this->nodes = newNodes;
+
+    if (nodeToRemove->block != nullptr) {
+        auto entry = this->blockIndex.find(nodeToRemove->block);
+        if (entry != this->blockIndex.end() && entry->second == nodeToRemove) {
+            this->blockIndex.erase(entry);
+        }
+    }
 }
 
 // Removes all edges from the graph, that refere to nodes no longer present in the graph
 void ProgramGraph::removeOrphanedEdges() {
     // Init the list of edges, we want to keep
     std::vector<Edge *> cleanedEdges;
+    std::unordered_set<Node *> presentNodes(this->nodes.begin(), this->nodes.end());
 
     // Iterate over the edges
     for (auto edge : this->edges) {
         // Test if the end node and the start node both can be found in the graph
-        if (std::find(this->nodes.begin(), this->nodes.end(), edge->start) != this->nodes.end() &&
-        std::find(this->nodes.begin(), this->nodes.end(), edge->end) != this->nodes.end() ) {
+        if (presentNodes.count(edge->start) != 0 && presentNodes.count(edge->end) != 0) {
             // If we have and edge without orphaned nodes. Test for self references
             if (edge->start != edge->end) {
                 // If we aren't having a self reference, add the node to the keep-list
@@ -243,6 +258,7 @@ void ProgramGraph::removeOrphanedEdges() {
 
     // Set the edges of the graph to the keeping edges
     this->edges = cleanedEdges;
+    this->indexEdges();
 }
 
 // Calculate the energy of the graph
@@ -263,21 +279,40 @@ double ProgramGraph::getEnergy(LLVMHandler *handler) {
 }
 
 // Find all the edges starting at the given Node
-std::vector<Edge *> ProgramGraph::findEdgesStartingAtNode(Node *sourceNode) {
-    // Init the list
-    std::vector<Edge *> selection;
+const std::vector<Edge *> &ProgramGraph::findEdgesStartingAtNode(Node *sourceNode) const {
+    static const std::vector<Edge *> noEdges;
 
-    // Iterate over the edges
+    auto entry = this->outgoingEdges.find(sourceNode);
+    if (entry != this->outgoingEdges.end()) {
+        return entry->second;
+    }
+
+    return noEdges;
+}
+
+// Remove all the edges starting at the given Node
+void ProgramGraph::removeEdgesStartingAtNode(Node *sourceNode) {
+    if (this->outgoingEdges.erase(sourceNode) == 0) {
+        return;
+    }
+
+    std::vector<Edge *> remainingEdges;
     for (auto edge : this->edges) {
-        // If the start of the edge is the given Node
-        if (edge->start == sourceNode) {
-            // Add the edge to the list
-            selection.push_back(edge);
+        if (edge->start != sourceNode) {
+            remainingEdges.push_back(edge);
         }
     }
 
-    // Return the list of edges
-    return selection;
+    this->edges = remainingEdges;
+}
+
+// Group the edges of the graph by their start node
+void ProgramGraph::indexEdges() {
+    this->outgoingEdges.clear();
+
+    for (auto edge : this->edges) {
+        this->outgoingEdges[edge->start].push_back(edge);
+    }
 }
 
 // Test if thie graph contains a LoopNode
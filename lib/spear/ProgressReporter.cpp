@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include "ProgressReporter.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace {
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}  // namespace
+
+ProgressReporter &ProgressReporter::getInstance() {
+    static ProgressReporter instance;
+    return instance;
+}
+
+ProgressReporter::ProgressReporter() {
+    isTTY = isatty(fileno(stderr)) == 1;
+}
+
+void ProgressReporter::setEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(phaseMutex);
+    this->enabled.store(enabled, std::memory_order_relaxed);
+
+    if (!enabled) {
+        phaseActive.store(false, std::memory_order_release);
+        suspendedPhases.clear();
+    }
+}
+
+bool ProgressReporter::beginPhase(const std::string &phase, const std::string &unit, uint64_t totalUnits) {
+    if (!enabled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(phaseMutex);
+    if (phaseActive.exchange(false, std::memory_order_acq_rel)) {
+        suspendedPhases.push_back({phaseName, unitName, completedUnits.load(std::memory_order_relaxed),
+                                   this->totalUnits, phaseStart});
+    }
+
+    phaseName = phase;
+    unitName = unit;
+    this->totalUnits = totalUnits;
+    phaseStart = std::chrono::steady_clock::now();
+    completedUnits.store(0, std::memory_order_relaxed);
+
+    scheduleNextReport();
+    phaseActive.store(true, std::memory_order_release);
+    return true;
+}
+
+void ProgressReporter::scheduleNextReport() {
+    auto interval = isTTY ? std::chrono::nanoseconds(ttyInterval) : std::chrono::nanoseconds(recordInterval);
+    nextReport.store(steadyNowNs() + interval.count(), std::memory_order_relaxed);
+}
+
+void ProgressReporter::advance(uint64_t units) {
+    if (!phaseActive.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    completedUnits.fetch_add(units, std::memory_order_relaxed);
+
+    int64_t now = steadyNowNs();
+    int64_t due = nextReport.load(std::memory_order_relaxed);
+    if (now < due) {
+        return;
+    }
+
+    // Only the thread winning the exchange reports, all others continue with their work
+    auto interval = isTTY ? std::chrono::nanoseconds(ttyInterval) : std::chrono::nanoseconds(recordInterval);
+    if (!nextReport.compare_exchange_strong(due, now + interval.count(), std::memory_order_relaxed)) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(phaseMutex, std::try_to_lock);
+    if (lock.owns_lock() && phaseActive.load(std::memory_order_relaxed)) {
+        report(false);
+    }
+}
+
+void ProgressReporter::endPhase() {
+    std::lock_guard<std::mutex> lock(phaseMutex);
+    if (!phaseActive.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    report(true);
+
+    if (suspendedPhases.empty()) {
+        return;
+    }
+
+    // Continue the outer phase where it was suspended
+    SuspendedPhase &outerPhase = suspendedPhases.back();
+    phaseName = std::move(outerPhase.name);
+    unitName = std::move(outerPhase.unit);
+    totalUnits = outerPhase.totalUnits;
+    phaseStart = outerPhase.start;
+    completedUnits.store(outerPhase.completedUnits, std::memory_order_relaxed);
+    suspendedPhases.pop_back();
+
+    scheduleNextReport();
+    phaseActive.store(true, std::memory_order_release);
+}
+
+void ProgressReporter::report(bool final) {
+    uint64_t done = completedUnits.load(std::memory_order_relaxed);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - phaseStart).count();
+    double rate = elapsed > 0 ? static_cast<double>(done) / elapsed : 0;
+
+    // A negative ETA marks an unknown remaining time
+    double eta = -1;
+    if (totalUnits > 0 && rate > 0) {
+        eta = done >= totalUnits ? 0 : static_cast<double>(totalUnits - done) / rate;
+    }
+
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(2);
+    if (isTTY) {
+        stream << "\r\033[K[" << phaseName << "] " << done;
+        if (totalUnits > 0) {
+            stream << "/" << totalUnits;
+        }
+        stream << " " << unitName << " | " << rate << " " << unitName << "/s";
+        if (eta >= 0) {
+            stream << " | ETA " << eta << "s";
+        }
+        if (final) {
+            stream << " | done in " << elapsed << "s\n";
+        }
+    } else {
+        stream << "{\"progress\":\"" << phaseName << "\",\"unit\":\"" << unitName << "\",\"done\":" << done
+               << ",\"total\":" << totalUnits << ",\"rate\":" << rate << ",\"eta\":" << eta
+               << ",\"elapsed\":" << elapsed << ",\"final\":" << (final ? "true" : "false") << "}\n";
+    }
+
+    std::cerr << stream.str() << std::flush;
+}
@@ -57,6 +57,28 @@ double RegisterReader::getEnergy() {
     return static_cast<double>(result) * mutlitplier;
 }
 
+uint64_t RegisterReader::readEnergyCounter() {
+    return static_cast<uint64_t>(read(this->energyReg));
+}
+
+bool RegisterReader::isAccessible(int core) {
+    char registerFile[32]{};
+    snprintf(registerFile, sizeof(registerFile), "/dev/cpu/%d/msr", core);
+
+    int registerFileDescriptor = open(registerFile, O_RDONLY);
+    if (registerFileDescriptor < 0) {
+        return false;
+    }
+
+    close(registerFileDescriptor);
+    return true;
+}
+
+bool RegisterReader::hasPerCoreCounter() {
+    // AMD reports the energy of every core in 0xC001029A, Intel only offers the shared PP0 domain in 0x639
+    return cpu_vendor_runtime() == CPU_VENDOR_AMD;
+}
+
 double RegisterReader::readMultiplier() {
     uint64_t result = read(this->unitReg);
     double unit = static_cast<char>(((result >> 8) & 0x1F));
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include "SelfEnergyMeter.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Logger.h"
+#include "MetricsRegistry.h"
+
+#ifndef SPEAR_VERSION
+#define SPEAR_VERSION "unknown"
+#endif
+
+SelfEnergyMeter &SelfEnergyMeter::getInstance() {
+    static SelfEnergyMeter instance;
+    return instance;
+}
+
+void SelfEnergyMeter::configure(const SelfEnergyConfiguration &configuration) {
+    if (!configuration.enabled) {
+        return;
+    }
+
+    configure(EnergyCounterSource::create(configuration.source, configuration.mockWatts), configuration.samplingRate);
+}
+
+void SelfEnergyMeter::configure(std::unique_ptr<EnergyCounterSource> counterSource, unsigned samplingRate) {
+    std::lock_guard<std::mutex> lock(meterMutex);
+    if (sampler) {
+        sampler->stop();
+        sampler.reset();
+    }
+
+    source = std::move(counterSource);
+    enabled = source != nullptr;
+
+    if (!enabled) {
+        return;
+    }
+
+    Logger::getInstance().log("Measuring the energy of SPEAR with the " + source->getName() + " counter",
+                              LOGLEVEL::INFO);
+
+    if (samplingRate > 0) {
+        sampler = std::make_unique<EnergySampler>(*source, samplingRate);
+        sampler->start();
+    }
+}
+
+SelfEnergyMeter::Reading SelfEnergyMeter::read() {
+    if (sampler) {
+        return {sampler->getLatestTicks(), std::chrono::steady_clock::now()};
+    }
+
+    return {source->readCounter(), std::chrono::steady_clock::now()};
+}
+
+void SelfEnergyMeter::accumulate(Measurement &measurement, const Reading &start, const Reading &end) const {
+    // Readings of the sampler are already extended to 64 bits
+    const unsigned counterBits = sampler ? 64 : source->getCounterBits();
+    const uint64_t ticks = EnergyCounterSource::counterDelta(start.counter, end.counter, counterBits);
+    const double joules = static_cast<double>(ticks) * source->getEnergyUnit();
+
+    measurement.joules += joules;
+    measurement.seconds += std::chrono::duration<double>(end.time - start.time).count();
+    measurement.count++;
+}
+
+void SelfEnergyMeter::beginPhase(const std::string &phase) {
+    if (!enabled) {
+        return;
+    }
+
+    endPhase();
+
+    std::lock_guard<std::mutex> lock(meterMutex);
+    if (phases.find(phase) == phases.end()) {
+        phaseOrder.push_back(phase);
+    }
+
+    currentPhase = phase;
+    phaseActive = true;
+    phaseStart = read();
+}
+
+void SelfEnergyMeter::endPhase() {
+    if (!enabled) {
+        return;
+    }
+
+    endFunction();
+
+    std::lock_guard<std::mutex> lock(meterMutex);
+    if (!phaseActive) {
+        return;
+    }
+
+    const Reading phaseEnd = read();
+    auto &measurement = phases[currentPhase].total;
+    accumulate(measurement, phaseStart, phaseEnd);
+    phaseActive = false;
+
+    // The sampler collects on its own, collecting here completes the timeline up to the end of the phase
+    if (sampler) {
+        sampler->collect();
+    }
+
+    MetricsRegistry::getInstance()
+        .gauge("spear_self_energy_joules", "Energy consumed by SPEAR per analysis phase", {{"phase", currentPhase}})
+        .set(measurement.joules);
+}
+
+void SelfEnergyMeter::beginFunction(const std::string &functionName) {
+    if (!enabled) {
+        return;
+    }
+
+    endFunction();
+
+    std::lock_guard<std::mutex> lock(meterMutex);
+    if (!phaseActive) {
+        return;
+    }
+
+    currentFunction = functionName;
+    functionActive = true;
+    functionStart = read();
+}
+
+void SelfEnergyMeter::endFunction() {
+    if (!enabled) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(meterMutex);
+    if (!functionActive) {
+        return;
+    }
+
+    accumulate(phases[currentPhase].functions[currentFunction], functionStart, read());
+    functionActive = false;
+}
+
+void SelfEnergyMeter::stop() {
+    if (!enabled) {
+        return;
+    }
+
+    endPhase();
+
+    std::lock_guard<std::mutex> lock(meterMutex);
+    if (sampler) {
+        sampler->stop();
+    }
+}
+
+void SelfEnergyMeter::suspendSampler() {
+    std::lock_guard<std::mutex> lock(meterMutex);
+    if (sampler && sampler->isRunning()) {
+        sampler->stop();
+        samplerSuspended = true;
+    }
+}
+
+void SelfEnergyMeter::resumeSampler() {
+    std::lock_guard<std::mutex> lock(meterMutex);
+    if (sampler && samplerSuspended) {
+        sampler->start();
+        samplerSuspended = false;
+    }
+}
+
+void SelfEnergyMeter::reset() {
+    std::lock_guard<std::mutex> lock(meterMutex);
+    phases.clear();
+    phaseOrder.clear();
+    phaseActive = false;
+    functionActive = false;
+}
+
+void SelfEnergyMeter::merge(const nlohmann::json &measurements) {
+    if (!enabled || !measurements.contains("phases") || !measurements["phases"].is_array()) {
+        return;
+    }
+
+    auto addMeasurement = [](Measurement &measurement, const nlohmann::json &measurementJson) {
+        measurement.joules += measurementJson.value("joules", 0.0);
+        measurement.seconds += measurementJson.value("seconds", 0.0);
+        measurement.count += measurementJson.value("count", uint64_t{0});
+    };
+
+    std::lock_guard<std::mutex> lock(meterMutex);
+    for (const auto &phaseJson : measurements["phases"]) {
+        const std::string phaseName = phaseJson.value("phase", "");
+        if (phaseName.empty()) {
+            continue;
+        }
+
+        if (phases.find(phaseName) == phases.end()) {
+            phaseOrder.push_back(phaseName);
+        }
+
+        auto &phase = phases[phaseName];
+        addMeasurement(phase.total, phaseJson);
+
+        if (phaseJson.contains("functions") && phaseJson["functions"].is_object()) {
+            for (const auto &[functionName, functionJson] : phaseJson["functions"].items()) {
+                addMeasurement(phase.functions[functionName], functionJson);
+            }
+        }
+
+        MetricsRegistry::getInstance()
+            .gauge("spear_self_energy_joules", "Energy consumed by SPEAR per analysis phase", {{"phase", phaseName}})
+            .set(phase.total.joules);
+    }
+}
+
+nlohmann::json SelfEnergyMeter::timelineToJson() {
+    std::lock_guard<std::mutex> lock(meterMutex);
+    if (!sampler) {
+        return nullptr;
+    }
+
+    return sampler->toJson();
+}
+
+nlohmann::json SelfEnergyMeter::toJson() {
+    std::lock_guard<std::mutex> lock(meterMutex);
+
+    nlohmann::json output = nlohmann::json::object();
+    output["version"] = SPEAR_VERSION;
+    output["source"] = source ? source->getName() : "none";
+    output["sampled"] = sampler != nullptr;
+
+    auto measurementToJson = [](const Measurement &measurement) {
+        return nlohmann::json{{"joules", measurement.joules},
+                              {"seconds", measurement.seconds},
+                              {"count", measurement.count}};
+    };
+
+    // Totals per function over all phases, so the cost of a function can be compared across releases
+    std::map<std::string, Measurement> functionTotals;
+    double totalJoules = 0;
+    double totalSeconds = 0;
+
+    nlohmann::json phasesJson = nlohmann::json::array();
+    for (const auto &phaseName : phaseOrder) {
+        const auto &phase = phases[phaseName];
+
+        nlohmann::json phaseJson = measurementToJson(phase.total);
+        phaseJson["phase"] = phaseName;
+        totalJoules += phase.total.joules;
+        totalSeconds += phase.total.seconds;
+
+        if (!phase.functions.empty()) {
+            nlohmann::json functionsJson = nlohmann::json::object();
+            for (const auto &[functionName, measurement] : phase.functions) {
+                functionsJson[functionName] = measurementToJson(measurement);
+
+                auto &functionTotal = functionTotals[functionName];
+                functionTotal.joules += measurement.joules;
+                functionTotal.seconds += measurement.seconds;
+                functionTotal.count += measurement.count;
+            }
+            phaseJson["functions"] = functionsJson;
+        }
+
+        phasesJson.push_back(phaseJson);
+    }
+
+    output["phases"] = phasesJson;
+    output["joules"] = totalJoules;
+    output["seconds"] = totalSeconds;
+
+    nlohmann::json functionTotalsJson = nlohmann::json::object();
+    for (const auto &[functionName, measurement] : functionTotals) {
+        functionTotalsJson[functionName] = measurementToJson(measurement);
+    }
+    output["functions"] = functionTotalsJson;
+
+    return output;
+}
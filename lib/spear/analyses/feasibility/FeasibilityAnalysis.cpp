@@ -90,7 +90,11 @@ FeasibilityAnalysis::initialSeeds() {
     const d_t Zero = this->getZeroValue();
     l_t init = emptyElement();
 
-    if (this->EntryPoints.size() == 1 && this->EntryPoints[0] == "__ALL__") {
+    if (this->seedFunction) {
+        for (n_t SP : ICFG->getStartPointsOf(this->seedFunction)) {
+            Seeds.addSeed(SP, Zero, init);
+        }
+    } else if (this->EntryPoints.size() == 1 && this->EntryPoints[0] == "__ALL__") {
         // Add seeds for all entry points
         for (auto func : this->IRDB->getAllFunctions()) {
             if (!func || func->isDeclaration()) {
@@ -200,6 +204,19 @@ FeasibilityAnalysis::getNormalEdgeFunction(n_t curr, d_t currNode, n_t succ, d_t
         return EF(std::in_place_type<psr::EdgeIdentity<l_t>>);
     }
 
+    /**
+     * Switches constrain their condition on every outgoing edge. All case values leading to the successor are
+     * encoded as one atom of merged value ranges, the default edge as the complement of all other cases. A switch
+     * with hundreds of cases thereby adds a single atom per edge.
+     */
+    if (auto *switchInst = llvm::dyn_cast<llvm::SwitchInst>(curr)) {
+        if (!switchInst->getCondition()->getType()->isIntegerTy()) {
+            return EF(std::in_place_type<psr::EdgeIdentity<l_t>>);
+        }
+
+        return EF(std::in_place_type<FeasibilityAddAtomsEF>, localManager, CurrBB, SuccBB, switchInst);
+    }
+
     // We only care about branch conditions for pruning everything else is identity.
     auto *br = llvm::dyn_cast<llvm::BranchInst>(curr);
     if (!br) {
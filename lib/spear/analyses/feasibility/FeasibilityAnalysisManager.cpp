@@ -10,8 +10,13 @@
 #include <utility>
 #include <vector>
 #include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
 
 #include "analyses/feasibility/FeasibilityAnalysisManager.h"
+#include "Logger.h"
+#include "MetricsRegistry.h"
 
 namespace Feasibility {
 
@@ -61,9 +66,16 @@ uint32_t FeasibilityAnalysisManager::internSet(const ExprSet &set) {
     }
 
     // If we did not find a valid candidate, we need to add the new set to the manager and cache it.
-    // We add it to the end of the set storage and return the new ID.
-    const uint32_t newId = static_cast<uint32_t>(Sets.size());
-    Sets.push_back(set);
+    // A released slot is reused first, otherwise the set is added to the end of the set storage.
+    uint32_t newId;
+    if (!FreeSetIds.empty()) {
+        newId = FreeSetIds.back();
+        FreeSetIds.pop_back();
+        Sets[newId] = set;
+    } else {
+        newId = static_cast<uint32_t>(Sets.size());
+        Sets.push_back(set);
+    }
     CanonicalSetCache.emplace(key, newId);
 
     return newId;
@@ -81,6 +93,17 @@ uint32_t FeasibilityAnalysisManager::addAtom(uint32_t baseId, const z3::expr &at
   return internSet(S);
 }
 
+uint32_t FeasibilityAnalysisManager::addAtoms(uint32_t baseId, const std::vector<z3::expr> &atoms) {
+  // Ignore bottom and edges without atoms
+  if (baseId == FeasibilityElement::bottomId || atoms.empty()) {
+    return baseId;
+  }
+
+  ExprSet S = getSet(baseId);
+  S.insert(atoms.begin(), atoms.end());
+  return internSet(S);
+}
+
 uint32_t FeasibilityAnalysisManager::intersect(uint32_t aId, uint32_t bId) {
   // If either set is top (empty set of formulas), the result is the other set, as top is neutral for intersection.
   if (aId == FeasibilityElement::topId || bId == FeasibilityElement::topId) {
@@ -123,13 +146,20 @@ const llvm::Value *FeasibilityAnalysisManager::lookupEnv(uint32_t envId, const l
     return nullptr;
   }
 
+  EnvLookups.fetch_add(1, std::memory_order_relaxed);
+
   // Start at the env root corresponding to envId and iterate up the parent chain to find a binding for the given key.
+  uint64_t visitedNodes = 0;
   for (auto *n = EnvRoots[envId]; n; n = n->parent) {
-    if (n->key == key) {
-      return n->val;
+    visitedNodes++;
+    if (const llvm::Value *bound = n->find(key)) {
+      EnvVisitedNodes.fetch_add(visitedNodes, std::memory_order_relaxed);
+      return bound;
     }
   }
 
+  EnvVisitedNodes.fetch_add(visitedNodes, std::memory_order_relaxed);
+
   // If the iteration completes without finding a binding for the key,
   // we return nullptr to indicate that no binding was found in this environment.
   return nullptr;
@@ -260,6 +290,10 @@ uint32_t FeasibilityAnalysisManager::extendEnv(uint32_t baseEnvId, const llvm::V
     return baseEnvId;
   }
 
+  return extendEnvBindings(baseEnvId, EnvBindings{{key, val}});
+}
+
+uint32_t FeasibilityAnalysisManager::extendEnvBindings(uint32_t baseEnvId, EnvBindings bindings) {
   // Make sure the empty environment is initialized and handle out-of-bounds envId by treating it as the empty
   // environment.
   ensureEnvZeroInitialized();
@@ -270,13 +304,32 @@ uint32_t FeasibilityAnalysisManager::extendEnv(uint32_t baseEnvId, const llvm::V
     baseEnvId = 0;
   }
 
-  // Avoid pointless self-bindings
-  if (key == val) {
+  // Avoid pointless self-bindings and invalid bindings
+  llvm::erase_if(bindings, [](const EnvBinding &binding) {
+    return !binding.first || !binding.second || binding.first == binding.second;
+  });
+
+  if (bindings.empty()) {
     return baseEnvId;
   }
 
+  // Sort by key so lookups can use a binary search and equal binding sets produce equal cache keys. The stable sort
+  // keeps the insertion order of duplicate keys, of which the last one wins
+  std::stable_sort(bindings.begin(), bindings.end(),
+                   [](const EnvBinding &a, const EnvBinding &b) { return a.first < b.first; });
+
+  EnvBindings unique;
+  unique.reserve(bindings.size());
+  for (const auto &binding : bindings) {
+    if (!unique.empty() && unique.back().first == binding.first) {
+      unique.back() = binding;
+    } else {
+      unique.push_back(binding);
+    }
+  }
+
   // Cache to prevent envId explosion
-  EnvKey ek{baseEnvId, key, val};
+  EnvKey ek{baseEnvId, unique};
 
   std::lock_guard<std::mutex> L(EnvInternMu);
 
@@ -286,12 +339,21 @@ uint32_t FeasibilityAnalysisManager::extendEnv(uint32_t baseEnvId, const llvm::V
   }
 
   // Add a new environment node to the environment storage, which extends the environment represented by
-  // baseEnvId with the new binding from key to val.
-  EnvPool.push_back(EnvNode{EnvRoots[baseEnvId], key, val});
-  EnvRoots.push_back(&EnvPool.back());
-
-  // Get the newest id
-  const uint32_t newId = static_cast<uint32_t>(EnvRoots.size() - 1);
+  // baseEnvId with the new bindings.
+  // A released node is overwritten in place, its root pointer stays valid.
+  const EnvNode *parent = EnvRoots[baseEnvId];
+  EnvNode node{parent, baseEnvId, std::move(unique), parent ? parent->depth + 1 : 1};
+
+  uint32_t newId;
+  if (!FreeEnvIds.empty()) {
+    newId = FreeEnvIds.back();
+    FreeEnvIds.pop_back();
+    EnvPool[newId - 1] = std::move(node);
+  } else {
+    EnvPool.push_back(std::move(node));
+    EnvRoots.push_back(&EnvPool.back());
+    newId = static_cast<uint32_t>(EnvRoots.size() - 1);
+  }
 
   // Add the new environment to the cache and return the new ID.
   EnvCache.emplace(ek, newId);
@@ -322,7 +384,8 @@ uint32_t FeasibilityAnalysisManager::applyPhiPack(uint32_t inEnvId,
     return inEnvId;
   }
 
-  uint32_t env = inEnvId;
+  // Collect the bindings of all PHIs of the edge and install them as a single environment node
+  EnvBindings bindings;
 
   // Iterate PHIs at top of succ
   for (auto &I : *succ) {
@@ -340,10 +403,11 @@ uint32_t FeasibilityAnalysisManager::applyPhiPack(uint32_t inEnvId,
 
     // Resolve the incoming value in the current environment to apply any existing bindings.
     const llvm::Value *incoming = phi->getIncomingValue(idx);
-    // Resole the incoming value in the current environment to apply any existing bindings.
+    // Resole the incoming value in the input environment to apply any existing bindings.
     // This is important to ensure that we correctly handle cases where the incoming value is itself
     // defined by a PHI node or has bindings in the current environment that need to be applied.
-    incoming = resolve(env, incoming);
+    // PHIs of the same block do not see each other's new values, so none of the edge's bindings are visible here.
+    incoming = resolve(inEnvId, incoming);
 
     // Avoid phi -> phi cycles
     if (incoming == phi) {
@@ -351,18 +415,214 @@ uint32_t FeasibilityAnalysisManager::applyPhiPack(uint32_t inEnvId,
     }
 
     // If already bound to same incoming, skip
-    if (const llvm::Value *existing = lookupEnv(env, phi)) {
+    if (const llvm::Value *existing = lookupEnv(inEnvId, phi)) {
       if (existing == incoming) {
         continue;
       }
     }
 
-    // Otherwise extend the environment with the new binding from the phi node to the incoming value and update
-    // the current environment ID.
-    env = extendEnv(env, phi, incoming);
+    bindings.emplace_back(phi, incoming);
+  }
+
+  // Extend the environment with the bindings from the phi nodes to their incoming values
+  return extendEnvBindings(inEnvId, std::move(bindings));
+}
+
+std::vector<SwitchCaseRange> FeasibilityAnalysisManager::compressCaseValues(std::vector<llvm::APInt> values) {
+  std::vector<SwitchCaseRange> ranges;
+  if (values.empty()) {
+    return ranges;
+  }
+
+  // Bit vectors are compared unsigned, so the ranges are built in unsigned order as well
+  std::sort(values.begin(), values.end(), [](const llvm::APInt &a, const llvm::APInt &b) { return a.ult(b); });
+
+  ranges.push_back({values.front(), values.front()});
+  for (size_t i = 1; i < values.size(); ++i) {
+    SwitchCaseRange &last = ranges.back();
+
+    // Duplicates and direct successors extend the current range. The maximal value has no successor, so the
+    // increment cannot wrap here
+    if (values[i] == last.high || (!last.high.isMaxValue() && values[i] == last.high + 1)) {
+      last.high = values[i];
+      continue;
+    }
+
+    ranges.push_back({values[i], values[i]});
+  }
+
+  return ranges;
+}
+
+const SwitchEdgeRanges &FeasibilityAnalysisManager::getSwitchRanges(const llvm::SwitchInst *switchInst,
+                                                                    const llvm::BasicBlock *succ) {
+  std::lock_guard<std::mutex> L(SwitchRangeMutex);
+
+  auto [it, inserted] = SwitchRangeCache.try_emplace({switchInst, succ});
+  if (!inserted) {
+    return it->second;
+  }
+
+  // The default edge is taken for every value that no case leads to another block. A case leading to the default
+  // block itself does not change the edge condition
+  const bool isDefault = switchInst->getDefaultDest() == succ;
+
+  std::vector<llvm::APInt> values;
+  for (const auto &switchCase : switchInst->cases()) {
+    const bool leadsToSucc = switchCase.getCaseSuccessor() == succ;
+    if (leadsToSucc != isDefault) {
+      values.push_back(switchCase.getCaseValue()->getValue());
+    }
+  }
+
+  SwitchEdgeRanges &entry = it->second;
+  entry.complement = isDefault;
+  entry.caseCount = values.size();
+  entry.ranges = compressCaseValues(std::move(values));
+
+  return entry;
+}
+
+EnvironmentStatistics FeasibilityAnalysisManager::getEnvironmentStatistics() const {
+  EnvironmentStatistics statistics;
+
+  {
+    std::lock_guard<std::mutex> L(EnvInternMu);
+    statistics.environments = EnvPool.size() - FreeEnvIds.size();
+
+    for (const EnvNode &node : EnvPool) {
+      statistics.bindings += node.bindings.size();
+      statistics.maxDepth = std::max(statistics.maxDepth, node.depth);
+    }
+  }
+
+  statistics.lookups = EnvLookups.load(std::memory_order_relaxed);
+  statistics.visitedNodes = EnvVisitedNodes.load(std::memory_order_relaxed);
+  return statistics;
+}
+
+void FeasibilityAnalysisManager::logEnvironmentStatistics() const {
+  const EnvironmentStatistics statistics = getEnvironmentStatistics();
+  if (statistics.environments == 0) {
+    return;
+  }
+
+  auto &registry = MetricsRegistry::getInstance();
+  registry.gauge("spear_feasibility_env_max_depth", "Longest chain of feasibility environment nodes")
+      .setMax(static_cast<double>(statistics.maxDepth));
+  registry.counter("spear_feasibility_env_lookups", "Lookups in feasibility environments").inc(statistics.lookups);
+  registry.counter("spear_feasibility_env_visited_nodes", "Environment nodes searched by the lookups")
+      .inc(statistics.visitedNodes);
+
+  const double nodesPerLookup = statistics.lookups > 0
+      ? static_cast<double>(statistics.visitedNodes) / static_cast<double>(statistics.lookups)
+      : 0.0;
+
+  Logger::getInstance().log("Feasibility environments: " + std::to_string(statistics.environments) + " with " +
+                                    std::to_string(statistics.bindings) + " bindings, max depth " +
+                                    std::to_string(statistics.maxDepth) + ", " +
+                                    std::to_string(statistics.lookups) + " lookups visiting " +
+                                    std::to_string(nodesPerLookup) + " nodes on average",
+                            LOGLEVEL::INFO);
+}
+
+size_t FeasibilityAnalysisManager::getStoredSetCount() const {
+  std::lock_guard<std::mutex> SetLock(SetsMutex);
+  return Sets.size() - FreeSetIds.size() - (FeasibilityElement::bottomId + 1);
+}
+
+PoolCollectionStatistics FeasibilityAnalysisManager::collectGarbage(
+    const std::vector<FeasibilityElement> &liveElements) {
+  const auto start = std::chrono::steady_clock::now();
+  PoolCollectionStatistics statistics;
+
+  std::lock_guard<std::mutex> SetLock(SetsMutex);
+  std::lock_guard<std::mutex> EnvLock(EnvInternMu);
+  ensureEnvZeroInitialized();
+
+  // Mark. Top, bottom and the empty environment are never released
+  std::vector<bool> liveSets(Sets.size(), false);
+  std::vector<bool> liveEnvs(EnvRoots.size(), false);
+  liveSets[FeasibilityElement::topId] = true;
+  liveSets[FeasibilityElement::bottomId] = true;
+  liveEnvs[0] = true;
+
+  for (const FeasibilityElement &element : liveElements) {
+    if (element.getManager() != this) {
+      continue;
+    }
+
+    if (element.getFormulaId() < liveSets.size()) {
+      liveSets[element.getFormulaId()] = true;
+    }
+
+    // Lookups walk the parent chain, so all environments below a live one stay alive
+    for (uint32_t env = element.getEnvId(); env < liveEnvs.size() && !liveEnvs[env]; env = EnvPool[env - 1].parentId) {
+      liveEnvs[env] = true;
+    }
+  }
+
+  // Sweep the sets. Released slots are empty, interned sets never are
+  for (uint32_t id = FeasibilityElement::bottomId + 1; id < Sets.size(); ++id) {
+    if (Sets[id].empty()) {
+      continue;
+    }
+
+    statistics.sets++;
+    if (!liveSets[id]) {
+      statistics.reclaimedSets++;
+      statistics.reclaimedAtoms += Sets[id].size();
+      Sets[id].clear();
+      FreeSetIds.push_back(id);
+    }
+  }
+
+  for (auto it = CanonicalSetCache.begin(); it != CanonicalSetCache.end();) {
+    it = liveSets[it->second] ? std::next(it) : CanonicalSetCache.erase(it);
+  }
+
+  // Sweep the environments. Released nodes have no bindings, created nodes always have some
+  for (uint32_t id = 1; id < EnvRoots.size(); ++id) {
+    EnvNode &node = EnvPool[id - 1];
+    if (node.bindings.empty()) {
+      continue;
+    }
+
+    statistics.environments++;
+    if (!liveEnvs[id]) {
+      statistics.reclaimedEnvironments++;
+      node = EnvNode{};
+      FreeEnvIds.push_back(id);
+    }
+  }
+
+  for (auto it = EnvCache.begin(); it != EnvCache.end();) {
+    it = liveEnvs[it->second] ? std::next(it) : EnvCache.erase(it);
   }
 
-  return env;
+  // Hand out the lowest ids first, keeping the storage dense
+  std::sort(FreeSetIds.begin(), FreeSetIds.end(), std::greater<>());
+  std::sort(FreeEnvIds.begin(), FreeEnvIds.end(), std::greater<>());
+
+  statistics.durationUs = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+  LastCollection = statistics;
+
+  auto &registry = MetricsRegistry::getInstance();
+  registry.counter("spear_feasibility_sets_reclaimed", "Feasibility formula sets released after solving")
+      .inc(statistics.reclaimedSets);
+  registry.counter("spear_feasibility_envs_reclaimed", "Feasibility environments released after solving")
+      .inc(statistics.reclaimedEnvironments);
+
+  Logger::getInstance().log("Feasibility pools: released " + std::to_string(statistics.reclaimedSets) + " of " +
+                                    std::to_string(statistics.sets) + " sets holding " +
+                                    std::to_string(statistics.reclaimedAtoms) + " atoms and " +
+                                    std::to_string(statistics.reclaimedEnvironments) + " of " +
+                                    std::to_string(statistics.environments) + " environments in " +
+                                    std::to_string(statistics.durationUs) + " µs",
+                            LOGLEVEL::INFO);
+
+  return statistics;
 }
 
 FeasibilityAnalysisManager::SetKey FeasibilityAnalysisManager::makeSetKey(const ExprSet &set) const {
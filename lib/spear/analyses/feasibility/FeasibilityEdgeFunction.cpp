@@ -4,6 +4,7 @@
  */
 
 #include <utility>
+#include <vector>
 
 #include "analyses/feasibility/FeasibilityEdgeFunction.h"
 #include "analyses/feasibility/FeasibilityAnalysisManager.h"
@@ -105,10 +106,15 @@ l_t FeasibilityAddAtomsEF::computeTarget(const l_t &source) const {
   uint32_t env = source.getEnvId();
   uint32_t pc  = source.getFormulaId();
 
+  // The atoms are added together, so no set is interned for the path condition in between two atoms
+  std::vector<z3::expr> newAtoms;
+  newAtoms.reserve(atoms.size());
+
   // Iterate over the atoms
   for (const auto &singleAtom : atoms) {
-    // If the atom does not have an associated ICmp instruction, we cannot create a constraint for it, so we skip it.
-    if (!singleAtom.icmp) {
+    // If the atom does not have an associated ICmp or switch instruction, we cannot create a constraint for it, so we
+    // skip it.
+    if (!singleAtom.icmp && !singleAtom.switchInst) {
       // This case should never occur
       continue;
     }
@@ -120,10 +126,14 @@ l_t FeasibilityAddAtomsEF::computeTarget(const l_t &source) const {
     }
 
     // Create a new atomic expression
-    z3::expr atom = Util::createConstraintFromICmp(manager, singleAtom.icmp, singleAtom.TrueEdge, env);
-    pc = manager->addAtom(pc, atom);
+    z3::expr atom = singleAtom.switchInst
+        ? Util::createConstraintFromSwitch(manager, singleAtom.switchInst, singleAtom.SuccBB, env)
+        : Util::createConstraintFromICmp(manager, singleAtom.icmp, singleAtom.TrueEdge, env);
+    newAtoms.push_back(atom);
   }
 
+  pc = manager->addAtoms(pc, newAtoms);
+
   // If the resulting element is the same as the Top element (empty set of formulas), we return an
   // explicit Empty element to represent this.
   if (pc == l_t::topId) {
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "analyses/feasibility/FeasibilityPortfolio.h"
+#include "Logger.h"
+#include "MetricsRegistry.h"
+
+namespace Feasibility {
+
+const std::vector<std::string> SatPortfolio::portfolioConfigurations = {
+    "seed-1",
+    "seed-2",
+    "qfbv",
+    "bitblast",
+};
+
+std::mutex SatPortfolio::statisticsMutex;
+std::vector<int64_t> SatPortfolio::latencies;
+size_t SatPortfolio::recordedQueries = 0;
+int64_t SatPortfolio::maxLatency = 0;
+size_t SatPortfolio::escalatedQueries = 0;
+
+bool SatPortfolio::isSat(const std::vector<z3::expr> &set, z3::context *ctx,
+                         const SatPortfolioConfiguration &configuration) {
+    auto queryStart = std::chrono::high_resolution_clock::now();
+
+    const unsigned initialBudget = configuration.enabled ? configuration.initialBudget : 0;
+    z3::check_result result = checkDefault(set, ctx, initialBudget);
+
+    // Only queries that ran into the initial budget are escalated
+    const bool escalated = configuration.enabled && result == z3::unknown;
+    if (escalated) {
+        result = checkPortfolio(set, ctx, configuration.portfolioBudget);
+    }
+
+    auto queryEnd = std::chrono::high_resolution_clock::now();
+    recordLatency(std::chrono::duration_cast<std::chrono::microseconds>(queryEnd - queryStart).count(), escalated);
+
+    // Only a proof of unsatisfiability makes a set infeasible, an unknown result has to be treated as feasible
+    return result != z3::unsat;
+}
+
+z3::check_result SatPortfolio::checkDefault(const std::vector<z3::expr> &set, z3::context *ctx, unsigned timeout) {
+    z3::solver solver(*ctx);
+    if (timeout > 0) {
+        solver.set("timeout", timeout);
+    }
+
+    for (const auto &atom : set) {
+        solver.add(atom);
+    }
+
+    return solver.check();
+}
+
+z3::solver SatPortfolio::makeSolver(const std::string &configuration, z3::context &ctx) {
+    if (configuration == "qfbv") {
+        return z3::tactic(ctx, "qfbv").mk_solver();
+    }
+
+    if (configuration == "bitblast") {
+        return (z3::tactic(ctx, "simplify") & z3::tactic(ctx, "bit-blast") & z3::tactic(ctx, "sat")).mk_solver();
+    }
+
+    // Default solver with a different random seed
+    z3::solver solver(ctx);
+    solver.set("random_seed", configuration == "seed-2" ? 2U : 1U);
+    return solver;
+}
+
+z3::check_result SatPortfolio::checkPortfolio(const std::vector<z3::expr> &set, z3::context *ctx, unsigned timeout) {
+    const size_t configurationCount = portfolioConfigurations.size();
+
+    // Translate the formulas into one context per configuration. This has to happen before the threads are started,
+    // as the source context must not be accessed concurrently
+    z3::expr_vector sourceSet(*ctx);
+    for (const auto &atom : set) {
+        sourceSet.push_back(atom);
+    }
+
+    std::vector<std::unique_ptr<z3::context>> contexts;
+    std::vector<z3::solver> solvers;
+    contexts.reserve(configurationCount);
+    solvers.reserve(configurationCount);
+
+    for (const auto &configuration : portfolioConfigurations) {
+        contexts.push_back(std::make_unique<z3::context>());
+        z3::expr_vector translatedSet(*contexts.back(), sourceSet);
+
+        solvers.push_back(makeSolver(configuration, *contexts.back()));
+        if (timeout > 0) {
+            solvers.back().set("timeout", timeout);
+        }
+        for (unsigned atomIndex = 0; atomIndex < translatedSet.size(); ++atomIndex) {
+            solvers.back().add(translatedSet[atomIndex]);
+        }
+    }
+
+    // Guards answered and started, so a configuration either starts before the winner interrupts it or not at all
+    std::mutex answerMutex;
+    bool answered = false;
+    std::vector<bool> started(configurationCount, false);
+    std::atomic<int> winner{-1};
+    std::vector<z3::check_result> results(configurationCount, z3::unknown);
+
+    std::vector<std::thread> threads;
+    threads.reserve(configurationCount);
+
+    for (size_t configurationIndex = 0; configurationIndex < configurationCount; ++configurationIndex) {
+        threads.emplace_back([&, configurationIndex]() {
+            // Another configuration may have answered before this thread got scheduled
+            {
+                std::lock_guard<std::mutex> lock(answerMutex);
+                if (answered) {
+                    return;
+                }
+                started[configurationIndex] = true;
+            }
+
+            z3::check_result result = z3::unknown;
+            try {
+                result = solvers[configurationIndex].check();
+            } catch (const z3::exception &) {
+                // Interrupted or unsupported by this configuration, the other configurations decide
+                result = z3::unknown;
+            }
+
+            results[configurationIndex] = result;
+            if (result == z3::unknown) {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(answerMutex);
+            if (answered) {
+                return;
+            }
+
+            // First answer wins, cancel all other configurations. A configuration interrupted between its start and
+            // its check() is still bounded by the timeout
+            answered = true;
+            winner = static_cast<int>(configurationIndex);
+            for (size_t otherIndex = 0; otherIndex < configurationCount; ++otherIndex) {
+                if (otherIndex != configurationIndex && started[otherIndex]) {
+                    contexts[otherIndex]->interrupt();
+                }
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    if (winner < 0) {
+        return z3::unknown;
+    }
+
+    return results[winner];
+}
+
+void SatPortfolio::recordLatency(int64_t latency, bool escalated) {
+    static Histogram &queryLatency = MetricsRegistry::getInstance().histogram(
+        "spear_z3_query_seconds", "Latency of the Z3 feasibility queries", Histogram::exponentialBuckets(1e-5, 4, 12));
+    static Counter &escalatedCounter = MetricsRegistry::getInstance().counter(
+        "spear_z3_escalated_queries", "Z3 queries escalated to the solver portfolio");
+
+    queryLatency.observe(static_cast<double>(latency) * 1e-6);
+    if (escalated) {
+        escalatedCounter.inc();
+    }
+
+    // Reservoir sampling keeps a uniform sample of all latencies in constant memory
+    static std::mt19937_64 generator(0);
+
+    std::lock_guard<std::mutex> lock(statisticsMutex);
+    recordedQueries++;
+    maxLatency = std::max(maxLatency, latency);
+    if (latencies.size() < latencySampleSize) {
+        latencies.push_back(latency);
+    } else {
+        std::uniform_int_distribution<size_t> distribution(0, recordedQueries - 1);
+        const size_t slot = distribution(generator);
+        if (slot < latencySampleSize) {
+            latencies[slot] = latency;
+        }
+    }
+    if (escalated) {
+        escalatedQueries++;
+    }
+}
+
+SatLatencyReport SatPortfolio::getLatencyReport() {
+    std::vector<int64_t> sortedLatencies;
+    SatLatencyReport report{0, 0, 0, 0, 0};
+
+    {
+        std::lock_guard<std::mutex> lock(statisticsMutex);
+        sortedLatencies = latencies;
+        report.queries = recordedQueries;
+        report.max = maxLatency;
+        report.escalatedQueries = escalatedQueries;
+    }
+
+    if (sortedLatencies.empty()) {
+        return report;
+    }
+
+    std::sort(sortedLatencies.begin(), sortedLatencies.end());
+
+    // Nearest rank percentiles
+    auto percentile = [&sortedLatencies](double fraction) {
+        auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sortedLatencies.size())));
+        rank = std::clamp<size_t>(rank, 1, sortedLatencies.size());
+        return sortedLatencies[rank - 1];
+    };
+
+    report.median = percentile(0.5);
+    report.p99 = percentile(0.99);
+    return report;
+}
+
+void SatPortfolio::logLatencyReport() {
+    const SatLatencyReport report = getLatencyReport();
+    if (report.queries == 0) {
+        return;
+    }
+
+    Logger::getInstance().log("Feasibility queries: " + std::to_string(report.queries) + " (" +
+                                      std::to_string(report.escalatedQueries) + " escalated to portfolio), median: " +
+                                      std::to_string(report.median) + "µs, p99: " + std::to_string(report.p99) +
+                                      "µs, max: " + std::to_string(report.max) + "µs",
+                              LOGLEVEL::INFO);
+}
+
+}  // namespace Feasibility
@@ -7,13 +7,21 @@
 #include <phasar/DataFlow/IfdsIde/IDETabulationProblem.h>
 #include <phasar/PhasarLLVM/DB/LLVMProjectIRDB.h>
 #include <llvm/Support/raw_ostream.h>
+#include <sys/resource.h>
 
+#include <algorithm>
+#include <chrono>
+#include <string>
 #include <utility>
 #include <memory>
+#include <vector>
 
 #include "analyses/feasibility/FeasibilityWrapper.h"
 #include "analyses/feasibility/FeasibilityAnalysis.h"
 #include "analyses/feasibility/util.h"
+#include "Logger.h"
+#include "ProgressReporter.h"
+#include "SelfEnergyMeter.h"
 
 Feasibility::FeasibilityWrapper::FeasibilityWrapper(std::shared_ptr<psr::HelperAnalyses> helperAnalyses,
                                                     llvm::FunctionAnalysisManager *analysisManager) {
@@ -44,16 +52,80 @@ Feasibility::FeasibilityWrapper::FeasibilityWrapper(std::shared_ptr<psr::HelperA
         llvm::errs() << Util::debugtag << " Starting IDESolver.solve()\n";
     }
 
-    // Solve the analysis problem using the IDE solver and store the results in the cachedResults member variable.
-    auto analysisResult = psr::solveIDEProblem(*this->problem.get(), interproceduralCFG);
-    // Query the result of the analysis
-    this->cachedResults = std::make_unique<ResultsTy>(std::move(analysisResult));
+    // No facts cross call edges, so every function is solved on its own. The tables of the solver are released
+    // before the next function is solved and only the values at the terminators, which are all the queries need,
+    // are kept. This allows to compact the pools between functions instead of once after the whole module.
+    auto solveStart = std::chrono::steady_clock::now();
+    this->cachedResults = std::make_unique<ResultsTy>();
+    auto *manager = this->problem->getManager();
+    const llvm::Value *zero = this->problem->getZeroValue();
+    size_t setsAfterCollection = 0;
+    size_t solvedFunctions = 0;
+
+    const auto definedFunctions = std::count_if(module->begin(), module->end(), [](const llvm::Function &function) {
+        return !function.isDeclaration();
+    });
+    ProgressPhase progress("feasibility solve", "functions", static_cast<uint64_t>(definedFunctions));
+
+    for (const llvm::Function &function : *module) {
+        if (function.isDeclaration()) {
+            continue;
+        }
+
+        // Solving and collecting are attributed to the function in the self-energy report
+        SelfEnergyFunction selfEnergyFunction(function.getName().str());
+        this->problem->setSeedFunction(&function);
+        auto analysisResult = psr::solveIDEProblem(*this->problem, interproceduralCFG);
+        solvedFunctions++;
+        ProgressReporter::getInstance().advance();
+
+        for (const llvm::BasicBlock &block : function) {
+            const llvm::Instruction *terminator = block.getTerminator();
+            if (terminator == nullptr) {
+                continue;
+            }
+
+            // Blocks the zero value never reached get no entry and are reported as infeasible
+            auto valuesAtTerminator = analysisResult.resultsAt(terminator);
+            auto zeroIterator = valuesAtTerminator.find(zero);
+            if (zeroIterator != valuesAtTerminator.end()) {
+                this->cachedResults->emplace(terminator, zeroIterator->second);
+            }
+        }
+
+        // Collect whenever the pools doubled since the last collection, keeping the total cost linear
+        if (manager->getStoredSetCount() > std::max<size_t>(2 * setsAfterCollection, minimumCollectionSets)) {
+            collectGarbage();
+            setsAfterCollection = manager->getStoredSetCount();
+        }
+    }
+
+    this->problem->setSeedFunction(nullptr);
+    collectGarbage();
+
+    rusage usage{};
+    const long peakRssKiB = getrusage(RUSAGE_SELF, &usage) == 0 ? usage.ru_maxrss : 0;
+    auto solveDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                                               solveStart);
+    Logger::getInstance().log("Feasibility analysis solved " + std::to_string(solvedFunctions) + " functions in " +
+                                      std::to_string(solveDuration.count()) + " ms, peak RSS " +
+                                      std::to_string(peakRssKiB / 1024) + " MiB",
+                              LOGLEVEL::INFO);
 
     if (Util::F_DebugEnabled) {
         llvm::errs() << Util::debugtag << " Finished IDESolver.solve()\n";
     }
 }
 
+void Feasibility::FeasibilityWrapper::collectGarbage() {
+    std::vector<FeasibilityElement> liveElements;
+    liveElements.reserve(this->cachedResults->size());
+    for (const auto &[terminator, element] : *this->cachedResults) {
+        liveElements.push_back(element);
+    }
+    this->problem->getManager()->collectGarbage(liveElements);
+}
+
 std::unique_ptr<Feasibility::ResultsTy> Feasibility::FeasibilityWrapper::getResults() const {
     return std::make_unique<ResultsTy>(*this->cachedResults);
 }
@@ -12,9 +12,12 @@
 #include <string>
 #include <vector>
 
+#include "ConfigParser.h"
+#include "MetricsRegistry.h"
 #include "analyses/feasibility/FeasibilityAnalysis.h"
 #include "analyses/feasibility/FeasibilityAnalysisManager.h"
 #include "analyses/feasibility/FeasibilityEdgeFunction.h"
+#include "analyses/feasibility/FeasibilityPortfolio.h"
 #include "analyses/feasibility/FeasibilitySetSatness.h"
 
 namespace Feasibility {
@@ -238,18 +241,68 @@ z3::expr Util::createConstraintFromICmp(FeasibilityAnalysisManager *manager,
     return cmp;
 }
 
+z3::expr Util::createConstraintFromSwitch(FeasibilityAnalysisManager *manager,
+                                          const llvm::SwitchInst *switchInst,
+                                          const llvm::BasicBlock *succ,
+                                          uint32_t envId) {
+    static Counter &caseCounter = MetricsRegistry::getInstance().counter(
+        "spear_feasibility_switch_cases", "Switch case values encoded into feasibility atoms");
+    static Counter &rangeCounter = MetricsRegistry::getInstance().counter(
+        "spear_feasibility_switch_ranges", "Value ranges the switch case values were merged into");
+
+    z3::context &context = manager->getContext();
+
+    if (!manager->hasEnv(envId)) {
+        // Same as for ICmps: do not constrain instead of crashing
+        return context.bool_val(true);
+    }
+
+    auto condition = createBitVal(manager->resolve(envId, switchInst->getCondition()), &context);
+    if (!condition) {
+        return context.bool_val(true);
+    }
+
+    const SwitchEdgeRanges &edge = manager->getSwitchRanges(switchInst, succ);
+    caseCounter.inc(edge.caseCount);
+    rangeCounter.inc(edge.ranges.size());
+
+    return createConstraintFromRanges(context, *condition, edge);
+}
+
+z3::expr Util::createConstraintFromRanges(z3::context &context, const z3::expr &condition,
+                                          const SwitchEdgeRanges &edge) {
+    // A value lies in [low, high] iff (value - low) <=u (high - low), so every range is one comparison
+    const unsigned bitwidth = condition.get_sort().bv_size();
+    auto makeValue = [&context, bitwidth](const llvm::APInt &value) {
+        // Conditions may be wider than 64 bits, go through the decimal representation
+        return context.bv_val(llvm::toString(value, 10, false).c_str(), bitwidth);
+    };
+
+    z3::expr_vector inRange(context);
+    for (const SwitchCaseRange &range : edge.ranges) {
+        const z3::expr low = makeValue(range.low);
+
+        if (range.low == range.high) {
+            inRange.push_back(condition == low);
+        } else {
+            inRange.push_back(z3::ule(condition - low, makeValue(range.high - range.low)));
+        }
+    }
+
+    // An empty union is false: a case edge without values cannot happen, a default edge without other cases is
+    // always taken
+    const z3::expr anyRange = inRange.empty() ? context.bool_val(false) : z3::mk_or(inRange);
+    return edge.complement ? !anyRange : anyRange;
+}
+
 bool Util::setSat(std::vector<z3::expr> set, z3::context *ctx) {
     if  (set.empty()) {
         // An empty set represents the formula "true", which is satisfiable.
         return true;
     }
 
-    z3::solver solver(*ctx);
-    for (const auto &atom : set) {
-        solver.add(atom);
-    }
-
-    return solver.check() == z3::sat;
+    // Read on every query, so an overridden configuration (e.g. of a degraded worker) takes effect immediately
+    return SatPortfolio::isSat(set, ctx, ConfigParser::getSatPortfolioConfiguration());
 }
 
 
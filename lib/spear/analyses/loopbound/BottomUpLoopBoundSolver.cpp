@@ -0,0 +1,493 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <llvm/ADT/SCCIterator.h>
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/Analysis/CallGraph.h>
+#include <llvm/IR/InstIterator.h>
+
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ProgressReporter.h"
+#include "analyses/loopbound/BottomUpLoopBoundSolver.h"
+#include "analyses/loopbound/util.h"
+
+LoopBound::BottomUpLoopBoundSolver::BottomUpLoopBoundSolver(LoopBoundIDEAnalysis &problem,
+                                                            psr::LLVMBasedICFG &interproceduralCFG,
+                                                            llvm::Module &module)
+    : problem(problem) {
+    collectSeeds();
+    collectCallees(interproceduralCFG, module);
+    orderComponents(module);
+    collectCounters();
+}
+
+void LoopBound::BottomUpLoopBoundSolver::collectSeeds() {
+    for (const auto &[node, factsAtNode] : problem.initialSeeds().getSeeds()) {
+        if (!node) {
+            continue;
+        }
+
+        seedNodes.insert(node);
+
+        for (const auto &[fact, value] : factsAtNode) {
+            // The zero value carries no information for any loop counter
+            if (!problem.isZeroValue(fact)) {
+                counterSeeds[fact].push_back({node, value});
+            }
+        }
+    }
+}
+
+void LoopBound::BottomUpLoopBoundSolver::collectCallees(psr::LLVMBasedICFG &interproceduralCFG,
+                                                        llvm::Module &module) {
+    for (const llvm::Function &function : module) {
+        if (function.isDeclaration()) {
+            continue;
+        }
+
+        for (const llvm::Instruction &instruction : llvm::instructions(function)) {
+            if (!llvm::isa<llvm::CallBase>(instruction)) {
+                continue;
+            }
+
+            // Declarations have no start point and are never summarized
+            std::vector<const llvm::Function *> callees;
+            for (const llvm::Function *callee : interproceduralCFG.getCalleesOfCallAt(&instruction)) {
+                if (callee && !callee->isDeclaration()) {
+                    callees.push_back(callee);
+                }
+            }
+
+            if (!callees.empty()) {
+                calleesAt[&instruction] = std::move(callees);
+            }
+        }
+    }
+}
+
+void LoopBound::BottomUpLoopBoundSolver::orderComponents(llvm::Module &module) {
+    llvm::CallGraph callGraph(module);
+
+    for (const auto &[callSite, callees] : calleesAt) {
+        auto *callBase = const_cast<llvm::CallBase *>(llvm::cast<llvm::CallBase>(callSite));
+        if (callBase->getCalledFunction()) {
+            continue;
+        }
+
+        llvm::CallGraphNode *callerNode = callGraph[callSite->getFunction()];
+        for (const llvm::Function *callee : callees) {
+            callerNode->addCalledFunction(callBase, callGraph[callee]);
+        }
+    }
+
+    // The SCC iterator enumerates the strongly connected components of the call graph in post-order. A component is
+    // always enumerated as a whole, so components already ordered by an earlier traversal are skipped entirely
+    llvm::DenseSet<const llvm::Function *> ordered;
+    auto collectComponents = [this, &ordered](auto sccIterator) {
+        for (; !sccIterator.isAtEnd(); ++sccIterator) {
+            std::vector<const llvm::Function *> component;
+            for (llvm::CallGraphNode *node : *sccIterator) {
+                const llvm::Function *function = node->getFunction();
+                if (function && !function->isDeclaration() && ordered.insert(function).second) {
+                    component.push_back(function);
+                }
+            }
+
+            if (!component.empty()) {
+                components.push_back(std::move(component));
+            }
+        }
+    };
+
+    // The external calling node reaches every function that is visible outside of the module. Internal functions
+    // without such a caller start a traversal of their own
+    collectComponents(llvm::scc_begin(&callGraph));
+    for (llvm::Function &function : module) {
+        if (!function.isDeclaration() && !ordered.contains(&function)) {
+            collectComponents(llvm::scc_begin(callGraph[&function]));
+        }
+    }
+}
+
+void LoopBound::BottomUpLoopBoundSolver::collectCounters() {
+    llvm::DenseMap<const llvm::Function *, std::vector<const llvm::Function *>> callers;
+    for (const auto &[callSite, callees] : calleesAt) {
+        for (const llvm::Function *callee : callees) {
+            callers[callee].push_back(callSite->getFunction());
+        }
+    }
+
+    // Only stores inside a loop counted by the fact change it, every other function returns the fact unchanged
+    llvm::DenseMap<d_t, std::vector<const llvm::Function *>> countingFunctions;
+    for (const auto &description : problem.LoopDescriptions) {
+        if (!description.loop || !description.counterRoot) {
+            continue;
+        }
+
+        countingFunctions[LoopBound::Util::stripAddr(description.counterRoot)].push_back(
+            description.loop->getHeader()->getParent());
+    }
+
+    for (const auto &[fact, seeds] : counterSeeds) {
+        std::vector<const llvm::Function *> pending = countingFunctions.lookup(fact);
+        for (const auto &[node, value] : seeds) {
+            pending.push_back(node->getFunction());
+        }
+
+        auto &functions = counterFunctions[fact];
+        while (!pending.empty()) {
+            const llvm::Function *function = pending.back();
+            pending.pop_back();
+
+            if (!functions.insert(function).second) {
+                continue;
+            }
+
+            functionCounters[function].push_back(fact);
+
+            auto callersIt = callers.find(function);
+            if (callersIt != callers.end()) {
+                pending.insert(pending.end(), callersIt->second.begin(), callersIt->second.end());
+            }
+        }
+    }
+}
+
+void LoopBound::BottomUpLoopBoundSolver::solve() {
+    statistics = {};
+    summaries.clear();
+    results.clear();
+
+    {
+        ProgressPhase progress("loopbound bottom-up summaries", "components", components.size());
+        for (const auto &component : components) {
+            summarizeComponent(component);
+            ProgressReporter::getInstance().advance();
+        }
+    }
+
+    ProgressPhase progress("loopbound bottom-up instantiation", "counters", counterSeeds.size());
+    for (const auto &[fact, seeds] : counterSeeds) {
+        instantiate(fact, seeds);
+        ProgressReporter::getInstance().advance();
+    }
+}
+
+void LoopBound::BottomUpLoopBoundSolver::summarizeComponent(const std::vector<const llvm::Function *> &component) {
+    const llvm::DenseSet<const llvm::Function *> members(component.begin(), component.end());
+
+    // A changed summary only affects the callers inside the component, all other callers are summarized later
+    llvm::DenseMap<const llvm::Function *, std::vector<const llvm::Function *>> componentCallers;
+    for (const llvm::Function *function : component) {
+        for (const llvm::Instruction &instruction : llvm::instructions(*function)) {
+            auto calleesIt = calleesAt.find(&instruction);
+            if (calleesIt == calleesAt.end()) {
+                continue;
+            }
+
+            for (const llvm::Function *callee : calleesIt->second) {
+                if (members.contains(callee) && !llvm::is_contained(componentCallers[callee], function)) {
+                    componentCallers[callee].push_back(function);
+                }
+            }
+        }
+    }
+
+    std::deque<const llvm::Function *> pending(component.begin(), component.end());
+    llvm::DenseSet<const llvm::Function *> queued(members);
+
+    while (!pending.empty()) {
+        const llvm::Function *function = pending.front();
+        pending.pop_front();
+        queued.erase(function);
+
+        auto countersIt = functionCounters.find(function);
+        if (countersIt == functionCounters.end()) {
+            continue;
+        }
+
+        bool changed = false;
+        for (d_t fact : countersIt->second) {
+            CounterTable table = tabulate(function, fact, true);
+            statistics.summaries += table.endSummaries.size();
+
+            CounterTable &summary = summaries[function][fact];
+            changed |= !(summary.endSummaries == table.endSummaries);
+            summary = std::move(table);
+        }
+
+        if (!changed) {
+            continue;
+        }
+
+        auto callersIt = componentCallers.find(function);
+        if (callersIt == componentCallers.end()) {
+            continue;
+        }
+
+        for (const llvm::Function *caller : callersIt->second) {
+            if (queued.insert(caller).second) {
+                pending.push_back(caller);
+            }
+        }
+    }
+}
+
+LoopBound::BottomUpLoopBoundSolver::CounterTable LoopBound::BottomUpLoopBoundSolver::tabulate(
+    const llvm::Function *function, d_t fact, bool fromStartPoint) {
+    CounterTable table;
+    std::deque<n_t> pathEdges;
+
+    auto addPathEdge = [this, &table, &pathEdges](n_t node, const EF &jumpFunction) {
+        auto [entryIt, inserted] = table.jumpFunctions.try_emplace(node, jumpFunction);
+        if (!inserted) {
+            EF joined = entryIt->second.joinWith(jumpFunction);
+            if (joined == entryIt->second) {
+                return;
+            }
+
+            statistics.joins++;
+            entryIt->second = std::move(joined);
+        }
+
+        pathEdges.push_back(node);
+    };
+
+    // Seeds and the start point of an entered function start at the identity
+    if (fromStartPoint) {
+        if (n_t startPoint = ParallelLoopBoundSolver::startPointOf(function)) {
+            addPathEdge(startPoint, edgeIdentity());
+        }
+    }
+
+    auto seedsIt = counterSeeds.find(fact);
+    if (seedsIt != counterSeeds.end()) {
+        for (const auto &[node, value] : seedsIt->second) {
+            if (node->getFunction() == function) {
+                addPathEdge(node, edgeIdentity());
+            }
+        }
+    }
+
+    while (!pathEdges.empty()) {
+        const n_t node = pathEdges.front();
+        pathEdges.pop_front();
+        statistics.iterations++;
+
+        const EF jumpFunction = table.jumpFunctions.find(node)->second;
+
+        if (!llvm::isa<llvm::CallBase>(node)) {
+            // The flow functions of the analysis are the identity, the fact is passed to the successor unchanged
+            for (n_t successor : ParallelLoopBoundSolver::successorsOf(node)) {
+                addPathEdge(successor,
+                            jumpFunction.composeWith(problem.getNormalEdgeFunction(node, fact, successor, fact)));
+            }
+            continue;
+        }
+
+        const std::vector<n_t> returnSites = ParallelLoopBoundSolver::successorsOf(node);
+
+        auto calleesIt = calleesAt.find(node);
+        if (calleesIt != calleesAt.end()) {
+            for (const llvm::Function *callee : calleesIt->second) {
+                // Callees that are not summarized for the fact return it unchanged, the call-to-return edge covers
+                // them. Callees of the same component without a summary yet are applied once it is published
+                auto calleeIt = summaries.find(callee);
+                if (!isSummarized(callee, fact) || calleeIt == summaries.end()) {
+                    continue;
+                }
+
+                auto summaryIt = calleeIt->second.find(fact);
+                if (summaryIt == calleeIt->second.end()) {
+                    continue;
+                }
+
+                for (const auto &[exitNode, summary] : summaryIt->second.endSummaries) {
+                    for (n_t returnSite : returnSites) {
+                        addPathEdge(returnSite, jumpFunction.composeWith(
+                            summaryEdgeFunction(fact, node, callee, exitNode, summary, returnSite)));
+                    }
+                }
+            }
+        }
+
+        for (n_t returnSite : returnSites) {
+            addPathEdge(returnSite, jumpFunction.composeWith(
+                problem.getCallToRetEdgeFunction(node, fact, returnSite, fact, {})));
+        }
+    }
+
+    for (const auto &[node, jumpFunction] : table.jumpFunctions) {
+        if (llvm::isa<llvm::ReturnInst>(node)) {
+            table.endSummaries[node] = jumpFunction;
+        }
+    }
+
+    return table;
+}
+
+void LoopBound::BottomUpLoopBoundSolver::instantiate(d_t fact, const std::vector<std::pair<n_t, l_t>> &seeds) {
+    // Functions the counter is passed into at a reached call are entered at their start point and use their summary.
+    // Functions that are only reached by their own seeds are tabulated from the seeds alone
+    llvm::DenseSet<const llvm::Function *> entered;
+    std::unordered_map<const llvm::Function *, CounterTable> seedTables;
+    llvm::DenseMap<const llvm::Function *, const JumpFunctionTable *> tables;
+
+    std::vector<const llvm::Function *> pending;
+    for (const auto &[node, value] : seeds) {
+        pending.push_back(node->getFunction());
+    }
+
+    while (!pending.empty()) {
+        const llvm::Function *function = pending.back();
+        pending.pop_back();
+
+        const JumpFunctionTable *table = nullptr;
+        if (entered.contains(function)) {
+            table = &summaries.find(function)->second.find(fact)->second.jumpFunctions;
+        } else if (!tables.contains(function)) {
+            auto [seedTableIt, inserted] = seedTables.try_emplace(function, tabulate(function, fact, false));
+            table = &seedTableIt->second.jumpFunctions;
+        }
+
+        if (!table || tables.lookup(function) == table) {
+            continue;
+        }
+        tables[function] = table;
+
+        for (const auto &[node, jumpFunction] : *table) {
+            auto calleesIt = calleesAt.find(node);
+            if (calleesIt == calleesAt.end()) {
+                continue;
+            }
+
+            for (const llvm::Function *callee : calleesIt->second) {
+                if (isSummarized(callee, fact) && entered.insert(callee).second) {
+                    pending.push_back(callee);
+                }
+            }
+        }
+    }
+
+    // Phase one: propagate the seed values from the start nodes to the calls of their function and from the calls
+    // into the start points of the callees. Nodes without a value hold the top element
+    llvm::DenseMap<n_t, l_t> values;
+    std::deque<n_t> valueWorklist;
+
+    auto propagateValue = [this, &values, &valueWorklist](n_t node, const l_t &value) {
+        auto valueIt = values.find(node);
+        const l_t current = valueIt != values.end() ? valueIt->second : problem.topElement();
+        l_t joined = problem.join(current, value);
+        if (joined == current) {
+            return;
+        }
+
+        values[node] = std::move(joined);
+        valueWorklist.push_back(node);
+    };
+
+    for (const auto &[node, value] : seeds) {
+        values[node] = value;
+        valueWorklist.push_back(node);
+    }
+
+    while (!valueWorklist.empty()) {
+        const n_t node = valueWorklist.front();
+        valueWorklist.pop_front();
+        const l_t value = values.find(node)->second;
+        const llvm::Function *function = node->getFunction();
+
+        if (seedNodes.contains(node) || node == ParallelLoopBoundSolver::startPointOf(function)) {
+            for (const auto &[callSite, jumpFunction] : *tables.lookup(function)) {
+                if (llvm::isa<llvm::CallBase>(callSite)) {
+                    propagateValue(callSite, jumpFunction.computeTarget(value));
+                }
+            }
+        }
+
+        if (!llvm::isa<llvm::CallBase>(node)) {
+            continue;
+        }
+
+        auto calleesIt = calleesAt.find(node);
+        if (calleesIt == calleesAt.end()) {
+            continue;
+        }
+
+        for (const llvm::Function *callee : calleesIt->second) {
+            n_t startPoint = ParallelLoopBoundSolver::startPointOf(callee);
+            if (entered.contains(callee) && startPoint) {
+                propagateValue(startPoint, problem.getCallEdgeFunction(node, fact, callee, fact).computeTarget(value));
+            }
+        }
+    }
+
+    // Phase two: every other node applies its jump function to the value at the start point of its function. Calls
+    // and start points keep the values of phase one
+    for (const auto &[function, table] : tables) {
+        const n_t startPoint = ParallelLoopBoundSolver::startPointOf(function);
+        auto startValueIt = values.find(startPoint);
+        const l_t startValue = startValueIt != values.end() ? startValueIt->second : problem.topElement();
+
+        for (const auto &[node, jumpFunction] : *table) {
+            auto valueIt = values.find(node);
+
+            if (llvm::isa<llvm::CallBase>(node) || node == startPoint) {
+                if (valueIt != values.end()) {
+                    results[node].insert_or_assign(fact, valueIt->second);
+                }
+                continue;
+            }
+
+            const l_t current = valueIt != values.end() ? valueIt->second : problem.topElement();
+            results[node].insert_or_assign(fact, problem.join(current, jumpFunction.computeTarget(startValue)));
+        }
+    }
+}
+
+bool LoopBound::BottomUpLoopBoundSolver::isSummarized(const llvm::Function *function, d_t fact) const {
+    auto functionsIt = counterFunctions.find(fact);
+    return functionsIt != counterFunctions.end() && functionsIt->second.contains(function);
+}
+
+LoopBound::EF LoopBound::BottomUpLoopBoundSolver::summaryEdgeFunction(d_t fact, n_t callSite,
+                                                                      const llvm::Function *callee, n_t exitNode,
+                                                                      const EF &summary, n_t returnSite) {
+    return problem.getCallEdgeFunction(callSite, fact, callee, fact)
+        .composeWith(summary)
+        .composeWith(problem.getReturnEdgeFunction(callSite, callee, exitNode, fact, returnSite, fact));
+}
+
+std::optional<LoopBound::DeltaInterval> LoopBound::BottomUpLoopBoundSolver::resultAt(
+    const llvm::Instruction *instruction, const llvm::Value *fact) const {
+    auto nodeIt = results.find(instruction);
+    if (nodeIt == results.end()) {
+        return std::nullopt;
+    }
+
+    auto factIt = nodeIt->second.find(fact);
+    if (factIt == nodeIt->second.end()) {
+        return std::nullopt;
+    }
+
+    return factIt->second;
+}
+
+const LoopBound::ParallelResultTable &LoopBound::BottomUpLoopBoundSolver::getResults() const {
+    return results;
+}
+
+size_t LoopBound::BottomUpLoopBoundSolver::getNumberOfComponents() const {
+    return components.size();
+}
+
+LoopBound::LoopBoundSolverStatistics LoopBound::BottomUpLoopBoundSolver::getStatistics() const {
+    return statistics;
+}
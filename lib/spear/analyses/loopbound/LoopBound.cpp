@@ -15,6 +15,7 @@
 #include <utility>
 #include <vector>
 
+#include "ProgressReporter.h"
 #include "analyses/loopbound/LoopBoundEdgeFunction.h"
 #include "analyses/loopbound/util.h"
 
@@ -93,6 +94,14 @@ psr::InitialSeeds<LoopBoundIDEAnalysis::n_t, LoopBoundIDEAnalysis::d_t, LoopBoun
 LoopBoundIDEAnalysis::initialSeeds() {
     psr::InitialSeeds<n_t, d_t, l_t> Seeds;
 
+    // Counters without a constant increment never yield a value, unless the same counter drives another loop
+    llvm::DenseSet<const llvm::Value *> affineRoots;
+    for (const auto &desc : LoopDescriptions) {
+        if (desc.hasAffineCounter && desc.counterRoot) {
+            affineRoots.insert(LoopBound::Util::stripAddr(desc.counterRoot));
+        }
+    }
+
     for (auto &desc : LoopDescriptions) {
         llvm::Loop *loop = desc.loop;
         const llvm::Value *root = desc.counterRoot;
@@ -101,6 +110,10 @@ LoopBoundIDEAnalysis::initialSeeds() {
             continue;
         }
 
+        if (!affineRoots.contains(LoopBound::Util::stripAddr(root))) {
+            continue;
+        }
+
         llvm::BasicBlock *header = loop->getHeader();
         if (!header || header->empty()) {
             continue;
@@ -235,6 +248,9 @@ bool LoopBoundIDEAnalysis::isLatchToHeaderEdge(n_t Curr, n_t Succ) const {
 
 LoopBoundIDEAnalysis::FlowFunctionPtrType
 LoopBoundIDEAnalysis::getNormalFlowFunction(n_t Curr, n_t Succ) {
+    // Phasar reports no progress itself. Our solver only uses the edge functions, so this counts Phasar's work only
+    ProgressReporter::getInstance().advance();
+
     if (isLatchToHeaderEdge(Curr, Succ)) {
         if (LoopBound::Util::LB_DebugEnabled.load()) {
             llvm::errs() << "[LB] CUT edge (no-kill facts): " << *Curr << " -> " << *Succ << "\n";
@@ -261,6 +277,8 @@ LoopBoundIDEAnalysis::getRetFlowFunction(n_t Curr, f_t, n_t, n_t) {
 LoopBoundIDEAnalysis::FlowFunctionPtrType
 LoopBoundIDEAnalysis::getCallToRetFlowFunction(n_t Curr, n_t Succ,
                                                llvm::ArrayRef<f_t>) {
+    ProgressReporter::getInstance().advance();
+
     auto Inner = std::make_shared<KeepLocalOnCallToRet<d_t, container_t> >();
     return std::make_shared<DebugFlow<d_t, container_t> >(Inner,
                                                           "CallToRetKeepLocal",
@@ -584,6 +602,21 @@ LoopBoundIDEAnalysis::extractConstIncFromStore(const llvm::StoreInst *storeInst,
 }
 
 
+bool LoopBoundIDEAnalysis::hasAffineCounter(llvm::Loop *loop, const llvm::Value *counterRoot) {
+    const llvm::Value *root = LoopBound::Util::stripAddr(counterRoot);
+
+    for (llvm::BasicBlock *block : loop->blocks()) {
+        for (llvm::Instruction &inst : *block) {
+            auto *storeInst = llvm::dyn_cast<llvm::StoreInst>(&inst);
+            if (storeInst && extractConstIncFromStore(storeInst, root).has_value()) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
 bool LoopBoundIDEAnalysis::isLoadOfCounterRoot(llvm::Value *value,
                                                const llvm::Value *root) {
     if (auto *loopInstruction = llvm::dyn_cast<llvm::LoadInst>(value)) {
@@ -644,7 +677,8 @@ LoopBoundIDEAnalysis::findConstInitForCell(
         if (auto *loadInst = llvm::dyn_cast<llvm::LoadInst>(candidate)) {
             auto &domTree = FAM->getResult<llvm::DominatorTreeAnalysis>(*function);
             auto &LIInfo = FAM->getResult<llvm::LoopAnalysis>(*function);
-            if (auto constFromLoad = LoopBound::Util::tryDeduceConstFromLoad(loadInst, domTree, LIInfo)) {
+            auto &accesses = LoopBound::Util::getMemoryAccessIndex(*function, *FAM);
+            if (auto constFromLoad = LoopBound::Util::tryDeduceConstFromLoad(loadInst, domTree, LIInfo, accesses)) {
                 return *constFromLoad;
             }
         }
@@ -691,6 +725,7 @@ void LoopBoundIDEAnalysis::findLoopCounters(llvm::FunctionAnalysisManager *FAM)
                 LoopBound::LoopType::UNKNOWN_LOOP
             };
 
+            description.hasAffineCounter = hasAffineCounter(loop, info->Roots[0]);
             description.type = Util::determineLoopType(description, FAM);
 
             LoopDescriptions.push_back(description);
@@ -4,6 +4,8 @@
 */
 
 #include <algorithm>
+#include <limits>
+#include <optional>
 
 #include "analyses/loopbound/LoopBoundEdgeFunction.h"
 #include "analyses/loopbound/util.h"
@@ -354,4 +356,63 @@ EF edgeTop() {
   return EF(std::in_place_type<DeltaIntervalTop>);
 }
 
+namespace {
+
+constexpr int64_t NEG_INF = std::numeric_limits<int64_t>::min();
+constexpr int64_t POS_INF = std::numeric_limits<int64_t>::max();
+
+template <typename BoundedEF>
+std::optional<EF> widenBounded(const EF &previous, const EF &joined) {
+  auto *before = previous.template dyn_cast<BoundedEF>();
+  auto *after = joined.template dyn_cast<BoundedEF>();
+  if (!before || !after) {
+    return std::nullopt;
+  }
+
+  const int64_t L = after->lowerBound < before->lowerBound ? NEG_INF : before->lowerBound;
+  const int64_t U = after->upperBound > before->upperBound ? POS_INF : before->upperBound;
+  return EF(std::in_place_type<BoundedEF>, L, U);
+}
+
+template <typename BoundedEF>
+std::optional<EF> narrowBounded(const EF &current, const EF &recomputed) {
+  auto *widened = current.template dyn_cast<BoundedEF>();
+  auto *precise = recomputed.template dyn_cast<BoundedEF>();
+  if (!widened || !precise) {
+    return std::nullopt;
+  }
+
+  const int64_t L = widened->lowerBound == NEG_INF ? precise->lowerBound : widened->lowerBound;
+  const int64_t U = widened->upperBound == POS_INF ? precise->upperBound : widened->upperBound;
+  return EF(std::in_place_type<BoundedEF>, L, U);
+}
+
+}  // namespace
+
+EF widenEdgeFunction(const EF &previous, const EF &joined) {
+  if (auto widened = widenBounded<DeltaIntervalAdditive>(previous, joined)) {
+    return *widened;
+  }
+  if (auto widened = widenBounded<DeltaIntervalMultiplicative>(previous, joined)) {
+    return *widened;
+  }
+  if (auto widened = widenBounded<DeltaIntervalDivision>(previous, joined)) {
+    return *widened;
+  }
+  return joined;
+}
+
+EF narrowEdgeFunction(const EF &current, const EF &recomputed) {
+  if (auto narrowed = narrowBounded<DeltaIntervalAdditive>(current, recomputed)) {
+    return *narrowed;
+  }
+  if (auto narrowed = narrowBounded<DeltaIntervalMultiplicative>(current, recomputed)) {
+    return *narrowed;
+  }
+  if (auto narrowed = narrowBounded<DeltaIntervalDivision>(current, recomputed)) {
+    return *narrowed;
+  }
+  return current;
+}
+
 }  // namespace LoopBound
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <llvm/ADT/SCCIterator.h>
+#include <llvm/Analysis/CallGraph.h>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <set>
+#include <vector>
+
+#include "analyses/loopbound/LoopBoundSummary.h"
+#include "analyses/loopbound/loopBoundWrapper.h"
+#include "analyses/loopbound/util.h"
+
+LoopBound::LoopBoundSummaries::LoopBoundSummaries(llvm::Module &module) {
+    llvm::CallGraph callGraph(module);
+
+    // The SCC iterator enumerates the strongly connected components of the call graph in post-order
+    for (auto sccIterator = llvm::scc_begin(&callGraph); !sccIterator.isAtEnd(); ++sccIterator) {
+        const bool isRecursive = sccIterator.hasCycle();
+
+        for (llvm::CallGraphNode *node : *sccIterator) {
+            llvm::Function *function = node->getFunction();
+            if (!function || function->isDeclaration()) {
+                continue;
+            }
+
+            postOrder.push_back(function);
+            if (isRecursive) {
+                recursiveFunctions.insert(function);
+            }
+        }
+    }
+
+    collectArgumentValues();
+}
+
+void LoopBound::LoopBoundSummaries::collectArgumentValues() {
+    CallerCacheMap callerCaches;
+
+    // Callers are visited before their callees, so forwarded arguments are always resolved already
+    for (auto functionIt = postOrder.rbegin(); functionIt != postOrder.rend(); ++functionIt) {
+        const llvm::Function *function = *functionIt;
+        argumentValues[function] = valuesAtCallSites(*function, callerCaches);
+    }
+}
+
+std::vector<LoopBound::LoopBoundSummaries::ArgumentValues>
+LoopBound::LoopBoundSummaries::valuesAtCallSites(const llvm::Function &function, CallerCacheMap &callerCaches) {
+    const unsigned argumentCount = function.arg_size();
+    std::vector<ArgumentValues> values(argumentCount, std::set<int64_t>{});
+
+    // Recursive functions and functions that can be called from unknown locations cannot be summarized
+    bool hasCallSite = false;
+    bool isClosed = recursiveFunctions.count(&function) == 0 && !function.hasAddressTaken() &&
+                    function.getName() != "main";
+
+    for (const llvm::User *user : function.users()) {
+        if (!isClosed) {
+            break;
+        }
+
+        const auto *callBase = llvm::dyn_cast<llvm::CallBase>(user);
+        if (!callBase || callBase->getCalledFunction() != &function) {
+            isClosed = false;
+            break;
+        }
+
+        hasCallSite = true;
+
+        const llvm::Function *caller = callBase->getFunction();
+        auto &callerCache = callerCaches[caller];
+        if (!callerCache) {
+            callerCache = std::make_unique<LoopCache>(*const_cast<llvm::Function *>(caller));
+        }
+
+        for (unsigned argumentIndex = 0; argumentIndex < argumentCount; ++argumentIndex) {
+            auto &argumentValue = values[argumentIndex];
+            if (!argumentValue) {
+                continue;
+            }
+
+            auto actualValues = resolveActual(callBase->getArgOperand(argumentIndex), *callerCache);
+            if (!actualValues) {
+                argumentValue = std::nullopt;
+                continue;
+            }
+
+            argumentValue->insert(actualValues->begin(), actualValues->end());
+            if (argumentValue->size() > maxArgumentValues) {
+                argumentValue = std::nullopt;
+            }
+        }
+    }
+
+    if (!isClosed || !hasCallSite) {
+        std::fill(values.begin(), values.end(), std::nullopt);
+    }
+
+    return values;
+}
+
+LoopBound::LoopBoundSummaries::ArgumentValues
+LoopBound::LoopBoundSummaries::resolveActual(const llvm::Value *actual, LoopCache &callerCache) {
+    const llvm::Value *value = LoopBound::Util::stripCasts(actual);
+
+    if (auto *loadInst = llvm::dyn_cast_or_null<llvm::LoadInst>(value)) {
+        value = resolveStoredValue(loadInst, callerCache);
+        value = value ? LoopBound::Util::stripCasts(value) : nullptr;
+    }
+
+    if (!value) {
+        return std::nullopt;
+    }
+
+    if (const llvm::ConstantInt *constValue = LoopBound::Util::tryEvalToConstInt(value)) {
+        return std::set<int64_t>{constValue->getSExtValue()};
+    }
+
+    // Arguments of the caller are forwarded. Their values were collected before the callee is visited
+    if (auto *argument = llvm::dyn_cast<llvm::Argument>(value)) {
+        auto callerIt = argumentValues.find(argument->getParent());
+        if (callerIt == argumentValues.end() || argument->getArgNo() >= callerIt->second.size()) {
+            return std::nullopt;
+        }
+        return callerIt->second[argument->getArgNo()];
+    }
+
+    return std::nullopt;
+}
+
+const llvm::Value *LoopBound::LoopBoundSummaries::resolveStoredValue(const llvm::LoadInst *loadInst,
+                                                                     LoopCache &callerCache) {
+    const llvm::Value *object = LoopBound::Util::getUnderlyingObject(loadInst->getPointerOperand());
+    if (!object) {
+        return nullptr;
+    }
+
+    // Memory written inside an enclosing loop changes between iterations, the dominating store is not sufficient.
+    // The outermost enclosing loop contains all others.
+    llvm::Loop *outermostLoop = callerCache.LI.getLoopFor(loadInst->getParent());
+    while (outermostLoop && outermostLoop->getParentLoop()) {
+        outermostLoop = outermostLoop->getParentLoop();
+    }
+    if (callerCache.Accesses.isWrittenInLoop(object, outermostLoop)) {
+        return nullptr;
+    }
+
+    const llvm::StoreInst *definingStore = callerCache.Accesses.findDominatingStore(loadInst, object,
+                                                                                    callerCache.DT);
+    if (!definingStore) {
+        return nullptr;
+    }
+
+    return definingStore->getValueOperand();
+}
+
+std::optional<unsigned> LoopBound::LoopBoundSummaries::findCheckArgument(const CheckExpr &check,
+                                                                         LoopCache &loopCache) {
+    if (check.isConstant || check.isUnknown || !check.BaseLoad) {
+        return std::nullopt;
+    }
+
+    const llvm::Value *storedValue = resolveStoredValue(check.BaseLoad, loopCache);
+    if (!storedValue) {
+        return std::nullopt;
+    }
+
+    if (auto *argument = llvm::dyn_cast<llvm::Argument>(LoopBound::Util::stripCasts(storedValue))) {
+        return argument->getArgNo();
+    }
+
+    return std::nullopt;
+}
+
+int64_t LoopBound::LoopBoundSummaries::evaluateCheck(const CheckExpr &check, int64_t argumentValue) {
+    // Mirrors CheckExpr::calculateCheck for a known base value
+    const int64_t combinedValue = argumentValue + check.Offset;
+    if (check.MulBy) {
+        return combinedValue * check.MulBy.value();
+    }
+    if (check.DivBy) {
+        return combinedValue / check.DivBy.value();
+    }
+    return combinedValue;
+}
+
+size_t LoopBound::LoopBoundSummaries::instantiate(std::vector<LoopClassifier> &classifiers,
+                                                  const std::vector<ArgumentCheck> &argumentChecks) {
+    size_t instantiatedLoops = 0;
+
+    for (const auto &argumentCheck : argumentChecks) {
+        if (argumentCheck.classifierIndex >= classifiers.size()) {
+            continue;
+        }
+
+        LoopClassifier &classifier = classifiers[argumentCheck.classifierIndex];
+
+        auto valuesIt = argumentValues.find(classifier.function);
+        if (valuesIt == argumentValues.end() || argumentCheck.argumentIndex >= valuesIt->second.size()) {
+            continue;
+        }
+
+        const ArgumentValues &values = valuesIt->second[argumentCheck.argumentIndex];
+        if (!values || values->empty()) {
+            continue;
+        }
+
+        // The loop is bounded by the join of the bounds of all calling contexts. If one context is unbounded,
+        // the whole loop stays unbounded
+        std::optional<DeltaInterval> joinedBound = std::nullopt;
+        std::optional<int64_t> widestCheck = std::nullopt;
+        bool allContextsBounded = true;
+
+        for (int64_t argumentValue : values.value()) {
+            // With a known check value the symbolic loop is a normal counting loop in this context
+            LoopClassifier context = classifier;
+            context.type = LoopBound::NORMAL_LOOP;
+            context.check = evaluateCheck(argumentCheck.check, argumentValue);
+            context.bound = context.calculateBound();
+
+            if (!context.bound) {
+                allContextsBounded = false;
+                break;
+            }
+
+            if (!joinedBound || context.bound->getUpperBound() > joinedBound->getUpperBound()) {
+                widestCheck = context.check;
+            }
+            joinedBound = joinedBound ? joinedBound->leastUpperBound(context.bound.value()) : context.bound;
+        }
+
+        if (!allContextsBounded || !joinedBound) {
+            continue;
+        }
+
+        classifier.type = LoopBound::NORMAL_LOOP;
+        classifier.check = widestCheck;
+        classifier.bound = joinedBound;
+        instantiatedLoops++;
+    }
+
+    return instantiatedLoops;
+}
@@ -0,0 +1,571 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/Module.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ProgressReporter.h"
+#include "analyses/loopbound/ParallelLoopBoundSolver.h"
+#include "analyses/loopbound/util.h"
+
+LoopBound::ParallelLoopBoundSolver::ParallelLoopBoundSolver(LoopBoundIDEAnalysis &problem,
+                                                            psr::LLVMBasedICFG &interproceduralCFG,
+                                                            unsigned threadCount, unsigned widenAfter,
+                                                            unsigned narrowingRounds)
+    : problem(problem), threadCount(std::max(1U, threadCount)), widenAfter(widenAfter),
+      narrowingRounds(narrowingRounds) {
+    partitionSeeds();
+    collectCallees(interproceduralCFG);
+    collectFunctions();
+}
+
+void LoopBound::ParallelLoopBoundSolver::partitionSeeds() {
+    std::unordered_map<d_t, size_t> worklistIndex;
+
+    for (const auto &[node, factsAtNode] : problem.initialSeeds().getSeeds()) {
+        if (!node) {
+            continue;
+        }
+
+        seedNodes.insert(node);
+
+        for (const auto &[fact, value] : factsAtNode) {
+            // The zero value carries no information for any loop counter
+            if (problem.isZeroValue(fact)) {
+                continue;
+            }
+
+            auto [indexIt, inserted] = worklistIndex.try_emplace(fact, worklists.size());
+            if (inserted) {
+                worklists.push_back({fact, {}, {}, 0});
+            }
+
+            worklists[indexIt->second].seeds.push_back({node, value});
+        }
+    }
+}
+
+void LoopBound::ParallelLoopBoundSolver::collectCallees(psr::LLVMBasedICFG &interproceduralCFG) {
+    if (worklists.empty()) {
+        return;
+    }
+
+    const llvm::Module *module = worklists.front().seeds.front().first->getModule();
+    for (const llvm::Function &function : *module) {
+        if (function.isDeclaration()) {
+            continue;
+        }
+
+        for (const llvm::Instruction &instruction : llvm::instructions(function)) {
+            if (!llvm::isa<llvm::CallBase>(instruction)) {
+                continue;
+            }
+
+            // Declarations have no start point, the counter cannot be passed into them
+            std::vector<const llvm::Function *> callees;
+            for (const llvm::Function *callee : interproceduralCFG.getCalleesOfCallAt(&instruction)) {
+                if (callee && !callee->isDeclaration()) {
+                    callees.push_back(callee);
+                }
+            }
+
+            if (!callees.empty()) {
+                calleesAt[&instruction] = std::move(callees);
+            }
+        }
+    }
+}
+
+void LoopBound::ParallelLoopBoundSolver::collectFunctions() {
+    llvm::DenseMap<const llvm::Function *, std::vector<const llvm::Function *>> callers;
+    for (const auto &[callSite, callees] : calleesAt) {
+        for (const llvm::Function *callee : callees) {
+            callers[callee].push_back(callSite->getFunction());
+        }
+    }
+
+    // Only stores inside a loop counted by the fact change it, so every other function leaves the fact unchanged
+    llvm::DenseMap<d_t, std::vector<const llvm::Function *>> countingFunctions;
+    for (const auto &description : problem.LoopDescriptions) {
+        if (!description.loop || !description.counterRoot) {
+            continue;
+        }
+
+        countingFunctions[LoopBound::Util::stripAddr(description.counterRoot)].push_back(
+            description.loop->getHeader()->getParent());
+    }
+
+    for (auto &worklist : worklists) {
+        std::vector<const llvm::Function *> pending = countingFunctions.lookup(worklist.fact);
+        for (const auto &[node, value] : worklist.seeds) {
+            pending.push_back(node->getFunction());
+        }
+
+        while (!pending.empty()) {
+            const llvm::Function *function = pending.back();
+            pending.pop_back();
+
+            if (!worklist.functions.insert(function).second) {
+                continue;
+            }
+
+            worklist.instructionCount += function->getInstructionCount();
+
+            auto callersIt = callers.find(function);
+            if (callersIt != callers.end()) {
+                pending.insert(pending.end(), callersIt->second.begin(), callersIt->second.end());
+            }
+        }
+    }
+
+    // Start with the largest worklists so long running worklists do not end up at the tail of the schedule
+    std::sort(worklists.begin(), worklists.end(), [](const CounterWorklist &lhs, const CounterWorklist &rhs) {
+        return lhs.instructionCount > rhs.instructionCount;
+    });
+}
+
+void LoopBound::ParallelLoopBoundSolver::solve() {
+    std::atomic<size_t> nextWorklist{0};
+    statistics = {};
+    ProgressPhase progress("loopbound solve", "counters", worklists.size());
+
+    auto worker = [this, &nextWorklist]() {
+        for (size_t index = nextWorklist.fetch_add(1); index < worklists.size(); index = nextWorklist.fetch_add(1)) {
+            solveWorklist(worklists[index]);
+            ProgressReporter::getInstance().advance();
+        }
+    };
+
+    const unsigned spawnedThreads = std::min<unsigned>(threadCount, static_cast<unsigned>(worklists.size()));
+
+    std::vector<std::thread> threads;
+    threads.reserve(spawnedThreads);
+    for (unsigned threadIndex = 0; threadIndex < spawnedThreads; ++threadIndex) {
+        threads.emplace_back(worker);
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+void LoopBound::ParallelLoopBoundSolver::solveWorklist(const CounterWorklist &worklist) {
+    TabulationState state;
+
+    for (const auto &[node, value] : worklist.seeds) {
+        state.startNodes.insert(node);
+        addPathEdge(state, node, edgeIdentity());
+    }
+
+    while (!state.pathEdges.empty()) {
+        const n_t node = state.pathEdges.front();
+        state.pathEdges.pop_front();
+        state.statistics.iterations++;
+
+        const EF jumpFunction = state.jumpFunctions.find(node)->second;
+
+        // The narrowing pass needs the incoming edges, which are the same every time a path edge is expanded
+        const bool recordIncoming = widenAfter > 0 && state.expanded.insert(node).second;
+
+        if (llvm::isa<llvm::CallBase>(node)) {
+            processCall(worklist, state, node, jumpFunction, recordIncoming);
+            continue;
+        }
+
+        if (llvm::isa<llvm::ReturnInst>(node)) {
+            processExit(worklist, state, node, jumpFunction);
+        }
+
+        // The flow functions of the analysis are the identity, the fact is passed to the successor unchanged
+        for (n_t successor : successorsOf(node)) {
+            propagate(state, node, jumpFunction, successor,
+                      problem.getNormalEdgeFunction(node, worklist.fact, successor, worklist.fact), recordIncoming);
+        }
+    }
+
+    if (state.statistics.widenings > 0 && narrowingRounds > 0) {
+        state.statistics.narrowingRounds = narrow(state);
+    }
+
+    publishValues(worklist, state);
+}
+
+void LoopBound::ParallelLoopBoundSolver::processCall(const CounterWorklist &worklist, TabulationState &state,
+                                                     n_t callSite, const EF &jumpFunction, bool recordIncoming) {
+    const std::vector<n_t> returnSites = successorsOf(callSite);
+
+    auto calleesIt = calleesAt.find(callSite);
+    if (calleesIt != calleesAt.end()) {
+        for (const llvm::Function *callee : calleesIt->second) {
+            // A callee reaching no loop counted by the fact returns it unchanged, the call-to-return edge covers it
+            if (!worklist.functions.contains(callee)) {
+                continue;
+            }
+
+            n_t startPoint = startPointOf(callee);
+            if (!startPoint) {
+                continue;
+            }
+
+            auto &callers = state.incomingCalls[callee];
+            if (!llvm::is_contained(callers, callSite)) {
+                callers.push_back(callSite);
+            }
+
+            state.startNodes.insert(startPoint);
+            addPathEdge(state, startPoint, edgeIdentity());
+
+            // Summaries the callee publishes later are applied to this call by processExit
+            auto summariesIt = state.endSummaries.find(callee);
+            if (summariesIt == state.endSummaries.end()) {
+                continue;
+            }
+
+            for (const auto &[exitNode, summary] : summariesIt->second) {
+                for (n_t returnSite : returnSites) {
+                    propagate(state, callSite, jumpFunction, returnSite,
+                              summaryEdgeFunction(worklist.fact, callSite, callee, exitNode, summary, returnSite),
+                              widenAfter > 0);
+                }
+            }
+        }
+    }
+
+    for (n_t returnSite : returnSites) {
+        propagate(state, callSite, jumpFunction, returnSite,
+                  problem.getCallToRetEdgeFunction(callSite, worklist.fact, returnSite, worklist.fact, {}),
+                  recordIncoming);
+    }
+}
+
+void LoopBound::ParallelLoopBoundSolver::processExit(const CounterWorklist &worklist, TabulationState &state,
+                                                     n_t exitNode, const EF &jumpFunction) {
+    const llvm::Function *function = exitNode->getFunction();
+    state.endSummaries[function][exitNode] = jumpFunction;
+    state.statistics.summaries++;
+
+    auto callersIt = state.incomingCalls.find(function);
+    if (callersIt == state.incomingCalls.end()) {
+        return;
+    }
+
+    for (n_t callSite : callersIt->second) {
+        const EF callJumpFunction = state.jumpFunctions.find(callSite)->second;
+
+        for (n_t returnSite : successorsOf(callSite)) {
+            propagate(state, callSite, callJumpFunction, returnSite,
+                      summaryEdgeFunction(worklist.fact, callSite, function, exitNode, jumpFunction, returnSite),
+                      widenAfter > 0);
+        }
+    }
+}
+
+LoopBound::EF LoopBound::ParallelLoopBoundSolver::summaryEdgeFunction(d_t fact, n_t callSite,
+                                                                      const llvm::Function *callee, n_t exitNode,
+                                                                      const EF &summary, n_t returnSite) {
+    return problem.getCallEdgeFunction(callSite, fact, callee, fact)
+        .composeWith(summary)
+        .composeWith(problem.getReturnEdgeFunction(callSite, callee, exitNode, fact, returnSite, fact));
+}
+
+void LoopBound::ParallelLoopBoundSolver::propagate(TabulationState &state, n_t predecessor,
+                                                   const EF &predecessorFunction, n_t target, const EF &edgeFunction,
+                                                   bool recordIncoming) {
+    if (recordIncoming) {
+        // Summaries are applied again whenever the call or the summary changes, every edge is kept once
+        auto &edges = state.incoming[target];
+        const auto edge = std::make_pair(predecessor, edgeFunction);
+        if (!llvm::is_contained(edges, edge)) {
+            edges.push_back(edge);
+        }
+    }
+
+    addPathEdge(state, target, predecessorFunction.composeWith(edgeFunction));
+}
+
+void LoopBound::ParallelLoopBoundSolver::addPathEdge(TabulationState &state, n_t node, const EF &function) {
+    auto [entryIt, inserted] = state.jumpFunctions.try_emplace(node, function);
+    if (inserted) {
+        state.discoveryOrder.push_back(node);
+        state.pathEdges.push_back(node);
+        return;
+    }
+
+    EF joined = entryIt->second.joinWith(function);
+    if (joined == entryIt->second) {
+        return;
+    }
+
+    if (widenAfter > 0 && ++state.joinCounts[node] > widenAfter) {
+        joined = widenEdgeFunction(entryIt->second, joined);
+        state.statistics.widenings++;
+        if (joined == entryIt->second) {
+            return;
+        }
+    }
+
+    state.statistics.joins++;
+    entryIt->second = std::move(joined);
+    state.pathEdges.push_back(node);
+}
+
+unsigned LoopBound::ParallelLoopBoundSolver::narrow(TabulationState &state) const {
+    // Widened bounds reach every path edge downstream of the widened one, all of them are recomputed
+    auto isWidened = [](const EF &jumpFunction) {
+        return jumpFunction.computeTarget(DeltaInterval::empty()).isUnbounded();
+    };
+
+    llvm::DenseMap<n_t, std::optional<EF>> recomputed;
+    for (n_t node : state.discoveryOrder) {
+        if (isWidened(state.jumpFunctions.find(node)->second)) {
+            recomputed[node] = std::nullopt;
+        }
+    }
+
+    // Ascend again from the unwidened path edges without widening. Visiting the path edges in the order they were
+    // discovered converges within a few rounds on reducible control flow
+    unsigned rounds = 0;
+    bool converged = false;
+
+    while (!converged && rounds < narrowingRounds) {
+        converged = true;
+        rounds++;
+
+        for (n_t node : state.discoveryOrder) {
+            auto recomputedIt = recomputed.find(node);
+            if (recomputedIt == recomputed.end()) {
+                continue;
+            }
+
+            std::optional<EF> value;
+            if (state.startNodes.contains(node)) {
+                value = edgeIdentity();
+            }
+
+            auto incomingIt = state.incoming.find(node);
+            if (incomingIt != state.incoming.end()) {
+                for (const auto &[predecessor, edgeFunction] : incomingIt->second) {
+                    auto predecessorIt = recomputed.find(predecessor);
+                    const std::optional<EF> predecessorFunction = predecessorIt != recomputed.end()
+                        ? predecessorIt->second
+                        : std::optional<EF>(state.jumpFunctions.find(predecessor)->second);
+
+                    if (!predecessorFunction) {
+                        continue;
+                    }
+
+                    EF composed = predecessorFunction->composeWith(edgeFunction);
+                    value = value ? value->joinWith(composed) : composed;
+                }
+            }
+
+            if (value && (!recomputedIt->second || !(*recomputedIt->second == *value))) {
+                recomputedIt->second = std::move(value);
+                converged = false;
+            }
+        }
+    }
+
+    // Without convergence the widened functions are kept, they are sound but imprecise
+    if (!converged) {
+        return rounds;
+    }
+
+    for (auto &[node, value] : recomputed) {
+        if (value) {
+            auto jumpFunctionIt = state.jumpFunctions.find(node);
+            jumpFunctionIt->second = narrowEdgeFunction(jumpFunctionIt->second, *value);
+        }
+    }
+
+    return rounds;
+}
+
+void LoopBound::ParallelLoopBoundSolver::publishValues(const CounterWorklist &worklist,
+                                                       const TabulationState &state) {
+    const d_t fact = worklist.fact;
+
+    // Phase one: propagate the seed values from the start nodes to the calls of their function and from the calls
+    // into the start points of the callees. Nodes without a value hold the top element
+    llvm::DenseMap<n_t, l_t> values;
+    std::deque<n_t> valueWorklist;
+
+    llvm::DenseMap<const llvm::Function *, std::vector<n_t>> callSites;
+    for (const auto &[node, jumpFunction] : state.jumpFunctions) {
+        if (llvm::isa<llvm::CallBase>(node)) {
+            callSites[node->getFunction()].push_back(node);
+        }
+    }
+
+    auto propagateValue = [this, &values, &valueWorklist](n_t node, const l_t &value) {
+        auto valueIt = values.find(node);
+        const l_t current = valueIt != values.end() ? valueIt->second : problem.topElement();
+        l_t joined = problem.join(current, value);
+        if (joined == current) {
+            return;
+        }
+
+        values[node] = std::move(joined);
+        valueWorklist.push_back(node);
+    };
+
+    for (const auto &[node, value] : worklist.seeds) {
+        values[node] = value;
+        valueWorklist.push_back(node);
+    }
+
+    while (!valueWorklist.empty()) {
+        const n_t node = valueWorklist.front();
+        valueWorklist.pop_front();
+        const l_t value = values.find(node)->second;
+
+        if (seedNodes.contains(node) || node == startPointOf(node->getFunction())) {
+            auto callSitesIt = callSites.find(node->getFunction());
+            if (callSitesIt != callSites.end()) {
+                for (n_t callSite : callSitesIt->second) {
+                    propagateValue(callSite, state.jumpFunctions.find(callSite)->second.computeTarget(value));
+                }
+            }
+        }
+
+        if (!llvm::isa<llvm::CallBase>(node)) {
+            continue;
+        }
+
+        auto calleesIt = calleesAt.find(node);
+        if (calleesIt == calleesAt.end()) {
+            continue;
+        }
+
+        for (const llvm::Function *callee : calleesIt->second) {
+            n_t startPoint = startPointOf(callee);
+            if (worklist.functions.contains(callee) && startPoint) {
+                propagateValue(startPoint, problem.getCallEdgeFunction(node, fact, callee, fact).computeTarget(value));
+            }
+        }
+    }
+
+    // Phase two: every other node applies its jump function to the value at the start point of its function. Calls
+    // and start points keep the values of phase one. The values are calculated locally so the lock is only held while
+    // merging into the shared table
+    ParallelResultTable localResults;
+
+    for (const auto &[node, jumpFunction] : state.jumpFunctions) {
+        const n_t startPoint = startPointOf(node->getFunction());
+        auto valueIt = values.find(node);
+
+        if (llvm::isa<llvm::CallBase>(node) || node == startPoint) {
+            if (valueIt != values.end()) {
+                localResults[node].insert_or_assign(fact, valueIt->second);
+            }
+            continue;
+        }
+
+        auto startValueIt = values.find(startPoint);
+        const l_t startValue = startValueIt != values.end() ? startValueIt->second : problem.topElement();
+        const l_t current = valueIt != values.end() ? valueIt->second : problem.topElement();
+
+        localResults[node].insert_or_assign(fact, problem.join(current, jumpFunction.computeTarget(startValue)));
+    }
+
+    std::lock_guard<std::mutex> lock(resultMutex);
+    for (auto &[node, valuesAtNode] : localResults) {
+        results[node].merge(valuesAtNode);
+    }
+
+    statistics.iterations += state.statistics.iterations;
+    statistics.joins += state.statistics.joins;
+    statistics.widenings += state.statistics.widenings;
+    statistics.narrowingRounds += state.statistics.narrowingRounds;
+    statistics.summaries += state.statistics.summaries;
+}
+
+std::vector<LoopBound::ParallelLoopBoundSolver::n_t> LoopBound::ParallelLoopBoundSolver::successorsOf(
+    n_t instruction) {
+    std::vector<n_t> successors;
+
+    auto firstNonDebug = [](const llvm::Instruction *start) -> n_t {
+        const llvm::Instruction *current = start;
+        while (current != nullptr && llvm::isa<llvm::DbgInfoIntrinsic>(current)) {
+            current = current->getNextNode();
+        }
+        return current;
+    };
+
+    if (!instruction->isTerminator()) {
+        if (n_t next = firstNonDebug(instruction->getNextNode())) {
+            successors.push_back(next);
+        }
+        return successors;
+    }
+
+    for (const llvm::BasicBlock *successorBlock : llvm::successors(instruction->getParent())) {
+        if (successorBlock->empty()) {
+            continue;
+        }
+
+        if (n_t next = firstNonDebug(&successorBlock->front())) {
+            successors.push_back(next);
+        }
+    }
+
+    return successors;
+}
+
+LoopBound::ParallelLoopBoundSolver::n_t LoopBound::ParallelLoopBoundSolver::startPointOf(
+    const llvm::Function *function) {
+    if (function->isDeclaration() || function->getEntryBlock().empty()) {
+        return nullptr;
+    }
+
+    const llvm::Instruction *current = &function->getEntryBlock().front();
+    while (current != nullptr && llvm::isa<llvm::DbgInfoIntrinsic>(current)) {
+        current = current->getNextNode();
+    }
+
+    return current;
+}
+
+std::optional<LoopBound::DeltaInterval> LoopBound::ParallelLoopBoundSolver::resultAt(
+    const llvm::Instruction *instruction, const llvm::Value *fact) const {
+    std::lock_guard<std::mutex> lock(resultMutex);
+
+    auto nodeIt = results.find(instruction);
+    if (nodeIt == results.end()) {
+        return std::nullopt;
+    }
+
+    auto factIt = nodeIt->second.find(fact);
+    if (factIt == nodeIt->second.end()) {
+        return std::nullopt;
+    }
+
+    return factIt->second;
+}
+
+const LoopBound::ParallelResultTable &LoopBound::ParallelLoopBoundSolver::getResults() const {
+    return results;
+}
+
+size_t LoopBound::ParallelLoopBoundSolver::getNumberOfWorklists() const {
+    return worklists.size();
+}
+
+LoopBound::LoopBoundSolverStatistics LoopBound::ParallelLoopBoundSolver::getStatistics() const {
+    std::lock_guard<std::mutex> lock(resultMutex);
+    return statistics;
+}
@@ -11,13 +11,14 @@ std::optional<int64_t> LoopBound::CheckExpr::calculateCheck(
     llvm::FunctionAnalysisManager *analysisManager, llvm::LoopInfo &loopInfo) {
 
     if (!this->isConstant && this->BaseLoad) {
-        const llvm::Function *currentFunction = this->BaseLoad->getFunction();
+        auto *currentFunction = const_cast<llvm::Function *>(this->BaseLoad->getFunction());
         if (currentFunction) {
-            // Build dominator tree locally
-            llvm::DominatorTree dominatorTree(*const_cast<llvm::Function *>(currentFunction));
+            // Dominator tree and memory accesses are shared by all checks of the function
+            auto &dominatorTree = analysisManager->getResult<llvm::DominatorTreeAnalysis>(*currentFunction);
+            auto &accesses = LoopBound::Util::getMemoryAccessIndex(*currentFunction, *analysisManager);
 
             if (auto constValue =
-                LoopBound::Util::tryDeduceConstFromLoad(this->BaseLoad, dominatorTree, loopInfo)) {
+                LoopBound::Util::tryDeduceConstFromLoad(this->BaseLoad, dominatorTree, loopInfo, accesses)) {
                 auto combinedValue = *constValue + this->Offset;
                 if (MulBy) return combinedValue * MulBy.value();
                 if (DivBy) return combinedValue / DivBy.value();
@@ -71,6 +71,13 @@ bool DeltaInterval::isEmpty() const noexcept {
   return valueType == ValueType::EMPTY;
 }
 
+bool DeltaInterval::isUnbounded() const noexcept {
+  if (!isAdditive() && !isMultiplicative() && !isDivision()) {
+    return false;
+  }
+  return lowerBound == std::numeric_limits<int64_t>::min() || upperBound == std::numeric_limits<int64_t>::max();
+}
+
 bool DeltaInterval::isIdeNeutral() const {
   return isEmpty();
 }
@@ -10,13 +10,22 @@
 #include <phasar/DataFlow/IfdsIde/Solver/IDESolver.h>
 #include <phasar/PhasarLLVM/DB/LLVMProjectIRDB.h>
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "ConfigParser.h"
+#include "Logger.h"
+#include "ProgressReporter.h"
+#include "SelfEnergyMeter.h"
+#include "analyses/loopbound/BottomUpLoopBoundSolver.h"
 #include "analyses/loopbound/LoopBound.h"
+#include "analyses/loopbound/LoopBoundSummary.h"
+#include "analyses/loopbound/ParallelLoopBoundSolver.h"
 #include "analyses/loopbound/loopBoundWrapper.h"
 
 #include "analyses/loopbound/util.h"
@@ -48,6 +57,7 @@ LoopBound::LoopBoundWrapper::LoopBoundWrapper(const std::shared_ptr<psr::HelperA
             continue;
         }
 
+        SelfEnergyFunction selfEnergyFunction(F.getName().str());
         auto Cache = std::make_unique<LoopCache>(F);
 
         // Collect all Loop* from this function's LoopInfo
@@ -61,11 +71,35 @@ LoopBound::LoopBoundWrapper::LoopBoundWrapper(const std::shared_ptr<psr::HelperA
     this->problem = std::make_shared<LoopBoundIDEAnalysis>(
             LoopBound::LoopBoundIDEAnalysis(analysisManager, &helperAnalyses->getProjectIRDB(), this->Loops));
 
-    auto analysisResult = psr::solveIDEProblem(*this->problem, interproceduralCFG);
-    this->cachedResults = std::make_unique<ResultsTy>(std::move(analysisResult));
+    const auto loopboundMode = ConfigParser::getAnalysisConfiguration().loopboundconfig.mode;
+
+    if (loopboundMode == LoopBoundMode::BOTTOMUP) {
+        solveBottomUp(interproceduralCFG, *module);
+    } else if (loopboundMode == LoopBoundMode::COMPARE) {
+        compareModes(interproceduralCFG, *module);
+    } else {
+        solveProblem(interproceduralCFG);
+        this->loopClassifiers = buildClassifiers(nullptr);
+    }
+
+    logConvergence();
+
+    if (LoopBound::Util::LB_DebugEnabled) {
+        printClassifiers();
+    }
+}
+
+std::vector<LoopBound::LoopClassifier>
+LoopBound::LoopBoundWrapper::buildClassifiers(std::vector<ArgumentCheck> *argumentChecks) {
+    std::vector<LoopClassifier> classifiers;
+    this->widenedLoops = 0;
 
     const auto loopDescriptions = this->problem->getLoopParameterDescriptions();
 
+    // The solver covers the whole module, only the classification of the loops is attributed per function in the
+    // self-energy report. The meter is switched whenever the descriptions move on to another function
+    const llvm::Function *attributedFunction = nullptr;
+
     for (const auto &description : loopDescriptions) {
         if (!description.loop || !description.counterRoot || !description.icmp) {
             continue;
@@ -85,9 +119,17 @@ LoopBound::LoopBoundWrapper::LoopBoundWrapper(const std::shared_ptr<psr::HelperA
             continue;
         }
 
-        // Local DT and LoopInfo for the current parent function.
-        llvm::DominatorTree DT(*parentFunction);
-        llvm::LoopInfo loopInfo(DT);
+        if (parentFunction != attributedFunction) {
+            SelfEnergyMeter::getInstance().beginFunction(parentFunction->getName().str());
+            attributedFunction = parentFunction;
+        }
+
+        // Dominator tree, LoopInfo and memory accesses are built once per function and shared by all its loops
+        auto &loopCache = LoopCaches[parentFunction];
+        if (!loopCache) {
+            loopCache = std::make_unique<LoopCache>(*parentFunction);
+        }
+        llvm::LoopInfo &loopInfo = loopCache->LI;
 
         const llvm::Value *counterRoot = LoopBound::Util::stripAddr(description.counterRoot);
         if (!counterRoot) {
@@ -99,8 +141,8 @@ LoopBound::LoopBoundWrapper::LoopBoundWrapper(const std::shared_ptr<psr::HelperA
         auto incrementInterval = queryIntervalAtInstuction(incrementStore, counterRoot);
         auto predicate = description.icmp->getPredicate();
 
-        // Pass local DT and LoopInfo into helpers that need them.
-        auto checkExpression = findLoopCheckExpr(description, analysisManager, loopInfo);
+        // Pass the cached LoopInfo into helpers that need it.
+        auto checkExpression = findLoopCheckExpr(description, this->FAM, loopInfo);
         if (!checkExpression) {
             continue;
         }
@@ -109,28 +151,298 @@ LoopBound::LoopBoundWrapper::LoopBoundWrapper(const std::shared_ptr<psr::HelperA
 
         if (incrementInterval == std::nullopt) {
             loopType = LoopBound::UNKNOWN_LOOP;
+        } else if (incrementInterval->isUnbounded()) {
+            // A widened increment does not bound the loop
+            loopType = LoopBound::UNKNOWN_LOOP;
+            this->widenedLoops++;
+        }
+
+        // Symbolic counting loops whose check is based on a function argument are kept parameterized, so the
+        // bottom-up mode can instantiate them with the values passed at the call sites
+        if (argumentChecks != nullptr && loopType == LoopBound::SYMBOLIC_BOUND_LOOP && description.init &&
+            LoopBound::Util::loopIsCounting(description.loop, description.icmp)) {
+            auto checkArgument = LoopBoundSummaries::findCheckArgument(checkExpression.value(), *loopCache);
+            if (checkArgument) {
+                argumentChecks->push_back({classifiers.size(), checkArgument.value(), checkExpression.value()});
+            }
         }
 
         LoopClassifier newLoopClassifier(parentFunction, description.loop, incrementInterval, description.init,
-                                         predicate, checkExpression->calculateCheck(analysisManager, loopInfo),
+                                         predicate, checkExpression->calculateCheck(this->FAM, loopInfo),
                                          loopType);
 
-        this->loopClassifiers.push_back(std::move(newLoopClassifier));
+        classifiers.push_back(std::move(newLoopClassifier));
     }
 
-    if (LoopBound::Util::LB_DebugEnabled) {
-        printClassifiers();
+    if (attributedFunction) {
+        SelfEnergyMeter::getInstance().endFunction();
+    }
+
+    return classifiers;
+}
+
+void LoopBound::LoopBoundWrapper::solveBottomUp(psr::LLVMBasedICFG &interproceduralCFG, llvm::Module &module) {
+    auto bottomUpStart = std::chrono::high_resolution_clock::now();
+
+    // Every function is summarized once per counter, independent of the amount of contexts it is called from
+    this->bottomUpSolver = std::make_unique<BottomUpLoopBoundSolver>(*this->problem, interproceduralCFG, module);
+    this->bottomUpSolver->solve();
+    this->solverDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - bottomUpStart);
+
+    std::vector<ArgumentCheck> argumentChecks;
+    this->loopClassifiers = buildClassifiers(&argumentChecks);
+
+    LoopBoundSummaries summaries(module);
+    const size_t instantiatedLoops = summaries.instantiate(this->loopClassifiers, argumentChecks);
+
+    auto bottomUpEnd = std::chrono::high_resolution_clock::now();
+    auto bottomUpDuration = std::chrono::duration_cast<std::chrono::microseconds>(bottomUpEnd - bottomUpStart);
+
+    Logger::getInstance().log("Bottom-up loop bound analysis: summarized " +
+                                      std::to_string(this->bottomUpSolver->getNumberOfComponents()) +
+                                      " call graph components, " + std::to_string(argumentChecks.size()) +
+                                      " parameterized loops, " + std::to_string(instantiatedLoops) +
+                                      " bounded at their call sites, took " +
+                                      std::to_string(bottomUpDuration.count()) + "µs",
+                              LOGLEVEL::INFO);
+}
+
+void LoopBound::LoopBoundWrapper::compareModes(psr::LLVMBasedICFG &interproceduralCFG, llvm::Module &module) {
+    auto topDownStart = std::chrono::high_resolution_clock::now();
+    {
+        ProgressPhase progress("loopbound top-down solve", "flow functions", 0);
+        auto analysisResult = psr::solveIDEProblem(*this->problem, interproceduralCFG);
+        this->cachedResults = std::make_unique<ResultsTy>(std::move(analysisResult));
+    }
+    auto topDownClassifiers = buildClassifiers(nullptr);
+    auto topDownEnd = std::chrono::high_resolution_clock::now();
+    auto topDownDuration = std::chrono::duration_cast<std::chrono::microseconds>(topDownEnd - topDownStart);
+
+    auto bottomUpStart = std::chrono::high_resolution_clock::now();
+    solveBottomUp(interproceduralCFG, module);
+    auto bottomUpEnd = std::chrono::high_resolution_clock::now();
+    auto bottomUpDuration = std::chrono::duration_cast<std::chrono::microseconds>(bottomUpEnd - bottomUpStart);
+
+    std::unordered_map<const llvm::Loop *, std::optional<DeltaInterval>> bottomUpBounds;
+    for (const auto &classifier : this->loopClassifiers) {
+        bottomUpBounds[classifier.loop] = classifier.bound;
+    }
+
+    auto isComputed = [](const std::optional<DeltaInterval> &bound) {
+        return bound.has_value() && bound->valueType != DeltaInterval::ValueType::FALLBACK;
+    };
+
+    auto printBound = [](const std::optional<DeltaInterval> &bound) {
+        if (bound) {
+            llvm::errs() << bound.value();
+        } else {
+            llvm::errs() << "UNBOUND";
+        }
+    };
+
+    size_t identicalBounds = 0;
+    size_t refinedBounds = 0;
+    size_t differentBounds = 0;
+
+    for (const auto &classifier : topDownClassifiers) {
+        const auto &topDownBound = classifier.bound;
+        const auto &bottomUpBound = bottomUpBounds[classifier.loop];
+
+        if (topDownBound == bottomUpBound) {
+            identicalBounds++;
+        } else if (!isComputed(topDownBound) && isComputed(bottomUpBound)) {
+            refinedBounds++;
+        } else {
+            differentBounds++;
+
+            if (LoopBound::Util::LB_DebugEnabled) {
+                llvm::errs() << "[LB] mode mismatch in " << classifier.function->getName() << " loop "
+                             << classifier.loop->getName() << ": top-down ";
+                printBound(topDownBound);
+                llvm::errs() << " bottom-up ";
+                printBound(bottomUpBound);
+                llvm::errs() << "\n";
+            }
+        }
+    }
+
+    const double speedup = bottomUpDuration.count() > 0
+        ? static_cast<double>(topDownDuration.count()) / static_cast<double>(bottomUpDuration.count())
+        : 0.0;
+
+    Logger::getInstance().log("Loop bound mode comparison: top-down " + std::to_string(topDownDuration.count()) +
+                                      "µs, bottom-up " + std::to_string(bottomUpDuration.count()) + "µs (" +
+                                      std::to_string(speedup) + "x). Bounds identical: " +
+                                      std::to_string(identicalBounds) + ", refined by bottom-up: " +
+                                      std::to_string(refinedBounds) + ", different: " +
+                                      std::to_string(differentBounds),
+                              LOGLEVEL::INFO);
+
+    // Keep the top-down results as the results of the analysis
+    this->bottomUpSolver.reset();
+    this->loopClassifiers = std::move(topDownClassifiers);
+}
+
+void LoopBound::LoopBoundWrapper::solveProblem(psr::LLVMBasedICFG &interproceduralCFG) {
+    const auto loopboundConfiguration = ConfigParser::getAnalysisConfiguration().loopboundconfig;
+    const unsigned threadCount = loopboundConfiguration.threads > 1 ? loopboundConfiguration.threads : 1;
+
+    // Phasar is the default solver. DeltaInterval joins by hull, so its iteration terminates without widening.
+    // Phasar cannot widen, so an enabled widening always runs in our solver, even with a single thread
+    if (threadCount == 1 && loopboundConfiguration.widenAfter == 0) {
+        ProgressPhase progress("loopbound solve", "flow functions", 0);
+        auto analysisResult = psr::solveIDEProblem(*this->problem, interproceduralCFG);
+        this->cachedResults = std::make_unique<ResultsTy>(std::move(analysisResult));
+        return;
+    }
+
+    auto parallelStart = std::chrono::high_resolution_clock::now();
+    this->parallelSolver = std::make_unique<ParallelLoopBoundSolver>(*this->problem, interproceduralCFG, threadCount,
+                                                                     loopboundConfiguration.widenAfter,
+                                                                     loopboundConfiguration.narrowingRounds);
+    this->parallelSolver->solve();
+    auto parallelEnd = std::chrono::high_resolution_clock::now();
+    auto parallelDuration = std::chrono::duration_cast<std::chrono::microseconds>(parallelEnd - parallelStart);
+    this->solverDuration = parallelDuration;
+
+    Logger::getInstance().log("Loop bound analysis solved " +
+                                      std::to_string(this->parallelSolver->getNumberOfWorklists()) +
+                                      " counter worklists with " + std::to_string(threadCount) + " threads in " +
+                                      std::to_string(parallelDuration.count()) + "µs",
+                              LOGLEVEL::INFO);
+
+    if (!loopboundConfiguration.verifyParallel) {
+        return;
+    }
+
+    // Solve the problem serially as well to check the parallel fixed point and report the speedup
+    auto serialStart = std::chrono::high_resolution_clock::now();
+    ProgressPhase progress("loopbound verification", "flow functions", 0);
+    auto analysisResult = psr::solveIDEProblem(*this->problem, interproceduralCFG);
+    this->cachedResults = std::make_unique<ResultsTy>(std::move(analysisResult));
+    auto serialEnd = std::chrono::high_resolution_clock::now();
+    auto serialDuration = std::chrono::duration_cast<std::chrono::microseconds>(serialEnd - serialStart);
+
+    const double speedup = parallelDuration.count() > 0
+        ? static_cast<double>(serialDuration.count()) / static_cast<double>(parallelDuration.count())
+        : 0.0;
+
+    Logger::getInstance().log("Loop bound analysis serial: " + std::to_string(serialDuration.count()) +
+                                      "µs, parallel: " + std::to_string(parallelDuration.count()) + "µs, speedup: " +
+                                      std::to_string(speedup) + "x with " + std::to_string(threadCount) + " threads",
+                              LOGLEVEL::INFO);
+
+    const size_t mismatches = verifyParallelResults();
+    if (mismatches > 0) {
+        Logger::getInstance().log("Loop bound analysis: parallel solver disagrees with the serial solver at " +
+                                          std::to_string(mismatches) + " points. Using the serial results",
+                                  LOGLEVEL::WARNING);
+        this->parallelSolver.reset();
+    }
+}
+
+void LoopBound::LoopBoundWrapper::logConvergence() const {
+    size_t skippedLoops = 0;
+    for (const auto &description : this->problem->getLoopParameterDescriptions()) {
+        if (!description.hasAffineCounter) {
+            skippedLoops++;
+        }
+    }
+
+    std::string message = "Loop bound analysis: " + std::to_string(skippedLoops) +
+                          " loops without an affine counter were not seeded";
+
+    if (this->parallelSolver || this->bottomUpSolver) {
+        const auto statistics = this->parallelSolver ? this->parallelSolver->getStatistics()
+                                                     : this->bottomUpSolver->getStatistics();
+        message += ", " + std::to_string(statistics.iterations) + " iterations, " +
+                   std::to_string(statistics.joins) + " joins, " + std::to_string(statistics.widenings) +
+                   " widenings, " + std::to_string(statistics.narrowingRounds) + " narrowing rounds, " +
+                   std::to_string(statistics.summaries) + " callee summaries in " +
+                   std::to_string(this->solverDuration.count()) + "µs";
     }
+
+    message += ", " + std::to_string(this->widenedLoops) + " loops reclassified as unknown after widening";
+
+    Logger::getInstance().log(message, LOGLEVEL::INFO);
+}
+
+size_t LoopBound::LoopBoundWrapper::verifyParallelResults() const {
+    if (!this->parallelSolver || !this->cachedResults) {
+        return 0;
+    }
+
+    // Top, bottom and empty intervals are treated as "no information" by all queries, so they are compared as equal
+    auto normalize = [](const DeltaInterval &intervalValue) -> std::optional<DeltaInterval> {
+        if (intervalValue.isBottom() || intervalValue.isTop() || intervalValue.isEmpty()) {
+            return std::nullopt;
+        }
+        return intervalValue;
+    };
+
+    const auto &parallelResults = this->parallelSolver->getResults();
+    auto hasParallelValue = [&parallelResults](const llvm::Instruction *instruction, const llvm::Value *fact) {
+        auto instructionIterator = parallelResults.find(instruction);
+        return instructionIterator != parallelResults.end() && instructionIterator->second.contains(fact);
+    };
+
+    size_t mismatches = 0;
+    auto compare = [&](const llvm::Instruction *instruction, const DeltaInterval &serialValue,
+                       const DeltaInterval &parallelValue) {
+        if (normalize(serialValue) == normalize(parallelValue)) {
+            return;
+        }
+
+        mismatches++;
+        if (LoopBound::Util::LB_DebugEnabled) {
+            llvm::errs() << "[LB] parallel mismatch at " << *instruction << ": serial " << serialValue
+                         << " parallel " << parallelValue << "\n";
+        }
+    };
+
+    for (const auto &[instruction, valuesAtInstruction] : parallelResults) {
+        for (const auto &[fact, parallelValue] : valuesAtInstruction) {
+            compare(instruction, this->cachedResults->resultAt(instruction, fact), parallelValue);
+        }
+    }
+
+    // The serial solver also carries the counters of a caller through its callees. Only the counters of the function
+    // an instruction belongs to are queried, so the other direction is restricted to these
+    std::unordered_map<const llvm::Function *, std::unordered_set<const llvm::Value *>> countersPerFunction;
+    for (const auto &description : this->problem->getLoopParameterDescriptions()) {
+        if (description.function && description.counterRoot) {
+            countersPerFunction[description.function].insert(description.counterRoot);
+        }
+    }
+
+    for (const auto &[function, counters] : countersPerFunction) {
+        for (const llvm::BasicBlock &block : *function) {
+            for (const llvm::Instruction &instruction : block) {
+                for (const llvm::Value *counter : counters) {
+                    // Values the parallel solver computed were compared above
+                    if (!hasParallelValue(&instruction, counter)) {
+                        compare(&instruction, this->cachedResults->resultAt(&instruction, counter),
+                                DeltaInterval::bottom());
+                    }
+                }
+            }
+        }
+    }
+
+    return mismatches;
 }
 
 std::optional<int64_t> LoopBound::CheckExpr::calculateCheck(llvm::FunctionAnalysisManager *analysisManager,
                                                             llvm::LoopInfo &loopInfo) {
     if (!this->isConstant && this->BaseLoad) {
-        const llvm::Function *currentFunction = this->BaseLoad->getFunction();
+        auto *currentFunction = const_cast<llvm::Function *>(this->BaseLoad->getFunction());
         if (currentFunction) {
-            llvm::DominatorTree dominatorTree(*const_cast<llvm::Function *>(currentFunction));
+            auto &dominatorTree = analysisManager->getResult<llvm::DominatorTreeAnalysis>(*currentFunction);
+            auto &accesses = LoopBound::Util::getMemoryAccessIndex(*currentFunction, *analysisManager);
 
-            if (auto constValue = LoopBound::Util::tryDeduceConstFromLoad(this->BaseLoad, dominatorTree, loopInfo)) {
+            if (auto constValue =
+                    LoopBound::Util::tryDeduceConstFromLoad(this->BaseLoad, dominatorTree, loopInfo, accesses)) {
                 auto combinedValue = *constValue + this->Offset;
                 if (MulBy) {
                     return combinedValue * MulBy.value();
@@ -165,7 +477,7 @@ void LoopBound::LoopBoundWrapper::collectLoops(llvm::Loop *loop, std::vector<llv
 
 bool LoopBound::LoopBoundWrapper::hasCachedValueAt(const llvm::Instruction *instruction,
                                                    const llvm::Value *factValue) const {
-    if (!this->cachedResults || !instruction || !factValue) {
+    if ((!this->cachedResults && !this->parallelSolver && !this->bottomUpSolver) || !instruction || !factValue) {
         return false;
     }
 
@@ -174,6 +486,12 @@ bool LoopBound::LoopBoundWrapper::hasCachedValueAt(const llvm::Instruction *inst
         return false;
     }
 
+    if (this->parallelSolver || this->bottomUpSolver) {
+        auto solverValue = solverResultAt(instruction, cleanFact);
+        return solverValue.has_value() && !solverValue->isBottom() && !solverValue->isTop() &&
+               !solverValue->isEmpty();
+    }
+
     const auto &results = *this->cachedResults;
     const auto &resultsAtInst = results.resultsAt(instruction);
 
@@ -189,7 +507,7 @@ bool LoopBound::LoopBoundWrapper::hasCachedValueAt(const llvm::Instruction *inst
 std::optional<LoopBound::DeltaInterval>
 LoopBound::LoopBoundWrapper::queryIntervalAtInstuction(const llvm::Instruction *instruction,
                                                        const llvm::Value *factValue) {
-    if (!instruction || !factValue || !this->cachedResults) {
+    if (!instruction || !factValue || (!this->cachedResults && !this->parallelSolver && !this->bottomUpSolver)) {
         return std::nullopt;
     }
 
@@ -198,6 +516,14 @@ LoopBound::LoopBoundWrapper::queryIntervalAtInstuction(const llvm::Instruction *
         return std::nullopt;  // Invalid fact
     }
 
+    if (this->parallelSolver || this->bottomUpSolver) {
+        auto solverValue = solverResultAt(instruction, cleanFact);
+        if (!solverValue || solverValue->isBottom() || solverValue->isTop() || solverValue->isEmpty()) {
+            return std::nullopt;
+        }
+        return solverValue;
+    }
+
     auto intervalValue = this->cachedResults->resultAt(instruction, cleanFact);
 
     if (intervalValue.isBottom() || intervalValue.isTop() || intervalValue.isEmpty()) {
@@ -206,6 +532,17 @@ LoopBound::LoopBoundWrapper::queryIntervalAtInstuction(const llvm::Instruction *
     return intervalValue;
 }
 
+std::optional<LoopBound::DeltaInterval> LoopBound::LoopBoundWrapper::solverResultAt(
+    const llvm::Instruction *instruction, const llvm::Value *fact) const {
+    if (this->parallelSolver) {
+        return this->parallelSolver->resultAt(instruction, fact);
+    }
+    if (this->bottomUpSolver) {
+        return this->bottomUpSolver->resultAt(instruction, fact);
+    }
+    return std::nullopt;
+}
+
 const llvm::StoreInst *
 LoopBound::LoopBoundWrapper::findStoreIncOfLoop(const LoopBound::LoopParameterDescription &description) {
     if (!description.loop || !description.counterRoot) {
@@ -363,8 +700,9 @@ LoopBound::LoopBoundWrapper::findLoopCheckExpr(const LoopBound::LoopParameterDes
     // 3) load -> try deduce const
     if (auto *LI = llvm::dyn_cast<llvm::LoadInst>(otherSideValue)) {
         if (auto *F = const_cast<llvm::Function *>(LI->getFunction())) {
-            llvm::DominatorTree DT(*F);
-            if (auto CV = LoopBound::Util::tryDeduceConstFromLoad(LI, DT, loopInfo)) {
+            auto &DT = analysisManager->getResult<llvm::DominatorTreeAnalysis>(*F);
+            auto &accesses = LoopBound::Util::getMemoryAccessIndex(*F, *analysisManager);
+            if (auto CV = LoopBound::Util::tryDeduceConstFromLoad(LI, DT, loopInfo, accesses)) {
                 return LoopBound::CheckExpr{nullptr, nullptr, *CV, false, false};
             }
         }
@@ -491,5 +829,9 @@ std::optional<LoopBound::CheckExpr> LoopBound::LoopBoundWrapper::peelBasePlusCon
 }
 
 std::unique_ptr<LoopBound::ResultsTy> LoopBound::LoopBoundWrapper::getResults() const {
+    // The parallel solver does not produce Phasar results
+    if (!this->cachedResults) {
+        return nullptr;
+    }
     return std::make_unique<ResultsTy>(*this->cachedResults);
 }
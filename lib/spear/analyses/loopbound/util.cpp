@@ -3,6 +3,7 @@
  * All rights reserved.
 */
 
+#include <llvm/ADT/DepthFirstIterator.h>
 #include <llvm/IR/Operator.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Analysis/ConstantFolding.h>
@@ -231,66 +232,97 @@ const llvm::ConstantInt *tryEvalToConstInt(const llvm::Value *value) {
     return llvm::ConstantInt::get(binOp->getType()->getContext(), resultValue);
 }
 
-const llvm::StoreInst *findDominatingStoreToObject(const llvm::LoadInst *loadInst,
-                                                   const llvm::Value *object,
-                                                   llvm::DominatorTree &dominatorTree) {
-    if (!loadInst || !object) {
-        return nullptr;
+MemoryAccessIndex::MemoryAccessIndex(const llvm::Function &function, const llvm::DominatorTree &dominatorTree) {
+    // Parents are visited before their children in the dominator tree, so dominating accesses are listed first
+    for (const llvm::DomTreeNode *treeNode : llvm::depth_first(dominatorTree.getRootNode())) {
+        indexBlock(*treeNode->getBlock());
     }
 
-    const llvm::StoreInst *bestStore = nullptr;
+    for (const llvm::BasicBlock &basicBlock : function) {
+        if (!dominatorTree.isReachableFromEntry(&basicBlock)) {
+            indexBlock(basicBlock);
+        }
+    }
+}
 
-    const llvm::Function *function = loadInst->getFunction();
-    if (!function) {
-        return nullptr;
+void MemoryAccessIndex::indexBlock(const llvm::BasicBlock &basicBlock) {
+    for (const llvm::Instruction &instruction : basicBlock) {
+        if (auto *storeInst = llvm::dyn_cast<llvm::StoreInst>(&instruction)) {
+            storesByObject[getUnderlyingObject(storeInst->getPointerOperand())].push_back(storeInst);
+        } else if (auto *loadInst = llvm::dyn_cast<llvm::LoadInst>(&instruction)) {
+            loadsByObject[getUnderlyingObject(loadInst->getPointerOperand())].push_back(loadInst);
+        }
     }
+}
 
-    for (const llvm::BasicBlock &basicBlock : *function) {
-        for (const llvm::Instruction &instruction : basicBlock) {
-            auto *storeInst = llvm::dyn_cast<llvm::StoreInst>(&instruction);
-            if (!storeInst) {
-                continue;
-            }
+const std::vector<const llvm::StoreInst *> &MemoryAccessIndex::getStores(const llvm::Value *object) const {
+    static const std::vector<const llvm::StoreInst *> noStores;
 
-            const llvm::Value *storeObject = getUnderlyingObject(storeInst->getPointerOperand());
-            if (!storeObject || storeObject != object) {
-                continue;
-            }
+    auto storesIt = storesByObject.find(object);
+    return storesIt != storesByObject.end() ? storesIt->second : noStores;
+}
 
-            if (!dominatorTree.dominates(storeInst, loadInst)) {
-                continue;
-            }
+const std::vector<const llvm::LoadInst *> &MemoryAccessIndex::getLoads(const llvm::Value *object) const {
+    static const std::vector<const llvm::LoadInst *> noLoads;
 
-            if (!bestStore) {
-                bestStore = storeInst;
-                continue;
-            }
+    auto loadsIt = loadsByObject.find(object);
+    return loadsIt != loadsByObject.end() ? loadsIt->second : noLoads;
+}
 
-            if (dominatorTree.dominates(bestStore, storeInst)) {
-                bestStore = storeInst;
-                continue;
-            }
+bool MemoryAccessIndex::isWrittenInLoop(const llvm::Value *object, const llvm::Loop *loop) const {
+    if (!object || !loop) {
+        return false;
+    }
 
-            if (storeInst->getParent() == loadInst->getParent() && bestStore->getParent() == loadInst->getParent()) {
-                const llvm::BasicBlock *block = loadInst->getParent();
-                const llvm::StoreInst *lastSeenStore = nullptr;
-                for (const llvm::Instruction &currentInst : *block) {
-                    if (&currentInst == bestStore)
-                        lastSeenStore = bestStore;
-                    if (&currentInst == storeInst)
-                        lastSeenStore = storeInst;
-                    if (&currentInst == loadInst)
-                        break;
-                }
-                bestStore = lastSeenStore;
-            } else if (storeInst->getParent() == loadInst->getParent() && bestStore->getParent() != loadInst->
-                       getParent()) {
-                bestStore = storeInst;
-            }
+    for (const llvm::StoreInst *storeInst : getStores(object)) {
+        if (loop->contains(storeInst->getParent())) {
+            return true;
         }
     }
 
-    return bestStore;
+    return false;
+}
+
+const llvm::StoreInst *MemoryAccessIndex::findDominatingStore(const llvm::LoadInst *loadInst,
+                                                              const llvm::Value *object,
+                                                              const llvm::DominatorTree &dominatorTree) const {
+    if (!loadInst || !object) {
+        return nullptr;
+    }
+
+    // The stores dominating the load form a chain in dominance order, the last one is executed right before the load
+    const auto &stores = getStores(object);
+    for (auto storeIt = stores.rbegin(); storeIt != stores.rend(); ++storeIt) {
+        if (dominatorTree.dominates(*storeIt, loadInst)) {
+            return *storeIt;
+        }
+    }
+
+    return nullptr;
+}
+
+bool MemoryAccessIndex::invalidate(llvm::Function &function, const llvm::PreservedAnalyses &preservedAnalyses,
+                                   llvm::FunctionAnalysisManager::Invalidator &invalidator) {
+    auto checker = preservedAnalyses.getChecker<MemoryAccessAnalysis>();
+    if (!checker.preserved() && !checker.preservedSet<llvm::AllAnalysesOn<llvm::Function>>()) {
+        return true;
+    }
+
+    return invalidator.invalidate<llvm::DominatorTreeAnalysis>(function, preservedAnalyses);
+}
+
+llvm::AnalysisKey MemoryAccessAnalysis::Key;
+
+MemoryAccessIndex MemoryAccessAnalysis::run(llvm::Function &function,
+                                            llvm::FunctionAnalysisManager &analysisManager) {
+    return MemoryAccessIndex(function, analysisManager.getResult<llvm::DominatorTreeAnalysis>(function));
+}
+
+const MemoryAccessIndex &getMemoryAccessIndex(llvm::Function &function,
+                                              llvm::FunctionAnalysisManager &analysisManager) {
+    // Does nothing if the analysis is registered already
+    analysisManager.registerPass([] { return MemoryAccessAnalysis(); });
+    return analysisManager.getResult<MemoryAccessAnalysis>(function);
 }
 
 const llvm::ICmpInst *peelToICmp(const llvm::Value *value) {
@@ -347,7 +379,8 @@ const llvm::Value *getMemRootFromValue(const llvm::Value *value) {
 }
 
 std::optional<int64_t> tryDeduceConstFromLoad(
-    const llvm::LoadInst *loadInst, llvm::DominatorTree &dominatorTree, llvm::LoopInfo &loopInfo) {
+    const llvm::LoadInst *loadInst, llvm::DominatorTree &dominatorTree, llvm::LoopInfo &loopInfo,
+    const MemoryAccessIndex &accesses) {
     if (!loadInst)
         return std::nullopt;
 
@@ -355,24 +388,16 @@ std::optional<int64_t> tryDeduceConstFromLoad(
     if (!object)
         return std::nullopt;
 
-    llvm::Loop *currentLoop = loopInfo.getLoopFor(loadInst->getParent());
-    if (currentLoop) {
-        for (llvm::Loop *loopLevel = currentLoop; loopLevel != nullptr; loopLevel = loopLevel->getParentLoop()) {
-            for (llvm::BasicBlock *loopBlock : loopLevel->blocks()) {
-                for (llvm::Instruction &instruction : *loopBlock) {
-                    auto *storeInst = llvm::dyn_cast<llvm::StoreInst>(&instruction);
-                    if (!storeInst)
-                        continue;
-                    const llvm::Value *storeDestination = stripAddr(storeInst->getPointerOperand());
-                    if (storeDestination == object) {
-                        return std::nullopt;
-                    }
-                }
-            }
-        }
+    // Every enclosing loop is contained in the outermost one, checking it covers all loop levels
+    llvm::Loop *outermostLoop = loopInfo.getLoopFor(loadInst->getParent());
+    while (outermostLoop && outermostLoop->getParentLoop()) {
+        outermostLoop = outermostLoop->getParentLoop();
+    }
+    if (accesses.isWrittenInLoop(object, outermostLoop)) {
+        return std::nullopt;
     }
 
-    const llvm::StoreInst *definingStore = findDominatingStoreToObject(loadInst, object, dominatorTree);
+    const llvm::StoreInst *definingStore = accesses.findDominatingStore(loadInst, object, dominatorTree);
     if (!definingStore)
         return std::nullopt;
 
@@ -24,6 +24,7 @@ char LICENSE[] SEC("license") = "";
  *
  */
 struct evt {
+    __u64 ts;     // bpf_ktime_get_ns(), used by the consumer to interpolate the energy
     __u32 tid;
     __u32 id;
     __u8  type;   // 0 = enter, 1 = exit, 2=switch_out, 3=switch_in
@@ -46,6 +47,24 @@ struct {
     __type(value, __u32);
 } ignore_tgid_map SEC(".maps");
 
+// 1-element per-CPU array counting events that did not fit into the ring buffer
+struct {
+    __uint(type, BPF_MAP_TYPE_PERCPU_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, __u32);
+    __type(value, __u64);
+} dropped_events SEC(".maps");
+
+/**
+ * Count an event the ring buffer had no space for
+ */
+static __always_inline void count_drop(void) {
+    __u32 key = 0;
+    __u64 *dropped = bpf_map_lookup_elem(&dropped_events, &key);
+    if (dropped)
+        *dropped += 1;
+}
+
 /**
  * Task ID ingoring handler
  */
@@ -71,9 +90,11 @@ int tp_sys_enter(struct trace_event_raw_sys_enter *ctx) {
 
     struct evt *e = bpf_ringbuf_reserve(&rb, sizeof(*e), 0);
     if (!e) {
+        count_drop();
         return 0;
     }
 
+    e->ts   = bpf_ktime_get_ns();
     e->tid  = (__u32) bpf_get_current_pid_tgid();
     e->id   = (__u32) ctx->id;
     e->type = 0;
@@ -87,9 +108,14 @@ int tp_sched_switch(struct trace_event_raw_sched_switch *ctx) {
     // ctx->prev_pid  : TID being switched out
     // ctx->next_pid  : TID being switched in
 
+    __u64 ts = bpf_ktime_get_ns();
+
     // Emit SWITCH_OUT for prev
     struct evt *e = bpf_ringbuf_reserve(&rb, sizeof(*e), 0);
-    if (e) {
+    if (!e) {
+        count_drop();
+    } else {
+        e->ts   = ts;
         e->tid  = (__u32) ctx->prev_pid;
         e->id   = 0;
         e->type = 2;  // switch_out
@@ -98,7 +124,10 @@ int tp_sched_switch(struct trace_event_raw_sched_switch *ctx) {
 
     // Emit SWITCH_IN for next
     e = bpf_ringbuf_reserve(&rb, sizeof(*e), 0);
-    if (e) {
+    if (!e) {
+        count_drop();
+    } else {
+        e->ts   = ts;
         e->tid  = (__u32) ctx->next_pid;
         e->id   = 0;
         e->type = 3;  // switch_in
@@ -119,9 +148,11 @@ int tp_sys_exit(struct trace_event_raw_sys_exit *ctx) {
 
     struct evt *e = bpf_ringbuf_reserve(&rb, sizeof(*e), 0);
     if (!e) {
+        count_drop();
         return 0;
     }
 
+    e->ts   = bpf_ktime_get_ns();
     e->tid  = (__u32) bpf_get_current_pid_tgid();
     e->id   = (__u32) ctx->id;
     e->type = 1;
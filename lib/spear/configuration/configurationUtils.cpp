@@ -68,6 +68,40 @@ AnalysisOutputMode ConfigurationUtils::strToAnalysisOutputmode(const std::string
     }
 }
 
+SweepMode ConfigurationUtils::strToSweepMode(const std::string& str) {
+    if (str == "fallback") {
+        return SweepMode::FALLBACK;
+    } else if (str == "scale") {
+        return SweepMode::SCALE;
+    } else {
+        return SweepMode::UNDEFINED;
+    }
+}
+
+LoopBoundMode ConfigurationUtils::strToLoopBoundMode(const std::string& str) {
+    if (str == "topdown") {
+        return LoopBoundMode::TOPDOWN;
+    } else if (str == "bottomup") {
+        return LoopBoundMode::BOTTOMUP;
+    } else if (str == "compare") {
+        return LoopBoundMode::COMPARE;
+    } else {
+        return LoopBoundMode::UNDEFINED;
+    }
+}
+
+EnergySource ConfigurationUtils::strToEnergySource(const std::string& str) {
+    if (str == "auto") {
+        return EnergySource::AUTO;
+    } else if (str == "rapl") {
+        return EnergySource::RAPL;
+    } else if (str == "mock") {
+        return EnergySource::MOCK;
+    } else {
+        return EnergySource::UNDEFINED;
+    }
+}
+
 void ConfigurationUtils::convertStringToLowercase(std::string& inputString) {
     std::transform(inputString.begin(), inputString.end(), inputString.begin(),
                    [](unsigned char character) {
@@ -335,9 +335,6 @@ json CPUProfiler::profile() {
     this->log("Profiling will be performed for the following k values: " + regressionValues);
 
 
-    json profmapping = json::object();
-    std::vector<std::map<std::string, double>> allResults;
-
     // Perform a single measurement for each instruction to estimate runtime.
     auto estimateStart = std::chrono::steady_clock::now();
 
@@ -368,36 +365,97 @@ json CPUProfiler::profile() {
 
     this->log("Estimated finish time: " + std::string(std::ctime(&finishTimeT)));
 
+    // On hybrid CPUs every core type gets its own cost table. The clusters run concurrently if every core has its
+    // own energy counter, otherwise the shared counter forces them to be measured one after another
+    const auto& coreTypes = topology.getCoreTypes();
+    const bool concurrentClusters = topology.isHybrid() && RegisterReader::hasPerCoreCounter();
+
+    std::vector<std::vector<int>> clusters;
+    for (const auto& coreType : coreTypes) {
+        clusters.push_back(coreType.cpus);
+    }
+
+    if (topology.isHybrid()) {
+        this->log("Hybrid CPU detected, profiling " + std::to_string(coreTypes.size()) + " core types " +
+            (concurrentClusters ? "concurrently" : "sequentially"));
+    }
+
+    std::vector<std::vector<std::map<std::string, double>>> coreTypeResults(coreTypes.size());
+
     for (int i = 0; i < ks.size(); i++) {
         int iterations = ks[i];
 
-        std::map<std::string, double> results;
-        std::map<std::string, std::vector<double>> measurements = std::map<std::string, std::vector<double>>();
+        std::vector<std::map<std::string, std::vector<double>>> measurements(coreTypes.size());
 
         for (const auto& [key, value] : _profileCode) {
-            std::vector<double> measuredEnergy = this->_measureFile(value, iterations);
-            measurements[key] = measuredEnergy;
+            if (!topology.isHybrid()) {
+                measurements[0][key] = this->_measureFile(value, iterations);
+            } else if (concurrentClusters) {
+                auto clusterEnergy = this->_measureClusters(value, iterations, clusters, true);
+                for (size_t type = 0; type < coreTypes.size(); type++) {
+                    measurements[type][key] = clusterEnergy[type];
+                }
+            } else {
+                for (size_t type = 0; type < coreTypes.size(); type++) {
+                    measurements[type][key] = this->_measureClusters(value, iterations, {clusters[type]}, false)[0];
+                }
+            }
         }
 
-        for (const auto& [key, value] : _profileCode) {
-            double median = _median(measurements[key]);
-            results[key] = median;
+        for (size_t type = 0; type < coreTypes.size(); type++) {
+            std::map<std::string, double> results;
+            for (const auto& [key, value] : _profileCode) {
+                double median = _median(measurements[type][key]);
+                results[key] = median;
+            }
+
+            coreTypeResults[type].push_back(results);
         }
+    }
 
-        allResults.push_back(results);
+    // The fastest core type provides the default table, the analysis can select another one by name
+    coreTypeProfiles = json::object();
+    for (size_t type = 1; type < coreTypes.size(); type++) {
+        coreTypeProfiles[coreTypes[type].name] = _costTable(coreTypeResults[type], ks);
     }
 
+    json profmapping = _costTable(coreTypeResults[0], ks);
+    if (topology.isHybrid()) {
+        coreTypeProfiles[coreTypes[0].name] = profmapping;
+    }
+
+    this->log("CPU profiling finished!");
+    return profmapping;
+}
+
+json CPUProfiler::_costTable(const std::vector<std::map<std::string, double>>& allResults,
+                             const std::vector<int>& ks) {
+    json profmapping = json::object();
+
     // Calculate regression parameters for each instruction based on the measurements
     auto regressions = _regression(allResults, ks);
 
 
+    double MIN_INST_ENERGY = ConfigParser::getProfilingConfiguration().min_instruction_energy;
+
+    // Programs generated with --calibrate contain the _overhead kernel, which runs the loop and sink skeleton of the
+    // instruction kernels without the instruction. Its slope is the skeleton cost per repetition.
+    double overhead = 0.0;
+    if (auto overheadIt = regressions.find("_overhead"); overheadIt != regressions.end()) {
+        overhead = overheadIt->second.first;
+    }
+
     // Collect the slope and intercept for each instruction and store them in the final profile mapping.
     // We also calculate a constant offset for the program energy based on the intercepts of all instructions,
     // as they all include the base energy of the program. We use the median of the intercepts to mitigate
     // potential outliers.
     std::vector<double> intercepts;
     for (const auto& [instr, coeff] : regressions) {
-        profmapping[instr] = coeff.first;
+        if (instr == "_overhead") {
+            profmapping[instr] = coeff.first;
+        } else {
+            profmapping[instr] = std::max(coeff.first - overhead, MIN_INST_ENERGY);
+        }
         intercepts.push_back(coeff.second);
     }
 
@@ -405,9 +463,8 @@ json CPUProfiler::profile() {
     // This offset represents the base energy consumption of the program
     double constanteOffset = _median(intercepts);
     profmapping["_programoffset"] = constanteOffset;
-    profmapping["_unknown_cost"] = ConfigParser::getProfilingConfiguration().min_instruction_energy;
+    profmapping["_unknown_cost"] = MIN_INST_ENERGY;
 
-    this->log("CPU profiling finished!");
     return profmapping;
 }
 
@@ -432,15 +489,50 @@ std::vector<double> CPUProfiler::_movingAverage(const std::vector<double>& data,
 }
 
 std::vector<double> CPUProfiler::_measureFile(const std::string& file, uint64_t runtime) const {
-    std::vector<double> results;
-    results.reserve(runtime * number_of_cores);
+    std::vector<int> cores;
+    for (int core = 0; core < number_of_cores; core++) {
+        cores.push_back(core);
+    }
+
+    return _measureClusters(file, runtime, {cores}, false)[0];
+}
+
+std::vector<std::vector<double>> CPUProfiler::_measureClusters(const std::string& file, uint64_t runtime,
+                                                                const std::vector<std::vector<int>>& clusters,
+                                                                bool perCoreCounters) const {
+    std::vector<std::vector<double>> results(clusters.size());
 
     #ifdef __linux__
-    RegisterReader powReader(0);
+    // Flatten the clusters, every CPU runs one instance of the program per iteration
+    std::vector<int> cpus;
+    std::vector<size_t> clusterOfCpu;
+    for (size_t cluster = 0; cluster < clusters.size(); cluster++) {
+        for (int cpu : clusters[cluster]) {
+            cpus.push_back(cpu);
+            clusterOfCpu.push_back(cluster);
+        }
+        results[cluster].reserve(runtime * clusters[cluster].size());
+    }
+
+    const size_t instances = cpus.size();
+
+    // A package counter sees all instances at once, a per-core counter only the instance on its core
+    std::vector<RegisterReader> powReaders;
+    if (perCoreCounters) {
+        for (int cpu : cpus) {
+            powReaders.emplace_back(cpu);
+        }
+    } else {
+        powReaders.emplace_back(0);
+    }
+
+    auto readerOf = [&powReaders, perCoreCounters](size_t instance) -> RegisterReader& {
+        return powReaders[perCoreCounters ? instance : 0];
+    };
 
     // Shared memory for initial energy values of each child
     double* sharedEnergyBefore = reinterpret_cast<double*>(mmap(nullptr,
-                                                number_of_cores * sizeof(double),
+                                                instances * sizeof(double),
                                                 PROT_READ | PROT_WRITE,
                                                 MAP_SHARED | MAP_ANONYMOUS,
                                                 -1, 0));
@@ -459,66 +551,66 @@ std::vector<double> CPUProfiler::_measureFile(const std::string& file, uint64_t
     }
 
     for (uint64_t it = 0; it < iters; /* manual increment inside */) {
-        std::vector<pid_t> pids(number_of_cores);
+        std::vector<pid_t> pids(instances);
         bool validIteration = true;
 
-        // Launch processes: one on each core
-        for (int core = 0; core < number_of_cores; core++) {
+        // Launch processes: one on each core of each cluster
+        for (size_t instance = 0; instance < instances; instance++) {
             pid_t pid = fork();
 
             if (pid == 0) {
                 cpu_set_t mask;
                 CPU_ZERO(&mask);
-                CPU_SET(core, &mask);
+                CPU_SET(cpus[instance], &mask);
 
                 if (sched_setaffinity(0, sizeof(mask), &mask) == -1) {
                     perror("sched_setaffinity (child)");
                     exit(1);
                 }
 
-                sharedEnergyBefore[core] = powReader.getEnergy();
+                sharedEnergyBefore[instance] = readerOf(instance).getEnergy();
 
                 if (execv(file.c_str(), args) == -1) {
                     perror("execv");
                     exit(1);
                 }
             } else if (pid > 0) {
-                pids[core] = pid;
+                pids[instance] = pid;
             } else {
                 perror("fork");
                 exit(1);
             }
         }
 
-        std::vector<double> iterationResults(number_of_cores);
+        std::vector<double> iterationResults(instances);
 
-        for (int core = 0; core < number_of_cores; core++) {
-            waitpid(pids[core], nullptr, 0);
+        for (size_t instance = 0; instance < instances; instance++) {
+            waitpid(pids[instance], nullptr, 0);
 
-            double after = powReader.getEnergy();
-            double before = sharedEnergyBefore[core];
+            double after = readerOf(instance).getEnergy();
+            double before = sharedEnergyBefore[instance];
             double diff = after - before;
 
             if (diff <= 0) {
                 validIteration = false;
             }
 
-            iterationResults[core] = diff / number_of_cores;
+            iterationResults[instance] = perCoreCounters ? diff : diff / static_cast<double>(instances);
         }
 
         if (!validIteration) {
             continue;
         }
 
-        for (int core = 0; core < number_of_cores; core++) {
-            results.push_back(iterationResults[core]);
+        for (size_t instance = 0; instance < instances; instance++) {
+            results[clusterOfCpu[instance]].push_back(iterationResults[instance]);
         }
 
         it++;
     }
 
+    munmap(sharedEnergyBefore, instances * sizeof(double));
     #endif
 
     return results;
 }
-
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+*/
+
+#include "profilers/CPUTopology.h"
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+std::vector<int> CPUTopology::parseCpuList(const std::string &cpuList) {
+    std::set<int> cpus;
+
+    size_t position = 0;
+    while (position < cpuList.size()) {
+        size_t end = cpuList.find(',', position);
+        if (end == std::string::npos) {
+            end = cpuList.size();
+        }
+
+        const std::string range = cpuList.substr(position, end - position);
+        position = end + 1;
+
+        const size_t first = range.find_first_of("0123456789");
+        if (first == std::string::npos) {
+            continue;
+        }
+
+        try {
+            const size_t dash = range.find('-', first);
+            const int low = std::stoi(range.substr(first));
+            const int high = dash == std::string::npos ? low : std::stoi(range.substr(dash + 1));
+
+            for (int cpu = low; cpu <= high; cpu++) {
+                cpus.insert(cpu);
+            }
+        } catch (const std::exception &) {
+            // Malformed ranges are skipped, sysfs does not produce them
+        }
+    }
+
+    return {cpus.begin(), cpus.end()};
+}
+
+bool CPUTopology::readLine(const std::filesystem::path &path, std::string &content) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    return static_cast<bool>(std::getline(file, content));
+}
+
+bool CPUTopology::detectPmuCoreTypes(const std::filesystem::path &sysfsRoot) {
+    // Ordered from the fastest to the slowest core type
+    const std::vector<std::pair<std::string, std::string>> pmus = {
+        {"cpu_core", "performance"},
+        {"cpu_atom", "efficiency"},
+        {"cpu_lowpower", "lowpower"},
+    };
+
+    for (const auto &[pmu, name] : pmus) {
+        std::string cpuList;
+        if (!readLine(sysfsRoot / "devices" / pmu / "cpus", cpuList)) {
+            continue;
+        }
+
+        auto cpus = parseCpuList(cpuList);
+        if (!cpus.empty()) {
+            coreTypes.push_back({name, cpus});
+        }
+    }
+
+    return !coreTypes.empty();
+}
+
+bool CPUTopology::detectCapacityCoreTypes(const std::filesystem::path &sysfsRoot) {
+    const auto cpuDirectory = sysfsRoot / "devices" / "system" / "cpu";
+
+    std::string onlineList;
+    if (!readLine(cpuDirectory / "online", onlineList)) {
+        return false;
+    }
+
+    std::map<int, std::vector<int>, std::greater<>> cpusByCapacity;
+    for (int cpu : parseCpuList(onlineList)) {
+        std::string capacity;
+        if (!readLine(cpuDirectory / ("cpu" + std::to_string(cpu)) / "cpu_capacity", capacity)) {
+            return false;
+        }
+
+        try {
+            cpusByCapacity[std::stoi(capacity)].push_back(cpu);
+        } catch (const std::exception &) {
+            return false;
+        }
+    }
+
+    if (cpusByCapacity.size() < 2) {
+        return false;
+    }
+
+    size_t index = 0;
+    for (auto &[capacity, cpus] : cpusByCapacity) {
+        std::string name;
+        if (index == 0) {
+            name = "performance";
+        } else if (index == 1 && cpusByCapacity.size() == 2) {
+            name = "efficiency";
+        } else {
+            name = "capacity" + std::to_string(capacity);
+        }
+
+        coreTypes.push_back({name, cpus});
+        index++;
+    }
+
+    return true;
+}
+
+void CPUTopology::detectDefaultCoreType(const std::filesystem::path &sysfsRoot) {
+    std::string onlineList;
+    std::vector<int> cpus;
+
+    if (readLine(sysfsRoot / "devices" / "system" / "cpu" / "online", onlineList)) {
+        cpus = parseCpuList(onlineList);
+    }
+
+    if (cpus.empty()) {
+        const unsigned hardwareThreads = std::max(std::thread::hardware_concurrency(), 1U);
+        for (unsigned cpu = 0; cpu < hardwareThreads; cpu++) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+    }
+
+    coreTypes.push_back({"default", cpus});
+}
+
+CPUTopology CPUTopology::detect(const std::filesystem::path &sysfsRoot) {
+    CPUTopology topology;
+
+    if (topology.detectPmuCoreTypes(sysfsRoot) || topology.detectCapacityCoreTypes(sysfsRoot)) {
+        return topology;
+    }
+
+    topology.detectDefaultCoreType(sysfsRoot);
+    return topology;
+}
+
+std::string CPUTopology::coreTypeOf(int cpu) const {
+    for (const auto &coreType : coreTypes) {
+        if (std::binary_search(coreType.cpus.begin(), coreType.cpus.end(), cpu)) {
+            return coreType.name;
+        }
+    }
+
+    return "";
+}
+
+std::vector<int> CPUTopology::allCpus() const {
+    std::vector<int> cpus;
+    for (const auto &coreType : coreTypes) {
+        cpus.insert(cpus.end(), coreType.cpus.begin(), coreType.cpus.end());
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    return cpus;
+}
+
+json CPUTopology::toJson() const {
+    json topology = json::object();
+    for (const auto &coreType : coreTypes) {
+        topology[coreType.name] = coreType.cpus;
+    }
+
+    return topology;
+}
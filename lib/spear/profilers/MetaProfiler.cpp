@@ -6,11 +6,9 @@
 #include "profilers/MetaProfiler.h"
 
 #include "RegisterReader.h"
+#include "profilers/SystemMetadata.h"
 #include <chrono>
-#include <sstream>
 #include <string>
-#include <vector>
-#include <cstdio>
 
 json MetaProfiler::profile() {
     this->log("Executing Metaprofiler");
@@ -18,15 +16,26 @@ json MetaProfiler::profile() {
 
     this->log("Querying Metainformation...");
 
-    std::string cpuname = _getCPUName();
-    std::string architecture = _getArchitecture();
-    std::string numberOfCores = _getNumberOfCores();
+    SystemMetadataCollector collector;
+    json system = collector.collectCached(SystemMetadataCollector::defaultCacheFile());
+
+    // Fields the machine does not report are null
+    auto cpuField = [&system](const std::string &name) -> std::string {
+        const auto &value = system["cpu"][name];
+        return value.is_string() ? value.get<std::string>() : "";
+    };
+
+    std::string cpuname = cpuField("name");
+    std::string architecture = cpuField("family");
+    std::string numberOfCores = cpuField("siblings");
     double raplUnit = _getRaplUnit();
 
     this->log("CPU Name " + cpuname);
     this->log("CPU Architecture " + architecture);
     this->log("Number of Cores " + numberOfCores);
     this->log("Rapl Unit " + std::to_string(raplUnit));
+    this->log(std::string("Metadata ") + (system["cached"].get<bool>() ? "read from cache" : "collected") + " in " +
+              std::to_string(system["collection_us"].get<int64_t>()) + " us");
 
 
     metainformation["version"] = "2.0.0";
@@ -34,6 +43,7 @@ json MetaProfiler::profile() {
     metainformation["architecture"] = architecture;
     metainformation["cores"] = numberOfCores;
     metainformation["raplunit"] = raplUnit;
+    metainformation["system"] = system;
 
     return metainformation;
 }
@@ -46,56 +56,6 @@ std::string MetaProfiler::stopTime() {
     return _getTimeStr();
 }
 
-std::string MetaProfiler::_getCPUName() {
-    char buffer[128];
-    std::string result;
-    std::string command = "cat /proc/cpuinfo | grep 'model name' | uniq";
-
-    FILE* pipe = popen(command.c_str(), "r");
-    if (!pipe) {
-        return "failed to execute the command";
-    }
-
-    while (!feof(pipe)) {
-        if (fgets(buffer, 128, pipe) != nullptr)
-            result += buffer;
-    }
-
-    pclose(pipe);
-
-    std::stringstream resstream;
-    std::string segment;
-    resstream << result;
-
-    std::vector<std::string> seglist;
-    while (std::getline(resstream, segment, ':')) {
-        seglist.push_back(segment);
-    }
-
-    if (segment.length() >= 2) {
-        auto lastchar = segment[segment.length()-1];
-        auto firstchar = segment[0];
-
-        if (lastchar == '\n') {
-            segment.erase(segment.length()-1);
-        }
-
-        if (firstchar == ' ') {
-            segment.erase(0, 1);
-        }
-    }
-
-    return  segment;
-}
-
-std::string MetaProfiler::_getArchitecture() {
-    return _readSystemFile("cat /proc/cpuinfo | grep 'cpu family' | uniq");
-}
-
-std::string MetaProfiler::_getNumberOfCores() {
-    return _readSystemFile("cat /proc/cpuinfo | grep 'siblings' | uniq");
-}
-
 double MetaProfiler::_getRaplUnit() {
     RegisterReader powReader(0);
     double unit = powReader.readMultiplier();
@@ -103,47 +63,6 @@ double MetaProfiler::_getRaplUnit() {
     return unit;
 }
 
-std::string MetaProfiler::_readSystemFile(std::string file) {
-    char buffer[128];
-    std::string result;
-
-    FILE* pipe = popen(file.c_str(), "r");
-    if (!pipe) {
-        return "failed to execute the command";
-    }
-
-    while (!feof(pipe)) {
-        if (fgets(buffer, 128, pipe) != nullptr)
-            result += buffer;
-    }
-
-    pclose(pipe);
-
-    std::stringstream resstream;
-    std::string segment;
-    resstream << result;
-
-    std::vector<std::string> seglist;
-    while ( std::getline(resstream, segment, ':') ) {
-        seglist.push_back(segment);
-    }
-
-    if ( segment.length() >=2 ) {
-        auto lastchar = segment[segment.length()-1];
-        auto firstchar = segment[0];
-
-        if (lastchar == '\n') {
-            segment.erase(segment.length()-1);
-        }
-
-        if (firstchar == ' ') {
-            segment.erase(0, 1);
-        }
-    }
-
-    return segment;
-}
-
 std::string MetaProfiler::_getTimeStr() {
     std::chrono::time_point<std::chrono::system_clock> timepoint = std::chrono::system_clock::now();
     uint64_t tpstr = timepoint.time_since_epoch().count();
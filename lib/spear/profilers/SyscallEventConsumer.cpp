@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+*/
+
+#include "profilers/SyscallEventConsumer.h"
+
+#include <time.h>
+
+#include <algorithm>
+#include <cstring>
+
+InflightTable::InflightTable(size_t capacity) {
+    size_t size = 1;
+    while (size < std::max<size_t>(capacity, 2)) {
+        size <<= 1;
+    }
+
+    slots.resize(size);
+    mask = size - 1;
+}
+
+size_t InflightTable::indexOf(uint32_t tid) const {
+    // Multiplicative hashing spreads the consecutive thread ids of a process over the table
+    return (static_cast<uint64_t>(tid) * 2654435761U) & mask;
+}
+
+Inflight *InflightTable::findOrInsert(uint32_t tid) {
+    size_t index = indexOf(tid);
+
+    for (size_t probe = 0; probe < slots.size(); probe++) {
+        Slot &slot = slots[index];
+
+        if (slot.occupied && slot.tid == tid) {
+            return &slot.state;
+        }
+
+        if (!slot.occupied) {
+            if (used + 1 == slots.size()) {
+                // Keep one slot free so lookups of unknown threads terminate early
+                return nullptr;
+            }
+
+            slot.occupied = true;
+            slot.tid = tid;
+            slot.state = Inflight{};
+            used++;
+            return &slot.state;
+        }
+
+        index = (index + 1) & mask;
+    }
+
+    return nullptr;
+}
+
+void InflightTable::erase(uint32_t tid) {
+    size_t index = indexOf(tid);
+
+    while (slots[index].occupied && slots[index].tid != tid) {
+        index = (index + 1) & mask;
+    }
+
+    if (!slots[index].occupied) {
+        return;
+    }
+
+    // Shift the following entries of the probe sequence back instead of leaving a tombstone
+    size_t hole = index;
+    size_t next = (hole + 1) & mask;
+    while (slots[next].occupied) {
+        const size_t home = indexOf(slots[next].tid);
+
+        // The entry may fill the hole if its home slot does not lie cyclically in (hole, next]
+        const bool movable = hole <= next ? (home <= hole || home > next) : (home <= hole && home > next);
+        if (movable) {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+
+        next = (next + 1) & mask;
+    }
+
+    slots[hole].occupied = false;
+    used--;
+}
+
+void InflightTable::clear() {
+    for (Slot &slot : slots) {
+        slot.occupied = false;
+    }
+    used = 0;
+}
+
+SyscallEventConsumer::SyscallEventConsumer(EnergyCounterSource &source, uint32_t maxSyscallId, size_t batchSize,
+                                           size_t threadCapacity)
+    : source(source),
+      extender(source.getCounterBits()),
+      energyUnit(source.getEnergyUnit()),
+      maxSyscallId(maxSyscallId),
+      batchSize(std::max<size_t>(batchSize, 1)),
+      inflight(threadCapacity),
+      energyPerSyscall(maxSyscallId, 0.0),
+      countPerSyscall(maxSyscallId, 0) {
+    batch.reserve(this->batchSize);
+}
+
+int SyscallEventConsumer::onRecord(void *ctx, void *data, size_t size) {
+    static_cast<SyscallEventConsumer *>(ctx)->push(data, size);
+    return 0;
+}
+
+void SyscallEventConsumer::push(const void *data, size_t size) {
+    if (size < sizeof(evt)) {
+        stats.malformed++;
+        return;
+    }
+
+    // The ring buffer memory is only valid during the callback
+    evt event;
+    std::memcpy(&event, data, sizeof(evt));
+    batch.push_back(event);
+
+    if (batch.size() >= batchSize) {
+        flush();
+    }
+}
+
+uint64_t SyscallEventConsumer::monotonicNs() {
+    timespec now{};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+void SyscallEventConsumer::flush() {
+    if (batch.empty()) {
+        return;
+    }
+
+    flush(monotonicNs());
+}
+
+void SyscallEventConsumer::flush(uint64_t nowNs) {
+    if (batch.empty()) {
+        return;
+    }
+
+    const double energy = static_cast<double>(extender.extend(source.readCounter())) * energyUnit;
+
+    // The interval before the previous reading is kept for events the ring buffer delivers late
+    if (hasReading) {
+        olderNs = previousNs;
+        olderEnergy = previousEnergy;
+        previousNs = currentNs;
+        previousEnergy = currentEnergy;
+    } else {
+        firstNs = nowNs;
+        olderNs = nowNs;
+        olderEnergy = energy;
+        previousNs = nowNs;
+        previousEnergy = energy;
+        hasReading = true;
+    }
+    currentNs = nowNs;
+    currentEnergy = energy;
+
+    for (const evt &event : batch) {
+        handle(event);
+    }
+
+    stats.processed += batch.size();
+    stats.batches++;
+    batch.clear();
+}
+
+double SyscallEventConsumer::energyAt(uint64_t ts) const {
+    if (ts < previousNs) {
+        // Late event of the interval before, or an event recorded before the first reading
+        if (ts <= olderNs || previousNs <= olderNs) {
+            return olderEnergy;
+        }
+
+        const double fraction = static_cast<double>(ts - olderNs) / static_cast<double>(previousNs - olderNs);
+        return olderEnergy + (previousEnergy - olderEnergy) * fraction;
+    }
+
+    if (ts == previousNs || currentNs <= previousNs) {
+        return previousEnergy;
+    }
+
+    if (ts >= currentNs) {
+        return currentEnergy;
+    }
+
+    const double fraction = static_cast<double>(ts - previousNs) / static_cast<double>(currentNs - previousNs);
+    return previousEnergy + (currentEnergy - previousEnergy) * fraction;
+}
+
+bool SyscallEventConsumer::isLate(uint64_t ts) const {
+    // Before the first reading nothing was measured, such events are clamped like the first batch is
+    return ts < olderNs && olderNs != firstNs;
+}
+
+void SyscallEventConsumer::handle(const evt &event) {
+    // Without a reading around the event its segment cannot be priced, clamping would attribute arbitrary energy
+    if (isLate(event.ts)) {
+        stats.lateEvents++;
+        inflight.erase(event.tid);
+        return;
+    }
+
+    Inflight *inf = inflight.findOrInsert(event.tid);
+    if (inf == nullptr) {
+        stats.tableOverflows++;
+        return;
+    }
+
+    switch (event.type) {
+        // sys_enter
+        case 0: {
+            if (event.id >= maxSyscallId) {
+                stats.unknownSyscalls++;
+                inflight.erase(event.tid);
+                return;
+            }
+
+            inf->syscall_id = event.id;
+            inf->in_syscall = true;
+
+            // At sys_enter we are on CPU, start measuring immediately
+            inf->start_energy = energyAt(event.ts);
+            inf->running = true;
+            break;
+        }
+        // switch_out
+        case 2: {
+            // If the thread is switched out while still inside a syscall,
+            // stop measuring so we do not measure sleep time.
+            if (inf->in_syscall && inf->running) {
+                energyPerSyscall[inf->syscall_id] += energyAt(event.ts) - inf->start_energy;
+                inf->running = false;
+            } else if (!inf->in_syscall) {
+                // Threads outside of syscalls are not tracked
+                inflight.erase(event.tid);
+            }
+            break;
+        }
+        // switch_in
+        case 3: {
+            // If the thread is scheduled back in and still inside the same syscall,
+            // restart measuring for the next on-CPU segment.
+            if (inf->in_syscall && !inf->running) {
+                inf->start_energy = energyAt(event.ts);
+                inf->running = true;
+            } else if (!inf->in_syscall) {
+                inflight.erase(event.tid);
+            }
+            break;
+        }
+        // sys_exit
+        case 1: {
+            // Finish the last on-CPU segment and count one syscall completion
+            if (inf->in_syscall) {
+                if (inf->running) {
+                    energyPerSyscall[inf->syscall_id] += energyAt(event.ts) - inf->start_energy;
+                }
+                countPerSyscall[inf->syscall_id]++;
+            }
+
+            // Clear state for this TID to avoid stale entries
+            inflight.erase(event.tid);
+            break;
+        }
+
+        default:
+            inflight.erase(event.tid);
+            break;
+    }
+}
+
+void SyscallEventConsumer::reset() {
+    batch.clear();
+    inflight.clear();
+    std::fill(energyPerSyscall.begin(), energyPerSyscall.end(), 0.0);
+    std::fill(countPerSyscall.begin(), countPerSyscall.end(), 0);
+    hasReading = false;
+    stats = SyscallConsumerStats{};
+}
@@ -16,19 +16,15 @@
 #include <cstring>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
 #include <vector>
 #include <memory>
 
 #include "ConfigParser.h"
+#include "EnergyCounterSource.h"
+#include "MetricsRegistry.h"
 #include "syscalls/generated_syscall_names.h"
 
 
-std::unordered_map<uint32_t, Inflight> SyscallProfiler::inflight{};
-std::vector<double> SyscallProfiler::energy_per_syscall(SyscallProfiler::MAX_SYSCALL, 0.0);
-std::vector<uint64_t> SyscallProfiler::count_per_syscall(SyscallProfiler::MAX_SYSCALL, 0);
-RegisterReader SyscallProfiler::raplReader{0};
-
 SyscallProfiler::SyscallProfiler() : Profiler("SYSCALL") {}
 
 /**
@@ -58,116 +54,40 @@ int SyscallProfiler::set_ignore_tgid_map(syscall_trace_bpf* skel, uint32_t tgid_
     return 0;
 }
 
-/**
- * Stop the current segement and accumulate the recorded energy to the total energy for this syscall ID.
- * Also marks the segment as not running.
- */
-void SyscallProfiler::stop_segment_and_accumulate(Inflight& inf) {
-    const double endEng = raplReader.getEnergy();
-    const double dE = endEng - inf.start_energy;
-
-    if (inf.syscall_id < MAX_SYSCALL) {
-        energy_per_syscall.at(inf.syscall_id) += dE;
+uint64_t SyscallProfiler::read_kernel_drops(syscall_trace_bpf* skel) {
+    // dropped_events is a 1-element BPF_MAP_TYPE_PERCPU_ARRAY, a lookup returns one value per possible CPU
+    const int cpus = libbpf_num_possible_cpus();
+    if (cpus <= 0) {
+        return 0;
     }
 
-    inf.running = false;
-}
-
-/**
- * Start a new running segment that measures the energy after the system call is entered (sys_enter) or
- * on switch in (switch_in) if the thread is still inside the same syscall. Records the start energy and marks the
- * segment as running.
- */
-void SyscallProfiler::start_segment(Inflight& inf) {
-    inf.start_energy = raplReader.getEnergy();
-    inf.running = true;
-}
+    std::vector<uint64_t> values(static_cast<size_t>(cpus), 0);
+    uint32_t key = 0;
 
-/**
- * Event handler that will be called for syscall enter/exit and sched_switch gating
- * @param ctx Unused callback context
- * @param data Data inserted into the ring buffer
- * @param data_sz Size of the corresponding data
- * @return Returns 0
- */
-int SyscallProfiler::handle_event(void* /* ctx */, void* data, size_t data_sz) {
-    if (data_sz < sizeof(evt)) {
+    if (bpf_map_lookup_elem(bpf_map__fd(skel->maps.dropped_events), &key, values.data()) != 0) {
+        std::fprintf(stderr, "bpf_map_lookup_elem(dropped_events) failed: %s\n", std::strerror(errno));
         return 0;
     }
 
-    const auto* event = static_cast<const evt*>(data);
-
-    // Ensure we have a state entry for this TID (also for switch events)
-    auto& inf = inflight[event->tid];
-
-    switch (event->type) {
-        // sys_enter
-        case 0: {
-            if (event->id >= MAX_SYSCALL) {
-                inf = Inflight{};
-                return 0;
-            }
-
-            inf.syscall_id = event->id;
-            inf.in_syscall = true;
-            inf.running = false;
-
-            // At sys_enter we are on CPU, start measuring immediately
-            start_segment(inf);
-            break;
-        }
-        // switch_out
-        case 2: {
-            // If the thread is switched out while still inside a syscall,
-            // stop measuring so we do not measure sleep time.
-            if (inf.in_syscall && inf.running) {
-                stop_segment_and_accumulate(inf);
-            }
-            break;
-        }
-        // switch_in
-        case 3: {
-            // If the thread is scheduled back in and still inside the same syscall,
-            // restart measuring for the next on-CPU segment.
-            if (inf.in_syscall && !inf.running) {
-                start_segment(inf);
-            }
-            break;
-        }
-        // sys_exit
-        case 1: {
-            // Finish the last on-CPU segment
-            if (inf.in_syscall && inf.running) {
-                stop_segment_and_accumulate(inf);
-            }
-
-            // Count one syscall completion
-            if (inf.in_syscall && inf.syscall_id < MAX_SYSCALL) {
-                count_per_syscall.at(inf.syscall_id) += 1;
-            }
-
-            // Clear state for this TID to avoid stale entries
-            inflight.erase(event->tid);
-            break;
-        }
-
-        default:
-            break;
+    uint64_t drops = 0;
+    for (uint64_t value : values) {
+        drops += value;
     }
-
-    return 0;
+    return drops;
 }
 
 json SyscallProfiler::profile() {
     this->log("Executing SyscallProfiler");
 
-    // Reset static state so repeated runs do not accumulate old data
-    inflight.clear();
-    std::fill(energy_per_syscall.begin(), energy_per_syscall.end(), 0.0);
-    std::fill(count_per_syscall.begin(), count_per_syscall.end(), 0);
+    auto syscallconfig = ConfigParser::getProfilingConfiguration().syscallconfig;
 
     json syscalls;
 
+    // The consumer preallocates all of its state, handling an event never allocates
+    RaplCounterSource raplSource;
+    SyscallEventConsumer consumer(raplSource, static_cast<uint32_t>(syscallconfig.maxSyscallId),
+                                  static_cast<size_t>(syscallconfig.batchSize));
+
     // Define bpf skeleton and parameters
     libbpf_set_strict_mode(LIBBPF_STRICT_ALL);
 
@@ -192,7 +112,7 @@ json SyscallProfiler::profile() {
     }
 
     std::unique_ptr<ring_buffer, RingBufDeleter> eventRingBuffer(
-        ring_buffer__new(bpf_map__fd(skel->maps.rb), handle_event, nullptr, nullptr));
+        ring_buffer__new(bpf_map__fd(skel->maps.rb), SyscallEventConsumer::onRecord, &consumer, nullptr));
 
     if (!eventRingBuffer) {
         throw std::runtime_error("failed to create ring buffer");
@@ -201,8 +121,6 @@ json SyscallProfiler::profile() {
     this->log("Successfully attached syscall trace bpf");
     this->log("Starting SyscallProfiler");
 
-    auto syscallconfig = ConfigParser::getProfilingConfiguration().syscallconfig;
-
     // Run for x seconds
     int seconds = syscallconfig.runtime;
 
@@ -220,10 +138,16 @@ json SyscallProfiler::profile() {
             break;
         }
 
-        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(end - now).count();
-        const int timeout_ms = static_cast<int>(std::max<int64_t>(0, remaining));
+        int err;
+        if (syscallconfig.busyPoll) {
+            // Spin on the ring buffer instead of sleeping in epoll, this keeps up with bursts at the cost of a core
+            err = ring_buffer__consume(eventRingBuffer.get());
+        } else {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(end - now).count();
+            const int timeout_ms = static_cast<int>(std::max<int64_t>(0, remaining));
 
-        int err = ring_buffer__poll(eventRingBuffer.get(), timeout_ms);
+            err = ring_buffer__poll(eventRingBuffer.get(), timeout_ms);
+        }
 
         if (err == -EINTR) {
             continue;
@@ -233,12 +157,35 @@ json SyscallProfiler::profile() {
             std::fprintf(stderr, "poll error: %d\n", err);
             break;
         }
+
+        // The ring buffer is drained, handle the remaining events of the partial batch
+        consumer.flush();
     }
 
-    for (size_t i = 0; i < energy_per_syscall.size(); ++i) {
-        if (count_per_syscall[i] > 0) {
-            if (energy_per_syscall.at(i) > 0.0) {
-                syscalls[getSyscallName(i)] = energy_per_syscall.at(i) / count_per_syscall.at(i);
+    consumer.flush();
+    consumer.setKernelDrops(read_kernel_drops(skel.get()));
+
+    const auto& stats = consumer.getStats();
+    this->log("Handled " + std::to_string(stats.processed) + " events in " + std::to_string(stats.batches) +
+              " batches");
+
+    if (stats.dropped() > 0) {
+        this->log("Dropped " + std::to_string(stats.dropped()) + " events (" + std::to_string(stats.kernelDrops) +
+                  " in the kernel, " + std::to_string(stats.tableOverflows) + " inflight table overflows, " +
+                  std::to_string(stats.lateEvents) + " late events, " + std::to_string(stats.malformed) +
+                  " malformed records), the results may be incomplete");
+    }
+
+    auto& metrics = MetricsRegistry::getInstance();
+    metrics.counter("spear_syscall_events", "Syscall tracer events handled by the consumer")
+        .inc(stats.processed);
+    metrics.counter("spear_syscall_events_dropped", "Syscall tracer events lost in the kernel or the consumer")
+        .inc(stats.dropped());
+
+    for (uint32_t i = 0; i < consumer.getMaxSyscallId(); ++i) {
+        if (consumer.getCount(i) > 0) {
+            if (consumer.getEnergy(i) > 0.0) {
+                syscalls[getSyscallName(i)] = consumer.getEnergy(i) / static_cast<double>(consumer.getCount(i));
             } else {
                 // If we have count > 0 but no energy, we are likely measuring very short syscalls that are below the
                 // resolution of our measurement. In this case, we can still report the default energy as a lower bound,
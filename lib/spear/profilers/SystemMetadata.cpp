@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+*/
+
+#include "profilers/SystemMetadata.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "profilers/CPUTopology.h"
+
+namespace {
+
+std::string trim(const std::string &value) {
+    const size_t first = value.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) {
+        return "";
+    }
+
+    const size_t last = value.find_last_not_of(" \t\r\n");
+    return value.substr(first, last - first + 1);
+}
+
+/**
+ * Convert a numeric sysfs value, null if the value is missing or malformed
+ */
+json numberOrNull(const std::string &value) {
+    if (value.empty()) {
+        return nullptr;
+    }
+
+    try {
+        return std::stoll(value);
+    } catch (const std::exception &) {
+        return nullptr;
+    }
+}
+
+json stringOrNull(const std::string &value) {
+    return value.empty() ? json(nullptr) : json(value);
+}
+
+}  // namespace
+
+SystemMetadataCollector::SystemMetadataCollector(std::filesystem::path procRoot, std::filesystem::path sysfsRoot,
+                                                 bool useCpuid)
+    : procRoot(std::move(procRoot)), sysfsRoot(std::move(sysfsRoot)), useCpuid(useCpuid) {}
+
+bool SystemMetadataCollector::readFile(const std::filesystem::path &path, std::string &content) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    content = buffer.str();
+    return true;
+}
+
+std::string SystemMetadataCollector::readLine(const std::filesystem::path &path) {
+    std::ifstream file(path);
+    std::string line;
+    if (!file.is_open() || !std::getline(file, line)) {
+        return "";
+    }
+
+    return trim(line);
+}
+
+std::map<std::string, std::string> SystemMetadataCollector::parseCpuInfo(const std::string &content) {
+    std::map<std::string, std::string> fields;
+    std::istringstream stream(content);
+    std::string line;
+
+    while (std::getline(stream, line)) {
+        // Entries of the processors are separated by empty lines, all processors share the fields we need
+        if (trim(line).empty()) {
+            if (!fields.empty()) {
+                break;
+            }
+            continue;
+        }
+
+        const size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+
+        fields.emplace(trim(line.substr(0, colon)), trim(line.substr(colon + 1)));
+    }
+
+    return fields;
+}
+
+bool SystemMetadataCollector::cpuid(std::string &vendor, std::string &brand) {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int registers[4] = {0, 0, 0, 0};
+
+    if (!__get_cpuid(0, &registers[0], &registers[1], &registers[2], &registers[3])) {
+        return false;
+    }
+
+    // The vendor string is stored in ebx, edx, ecx
+    char vendorString[13] = {};
+    std::memcpy(vendorString, &registers[1], 4);
+    std::memcpy(vendorString + 4, &registers[3], 4);
+    std::memcpy(vendorString + 8, &registers[2], 4);
+    vendor = vendorString;
+
+    char brandString[49] = {};
+    for (unsigned int leaf = 0; leaf < 3; leaf++) {
+        if (!__get_cpuid(0x80000002 + leaf, &registers[0], &registers[1], &registers[2], &registers[3])) {
+            return true;
+        }
+        std::memcpy(brandString + leaf * 16, registers, 16);
+    }
+    brand = trim(brandString);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+json SystemMetadataCollector::collectCpu() const {
+    std::string cpuinfo;
+    readFile(procRoot / "cpuinfo", cpuinfo);
+    auto fields = parseCpuInfo(cpuinfo);
+
+    auto field = [&fields](const std::string &name) -> std::string {
+        auto iterator = fields.find(name);
+        return iterator == fields.end() ? "" : iterator->second;
+    };
+
+    // Other architectures than x86 name the model differently
+    std::string name = field("model name");
+    if (name.empty()) {
+        name = field("Model").empty() ? field("cpu model") : field("Model");
+    }
+
+    std::string vendor = field("vendor_id");
+    if (vendor.empty()) {
+        vendor = field("CPU implementer");
+    }
+
+    std::string cpuidVendor;
+    std::string cpuidBrand;
+    if (useCpuid && (name.empty() || vendor.empty()) && cpuid(cpuidVendor, cpuidBrand)) {
+        name = name.empty() ? cpuidBrand : name;
+        vendor = vendor.empty() ? cpuidVendor : vendor;
+    }
+
+    json cpu = json::object();
+    cpu["name"] = stringOrNull(name);
+    cpu["vendor"] = stringOrNull(vendor);
+    cpu["family"] = stringOrNull(field("cpu family"));
+    cpu["model"] = stringOrNull(field("model"));
+    cpu["stepping"] = stringOrNull(field("stepping"));
+    cpu["siblings"] = stringOrNull(field("siblings"));
+
+    // procfs only reports the microcode on x86, sysfs has it per CPU as well
+    std::string microcode = field("microcode");
+    if (microcode.empty()) {
+        microcode = readLine(sysfsRoot / "devices" / "system" / "cpu" / "cpu0" / "microcode" / "version");
+    }
+    cpu["microcode"] = stringOrNull(microcode);
+
+    return cpu;
+}
+
+json SystemMetadataCollector::collectTopology() const {
+    const auto cpuDirectory = sysfsRoot / "devices" / "system" / "cpu";
+    const auto online = CPUTopology::parseCpuList(readLine(cpuDirectory / "online"));
+
+    std::set<std::string> packages;
+    std::set<std::pair<std::string, std::string>> physicalCores;
+    for (int cpu : online) {
+        const auto topologyDirectory = cpuDirectory / ("cpu" + std::to_string(cpu)) / "topology";
+        const std::string package = readLine(topologyDirectory / "physical_package_id");
+        const std::string core = readLine(topologyDirectory / "core_id");
+
+        if (!package.empty()) {
+            packages.insert(package);
+            if (!core.empty()) {
+                physicalCores.insert({package, core});
+            }
+        }
+    }
+
+    json topology = json::object();
+    topology["online"] = online.size();
+    topology["present"] = CPUTopology::parseCpuList(readLine(cpuDirectory / "present")).size();
+    topology["packages"] = packages.empty() ? json(nullptr) : json(packages.size());
+    topology["physical_cores"] = physicalCores.empty() ? json(nullptr) : json(physicalCores.size());
+    topology["smt"] = stringOrNull(readLine(cpuDirectory / "smt" / "control"));
+    topology["core_types"] = CPUTopology::detect(sysfsRoot).toJson();
+
+    return topology;
+}
+
+json SystemMetadataCollector::collectFrequency() const {
+    const auto cpufreqDirectory = sysfsRoot / "devices" / "system" / "cpu" / "cpu0" / "cpufreq";
+
+    // All values in kHz as reported by the kernel
+    json frequency = json::object();
+    frequency["min_khz"] = numberOrNull(readLine(cpufreqDirectory / "cpuinfo_min_freq"));
+    frequency["max_khz"] = numberOrNull(readLine(cpufreqDirectory / "cpuinfo_max_freq"));
+    frequency["scaling_min_khz"] = numberOrNull(readLine(cpufreqDirectory / "scaling_min_freq"));
+    frequency["scaling_max_khz"] = numberOrNull(readLine(cpufreqDirectory / "scaling_max_freq"));
+    frequency["driver"] = stringOrNull(readLine(cpufreqDirectory / "scaling_driver"));
+    frequency["governor"] = stringOrNull(readLine(cpufreqDirectory / "scaling_governor"));
+
+    return frequency;
+}
+
+json SystemMetadataCollector::collectKernel() const {
+    json kernel = json::object();
+    kernel["release"] = stringOrNull(readLine(procRoot / "sys" / "kernel" / "osrelease"));
+    kernel["version"] = stringOrNull(readLine(procRoot / "sys" / "kernel" / "version"));
+    kernel["boot_id"] = stringOrNull(bootId());
+
+    return kernel;
+}
+
+std::string SystemMetadataCollector::bootId() const {
+    return readLine(procRoot / "sys" / "kernel" / "random" / "boot_id");
+}
+
+json SystemMetadataCollector::collect() const {
+    auto start = std::chrono::steady_clock::now();
+
+    json metadata = json::object();
+    metadata["cpu"] = collectCpu();
+    metadata["topology"] = collectTopology();
+    metadata["frequency"] = collectFrequency();
+    metadata["kernel"] = collectKernel();
+
+    auto end = std::chrono::steady_clock::now();
+    metadata["cached"] = false;
+    metadata["collection_us"] = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    return metadata;
+}
+
+json SystemMetadataCollector::collectCached(const std::filesystem::path &cacheFile) const {
+    auto start = std::chrono::steady_clock::now();
+    const std::string currentBootId = bootId();
+
+    std::string cacheContent;
+    if (!currentBootId.empty() && readFile(cacheFile, cacheContent)) {
+        json cached = json::parse(cacheContent, nullptr, false);
+
+        if (!cached.is_discarded() && cached.is_object() && cached.contains("kernel") &&
+            cached["kernel"].contains("boot_id") && cached["kernel"]["boot_id"] == currentBootId) {
+            auto end = std::chrono::steady_clock::now();
+            cached["cached"] = true;
+            cached["collection_us"] = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+            return cached;
+        }
+    }
+
+    json metadata = collect();
+
+    // Without a boot id the cache could never be invalidated
+    if (!currentBootId.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(cacheFile.parent_path(), error);
+
+        std::ofstream cache(cacheFile);
+        if (cache.is_open()) {
+            cache << metadata.dump(4);
+        }
+    }
+
+    return metadata;
+}
+
+std::filesystem::path SystemMetadataCollector::defaultCacheFile() {
+    if (const char *cacheHome = std::getenv("XDG_CACHE_HOME"); cacheHome != nullptr && cacheHome[0] != '\0') {
+        return std::filesystem::path(cacheHome) / "spear" / "metadata.json";
+    }
+
+    if (const char *home = std::getenv("HOME"); home != nullptr && home[0] != '\0') {
+        return std::filesystem::path(home) / ".cache" / "spear" / "metadata.json";
+    }
+
+    return std::filesystem::temp_directory_path() / "spear_metadata.json";
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <z3++.h>
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "analyses/feasibility/FeasibilityAnalysisManager.h"
+
+namespace {
+
+/**
+ * Builds a chain of blocks where every block has one phi per argument of the function. The phis of a block take the
+ * phis of the previous block, the phis of the first block the arguments.
+ */
+llvm::Function *buildPhiChain(llvm::Module &module, int blocks, int width) {
+    auto &context = module.getContext();
+    auto *functionType = llvm::FunctionType::get(
+        llvm::Type::getVoidTy(context), std::vector<llvm::Type *>(width, llvm::Type::getInt32Ty(context)), false);
+    auto *function = llvm::Function::Create(functionType, llvm::Function::ExternalLinkage, "phichain", module);
+    llvm::IRBuilder<> builder(context);
+
+    auto *predecessor = llvm::BasicBlock::Create(context, "entry", function);
+    std::vector<llvm::Value *> values;
+    for (llvm::Argument &argument : function->args()) {
+        values.push_back(&argument);
+    }
+
+    for (int i = 0; i < blocks; i++) {
+        auto *block = llvm::BasicBlock::Create(context, "block" + std::to_string(i), function);
+        builder.SetInsertPoint(predecessor);
+        builder.CreateBr(block);
+
+        builder.SetInsertPoint(block);
+        for (llvm::Value *&value : values) {
+            llvm::PHINode *phi = builder.CreatePHI(value->getType(), 1);
+            phi->addIncoming(value, predecessor);
+            value = phi;
+        }
+
+        predecessor = block;
+    }
+
+    builder.SetInsertPoint(predecessor);
+    builder.CreateRetVoid();
+
+    return function;
+}
+
+/**
+ * Bind all phis of an edge in one environment node, as the feasibility analysis does
+ */
+uint32_t bindPerEdge(Feasibility::FeasibilityAnalysisManager &manager, const llvm::Function &function) {
+    uint32_t envId = 0;
+    for (const llvm::BasicBlock &block : function) {
+        if (const llvm::BasicBlock *successor = block.getSingleSuccessor()) {
+            envId = manager.applyPhiPack(envId, &block, successor);
+        }
+    }
+
+    return envId;
+}
+
+/**
+ * Bind every phi in an environment node of its own, as the analysis did before the phis of an edge were packed
+ */
+uint32_t bindPerPhi(Feasibility::FeasibilityAnalysisManager &manager, const llvm::Function &function) {
+    uint32_t envId = 0;
+    for (const llvm::BasicBlock &block : function) {
+        const llvm::BasicBlock *successor = block.getSingleSuccessor();
+        if (!successor) {
+            continue;
+        }
+
+        // The incoming values are resolved in the environment before the edge, phis are evaluated in parallel
+        const uint32_t inEnvId = envId;
+        for (const llvm::PHINode &phi : successor->phis()) {
+            envId = manager.extendEnv(envId, &phi, manager.resolve(inEnvId, phi.getIncomingValueForBlock(&block)));
+        }
+    }
+
+    return envId;
+}
+
+/**
+ * Resolve every phi of the function in the given environment
+ * @return Amount of phis resolved to an argument
+ */
+int64_t resolveAll(const Feasibility::FeasibilityAnalysisManager &manager, uint32_t envId,
+                   const std::vector<const llvm::PHINode *> &phis) {
+    int64_t resolved = 0;
+    for (const llvm::PHINode *phi : phis) {
+        resolved += llvm::isa<llvm::Argument>(manager.resolve(envId, phi));
+    }
+
+    return resolved;
+}
+
+}  // namespace
+
+/**
+ * Compares environments binding all phis of an edge in one node against one node per phi on a chain of wide blocks.
+ * Hidden from the default run, execute with: spear_tests "[benchmark]"
+ */
+TEST_CASE("Feasibility environments: one node per edge vs. one node per phi", "[.][benchmark]") {
+    llvm::LLVMContext context;
+    llvm::Module module("phichain", context);
+    const llvm::Function *function = buildPhiChain(module, 64, 16);
+
+    std::vector<const llvm::PHINode *> phis;
+    for (const llvm::BasicBlock &block : *function) {
+        for (const llvm::PHINode &phi : block.phis()) {
+            phis.push_back(&phi);
+        }
+    }
+
+    Feasibility::FeasibilityAnalysisManager perEdge(std::make_unique<z3::context>());
+    Feasibility::FeasibilityAnalysisManager perPhi(std::make_unique<z3::context>());
+    const uint32_t perEdgeEnv = bindPerEdge(perEdge, *function);
+    const uint32_t perPhiEnv = bindPerPhi(perPhi, *function);
+
+    // Both environments have to bind every phi to the same value before their times are compared
+    for (const llvm::PHINode *phi : phis) {
+        REQUIRE(perEdge.resolve(perEdgeEnv, phi) == perPhi.resolve(perPhiEnv, phi));
+    }
+    REQUIRE(resolveAll(perEdge, perEdgeEnv, phis) == static_cast<int64_t>(phis.size()));
+
+    for (const auto &[name, manager] : {std::pair{"per edge", &perEdge}, std::pair{"per phi ", &perPhi}}) {
+        const Feasibility::EnvironmentStatistics statistics = manager->getEnvironmentStatistics();
+        std::cout << "phi chain, one node " << name << ": " << statistics.environments << " environments, max depth "
+                  << statistics.maxDepth << ", " << statistics.lookups << " lookups visiting "
+                  << statistics.visitedNodes << " nodes" << std::endl;
+    }
+
+    // Environments are interned, rebinding the chain finds the existing ones as the analysis does on revisits
+    BENCHMARK("bind, one node per edge") {
+        return bindPerEdge(perEdge, *function);
+    };
+
+    BENCHMARK("bind, one node per phi") {
+        return bindPerPhi(perPhi, *function);
+    };
+
+    BENCHMARK("resolve all phis, one node per edge") {
+        return resolveAll(perEdge, perEdgeEnv, phis);
+    };
+
+    BENCHMARK("resolve all phis, one node per phi") {
+        return resolveAll(perPhi, perPhiEnv, phis);
+    };
+}
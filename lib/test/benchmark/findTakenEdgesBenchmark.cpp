@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../hlac/syntheticFunction.h"
+#include "HLAC/hlac.h"
+#include "HLAC/util.h"
+
+namespace {
+
+/**
+ * Path reconstruction used before the edges were indexed. Searches all edges of the function for every step of the
+ * path, loop nodes are not expanded
+ */
+std::vector<HLAC::Edge *> scanForTakenEdges(
+    HLAC::GenericNode *entryNode, const std::unordered_map<HLAC::GenericNode *, HLAC::GenericNode *> &predecessors,
+    const std::vector<std::unique_ptr<HLAC::Edge>> &edges) {
+    std::vector<HLAC::Edge *> result;
+    std::unordered_set<HLAC::Edge *> alreadyAddedEdges;
+
+    for (HLAC::GenericNode *currentNode = entryNode; currentNode != nullptr;) {
+        auto predecessorIterator = predecessors.find(currentNode);
+        if (predecessorIterator == predecessors.end() || predecessorIterator->second == nullptr) {
+            break;
+        }
+
+        HLAC::GenericNode *parentNode = predecessorIterator->second;
+        for (const auto &edge : edges) {
+            if (edge && edge->soure == parentNode && edge->destination == currentNode) {
+                if (alreadyAddedEdges.insert(edge.get()).second) {
+                    result.push_back(edge.get());
+                }
+                break;
+            }
+        }
+
+        currentNode = parentNode;
+    }
+
+    return result;
+}
+
+}  // namespace
+
+/**
+ * Compares the indexed path reconstruction against the scanning one it replaced on functions of growing size. The
+ * indexed times grow linearly with the node count, the scanning ones quadratically. Hidden from the default run,
+ * execute with: spear_tests "[benchmark]"
+ */
+TEST_CASE("findTakenEdges: indexed vs. scanning", "[.][benchmark]") {
+    for (int nodeCount : {1000, 10000, 100000}) {
+        SyntheticFunction function(nodeCount);
+        HLAC::GenericNode *exitNode = function.nodes.back().get();
+
+        // Scanning the largest function takes seconds per run, so it is only compared on the smaller ones
+        const bool compareScanning = nodeCount <= 10000;
+
+        // Both reconstructions have to agree before their times are compared
+        if (compareScanning) {
+            REQUIRE(HLAC::Util::findTakenEdges(exitNode, function.predecessors, function.edges, {}) ==
+                    scanForTakenEdges(exitNode, function.predecessors, function.edges));
+        }
+
+        BENCHMARK("indexed, " + std::to_string(nodeCount) + " nodes") {
+            return HLAC::Util::findTakenEdges(exitNode, function.predecessors, function.edges, {}).size();
+        };
+
+        if (compareScanning) {
+            BENCHMARK("scanning, " + std::to_string(nodeCount) + " nodes") {
+                return scanForTakenEdges(exitNode, function.predecessors, function.edges).size();
+            };
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
+#include "ConfigParser.h"
+#include "HLAC/hlac.h"
+#include "analyses/ResultRegistry.h"
+
+/**
+ * Measures the HLAC construction of the 512 loops of loop_dense.ll. Hidden from the default run, execute with:
+ * spear_tests "[benchmark]"
+ */
+TEST_CASE("HLAC construction of a loop-dense function", "[.][benchmark]") {
+    const std::filesystem::path testroot(TEST_INPUT_DIR);
+    ConfigParser configParser(testroot / "defaultconfig.json");
+    configParser.parse();
+
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic error;
+    auto module = llvm::parseIRFile((testroot / "programs/hlac/compiled/loop_dense.ll").string(), error, context);
+    REQUIRE(module != nullptr);
+
+    llvm::PassBuilder passBuilder;
+    llvm::LoopAnalysisManager loopAnalysisManager;
+    llvm::FunctionAnalysisManager functionAnalysisManager;
+    llvm::CGSCCAnalysisManager cGSCCAnalysisManager;
+    llvm::ModuleAnalysisManager moduleAnalysisManager;
+    passBuilder.registerModuleAnalyses(moduleAnalysisManager);
+    passBuilder.registerCGSCCAnalyses(cGSCCAnalysisManager);
+    passBuilder.registerFunctionAnalyses(functionAnalysisManager);
+    passBuilder.registerLoopAnalyses(loopAnalysisManager);
+    passBuilder.crossRegisterProxies(loopAnalysisManager, functionAnalysisManager, cGSCCAnalysisManager,
+                                     moduleAnalysisManager);
+
+    auto getTargetLibraryInfo = [&functionAnalysisManager](llvm::Function &function) -> llvm::TargetLibraryInfo & {
+        return functionAnalysisManager.getResult<llvm::TargetLibraryAnalysis>(function);
+    };
+    llvm::LazyCallGraph lazyCallGraph(*module, getTargetLibraryInfo);
+    lazyCallGraph.buildRefSCCs();
+
+    llvm::Function *mainFunction = module->getFunction("main");
+    REQUIRE(mainFunction != nullptr);
+    auto &loopInfo = functionAnalysisManager.getResult<llvm::LoopAnalysis>(*mainFunction);
+    REQUIRE(loopInfo.getLoopsInPreorder().size() == 512);
+
+    std::cout << "loop_dense.ll: " << mainFunction->size() << " blocks, " << loopInfo.getLoopsInPreorder().size()
+              << " loops" << std::endl;
+
+    // The loop info is cached by the analysis manager, every run only constructs the HLAC
+    ResultRegistry registry;
+    BENCHMARK("construct the HLAC of main") {
+        HLAC::hlac graph(registry, lazyCallGraph);
+        graph.makeFunction(mainFunction, &functionAnalysisManager);
+        return graph.functions.size();
+    };
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "analyses/loopbound/util.h"
+
+namespace {
+
+/**
+ * Lookup used before the MemoryAccessIndex was introduced. Scans every block of every enclosing loop for a store to
+ * the loaded object, then scans the whole function for the last dominating store
+ */
+std::optional<int64_t> scanForConstFromLoad(const llvm::LoadInst *loadInst, llvm::DominatorTree &dominatorTree,
+                                            llvm::LoopInfo &loopInfo) {
+    const llvm::Value *object = LoopBound::Util::getUnderlyingObject(loadInst->getPointerOperand());
+    if (!object) {
+        return std::nullopt;
+    }
+
+    for (llvm::Loop *loop = loopInfo.getLoopFor(loadInst->getParent()); loop != nullptr;
+         loop = loop->getParentLoop()) {
+        for (llvm::BasicBlock *loopBlock : loop->blocks()) {
+            for (llvm::Instruction &instruction : *loopBlock) {
+                auto *storeInst = llvm::dyn_cast<llvm::StoreInst>(&instruction);
+                if (storeInst && LoopBound::Util::stripAddr(storeInst->getPointerOperand()) == object) {
+                    return std::nullopt;
+                }
+            }
+        }
+    }
+
+    const llvm::StoreInst *bestStore = nullptr;
+    for (const llvm::BasicBlock &basicBlock : *loadInst->getFunction()) {
+        for (const llvm::Instruction &instruction : basicBlock) {
+            auto *storeInst = llvm::dyn_cast<llvm::StoreInst>(&instruction);
+            if (!storeInst || LoopBound::Util::getUnderlyingObject(storeInst->getPointerOperand()) != object ||
+                !dominatorTree.dominates(storeInst, loadInst)) {
+                continue;
+            }
+
+            // Dominating stores form a chain, the last one in dominance order is executed right before the load
+            if (!bestStore || dominatorTree.dominates(bestStore, storeInst)) {
+                bestStore = storeInst;
+            }
+        }
+    }
+
+    if (!bestStore) {
+        return std::nullopt;
+    }
+
+    const llvm::ConstantInt *constValue = LoopBound::Util::tryEvalToConstInt(bestStore->getValueOperand());
+    if (!constValue) {
+        return std::nullopt;
+    }
+
+    return constValue->getSExtValue();
+}
+
+}  // namespace
+
+/**
+ * Compares the indexed lookup of the constant stored to a loaded counter or bound against the scanning lookup it
+ * replaced. Hidden from the default run, execute with: spear_tests "[benchmark]"
+ */
+TEST_CASE("Memory access lookup: indexed vs. scanning", "[.][benchmark]") {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic error;
+    const auto path = std::filesystem::path(TEST_INPUT_DIR) / "programs/loopbound/compiled/loopbound_counter_dense.ll";
+    std::unique_ptr<llvm::Module> module = llvm::parseIRFile(path.string(), error, context);
+    REQUIRE(module != nullptr);
+
+    llvm::Function *function = module->getFunction("main");
+    REQUIRE(function != nullptr);
+
+    llvm::DominatorTree dominatorTree(*function);
+    llvm::LoopInfo loopInfo(dominatorTree);
+
+    std::vector<const llvm::LoadInst *> loads;
+    for (llvm::Instruction &instruction : llvm::instructions(*function)) {
+        if (auto *loadInst = llvm::dyn_cast<llvm::LoadInst>(&instruction)) {
+            loads.push_back(loadInst);
+        }
+    }
+    REQUIRE(!loads.empty());
+
+    // Both lookups have to agree before their times are compared
+    const LoopBound::Util::MemoryAccessIndex accesses(*function, dominatorTree);
+    for (const llvm::LoadInst *loadInst : loads) {
+        CHECK(LoopBound::Util::tryDeduceConstFromLoad(loadInst, dominatorTree, loopInfo, accesses) ==
+              scanForConstFromLoad(loadInst, dominatorTree, loopInfo));
+    }
+
+    BENCHMARK("scanning lookup, all loads") {
+        int64_t resolved = 0;
+        for (const llvm::LoadInst *loadInst : loads) {
+            resolved += scanForConstFromLoad(loadInst, dominatorTree, loopInfo).has_value();
+        }
+        return resolved;
+    };
+
+    BENCHMARK("indexed lookup, all loads") {
+        int64_t resolved = 0;
+        for (const llvm::LoadInst *loadInst : loads) {
+            resolved += LoopBound::Util::tryDeduceConstFromLoad(loadInst, dominatorTree, loopInfo, accesses)
+                                .has_value();
+        }
+        return resolved;
+    };
+
+    BENCHMARK("indexed lookup, all loads including building the index") {
+        const LoopBound::Util::MemoryAccessIndex freshAccesses(*function, dominatorTree);
+        int64_t resolved = 0;
+        for (const llvm::LoadInst *loadInst : loads) {
+            resolved += LoopBound::Util::tryDeduceConstFromLoad(loadInst, dominatorTree, loopInfo, freshAccesses)
+                                .has_value();
+        }
+        return resolved;
+    };
+}
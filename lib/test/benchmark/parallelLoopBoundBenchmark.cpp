@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+#include "../loopbound/loopBoundTestModule.h"
+
+namespace {
+
+/**
+ * Module with the given amount of functions. Each function counts a local counter in two loops and calls the next
+ * function inside the first one, every fourth function additionally counts one of four globals shared by the chain
+ */
+std::string buildCounterModule(size_t functionCount) {
+    std::string source = "@g0 = global i32 0\n@g1 = global i32 0\n@g2 = global i32 0\n@g3 = global i32 0\n\n";
+
+    for (size_t index = 0; index < functionCount; index++) {
+        const std::string name = "f" + std::to_string(index);
+        const std::string global = "@g" + std::to_string(index / 4 % 4);
+        const bool callsNext = index + 1 < functionCount;
+        const bool countsGlobal = index % 4 == 0;
+
+        source += "define void @" + name + "() {\n"
+                  "entry:\n"
+                  "  %i = alloca i32\n"
+                  "  store i32 0, ptr %i\n"
+                  "  br label %a.cond\n"
+                  "a.cond:\n"
+                  "  %a = load i32, ptr %i\n"
+                  "  %a.cmp = icmp slt i32 %a, 100\n"
+                  "  br i1 %a.cmp, label %a.body, label %b.cond\n"
+                  "a.body:\n";
+        if (callsNext) {
+            source += "  call void @f" + std::to_string(index + 1) + "()\n";
+        }
+        source += "  %a.old = load i32, ptr %i\n"
+                  "  %a.inc = add nsw i32 %a.old, 1\n"
+                  "  store i32 %a.inc, ptr %i\n"
+                  "  br label %a.cond\n"
+                  "b.cond:\n"
+                  "  %b = load i32, ptr %i\n"
+                  "  %b.cmp = icmp slt i32 %b, 200\n"
+                  "  br i1 %b.cmp, label %b.body, label %" + std::string(countsGlobal ? "g.cond" : "exit") + "\n"
+                  "b.body:\n"
+                  "  %b.old = load i32, ptr %i\n"
+                  "  %b.inc = add nsw i32 %b.old, 3\n"
+                  "  store i32 %b.inc, ptr %i\n"
+                  "  br label %b.cond\n";
+        if (countsGlobal) {
+            source += "g.cond:\n"
+                      "  %g = load i32, ptr " + global + "\n"
+                      "  %g.cmp = icmp slt i32 %g, 1000\n"
+                      "  br i1 %g.cmp, label %g.body, label %exit\n"
+                      "g.body:\n"
+                      "  %g.old = load i32, ptr " + global + "\n"
+                      "  %g.inc = add nsw i32 %g.old, 2\n"
+                      "  store i32 %g.inc, ptr " + global + "\n"
+                      "  br label %g.cond\n";
+        }
+        source += "exit:\n"
+                  "  ret void\n"
+                  "}\n\n";
+    }
+
+    source += "define i32 @main() {\n"
+              "entry:\n"
+              "  call void @f0()\n"
+              "  ret i32 0\n"
+              "}\n";
+
+    return source;
+}
+
+}  // namespace
+
+/**
+ * Compares the serial Phasar solver against the parallel loop bound solver with a growing amount of threads on a
+ * module with many counters, some of them carried through calls. Hidden from the default run, execute with:
+ * spear_tests "[benchmark]"
+ */
+TEST_CASE("Loop bound solver: serial vs. parallel with increasing thread counts", "[.][benchmark]") {
+    LoopBoundTestModule testModule(buildCounterModule(256));
+    auto serialResults = testModule.solveSerially();
+
+    // The speedup is only meaningful if the parallel solver computes the serial fixed point
+    {
+        LoopBound::ParallelLoopBoundSolver solver(*testModule.problem, testModule.getICFG(), 8);
+        solver.solve();
+        REQUIRE(testModule.countMismatches(serialResults, solver) == 0);
+    }
+
+    BENCHMARK("serial Phasar solver") {
+        testModule.solveSerially();
+    };
+
+    for (const unsigned threadCount : {1U, 2U, 4U, 8U}) {
+        BENCHMARK("parallel solver, " + std::to_string(threadCount) + " threads") {
+            LoopBound::ParallelLoopBoundSolver solver(*testModule.problem, testModule.getICFG(), threadCount);
+            solver.solve();
+            return solver.getStatistics().iterations;
+        };
+    }
+}
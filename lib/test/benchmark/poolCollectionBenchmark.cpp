@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/LLVMContext.h>
+#include <z3++.h>
+
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../testutils.h"
+#include "analyses/feasibility/FeasibilityAnalysisManager.h"
+
+namespace {
+
+/**
+ * Manager filled with one set and one environment per entry, every tenth entry is referenced by a live element
+ */
+struct SyntheticPool {
+    std::unique_ptr<Feasibility::FeasibilityAnalysisManager> manager;
+    std::vector<Feasibility::FeasibilityElement> liveElements;
+
+    SyntheticPool(llvm::LLVMContext &context, int entries)
+        : manager(std::make_unique<Feasibility::FeasibilityAnalysisManager>(std::make_unique<z3::context>())) {
+        z3::context &z3Context = manager->getContext();
+        const z3::expr x = z3Context.int_const("x");
+        auto *type = llvm::Type::getInt32Ty(context);
+
+        uint32_t envId = 0;
+        for (int i = 0; i < entries; i++) {
+            const uint32_t setId = manager->addAtom(Feasibility::FeasibilityElement::topId, x == i);
+
+            // Environments extend each other in chains of eight, a live environment keeps the ones it extends
+            envId = manager->extendEnv(i % 8 == 0 ? 0 : envId, llvm::ConstantInt::get(type, i),
+                                       llvm::ConstantInt::get(type, i + 1));
+
+            if (i % 10 == 0) {
+                liveElements.push_back(Feasibility::FeasibilityElement::createElement(
+                    manager.get(), setId, Feasibility::FeasibilityElement::Kind::Normal, envId));
+            }
+        }
+    }
+};
+
+}  // namespace
+
+/**
+ * Reports the collection of the feasibility_ssa_width.ll analysis and measures the collection cost for growing pools.
+ * Hidden from the default run, execute with: spear_tests "[benchmark]"
+ */
+TEST_CASE("Pool collection: released entries and cost for growing pools", "[.][benchmark]") {
+    const TestConfig feasibilityConfig = {.runFeasibilityAnalysis = true, .runLoopBoundAnalysis = false};
+    auto Run = runSpearOnFile(std::filesystem::path(TEST_INPUT_DIR),
+                              "programs/feasibility/compiled/feasibility_ssa_width.ll", feasibilityConfig, true);
+    REQUIRE(Run->phasarHandler.queryFeasibilty().contains("main"));
+
+    const auto &collection = Run->phasarHandler.feasibilityProblem->getManager()->getLastCollection();
+    std::cout << "feasibility_ssa_width.ll: released " << collection.reclaimedSets << " of " << collection.sets
+              << " sets and " << collection.reclaimedEnvironments << " of " << collection.environments
+              << " environments in " << collection.durationUs << "us" << std::endl;
+
+    llvm::LLVMContext context;
+    for (int entries : {1000, 4000, 16000}) {
+        // Every set that is not referenced by a live element has to be released
+        SyntheticPool pool(context, entries);
+        const auto statistics = pool.manager->collectGarbage(pool.liveElements);
+        REQUIRE(statistics.sets == static_cast<size_t>(entries));
+        REQUIRE(statistics.reclaimedSets == entries - pool.liveElements.size());
+        REQUIRE(statistics.reclaimedEnvironments < statistics.environments);
+
+        BENCHMARK_ADVANCED("collect " + std::to_string(entries) + " sets and environments")(
+            Catch::Benchmark::Chronometer meter) {
+            // A collection changes the pools, so every run collects a pool of its own
+            std::vector<SyntheticPool> pools;
+            for (int run = 0; run < meter.runs(); run++) {
+                pools.emplace_back(context, entries);
+            }
+
+            meter.measure([&pools](int run) {
+                return pools[run].manager->collectGarbage(pools[run].liveElements).reclaimedSets;
+            });
+        };
+    }
+}
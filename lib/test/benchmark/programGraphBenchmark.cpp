@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+#include <string>
+#include <vector>
+
+#include "../legacy/diamondChain.h"
+#include "ProgramGraph.h"
+
+namespace {
+
+/**
+ * Construct the graph of the given blocks and visit the outgoing edges of every node, as the legacy analysis does
+ * @return Amount of visited edges
+ */
+size_t constructAndTraverse(const std::vector<llvm::BasicBlock *> &blocks) {
+    ProgramGraph graph;
+    ProgramGraph::construct(&graph, blocks, AnalysisStrategy::WORSTCASE);
+
+    size_t adjacentEdges = 0;
+    for (auto *node : graph.nodes) {
+        adjacentEdges += graph.findEdgesStartingAtNode(node).size();
+    }
+
+    for (auto *node : graph.nodes) {
+        delete node;
+    }
+    for (auto *edge : graph.edges) {
+        delete edge;
+    }
+
+    return adjacentEdges;
+}
+
+}  // namespace
+
+/**
+ * Measures the ProgramGraph construction and traversal on diamond chains of growing size. The times grow linearly with
+ * the block count. Hidden from the default run, execute with: spear_tests "[benchmark]"
+ */
+TEST_CASE("ProgramGraph construction scales with the block count", "[.][benchmark]") {
+    llvm::LLVMContext context;
+    llvm::Module module("diamonds", context);
+
+    for (int diamonds : {1000, 4000, 16000}) {
+        llvm::Function *function = buildDiamondChain(module, diamonds);
+        std::vector<llvm::BasicBlock *> blocks;
+        for (auto &basicBlock : *function) {
+            blocks.push_back(&basicBlock);
+        }
+
+        // Every edge has to be found from its start node before the times are compared
+        REQUIRE(constructAndTraverse(blocks) == static_cast<size_t>(4 * diamonds));
+
+        BENCHMARK("construct and traverse, " + std::to_string(blocks.size()) + " blocks") {
+            return constructAndTraverse(blocks);
+        };
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <phasar.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../testutils.h"
+
+namespace {
+
+/**
+ * Set up the helper analyses and the ICFG of the module, as the pass did for every module before they were built on
+ * first use
+ */
+size_t setUpHelperAnalyses(SpearRun &run) {
+    psr::HelperAnalyses helperAnalyses(&run.module(), std::vector<std::string>{"__ALL__"});
+
+    // The ICFG, including the call graph and the points-to information it needs, is built on first access
+    static_cast<void>(helperAnalyses.getICFG());
+    return helperAnalyses.getProjectIRDB().getModule()->size();
+}
+
+}  // namespace
+
+/**
+ * Compares the startup of the analyses on modules without branches or loops against additionally setting up the
+ * helper analyses eagerly. Hidden from the default run, execute with: spear_tests "[benchmark]"
+ */
+TEST_CASE("Startup on trivial modules: lazy vs. eager helper analyses", "[.][benchmark]") {
+    const std::filesystem::path testroot(TEST_INPUT_DIR);
+    const TestConfig feasibilityConfig = {.runFeasibilityAnalysis = true, .runLoopBoundAnalysis = false};
+    const TestConfig loopBoundConfig = {.runFeasibilityAnalysis = false, .runLoopBoundAnalysis = true};
+    const std::string straightline = "programs/feasibility/compiled/feasibility_straightline.ll";
+    const std::string loopfree = "programs/loopbound/compiled/loopbound_loopfree.ll";
+
+    // Both modules have to skip the analyses, otherwise the lazy setup has nothing to save
+    {
+        auto Run = runSpearOnFile(testroot, straightline, feasibilityConfig, true);
+        REQUIRE(Run->phasarHandler.feasibilityProblem == nullptr);
+        REQUIRE(Run->phasarHandler.queryFeasibilty().contains("main"));
+    }
+    {
+        auto Run = runSpearOnFile(testroot, loopfree, loopBoundConfig, false);
+        REQUIRE(Run->phasarHandler.loopboundwrapper == nullptr);
+        REQUIRE(Run->phasarHandler.queryLoopBounds().empty());
+    }
+
+    BENCHMARK("feasibility_straightline.ll, lazy") {
+        auto Run = runSpearOnFile(testroot, straightline, feasibilityConfig, true);
+        return Run->phasarHandler.queryFeasibilty().size();
+    };
+
+    BENCHMARK("feasibility_straightline.ll, eager helper analyses") {
+        auto Run = runSpearOnFile(testroot, straightline, feasibilityConfig, true);
+        return Run->phasarHandler.queryFeasibilty().size() + setUpHelperAnalyses(*Run);
+    };
+
+    BENCHMARK("loopbound_loopfree.ll, lazy") {
+        auto Run = runSpearOnFile(testroot, loopfree, loopBoundConfig, false);
+        return Run->phasarHandler.queryLoopBounds().size();
+    };
+
+    BENCHMARK("loopbound_loopfree.ll, eager helper analyses") {
+        auto Run = runSpearOnFile(testroot, loopfree, loopBoundConfig, false);
+        return Run->phasarHandler.queryLoopBounds().size() + setUpHelperAnalyses(*Run);
+    };
+}
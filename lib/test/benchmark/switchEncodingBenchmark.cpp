@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/SourceMgr.h>
+#include <z3++.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "ConfigParser.h"
+#include "analyses/feasibility/FeasibilityAnalysisManager.h"
+#include "analyses/feasibility/FeasibilityElement.h"
+#include "analyses/feasibility/util.h"
+
+namespace {
+
+/**
+ * Formula sets of all edges of a switch under one encoding
+ */
+struct SwitchEncoding {
+    std::vector<uint32_t> setIds;
+    size_t atoms = 0;
+    size_t comparisons = 0;
+};
+
+/**
+ * Encode every edge as one atom of merged value ranges, as the feasibility analysis does
+ */
+SwitchEncoding encodeRanges(Feasibility::FeasibilityAnalysisManager &manager, const llvm::SwitchInst *switchInst,
+                            const std::set<const llvm::BasicBlock *> &successors, const z3::expr &condition) {
+    SwitchEncoding encoding;
+    for (const llvm::BasicBlock *succ : successors) {
+        const Feasibility::SwitchEdgeRanges &edge = manager.getSwitchRanges(switchInst, succ);
+        const z3::expr atom = Feasibility::Util::createConstraintFromRanges(manager.getContext(), condition, edge);
+
+        encoding.setIds.push_back(manager.addAtom(Feasibility::FeasibilityElement::topId, atom));
+        encoding.atoms++;
+        encoding.comparisons += edge.ranges.size();
+    }
+
+    return encoding;
+}
+
+/**
+ * Encode every case on its own. A case edge is the disjunction of one equality per case value, the default edge is
+ * one disequality atom per case value leading to another block
+ */
+SwitchEncoding encodeCases(Feasibility::FeasibilityAnalysisManager &manager, const llvm::SwitchInst *switchInst,
+                           const std::set<const llvm::BasicBlock *> &successors, const z3::expr &condition) {
+    z3::context &context = manager.getContext();
+    const unsigned bitwidth = condition.get_sort().bv_size();
+
+    SwitchEncoding encoding;
+    for (const llvm::BasicBlock *succ : successors) {
+        const bool isDefault = switchInst->getDefaultDest() == succ;
+        std::vector<z3::expr> atoms;
+        z3::expr_vector equalities(context);
+
+        for (const auto &switchCase : switchInst->cases()) {
+            if ((switchCase.getCaseSuccessor() == succ) == isDefault) {
+                continue;
+            }
+
+            const z3::expr value = context.bv_val(switchCase.getCaseValue()->getZExtValue(), bitwidth);
+            if (isDefault) {
+                atoms.push_back(condition != value);
+            } else {
+                equalities.push_back(condition == value);
+            }
+            encoding.comparisons++;
+        }
+
+        if (!isDefault) {
+            atoms.push_back(equalities.empty() ? context.bool_val(false) : z3::mk_or(equalities));
+        }
+
+        encoding.setIds.push_back(manager.addAtoms(Feasibility::FeasibilityElement::topId, atoms));
+        encoding.atoms += atoms.size();
+    }
+
+    return encoding;
+}
+
+/**
+ * Check every edge set together with the value the switch is reached with
+ * @return Amount of satisfiable edges
+ */
+int64_t querySets(Feasibility::FeasibilityAnalysisManager &manager, const SwitchEncoding &encoding,
+                  const z3::expr &pathCondition) {
+    int64_t satisfiable = 0;
+    for (uint32_t setId : encoding.setIds) {
+        std::vector<z3::expr> set = manager.getPureSet(setId);
+        set.push_back(pathCondition);
+        satisfiable += Feasibility::Util::setSat(set, &manager.getContext());
+    }
+
+    return satisfiable;
+}
+
+}  // namespace
+
+/**
+ * Compares the range compressed switch edge atoms against one atom per case on the wide switch of
+ * feasibility_switch.ll. Hidden from the default run, execute with: spear_tests "[benchmark]"
+ */
+TEST_CASE("Switch encoding: ranges vs. one atom per case", "[.][benchmark]") {
+    // The solver portfolio is read from the configuration
+    ConfigParser configParser(std::filesystem::path(TEST_INPUT_DIR) / "defaultconfig.json");
+    configParser.parse();
+
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic error;
+    const auto path = std::filesystem::path(TEST_INPUT_DIR) / "programs/feasibility/compiled/feasibility_switch.ll";
+    std::unique_ptr<llvm::Module> module = llvm::parseIRFile(path.string(), error, context);
+    REQUIRE(module != nullptr);
+
+    const llvm::SwitchInst *switchInst = nullptr;
+    for (llvm::Instruction &instruction : llvm::instructions(*module->getFunction("main"))) {
+        if (auto *candidate = llvm::dyn_cast<llvm::SwitchInst>(&instruction)) {
+            switchInst = candidate;
+        }
+    }
+    REQUIRE(switchInst != nullptr);
+
+    std::set<const llvm::BasicBlock *> successors;
+    for (const llvm::BasicBlock *succ : llvm::successors(switchInst)) {
+        successors.insert(succ);
+    }
+
+    Feasibility::FeasibilityAnalysisManager manager(std::make_unique<z3::context>());
+    const unsigned bitwidth = switchInst->getCondition()->getType()->getIntegerBitWidth();
+    const z3::expr condition = manager.getContext().bv_const("opcode", bitwidth);
+    const z3::expr pathCondition = condition == manager.getContext().bv_val(200, bitwidth);
+
+    const SwitchEncoding ranges = encodeRanges(manager, switchInst, successors, condition);
+    const SwitchEncoding cases = encodeCases(manager, switchInst, successors, condition);
+
+    std::cout << "feasibility_switch.ll: " << successors.size() << " edges, " << switchInst->getNumCases()
+              << " cases" << std::endl;
+    std::cout << "  ranges:   " << ranges.atoms << " atoms, " << ranges.comparisons << " comparisons" << std::endl;
+    std::cout << "  per case: " << cases.atoms << " atoms, " << cases.comparisons << " comparisons" << std::endl;
+
+    // Both encodings have to select the same edges before their times are compared
+    REQUIRE(querySets(manager, ranges, pathCondition) == querySets(manager, cases, pathCondition));
+    REQUIRE(ranges.atoms <= cases.atoms);
+
+    // The ranges of an edge are cached by the manager, as during the analysis
+    BENCHMARK("encode, ranges") {
+        return encodeRanges(manager, switchInst, successors, condition).atoms;
+    };
+
+    BENCHMARK("encode, one atom per case") {
+        return encodeCases(manager, switchInst, successors, condition).atoms;
+    };
+
+    BENCHMARK("query, ranges") {
+        return querySets(manager, ranges, pathCondition);
+    };
+
+    BENCHMARK("query, one atom per case") {
+        return querySets(manager, cases, pathCondition);
+    };
+}
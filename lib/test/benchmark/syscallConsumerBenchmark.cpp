@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "EnergyCounterSource.h"
+#include "profilers/SyscallEventConsumer.h"
+
+/**
+ * Measures the throughput of the syscall tracer's consumer on a synthetic stream of 64 threads, every syscall
+ * interrupted once by the scheduler. Hidden from the default run, execute with: spear_tests "[benchmark]"
+ */
+TEST_CASE("SyscallEventConsumer throughput", "[.][benchmark]") {
+    constexpr uint32_t threads = 64;
+    constexpr uint64_t syscallsPerThread = 1 << 12;
+
+    // The stream is recorded once, so the benchmark only measures the consumer
+    std::vector<evt> events;
+    events.reserve(4 * threads * syscallsPerThread);
+    for (uint64_t round = 0; round < syscallsPerThread; round++) {
+        for (uint32_t tid = 0; tid < threads; tid++) {
+            const uint32_t id = static_cast<uint32_t>((round + tid) % 462);
+            for (uint8_t type : {0, 2, 3, 1}) {
+                events.push_back({0, tid, type == 0 || type == 1 ? id : 0, type});
+            }
+        }
+    }
+
+    MockCounterSource source(10.0);
+    SyscallEventConsumer consumer(source, 462);
+    std::cout << "SyscallEventConsumer: " << events.size() << " events per run" << std::endl;
+
+    BENCHMARK_ADVANCED("consume the stream")(Catch::Benchmark::Chronometer meter) {
+        meter.measure([&] {
+            consumer.reset();
+
+            // Full batches read the counter at the current time, so the events are stamped on delivery with the
+            // same clock. The clock reads are part of the measured time
+            for (evt &event : events) {
+                event.ts = SyscallEventConsumer::monotonicNs();
+                SyscallEventConsumer::onRecord(&consumer, &event, sizeof(event));
+            }
+            consumer.flush();
+
+            return consumer.getStats().processed;
+        });
+    };
+
+    REQUIRE(consumer.getStats().processed == events.size());
+    REQUIRE(consumer.getStats().dropped() == 0);
+}
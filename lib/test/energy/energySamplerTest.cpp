@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "EnergyCounterSource.h"
+#include "EnergySampler.h"
+
+TEST_CASE("CounterExtender extends a wrapping counter") {
+    CounterExtender extender(8);
+
+    REQUIRE(extender.extend(250) == 0);
+    REQUIRE(extender.extend(255) == 5);
+    // 255 -> 4 wraps around after 5 ticks
+    REQUIRE(extender.extend(4) == 10);
+    REQUIRE(extender.extend(4) == 10);
+    REQUIRE(extender.extend(200) == 206);
+    REQUIRE(extender.extend(100) == 362);
+    REQUIRE(extender.getWraparounds() == 2);
+}
+
+TEST_CASE("SampleRingBuffer drops samples when full") {
+    SampleRingBuffer buffer(3);
+    REQUIRE(buffer.getCapacity() == 4);
+
+    for (uint64_t index = 0; index < 6; index++) {
+        REQUIRE(buffer.push({index, index * 10}) == (index < 4));
+    }
+    REQUIRE(buffer.getDropped() == 2);
+
+    std::vector<EnergySample> samples;
+    REQUIRE(buffer.drain(samples) == 4);
+    REQUIRE(samples.size() == 4);
+    for (uint64_t index = 0; index < 4; index++) {
+        REQUIRE(samples[index].timeNs == index);
+        REQUIRE(samples[index].ticks == index * 10);
+    }
+
+    REQUIRE(buffer.push({6, 60}));
+    REQUIRE(buffer.drain(samples) == 1);
+    REQUIRE(samples.back().ticks == 60);
+}
+
+TEST_CASE("EnergySampler extends the mock counter across wraparounds") {
+    // 8 bit counter with one Joule per tick that only advances on addEnergy()
+    MockCounterSource source(0, 8, 1.0);
+    EnergySampler sampler(source, 1000);
+
+    for (int step = 0; step < 10; step++) {
+        sampler.sample();
+        source.addEnergy(100);
+    }
+    sampler.sample();
+
+    REQUIRE(sampler.getLatestTicks() == 1000);
+    REQUIRE(sampler.getWraparounds() == 3);
+
+    auto timeline = sampler.getTimeline();
+    REQUIRE(timeline.size() == 11);
+    for (size_t index = 0; index < timeline.size(); index++) {
+        REQUIRE(timeline[index].ticks == index * 100);
+    }
+
+    auto json = sampler.toJson();
+    REQUIRE(json["source"] == "mock");
+    REQUIRE(json["samples"].size() == 11);
+    REQUIRE(json["samples"][10][1].get<double>() == 1000.0);
+}
+
+TEST_CASE("EnergySampler samples in the background") {
+    // 16 bit counter at 10 W and 1 mJ per tick wraps around about every 6.5 seconds
+    MockCounterSource source(10, 16, 1e-3);
+    EnergySampler sampler(source, 1000);
+
+    sampler.start();
+    REQUIRE(sampler.isRunning());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sampler.collect();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sampler.stop();
+    REQUIRE_FALSE(sampler.isRunning());
+
+    auto timeline = sampler.getTimeline();
+    REQUIRE(timeline.size() >= 10);
+    REQUIRE(sampler.getDroppedSamples() == 0);
+
+    for (size_t index = 1; index < timeline.size(); index++) {
+        REQUIRE(timeline[index].timeNs >= timeline[index - 1].timeNs);
+        REQUIRE(timeline[index].ticks >= timeline[index - 1].ticks);
+    }
+
+    // About one Joule in 100 ms, generous bounds for loaded machines
+    const double joules = static_cast<double>(timeline.back().ticks) * source.getEnergyUnit();
+    const double seconds = static_cast<double>(timeline.back().timeNs) * 1e-9;
+    REQUIRE(joules > 0.5);
+    REQUIRE(joules <= seconds * 10 + 0.01);
+}
+
+TEST_CASE("EnergySampler collects its buffer without a consumer") {
+    // The buffer holds 8 samples, far fewer than the sampler takes without a call to collect()
+    MockCounterSource source(10, 32, 1e-3);
+    EnergySampler sampler(source, 1000, 8);
+
+    sampler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    sampler.stop();
+
+    REQUIRE(sampler.getDroppedSamples() == 0);
+    REQUIRE(sampler.getTimeline().size() > 8);
+}
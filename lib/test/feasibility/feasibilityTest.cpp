@@ -4,6 +4,7 @@
  */
 
 #include <catch2/catch_test_macros.hpp>
+
 #include "../testutils.h"
 
 TestConfig feasibilityConfig = {.runFeasibilityAnalysis = true, .runLoopBoundAnalysis = false};
@@ -115,3 +116,64 @@ TEST_CASE("feasibility_wide.ll") {
     CHECK_INFEASIBLE_BLOCKS_STRICT(&feasibilityOfFunction, {"if.then", "if.then2"},
                                    {"entry", "if.then", "if.then2", "if.end", "if.end3"});
 }
+
+TEST_CASE("feasibility_switch.ll") {
+    auto Run = runSpearOnFile(std::filesystem::path(TEST_INPUT_DIR),
+                              "programs/feasibility/compiled/feasibility_switch.ll", feasibilityConfig, true);
+
+    auto feasibilityMap = Run->phasarHandler.queryFeasibilty();
+    auto feasibilityOfFunction = feasibilityMap["main"];
+
+    CHECK_INFEASIBLE_BLOCKS_STRICT(&feasibilityOfFunction, {"sw.bb", "sw.bb1", "sw.bb3", "sw.default"},
+                                   {"entry", "sw.bb", "sw.bb1", "sw.bb2", "sw.bb3", "sw.default", "sw.epilog"});
+}
+
+TEST_CASE("feasibility_ssa_width.ll environments") {
+    auto Run = runSpearOnFile(std::filesystem::path(TEST_INPUT_DIR),
+                              "programs/feasibility/compiled/feasibility_ssa_width.ll", feasibilityConfig, true);
+
+    auto feasibilityMap = Run->phasarHandler.queryFeasibilty();
+    REQUIRE(feasibilityMap.contains("main"));
+
+    auto statistics = Run->phasarHandler.feasibilityProblem->getManager()->getEnvironmentStatistics();
+    // All phis of an edge share one node, so an environment grows by at most one node per block on the path
+    REQUIRE(statistics.environments > 0);
+    REQUIRE(statistics.maxDepth <= Run->module().getFunction("main")->size());
+}
+
+TEST_CASE("feasibility_ssa_width.ll pool collection") {
+    auto Run = runSpearOnFile(std::filesystem::path(TEST_INPUT_DIR),
+                              "programs/feasibility/compiled/feasibility_ssa_width.ll", feasibilityConfig, true);
+
+    auto feasibilityMap = Run->phasarHandler.queryFeasibilty();
+    REQUIRE(feasibilityMap.contains("main"));
+
+    auto *manager = Run->phasarHandler.feasibilityProblem->getManager();
+    const auto first = manager->getLastCollection();
+    REQUIRE(first.sets > 0);
+    REQUIRE(first.reclaimedSets <= first.sets);
+    REQUIRE(first.reclaimedEnvironments <= first.environments);
+
+    // Released entries are not counted again, without live elements everything else goes
+    const auto second = manager->collectGarbage({});
+    REQUIRE(second.sets == first.sets - first.reclaimedSets);
+    REQUIRE(second.environments == first.environments - first.reclaimedEnvironments);
+    REQUIRE(second.reclaimedSets == second.sets);
+    REQUIRE(second.reclaimedEnvironments == second.environments);
+}
+
+TEST_CASE("feasibility_straightline.ll skips the solver") {
+    auto Run = runSpearOnFile(std::filesystem::path(TEST_INPUT_DIR),
+                              "programs/feasibility/compiled/feasibility_straightline.ll", feasibilityConfig, true);
+
+    auto feasibilityMap = Run->phasarHandler.queryFeasibilty();
+
+    // Without a branch no Z3 context is created, every block is feasible
+    REQUIRE(Run->phasarHandler.feasibilityProblem == nullptr);
+
+    auto feasibilityOfMain = feasibilityMap["main"];
+    CHECK_INFEASIBLE_BLOCKS_STRICT(&feasibilityOfMain, {}, {"entry"});
+
+    auto feasibilityOfScale = feasibilityMap["_Z5scaleii"];
+    CHECK_INFEASIBLE_BLOCKS_STRICT(&feasibilityOfScale, {}, {"entry"});
+}
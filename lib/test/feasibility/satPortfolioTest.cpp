@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <z3++.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "ConfigParser.h"
+#include "analyses/feasibility/FeasibilityPortfolio.h"
+#include "analyses/feasibility/util.h"
+
+namespace {
+
+/**
+ * x * y == 2147483647 * 2147483629 over 64 bit factors above 1. Factoring the product of two 31 bit primes takes far
+ * longer than the 1 ms budgets used below
+ */
+std::vector<z3::expr> hardSet(z3::context &context) {
+    const z3::expr x = context.bv_const("x", 64);
+    const z3::expr y = context.bv_const("y", 64);
+    const z3::expr limit = context.bv_val(static_cast<uint64_t>(1) << 32, 64);
+
+    return {x * y == context.bv_val(static_cast<uint64_t>(2147483647) * 2147483629, 64),
+            z3::ugt(x, context.bv_val(1, 64)), z3::ugt(y, context.bv_val(1, 64)), z3::ult(x, limit),
+            z3::ult(y, limit)};
+}
+
+}  // namespace
+
+TEST_CASE("SatPortfolio decides easy sets without escalating") {
+    z3::context context;
+    const z3::expr x = context.int_const("x");
+    const size_t escalatedBefore = Feasibility::SatPortfolio::getLatencyReport().escalatedQueries;
+
+    for (const bool enabled : {false, true}) {
+        const SatPortfolioConfiguration configuration{enabled, 1000, 1000};
+
+        REQUIRE(Feasibility::SatPortfolio::isSat({x > 1, x < 3}, &context, configuration));
+        REQUIRE_FALSE(Feasibility::SatPortfolio::isSat({x > 1, x < 2}, &context, configuration));
+    }
+
+    REQUIRE(Feasibility::SatPortfolio::getLatencyReport().escalatedQueries == escalatedBefore);
+}
+
+TEST_CASE("SatPortfolio treats undecided sets as satisfiable") {
+    z3::context context;
+    const auto before = Feasibility::SatPortfolio::getLatencyReport();
+
+    // Neither the default solver nor any portfolio configuration factors the product within 1 ms, the set is
+    // unknown and must not be pruned
+    const SatPortfolioConfiguration configuration{true, 1, 1};
+    REQUIRE(Feasibility::SatPortfolio::isSat(hardSet(context), &context, configuration));
+
+    const auto after = Feasibility::SatPortfolio::getLatencyReport();
+    REQUIRE(after.queries == before.queries + 1);
+    REQUIRE(after.escalatedQueries == before.escalatedQueries + 1);
+}
+
+TEST_CASE("SatPortfolio keeps the answer when the initial budget runs out") {
+    z3::context context;
+    const auto before = Feasibility::SatPortfolio::getLatencyReport();
+
+    // Whether the default solver answers within 1 ms or the portfolio takes over, the result is the same
+    const z3::expr x = context.bv_const("x", 16);
+    const z3::expr y = context.bv_const("y", 16);
+    const std::vector<z3::expr> set = {x * y == context.bv_val(77, 16), z3::ugt(x, context.bv_val(1, 16)),
+                                       z3::ugt(y, context.bv_val(1, 16)), z3::ult(x, context.bv_val(256, 16)),
+                                       z3::ult(y, context.bv_val(256, 16))};
+    REQUIRE(Feasibility::SatPortfolio::isSat(set, &context, {true, 1, 10000}));
+
+    const std::vector<z3::expr> unsatSet = {x * y == context.bv_val(79, 16), z3::ugt(x, context.bv_val(1, 16)),
+                                            z3::ugt(y, context.bv_val(1, 16)), z3::ult(x, context.bv_val(256, 16)),
+                                            z3::ult(y, context.bv_val(256, 16))};
+    REQUIRE_FALSE(Feasibility::SatPortfolio::isSat(unsatSet, &context, {true, 1, 10000}));
+
+    REQUIRE(Feasibility::SatPortfolio::getLatencyReport().queries == before.queries + 2);
+}
+
+TEST_CASE("setSat uses the current portfolio configuration") {
+    const AnalysisConfiguration original = ConfigParser::getAnalysisConfiguration();
+    z3::context context;
+
+    AnalysisConfiguration configuration = original;
+    configuration.satportfolioconfig = {true, 1, 1};
+    ConfigParser::overrideAnalysisConfiguration(configuration);
+
+    size_t escalated = Feasibility::SatPortfolio::getLatencyReport().escalatedQueries;
+    REQUIRE(Feasibility::Util::setSat(hardSet(context), &context));
+    REQUIRE(Feasibility::SatPortfolio::getLatencyReport().escalatedQueries == escalated + 1);
+
+    // A later override, e.g. of a degraded worker, is picked up by the next query
+    configuration.satportfolioconfig = {false, 0, 10000};
+    ConfigParser::overrideAnalysisConfiguration(configuration);
+
+    const z3::expr x = context.int_const("x");
+    escalated = Feasibility::SatPortfolio::getLatencyReport().escalatedQueries;
+    REQUIRE_FALSE(Feasibility::Util::setSat({x > 1, x < 2}, &context));
+    REQUIRE(Feasibility::SatPortfolio::getLatencyReport().escalatedQueries == escalated);
+
+    ConfigParser::overrideAnalysisConfiguration(original);
+}
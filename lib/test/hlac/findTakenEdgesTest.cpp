@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "HLAC/hlac.h"
+#include "HLAC/util.h"
+#include "syntheticFunction.h"
+
+TEST_CASE("EdgeIndex finds the first matching edge") {
+    SyntheticFunction function(4);
+    auto *first = function.nodes[0].get();
+    auto *second = function.nodes[1].get();
+
+    // A parallel edge added later does not replace the original one
+    function.edges.push_back(std::make_unique<HLAC::Edge>(first, second));
+    function.edges.back()->ilpIndex = 0;
+
+    const HLAC::EdgeIndex index(function.edges);
+    REQUIRE(index.find(first, second) == function.edges[1].get());
+    REQUIRE(index.find(second, first) == nullptr);
+    REQUIRE(index.findByIlpIndex(0) == function.edges[0].get());
+    REQUIRE(index.findByIlpIndex(1000) == nullptr);
+}
+
+TEST_CASE("findTakenEdges reconstructs the path of a generated function") {
+    SyntheticFunction function(64);
+
+    auto takenEdges = HLAC::Util::findTakenEdges(function.nodes.back().get(), function.predecessors, function.edges,
+                                                 {});
+
+    REQUIRE(takenEdges.size() == function.nodes.size() - 1);
+    for (size_t i = 0; i < takenEdges.size(); i++) {
+        // The path is collected from the end backwards
+        const size_t destination = function.nodes.size() - 1 - i;
+        REQUIRE(takenEdges[i]->soure == function.nodes[destination - 1].get());
+        REQUIRE(takenEdges[i]->destination == function.nodes[destination].get());
+    }
+}
+
+TEST_CASE("findTakenEdges reconstructs the path of large functions") {
+    for (int nodeCount : {1000, 10000, 100000}) {
+        SyntheticFunction function(nodeCount);
+
+        auto takenEdges = HLAC::Util::findTakenEdges(function.nodes.back().get(), function.predecessors,
+                                                     function.edges, {});
+
+        // The path runs from the last node back to the first one
+        REQUIRE(takenEdges.size() == static_cast<size_t>(nodeCount - 1));
+        REQUIRE(takenEdges.front()->destination == function.nodes.back().get());
+        REQUIRE(takenEdges.back()->soure == function.nodes.front().get());
+    }
+}
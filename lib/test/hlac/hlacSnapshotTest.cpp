@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "ConfigParser.h"
+#include "HLAC/HLACSnapshot.h"
+#include "HLAC/hlac.h"
+#include "MonolithicAnalysis.h"
+#include "OfflineAnalysis.h"
+#include "PassUtil.h"
+#include "ProfileHandler.h"
+#include "analyses/ResultRegistry.h"
+#include "analyses/loopbound/DeltaInterval.h"
+
+/**
+ * A callee with a counting loop and a main function calling it and an external function from a loop
+ */
+static const char *snapshotSource = R"(
+declare i32 @putchar(i32)
+
+define i32 @work(i32 %n) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %next, %loop ]
+  %next = add i32 %i, 1
+  %cond = icmp slt i32 %next, %n
+  br i1 %cond, label %loop, label %exit
+
+exit:
+  ret i32 %next
+}
+
+define i32 @main() {
+entry:
+  br label %header
+
+header:
+  %i = phi i32 [ 0, %entry ], [ %next, %latch ]
+  %result = call i32 @work(i32 %i)
+  %bit = and i32 %result, 1
+  %odd = icmp eq i32 %bit, 1
+  br i1 %odd, label %print, label %latch
+
+print:
+  %printed = call i32 @putchar(i32 %result)
+  br label %latch
+
+latch:
+  %next = add i32 %i, 1
+  %cond = icmp slt i32 %next, 8
+  br i1 %cond, label %header, label %exit
+
+exit:
+  ret i32 0
+}
+)";
+
+static HLAC::SnapshotNode makeVirtualNode(HLAC::VirtualNodeKind kind) {
+    HLAC::SnapshotNode node;
+    node.nodeType = static_cast<uint8_t>(HLAC::NodeType::VIRTUALNODE);
+    node.virtualNodeKind = static_cast<uint8_t>(kind);
+    return node;
+}
+
+static void requireEqualNodes(const HLAC::SnapshotNode &expected, const HLAC::SnapshotNode &actual) {
+    REQUIRE(actual.nodeType == expected.nodeType);
+    REQUIRE(actual.virtualNodeKind == expected.virtualNodeKind);
+    REQUIRE(actual.opcodeCounts == expected.opcodeCounts);
+    REQUIRE(actual.calleeName == expected.calleeName);
+    REQUIRE(actual.isSyscall == expected.isSyscall);
+    REQUIRE(actual.isLinkerFunction == expected.isLinkerFunction);
+    REQUIRE(actual.isDebugFunction == expected.isDebugFunction);
+    REQUIRE(actual.syscallId == expected.syscallId);
+    REQUIRE(actual.lowerBound == expected.lowerBound);
+    REQUIRE(actual.upperBound == expected.upperBound);
+    REQUIRE(actual.bodyScope == expected.bodyScope);
+}
+
+static void requireEqualSnapshots(const HLAC::HLACSnapshot &expected, const HLAC::HLACSnapshot &actual) {
+    REQUIRE(actual.opcodeNames == expected.opcodeNames);
+    REQUIRE(actual.functions.size() == expected.functions.size());
+
+    for (size_t functionIndex = 0; functionIndex < expected.functions.size(); functionIndex++) {
+        const auto &expectedFunction = expected.functions[functionIndex];
+        const auto &actualFunction = actual.functions[functionIndex];
+        REQUIRE(actualFunction.name == expectedFunction.name);
+        REQUIRE(actualFunction.isGotoFunction == expectedFunction.isGotoFunction);
+        REQUIRE(actualFunction.isIllFormatted == expectedFunction.isIllFormatted);
+        REQUIRE(actualFunction.isRecursive == expectedFunction.isRecursive);
+        REQUIRE(actualFunction.isIncomplete == expectedFunction.isIncomplete);
+        REQUIRE(actualFunction.scopes.size() == expectedFunction.scopes.size());
+
+        for (size_t scopeIndex = 0; scopeIndex < expectedFunction.scopes.size(); scopeIndex++) {
+            const auto &expectedScope = expectedFunction.scopes[scopeIndex];
+            const auto &actualScope = actualFunction.scopes[scopeIndex];
+            REQUIRE(actualScope.nodes.size() == expectedScope.nodes.size());
+            REQUIRE(actualScope.edges.size() == expectedScope.edges.size());
+
+            for (size_t nodeIndex = 0; nodeIndex < expectedScope.nodes.size(); nodeIndex++) {
+                requireEqualNodes(expectedScope.nodes[nodeIndex], actualScope.nodes[nodeIndex]);
+            }
+
+            for (size_t edgeIndex = 0; edgeIndex < expectedScope.edges.size(); edgeIndex++) {
+                const auto &expectedEdge = expectedScope.edges[edgeIndex];
+                const auto &actualEdge = actualScope.edges[edgeIndex];
+                REQUIRE(actualEdge.source == expectedEdge.source);
+                REQUIRE(actualEdge.destination == expectedEdge.destination);
+                REQUIRE(actualEdge.feasibility == expectedEdge.feasibility);
+                REQUIRE(actualEdge.isBackEdge == expectedEdge.isBackEdge);
+            }
+        }
+    }
+}
+
+TEST_CASE("HLACSnapshot survives a write and read round trip") {
+    HLAC::HLACSnapshot snapshot;
+    snapshot.opcodeNames = {"add", "icmp", "br"};
+
+    // A recursive function with a block, a syscall and an infeasible edge
+    HLAC::SnapshotFunction callee;
+    callee.name = "callee";
+    callee.isRecursive = true;
+
+    HLAC::SnapshotNode block;
+    block.nodeType = static_cast<uint8_t>(HLAC::NodeType::NODE);
+    block.opcodeCounts = {{0, 3}, {2, 1}};
+
+    HLAC::SnapshotNode syscall;
+    syscall.nodeType = static_cast<uint8_t>(HLAC::NodeType::CALLNODE);
+    syscall.calleeName = "write";
+    syscall.isSyscall = true;
+    syscall.isLinkerFunction = true;
+    syscall.syscallId = 1;
+
+    callee.scopes.push_back({{makeVirtualNode(HLAC::VirtualNodeKind::Entry), block, syscall,
+                              makeVirtualNode(HLAC::VirtualNodeKind::NormalExit)},
+                             {{0, 1, true, false}, {1, 2, false, false}, {1, 3, true, false}, {2, 3, true, false}}});
+
+    // A function with a loop whose body is stored as scope 1
+    HLAC::SnapshotFunction caller;
+    caller.name = "main";
+    caller.isIllFormatted = true;
+
+    HLAC::SnapshotNode loop;
+    loop.nodeType = static_cast<uint8_t>(HLAC::NodeType::LOOPNODE);
+    loop.lowerBound = 2;
+    loop.upperBound = 7;
+    loop.bodyScope = 1;
+
+    HLAC::SnapshotNode call;
+    call.nodeType = static_cast<uint8_t>(HLAC::NodeType::CALLNODE);
+    call.calleeName = "callee";
+
+    caller.scopes.push_back({{makeVirtualNode(HLAC::VirtualNodeKind::Entry), loop,
+                              makeVirtualNode(HLAC::VirtualNodeKind::NormalExit)},
+                             {{0, 1, true, false}, {1, 2, true, false}}});
+    caller.scopes.push_back({{makeVirtualNode(HLAC::VirtualNodeKind::Entry), call,
+                              makeVirtualNode(HLAC::VirtualNodeKind::NormalExit)},
+                             {{0, 1, true, false}, {1, 2, true, false}, {2, 0, true, true}}});
+
+    // A function that could not be captured keeps its flags only
+    HLAC::SnapshotFunction incomplete;
+    incomplete.name = "jumper";
+    incomplete.isGotoFunction = true;
+    incomplete.isIncomplete = true;
+
+    snapshot.functions = {callee, caller, incomplete};
+
+    const auto path = std::filesystem::temp_directory_path() / "spear_snapshot_roundtrip.hlac";
+    snapshot.write(path.string());
+
+    auto loaded = HLAC::HLACSnapshot::read(path.string());
+    REQUIRE(loaded.has_value());
+    requireEqualSnapshots(snapshot, loaded.value());
+
+    SECTION("Truncated snapshots are rejected") {
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+        REQUIRE_FALSE(HLAC::HLACSnapshot::read(path.string()).has_value());
+    }
+
+    SECTION("Files without the magic are rejected") {
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << "NOTSPEAR";
+        REQUIRE_FALSE(HLAC::HLACSnapshot::read(path.string()).has_value());
+    }
+
+    SECTION("Loop bodies must follow their parent scope") {
+        snapshot.functions[1].scopes[0].nodes[1].bodyScope = 0;
+        snapshot.write(path.string());
+        REQUIRE_FALSE(HLAC::HLACSnapshot::read(path.string()).has_value());
+    }
+
+    std::filesystem::remove(path);
+    REQUIRE_FALSE(HLAC::HLACSnapshot::read(path.string()).has_value());
+}
+
+TEST_CASE("Recosting a loaded HLACSnapshot reproduces the monolithic result") {
+    const std::filesystem::path testroot(TEST_INPUT_DIR);
+    ConfigParser configParser(testroot / "defaultconfig.json");
+    configParser.parse();
+
+    const AnalysisConfiguration original = ConfigParser::getAnalysisConfiguration();
+    AnalysisConfiguration configuration = original;
+    configuration.writeDotFiles = false;
+    ConfigParser::overrideAnalysisConfiguration(configuration);
+
+    // Price every opcode differently, so a wrong edge column or node energy changes the result
+    auto &profileHandler = ProfileHandler::get_instance();
+    const nlohmann::json profile = profileHandler.getProfile();
+    nlohmann::json originalCpu = profile.contains("cpu") ? profile["cpu"] : nlohmann::json::object();
+    nlohmann::json cpu = {{"add", 1.0e-9},   {"icmp", 2.0e-9}, {"br", 3.0e-9},           {"and", 4.0e-9},
+                          {"call", 5.0e-9},  {"ret", 6.0e-9},  {"_unknown_cost", 7.0e-9}, {"_programoffset", 1.0e-6}};
+    profileHandler.setOrCreate("cpu", cpu);
+
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic error;
+    auto module = llvm::parseAssemblyString(snapshotSource, error, context);
+    REQUIRE(module != nullptr);
+
+    llvm::PassBuilder passBuilder;
+    llvm::LoopAnalysisManager loopAnalysisManager;
+    llvm::FunctionAnalysisManager functionAnalysisManager;
+    llvm::CGSCCAnalysisManager cGSCCAnalysisManager;
+    llvm::ModuleAnalysisManager moduleAnalysisManager;
+    passBuilder.registerModuleAnalyses(moduleAnalysisManager);
+    passBuilder.registerCGSCCAnalyses(cGSCCAnalysisManager);
+    passBuilder.registerFunctionAnalyses(functionAnalysisManager);
+    passBuilder.registerLoopAnalyses(loopAnalysisManager);
+    passBuilder.crossRegisterProxies(loopAnalysisManager, functionAnalysisManager, cGSCCAnalysisManager,
+                                     moduleAnalysisManager);
+
+    ResultRegistry registry;
+    LoopBound::LoopFunctionMap loopBounds = {
+        {"work", {{"loop", LoopBound::DeltaInterval::interval(2, 5, LoopBound::DeltaInterval::ValueType::Additive)}}},
+        {"main", {{"header", LoopBound::DeltaInterval::interval(1, 8, LoopBound::DeltaInterval::ValueType::Additive)}}},
+    };
+    registry.storeLoopBoundResults(loopBounds);
+
+    auto graph = PassUtil::buildInitializedGraph(*module, functionAnalysisManager, registry);
+
+    const auto path = std::filesystem::temp_directory_path() / "spear_snapshot_recost.hlac";
+    HLAC::HLACSnapshot::capture(*graph).write(path.string());
+    auto loaded = HLAC::HLACSnapshot::read(path.string());
+    std::filesystem::remove(path);
+    REQUIRE(loaded.has_value());
+
+    const nlohmann::json live = MonolithicAnalysis::run(graph, false);
+    const nlohmann::json offline = OfflineAnalysis::run(loaded.value(), false);
+
+    for (const std::string functionName : {"work", "main"}) {
+        INFO("Function: " << functionName);
+        REQUIRE(live["functions"].contains(functionName));
+        REQUIRE(offline["functions"].contains(functionName));
+
+        const auto &liveFunction = live["functions"][functionName];
+        const auto &offlineFunction = offline["functions"][functionName];
+
+        // The offline model has the same columns and rows, and its optimum the same energy
+        REQUIRE(offlineFunction["ILPS"][0]["status"] == "solved");
+        REQUIRE(offlineFunction["ILPS"][0]["numVariables"] == liveFunction["ILPS"][0]["numVariables"]);
+        REQUIRE(offlineFunction["ILPS"][0]["numConstrains"] == liveFunction["ILPS"][0]["numConstrains"]);
+
+        const double liveEnergy = liveFunction["energy"].get<double>();
+        const double offlineEnergy = offlineFunction["energy"].get<double>();
+        REQUIRE(liveEnergy > 0.0);
+        REQUIRE(std::abs(offlineEnergy - liveEnergy) <= 1e-9 * liveEnergy);
+    }
+
+    profileHandler.setOrCreate("cpu", originalCpu);
+    ConfigParser::overrideAnalysisConfiguration(original);
+}
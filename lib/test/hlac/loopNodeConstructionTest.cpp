@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <filesystem>
+#include <memory>
+
+#include "ConfigParser.h"
+#include "HLAC/hlac.h"
+#include "analyses/ResultRegistry.h"
+
+static void countContainedNodes(const HLAC::GenericNode *genericNode, size_t &blocks, size_t &loops) {
+    if (dynamic_cast<const HLAC::Node *>(genericNode) != nullptr) {
+        blocks++;
+    }
+
+    if (auto *loopNode = dynamic_cast<const HLAC::LoopNode *>(genericNode)) {
+        loops++;
+        for (const auto &nodeUniquePointer : loopNode->Nodes) {
+            countContainedNodes(nodeUniquePointer.get(), blocks, loops);
+        }
+    }
+}
+
+TEST_CASE("HLAC construction of a loop-dense function") {
+    const std::filesystem::path testroot(TEST_INPUT_DIR);
+    ConfigParser configParser(testroot / "defaultconfig.json");
+    configParser.parse();
+
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic error;
+    auto module = llvm::parseIRFile((testroot / "programs/hlac/compiled/loop_dense.ll").string(), error, context);
+    REQUIRE(module != nullptr);
+
+    llvm::PassBuilder passBuilder;
+    llvm::LoopAnalysisManager loopAnalysisManager;
+    llvm::FunctionAnalysisManager functionAnalysisManager;
+    llvm::CGSCCAnalysisManager cGSCCAnalysisManager;
+    llvm::ModuleAnalysisManager moduleAnalysisManager;
+    passBuilder.registerModuleAnalyses(moduleAnalysisManager);
+    passBuilder.registerCGSCCAnalyses(cGSCCAnalysisManager);
+    passBuilder.registerFunctionAnalyses(functionAnalysisManager);
+    passBuilder.registerLoopAnalyses(loopAnalysisManager);
+    passBuilder.crossRegisterProxies(loopAnalysisManager, functionAnalysisManager, cGSCCAnalysisManager,
+                                     moduleAnalysisManager);
+
+    auto getTargetLibraryInfo = [&functionAnalysisManager](llvm::Function &function) -> llvm::TargetLibraryInfo & {
+        return functionAnalysisManager.getResult<llvm::TargetLibraryAnalysis>(function);
+    };
+    llvm::LazyCallGraph lazyCallGraph(*module, getTargetLibraryInfo);
+    lazyCallGraph.buildRefSCCs();
+
+    llvm::Function *mainFunction = module->getFunction("main");
+    REQUIRE(mainFunction != nullptr);
+    auto &loopInfo = functionAnalysisManager.getResult<llvm::LoopAnalysis>(*mainFunction);
+
+    ResultRegistry registry;
+    HLAC::hlac graph(registry, lazyCallGraph);
+
+    graph.makeFunction(mainFunction, &functionAnalysisManager);
+
+    // Every block ends up in exactly one container and every loop is represented once
+    size_t blocks = 0;
+    size_t loops = 0;
+    for (const auto &nodeUniquePointer : graph.functions.front()->Nodes) {
+        countContainedNodes(nodeUniquePointer.get(), blocks, loops);
+    }
+
+    REQUIRE(blocks == mainFunction->size());
+    REQUIRE(loops == loopInfo.getLoopsInPreorder().size());
+    REQUIRE(loops == 512);
+}
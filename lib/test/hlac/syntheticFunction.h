@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "HLAC/hlac.h"
+
+/**
+ * Node without an underlying basic block, enough to build edges and predecessor chains
+ */
+class SyntheticNode : public HLAC::GenericNode {
+ public:
+    explicit SyntheticNode(int id) { name = "n" + std::to_string(id); }
+
+    std::string getDotName() override { return name; }
+};
+
+/**
+ * Function graph of a chain of nodes, every node additionally skips its successor. The predecessor list follows the
+ * chain, like the longest path search would for equal node energies.
+ */
+struct SyntheticFunction {
+    std::vector<std::unique_ptr<HLAC::GenericNode>> nodes;
+    std::vector<std::unique_ptr<HLAC::Edge>> edges;
+    std::unordered_map<HLAC::GenericNode *, HLAC::GenericNode *> predecessors;
+
+    explicit SyntheticFunction(int nodeCount) {
+        for (int i = 0; i < nodeCount; i++) {
+            nodes.push_back(std::make_unique<SyntheticNode>(i));
+        }
+
+        for (int i = 0; i < nodeCount; i++) {
+            for (int step = 2; step >= 1; step--) {
+                if (i + step < nodeCount) {
+                    edges.push_back(std::make_unique<HLAC::Edge>(nodes[i].get(), nodes[i + step].get()));
+                    edges.back()->ilpIndex = static_cast<int>(edges.size()) - 1;
+                }
+            }
+        }
+
+        predecessors[nodes.front().get()] = nullptr;
+        for (int i = 1; i < nodeCount; i++) {
+            predecessors[nodes[i].get()] = nodes[i - 1].get();
+        }
+    }
+};
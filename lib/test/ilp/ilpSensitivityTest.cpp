@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+#include "ILP/ILPSolver.h"
+#include "ilpTestModule.h"
+
+namespace {
+
+bool approximatelyEqual(double expected, double actual) {
+    return std::abs(expected - actual) <= 1e-6 * std::max(std::abs(expected), std::abs(actual));
+}
+
+/**
+ * Build and solve the monolithic model of work with the given bounds of its loop
+ * @return Solved model and its optimal integer result
+ */
+std::pair<ILPModel, ILPResult> solveWork(ILPTestModule &testModule, int64_t lowerBound, int64_t upperBound) {
+    testModule.getLoopNode("work")->bounds =
+        LoopBound::DeltaInterval::interval(lowerBound, upperBound, LoopBound::DeltaInterval::ValueType::Additive);
+
+    auto model = testModule.graph->buildMonolithicILP(testModule.graph->getFunctionByName("work"));
+    REQUIRE(model.has_value());
+
+    auto result = testModule.graph->solveMonolithicIlp(model.value(), "work");
+    REQUIRE(result.has_value());
+
+    return {model.value(), result.value()};
+}
+
+}  // namespace
+
+TEST_CASE("calculateLoopBoundSensitivity prices one iteration of a binding loop bound") {
+    ILPTestModule testModule(LoopBound::LoopFunctionMap{});
+    HLAC::LoopNode *loopNode = testModule.getLoopNode("work");
+    REQUIRE(loopNode != nullptr);
+
+    auto [model, result] = solveWork(testModule, 2, 10);
+    const auto sensitivities = ILPSolver::calculateLoopBoundSensitivity(model, result);
+    REQUIRE(sensitivities.size() == 2);
+
+    const auto lower = std::find_if(sensitivities.begin(), sensitivities.end(),
+                                    [](const auto &sensitivity) { return !sensitivity.isUpperBound; });
+    const auto upper = std::find_if(sensitivities.begin(), sensitivities.end(),
+                                    [](const auto &sensitivity) { return sensitivity.isUpperBound; });
+    REQUIRE(lower != sensitivities.end());
+    REQUIRE(upper != sensitivities.end());
+    REQUIRE(lower->loopNode == loopNode);
+    REQUIRE(upper->loopNode == loopNode);
+
+    // The worst case runs the loop as often as possible, only the upper bound restricts it
+    REQUIRE_FALSE(lower->binding);
+    REQUIRE(std::abs(lower->marginalEnergy) < 1e-15);
+    REQUIRE(upper->binding);
+    REQUIRE(upper->exact);
+    REQUIRE(upper->marginalEnergy > 0.0);
+
+    // The dual price is the energy of one more iteration, as long as the bound stays in the valid range
+    REQUIRE(upper->validTo > 10.0);
+    const double nextIteration = solveWork(testModule, 2, 11).second.optimalValue;
+    REQUIRE(approximatelyEqual(result.optimalValue + upper->marginalEnergy, nextIteration));
+
+    // Below the lower bound of the loop the model becomes infeasible, the basis has to change before
+    REQUIRE(upper->validFrom < 10.0);
+    REQUIRE(upper->validFrom >= 2.0 - 1e-6);
+
+    const int64_t smallestValidBound = static_cast<int64_t>(std::ceil(upper->validFrom - 1e-6));
+    const double smallestValidEnergy = solveWork(testModule, 2, smallestValidBound).second.optimalValue;
+    const double removedIterations = static_cast<double>(10 - smallestValidBound);
+    REQUIRE(approximatelyEqual(result.optimalValue - removedIterations * upper->marginalEnergy, smallestValidEnergy));
+}
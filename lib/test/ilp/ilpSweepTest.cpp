@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "ConfigParser.h"
+#include "ILP/ILPSweep.h"
+#include "MonolithicAnalysis.h"
+#include "ilpTestModule.h"
+
+namespace {
+
+bool approximatelyEqual(double expected, double actual) {
+    return std::abs(expected - actual) <= 1e-6 * std::max(std::abs(expected), std::abs(actual));
+}
+
+/**
+ * The loop of work is bounded by a fallback value, the loop of main is analyzed and runs eight times
+ */
+LoopBound::LoopFunctionMap sweptLoopBounds() {
+    return {
+        {"work", {{"loop", LoopBound::DeltaInterval::interval(10, 10, LoopBound::DeltaInterval::ValueType::FALLBACK)}}},
+        {"main", {{"header", LoopBound::DeltaInterval::interval(8, 8, LoopBound::DeltaInterval::ValueType::Additive)}}},
+    };
+}
+
+/**
+ * Run the monolithic analysis with the given sweep
+ * @return Nominal energy and the sweep energies per function
+ */
+nlohmann::json runSweep(ILPTestModule &testModule, SweepMode mode, const std::vector<double> &grid) {
+    const AnalysisConfiguration original = ConfigParser::getAnalysisConfiguration();
+    AnalysisConfiguration configuration = original;
+    configuration.writeDotFiles = false;
+    configuration.sensitivityReportEnabled = false;
+    configuration.sweepconfig = {true, mode, grid};
+    ConfigParser::overrideAnalysisConfiguration(configuration);
+
+    const nlohmann::json result = MonolithicAnalysis::run(testModule.graph, false);
+    ConfigParser::overrideAnalysisConfiguration(original);
+
+    return result["functions"];
+}
+
+/**
+ * Difference of the swept energy at the given grid index to the nominal energy of the function
+ */
+double sweepDelta(const nlohmann::json &functions, const std::string &functionName, size_t gridIndex) {
+    const auto &function = functions[functionName];
+    return function["sweep"][gridIndex]["energy"].get<double>() - function["energy"].get<double>();
+}
+
+}  // namespace
+
+TEST_CASE("backedgeFactorForGridValue applies the grid per sweep mode") {
+    ILPTestModule testModule(LoopBound::LoopFunctionMap{});
+    HLAC::LoopNode *loopNode = testModule.getLoopNode("work");
+    REQUIRE(loopNode != nullptr);
+
+    const ILPLoopBoundRow lowerRow = {loopNode, 0, 0, false};
+    const ILPLoopBoundRow upperRow = {loopNode, 1, 0, true};
+
+    SECTION("Fallback bounds are replaced in fallback mode and scaled in scale mode") {
+        loopNode->bounds = LoopBound::DeltaInterval::interval(10, 10, LoopBound::DeltaInterval::ValueType::FALLBACK);
+
+        REQUIRE(ILPSweep::backedgeFactorForGridValue(lowerRow, 20.0, SweepMode::FALLBACK) == 19.0);
+        REQUIRE(ILPSweep::backedgeFactorForGridValue(upperRow, 20.0, SweepMode::FALLBACK) == 19.0);
+        REQUIRE(ILPSweep::backedgeFactorForGridValue(upperRow, 3.0, SweepMode::SCALE) == 29.0);
+
+        // Bounds below one iteration do not execute the backedge at all
+        REQUIRE(ILPSweep::backedgeFactorForGridValue(upperRow, 0.5, SweepMode::FALLBACK) == 0.0);
+    }
+
+    SECTION("Analyzed bounds are only scaled") {
+        loopNode->bounds = LoopBound::DeltaInterval::interval(2, 6, LoopBound::DeltaInterval::ValueType::Additive);
+
+        REQUIRE_FALSE(ILPSweep::backedgeFactorForGridValue(upperRow, 20.0, SweepMode::FALLBACK).has_value());
+        REQUIRE(ILPSweep::backedgeFactorForGridValue(lowerRow, 2.0, SweepMode::SCALE) == 3.0);
+        REQUIRE(ILPSweep::backedgeFactorForGridValue(upperRow, 2.0, SweepMode::SCALE) == 11.0);
+        REQUIRE(ILPSweep::backedgeFactorForGridValue(lowerRow, 0.25, SweepMode::SCALE) == 0.0);
+    }
+
+    SECTION("Rows without loop node or mode are not affected") {
+        const ILPLoopBoundRow snapshotRow = {nullptr, 0, 0, true};
+        REQUIRE_FALSE(ILPSweep::backedgeFactorForGridValue(snapshotRow, 2.0, SweepMode::SCALE).has_value());
+        REQUIRE_FALSE(ILPSweep::backedgeFactorForGridValue(upperRow, 2.0, SweepMode::UNDEFINED).has_value());
+    }
+}
+
+TEST_CASE("isAffectedBySweep checks loop bound rows and swept callees") {
+    ILPModel model;
+    model.callColumns.push_back({0, "work"});
+
+    REQUIRE_FALSE(ILPSweep::isAffectedBySweep(model, {}));
+    REQUIRE(ILPSweep::isAffectedBySweep(model, {{"work", {1.0, 2.0}}}));
+    REQUIRE_FALSE(ILPSweep::isAffectedBySweep(model, {{"other", {1.0, 2.0}}}));
+
+    model.loopBoundRows.push_back({nullptr, 0, 0, true});
+    REQUIRE(ILPSweep::isAffectedBySweep(model, {}));
+}
+
+TEST_CASE("Fallback sweeps change fallback loops and propagate into the callers") {
+    ILPTestModule testModule(sweptLoopBounds());
+
+    const std::vector<double> grid = {5.0, 10.0, 20.0};
+    const nlohmann::json functions = runSweep(testModule, SweepMode::FALLBACK, grid);
+
+    for (const std::string functionName : {"work", "main"}) {
+        INFO("Function: " << functionName);
+        REQUIRE(functions[functionName]["sweep"].size() == grid.size());
+
+        for (size_t gridIndex = 0; gridIndex < grid.size(); gridIndex++) {
+            REQUIRE(functions[functionName]["sweep"][gridIndex]["grid"] == grid[gridIndex]);
+            REQUIRE_FALSE(functions[functionName]["sweep"][gridIndex]["energy"].is_null());
+        }
+
+        // The grid value matching the fallback bound reproduces the nominal result
+        REQUIRE(approximatelyEqual(functions[functionName]["energy"].get<double>(),
+                                   functions[functionName]["sweep"][1]["energy"].get<double>()));
+    }
+
+    // The energy of work is linear in the bound of its loop
+    REQUIRE(sweepDelta(functions, "work", 0) < 0.0);
+    REQUIRE(sweepDelta(functions, "work", 2) > 0.0);
+    REQUIRE(approximatelyEqual(-2.0 * sweepDelta(functions, "work", 0), sweepDelta(functions, "work", 2)));
+
+    // main has no fallback loop itself, it changes by the energy of the eight calls to work
+    for (size_t gridIndex : {0, 2}) {
+        REQUIRE(approximatelyEqual(8.0 * sweepDelta(functions, "work", gridIndex),
+                                   sweepDelta(functions, "main", gridIndex)));
+    }
+}
+
+TEST_CASE("Scale sweeps scale every loop") {
+    ILPTestModule testModule(sweptLoopBounds());
+
+    const nlohmann::json scaled = runSweep(testModule, SweepMode::SCALE, {1.0, 2.0});
+    const nlohmann::json replaced = runSweep(testModule, SweepMode::FALLBACK, {20.0});
+
+    // A factor of one keeps every bound
+    REQUIRE(approximatelyEqual(scaled["work"]["energy"].get<double>(),
+                               scaled["work"]["sweep"][0]["energy"].get<double>()));
+    REQUIRE(approximatelyEqual(scaled["main"]["energy"].get<double>(),
+                               scaled["main"]["sweep"][0]["energy"].get<double>()));
+
+    // Doubling the fallback bound of work matches replacing it by twice the value
+    REQUIRE(approximatelyEqual(replaced["work"]["sweep"][0]["energy"].get<double>(),
+                               scaled["work"]["sweep"][1]["energy"].get<double>()));
+
+    // main additionally doubles its own loop, so it runs sixteen calls of the scaled work
+    const double mainWithoutLoop =
+        scaled["main"]["energy"].get<double>() - 8.0 * scaled["work"]["energy"].get<double>();
+    const double mainScaledLoop = scaled["main"]["sweep"][1]["energy"].get<double>() -
+                                  16.0 * scaled["work"]["sweep"][1]["energy"].get<double>();
+    REQUIRE(mainScaledLoop > mainWithoutLoop);
+    REQUIRE(sweepDelta(scaled, "main", 1) > 16.0 * sweepDelta(scaled, "work", 1));
+}
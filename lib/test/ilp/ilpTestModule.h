@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "ConfigParser.h"
+#include "HLAC/hlac.h"
+#include "PassUtil.h"
+#include "ProfileHandler.h"
+#include "analyses/ResultRegistry.h"
+#include "nlohmann/json.hpp"
+
+/**
+ * Module with a counting loop in work and a loop in main calling work once per iteration. The loops are named after
+ * their headers, loop in work and header in main.
+ */
+inline constexpr const char *ilpTestSource = R"(
+define i32 @work(i32 %n) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %next, %loop ]
+  %next = add i32 %i, 1
+  %cond = icmp slt i32 %next, %n
+  br i1 %cond, label %loop, label %exit
+
+exit:
+  ret i32 %next
+}
+
+define i32 @main() {
+entry:
+  br label %header
+
+header:
+  %i = phi i32 [ 0, %entry ], [ %next, %header ]
+  %result = call i32 @work(i32 %i)
+  %next = add i32 %i, 1
+  %cond = icmp slt i32 %next, 8
+  br i1 %cond, label %header, label %exit
+
+exit:
+  ret i32 0
+}
+)";
+
+/**
+ * Initialized HLAC of ilpTestSource using the given loop bounds. The default configuration is parsed and every opcode
+ * is priced with an energy of its own, the previous cpu profile is restored on destruction.
+ */
+struct ILPTestModule {
+    llvm::LLVMContext context;
+    std::unique_ptr<llvm::Module> module;
+    llvm::LoopAnalysisManager loopAnalysisManager;
+    llvm::FunctionAnalysisManager functionAnalysisManager;
+    llvm::CGSCCAnalysisManager cGSCCAnalysisManager;
+    llvm::ModuleAnalysisManager moduleAnalysisManager;
+    ResultRegistry registry;
+    nlohmann::json originalCpu;
+    std::shared_ptr<HLAC::hlac> graph;
+
+    explicit ILPTestModule(LoopBound::LoopFunctionMap loopBounds) {
+        ConfigParser configParser(std::filesystem::path(TEST_INPUT_DIR) / "defaultconfig.json");
+        configParser.parse();
+
+        auto &profileHandler = ProfileHandler::get_instance();
+        const nlohmann::json profile = profileHandler.getProfile();
+        originalCpu = profile.contains("cpu") ? profile["cpu"] : nlohmann::json::object();
+        nlohmann::json cpu = {{"add", 1.0e-9}, {"icmp", 2.0e-9}, {"br", 3.0e-9},           {"phi", 4.0e-9},
+                              {"call", 5.0e-9}, {"ret", 6.0e-9}, {"_unknown_cost", 7.0e-9}, {"_programoffset", 1.0e-6}};
+        profileHandler.setOrCreate("cpu", cpu);
+
+        llvm::SMDiagnostic error;
+        module = llvm::parseAssemblyString(ilpTestSource, error, context);
+        if (module == nullptr) {
+            throw std::runtime_error("Could not parse the ILP test module: " + error.getMessage().str());
+        }
+
+        llvm::PassBuilder passBuilder;
+        passBuilder.registerModuleAnalyses(moduleAnalysisManager);
+        passBuilder.registerCGSCCAnalyses(cGSCCAnalysisManager);
+        passBuilder.registerFunctionAnalyses(functionAnalysisManager);
+        passBuilder.registerLoopAnalyses(loopAnalysisManager);
+        passBuilder.crossRegisterProxies(loopAnalysisManager, functionAnalysisManager, cGSCCAnalysisManager,
+                                         moduleAnalysisManager);
+
+        registry.storeLoopBoundResults(loopBounds);
+        graph = PassUtil::buildInitializedGraph(*module, functionAnalysisManager, registry);
+    }
+
+    ~ILPTestModule() {
+        ProfileHandler::get_instance().setOrCreate("cpu", originalCpu);
+    }
+
+    /**
+     * Get the outermost loop node of the given function
+     * @param functionName Name of the function containing the loop
+     * @return Loop node, nullptr if the function has no loop
+     */
+    HLAC::LoopNode *getLoopNode(const std::string &functionName) const {
+        HLAC::FunctionNode *functionNode = graph->getFunctionByName(functionName);
+        if (functionNode == nullptr) {
+            return nullptr;
+        }
+
+        for (const auto &node : functionNode->Nodes) {
+            if (auto *loopNode = dynamic_cast<HLAC::LoopNode *>(node.get())) {
+                return loopNode;
+            }
+        }
+
+        return nullptr;
+    }
+};
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+#include <string>
+
+/**
+ * Builds a function of consecutive if/else diamonds, every diamond adds three blocks and four edges
+ */
+inline llvm::Function *buildDiamondChain(llvm::Module &module, int diamonds) {
+    auto &context = module.getContext();
+    auto *functionType = llvm::FunctionType::get(llvm::Type::getVoidTy(context), {llvm::Type::getInt1Ty(context)},
+                                                 false);
+    auto *function = llvm::Function::Create(functionType, llvm::Function::ExternalLinkage,
+                                            "diamonds" + std::to_string(diamonds), module);
+    llvm::Value *condition = function->getArg(0);
+    llvm::IRBuilder<> builder(context);
+
+    auto *head = llvm::BasicBlock::Create(context, "head0", function);
+    for (int i = 0; i < diamonds; i++) {
+        auto *thenBlock = llvm::BasicBlock::Create(context, "then" + std::to_string(i), function);
+        auto *elseBlock = llvm::BasicBlock::Create(context, "else" + std::to_string(i), function);
+        auto *next = llvm::BasicBlock::Create(context, "head" + std::to_string(i + 1), function);
+
+        builder.SetInsertPoint(head);
+        builder.CreateCondBr(condition, thenBlock, elseBlock);
+        builder.SetInsertPoint(thenBlock);
+        builder.CreateBr(next);
+        builder.SetInsertPoint(elseBlock);
+        builder.CreateBr(next);
+
+        head = next;
+    }
+
+    builder.SetInsertPoint(head);
+    builder.CreateRetVoid();
+
+    return function;
+}
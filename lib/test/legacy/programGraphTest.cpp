@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/Analysis/ScalarEvolution.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <filesystem>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "ConfigParser.h"
+#include "ProgramGraph.h"
+#include "diamondChain.h"
+
+TEST_CASE("ProgramGraph construction of large diamond chains") {
+    llvm::LLVMContext context;
+    llvm::Module module("diamonds", context);
+
+    for (int diamonds : {1000, 4000, 16000}) {
+        llvm::Function *function = buildDiamondChain(module, diamonds);
+        std::vector<llvm::BasicBlock *> blocks;
+        for (auto &basicBlock : *function) {
+            blocks.push_back(&basicBlock);
+        }
+
+        ProgramGraph graph;
+        ProgramGraph::construct(&graph, blocks, AnalysisStrategy::WORSTCASE);
+
+        size_t adjacentEdges = 0;
+        for (auto *node : graph.nodes) {
+            adjacentEdges += graph.findEdgesStartingAtNode(node).size();
+        }
+
+        REQUIRE(graph.nodes.size() == blocks.size());
+        REQUIRE(graph.edges.size() == static_cast<size_t>(4 * diamonds));
+        REQUIRE(adjacentEdges == graph.edges.size());
+
+        for (auto *basicBlock : blocks) {
+            Node *node = graph.findBlock(basicBlock);
+            REQUIRE(node != nullptr);
+            REQUIRE(node->block == basicBlock);
+            REQUIRE(graph.findEdgesStartingAtNode(node).size() == basicBlock->getTerminator()->getNumSuccessors());
+        }
+
+        for (auto *node : graph.nodes) {
+            delete node;
+        }
+        for (auto *edge : graph.edges) {
+            delete edge;
+        }
+    }
+}
+
+TEST_CASE("ProgramGraph indices follow the loop replacement") {
+    const std::filesystem::path testroot(TEST_INPUT_DIR);
+    ConfigParser configParser(testroot / "defaultconfig.json");
+    configParser.parse();
+
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic error;
+    auto module = llvm::parseIRFile((testroot / "programs/hlac/compiled/loop_dense.ll").string(), error, context);
+    REQUIRE(module != nullptr);
+
+    llvm::PassBuilder passBuilder;
+    llvm::LoopAnalysisManager loopAnalysisManager;
+    llvm::FunctionAnalysisManager functionAnalysisManager;
+    llvm::CGSCCAnalysisManager cGSCCAnalysisManager;
+    llvm::ModuleAnalysisManager moduleAnalysisManager;
+    passBuilder.registerModuleAnalyses(moduleAnalysisManager);
+    passBuilder.registerCGSCCAnalyses(cGSCCAnalysisManager);
+    passBuilder.registerFunctionAnalyses(functionAnalysisManager);
+    passBuilder.registerLoopAnalyses(loopAnalysisManager);
+    passBuilder.crossRegisterProxies(loopAnalysisManager, functionAnalysisManager, cGSCCAnalysisManager,
+                                     moduleAnalysisManager);
+
+    llvm::Function *mainFunction = module->getFunction("main");
+    REQUIRE(mainFunction != nullptr);
+    auto &loopInfo = functionAnalysisManager.getResult<llvm::LoopAnalysis>(*mainFunction);
+    auto &scalarEvolution = functionAnalysisManager.getResult<llvm::ScalarEvolutionAnalysis>(*mainFunction);
+
+    std::vector<llvm::BasicBlock *> blocks;
+    for (auto &basicBlock : *mainFunction) {
+        blocks.push_back(&basicBlock);
+    }
+
+    // Same steps as the legacy analysis, without the energy calculation
+    auto *graph = new ProgramGraph();
+    ProgramGraph::construct(graph, blocks, AnalysisStrategy::WORSTCASE);
+    for (auto *topLoop : loopInfo.getTopLevelLoops()) {
+        auto *loopTree = new LoopTree(topLoop, topLoop->getSubLoops(), nullptr, &scalarEvolution);
+        auto *loopNode = LoopNode::construct(loopTree, graph, AnalysisStrategy::WORSTCASE);
+        graph->replaceNodesWithLoopNode(topLoop->getBlocksVector(), loopNode);
+    }
+
+    size_t blocksOutsideLoops = 0;
+    for (auto *basicBlock : blocks) {
+        if (loopInfo.getLoopFor(basicBlock) == nullptr) {
+            blocksOutsideLoops++;
+            REQUIRE(graph->findBlock(basicBlock) != nullptr);
+        } else {
+            REQUIRE(graph->findBlock(basicBlock) == nullptr);
+        }
+    }
+
+    REQUIRE(graph->nodes.size() == blocksOutsideLoops + loopInfo.getTopLevelLoops().size());
+    REQUIRE(graph->getLoopNodes().size() == 256);
+
+    // The outgoing edges of every node match a scan over all edges
+    std::unordered_set<Node *> presentNodes(graph->nodes.begin(), graph->nodes.end());
+    for (auto *node : graph->nodes) {
+        std::vector<Edge *> expected;
+        for (auto *edge : graph->edges) {
+            if (edge->start == node) {
+                expected.push_back(edge);
+            }
+        }
+
+        REQUIRE(graph->findEdgesStartingAtNode(node) == expected);
+    }
+
+    for (auto *edge : graph->edges) {
+        REQUIRE(presentNodes.count(edge->start) == 1);
+        REQUIRE(presentNodes.count(edge->end) == 1);
+    }
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+#include "loopBoundTestModule.h"
+
+namespace {
+
+/**
+ * Counters modified through calls and recursion. main counts the global g in a loop calling bump, which counts g as
+ * well, and calls bump once more afterwards. ping and pong call each other inside their loops counting the global h.
+ * rec counts its local i in two loops and calls itself inside the first one. orphan counts g but is never called
+ */
+constexpr const char *recursiveCounterSource = R"(
+@g = global i32 0
+@h = global i32 0
+
+define void @bump() {
+entry:
+  br label %cond
+
+cond:
+  %value = load i32, ptr @g
+  %cmp = icmp slt i32 %value, 50
+  br i1 %cmp, label %body, label %exit
+
+body:
+  %old = load i32, ptr @g
+  %inc = add nsw i32 %old, 2
+  store i32 %inc, ptr @g
+  br label %cond
+
+exit:
+  ret void
+}
+
+define void @ping(i32 %n) {
+entry:
+  %more = icmp sgt i32 %n, 0
+  br i1 %more, label %cond, label %exit
+
+cond:
+  %value = load i32, ptr @h
+  %cmp = icmp slt i32 %value, 100
+  br i1 %cmp, label %body, label %exit
+
+body:
+  %old = load i32, ptr @h
+  %ping.inc = add nsw i32 %old, 3
+  store i32 %ping.inc, ptr @h
+  %next = sub nsw i32 %n, 1
+  call void @pong(i32 %next)
+  br label %cond
+
+exit:
+  ret void
+}
+
+define void @pong(i32 %n) {
+entry:
+  %more = icmp sgt i32 %n, 0
+  br i1 %more, label %cond, label %exit
+
+cond:
+  %value = load i32, ptr @h
+  %cmp = icmp slt i32 %value, 100
+  br i1 %cmp, label %body, label %exit
+
+body:
+  %next = sub nsw i32 %n, 1
+  call void @ping(i32 %next)
+  %old = load i32, ptr @h
+  %pong.inc = add nsw i32 %old, 7
+  store i32 %pong.inc, ptr @h
+  br label %cond
+
+exit:
+  ret void
+}
+
+define void @rec(i32 %depth) {
+entry:
+  %i = alloca i32
+  store i32 0, ptr %i
+  %deeper = icmp sgt i32 %depth, 0
+  br i1 %deeper, label %a.cond, label %exit
+
+a.cond:
+  %a = load i32, ptr %i
+  %a.cmp = icmp slt i32 %a, 10
+  br i1 %a.cmp, label %a.body, label %b.cond
+
+a.body:
+  %next.depth = sub nsw i32 %depth, 1
+  call void @rec(i32 %next.depth)
+  %a.old = load i32, ptr %i
+  %a.inc = add nsw i32 %a.old, 1
+  store i32 %a.inc, ptr %i
+  br label %a.cond
+
+b.cond:
+  %b = load i32, ptr %i
+  %b.cmp = icmp slt i32 %b, 20
+  br i1 %b.cmp, label %b.body, label %exit
+
+b.body:
+  %b.old = load i32, ptr %i
+  %b.inc = add nsw i32 %b.old, 5
+  store i32 %b.inc, ptr %i
+  br label %b.cond
+
+exit:
+  ret void
+}
+
+define internal void @orphan() {
+entry:
+  br label %cond
+
+cond:
+  %value = load i32, ptr @g
+  %cmp = icmp slt i32 %value, 10
+  br i1 %cmp, label %body, label %exit
+
+body:
+  %old = load i32, ptr @g
+  %orphan.inc = add nsw i32 %old, 4
+  store i32 %orphan.inc, ptr @g
+  br label %cond
+
+exit:
+  ret void
+}
+
+define i32 @main() {
+entry:
+  store i32 0, ptr @g
+  br label %g.cond
+
+g.cond:
+  %g.value = load i32, ptr @g
+  %g.cmp = icmp slt i32 %g.value, 100
+  br i1 %g.cmp, label %g.body, label %exit
+
+g.body:
+  call void @bump()
+  %g.old = load i32, ptr @g
+  %g.inc = add nsw i32 %g.old, 1
+  store i32 %g.inc, ptr @g
+  br label %g.cond
+
+exit:
+  call void @ping(i32 4)
+  call void @rec(i32 3)
+  call void @bump()
+  ret i32 0
+}
+)";
+
+}  // namespace
+
+TEST_CASE("BottomUpLoopBoundSolver matches the whole-program solver on calls and recursion") {
+    LoopBoundTestModule testModule(recursiveCounterSource);
+    auto serialResults = testModule.solveSerially();
+
+    LoopBound::BottomUpLoopBoundSolver solver(*testModule.problem, testModule.getICFG(), *testModule.module);
+    solver.solve();
+
+    // bump, rec, main and orphan are components of their own, ping and pong form a recursive component
+    REQUIRE(solver.getNumberOfComponents() == 5);
+    REQUIRE(solver.getStatistics().summaries > 0);
+
+    const llvm::Value *globalCounter = testModule.module->getGlobalVariable("g");
+    const llvm::Value *recursiveCounter = testModule.module->getGlobalVariable("h");
+    const llvm::Value *localCounter = findAlloca(*testModule.module->getFunction("rec"), "i");
+    const llvm::StoreInst *globalIncrement = findStoreOf(*testModule.module->getFunction("main"), "g.inc");
+    const llvm::StoreInst *pingIncrement = findStoreOf(*testModule.module->getFunction("ping"), "ping.inc");
+    const llvm::StoreInst *pongIncrement = findStoreOf(*testModule.module->getFunction("pong"), "pong.inc");
+    const llvm::StoreInst *localIncrement = findStoreOf(*testModule.module->getFunction("rec"), "a.inc");
+    const llvm::StoreInst *orphanIncrement = findStoreOf(*testModule.module->getFunction("orphan"), "orphan.inc");
+    REQUIRE(globalCounter != nullptr);
+    REQUIRE(recursiveCounter != nullptr);
+    REQUIRE(localCounter != nullptr);
+    REQUIRE(globalIncrement != nullptr);
+    REQUIRE(pingIncrement != nullptr);
+    REQUIRE(pongIncrement != nullptr);
+    REQUIRE(localIncrement != nullptr);
+    REQUIRE(orphanIncrement != nullptr);
+
+    // The summary of bump adds two to the counter of main, the summary of rec adds the five of its second loop to the
+    // counter of the calling instance
+    const auto globalBounds = LoopBound::DeltaInterval::interval(1, 2, LoopBound::DeltaInterval::ValueType::Additive);
+    const auto localBounds = LoopBound::DeltaInterval::interval(1, 5, LoopBound::DeltaInterval::ValueType::Additive);
+    REQUIRE(solver.resultAt(globalIncrement, globalCounter) == globalBounds);
+    REQUIRE(solver.resultAt(localIncrement, localCounter) == localBounds);
+
+    // Every value inside the recursive component and in the function without callers matches the whole-program solver
+    for (const auto &[increment, counter] : {std::make_pair(pingIncrement, recursiveCounter),
+                                             std::make_pair(pongIncrement, recursiveCounter),
+                                             std::make_pair(orphanIncrement, globalCounter)}) {
+        INFO("Increment: " << increment->getValueOperand()->getName().str());
+
+        const auto bottomUpValue = solver.resultAt(increment, counter);
+        REQUIRE(bottomUpValue.has_value());
+        REQUIRE_FALSE(bottomUpValue->isEmpty());
+        REQUIRE(bottomUpValue == serialResults.resultAt(increment, counter));
+    }
+
+    REQUIRE(testModule.countMismatches(serialResults, solver) == 0);
+}
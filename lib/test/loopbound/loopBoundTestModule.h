@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <phasar.h>
+#include <phasar/DataFlow/IfdsIde/Solver/IDESolver.h>
+
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ConfigParser.h"
+#include "analyses/loopbound/BottomUpLoopBoundSolver.h"
+#include "analyses/loopbound/LoopBound.h"
+#include "analyses/loopbound/ParallelLoopBoundSolver.h"
+#include "analyses/loopbound/loopBoundWrapper.h"
+#include "analyses/loopbound/util.h"
+
+/**
+ * Loop bound problem of a module given as IR. The loops are collected per function like the LoopBoundWrapper does and
+ * the ICFG is built from main.
+ */
+struct LoopBoundTestModule {
+    llvm::LLVMContext context;
+    std::unique_ptr<llvm::Module> module;
+    llvm::LoopAnalysisManager loopAnalysisManager;
+    llvm::FunctionAnalysisManager functionAnalysisManager;
+    llvm::CGSCCAnalysisManager cGSCCAnalysisManager;
+    llvm::ModuleAnalysisManager moduleAnalysisManager;
+    std::unique_ptr<psr::HelperAnalyses> helperAnalyses;
+    std::vector<llvm::Loop *> loops;
+    std::unique_ptr<LoopBound::LoopBoundIDEAnalysis> problem;
+
+    explicit LoopBoundTestModule(const std::string &source) {
+        ConfigParser configParser(std::filesystem::path(TEST_INPUT_DIR) / "defaultconfig.json");
+        configParser.parse();
+
+        llvm::SMDiagnostic error;
+        module = llvm::parseAssemblyString(source, error, context);
+        if (module == nullptr) {
+            throw std::runtime_error("Could not parse the loop bound test module: " + error.getMessage().str());
+        }
+
+        llvm::PassBuilder passBuilder;
+        passBuilder.registerModuleAnalyses(moduleAnalysisManager);
+        passBuilder.registerCGSCCAnalyses(cGSCCAnalysisManager);
+        passBuilder.registerFunctionAnalyses(functionAnalysisManager);
+        passBuilder.registerLoopAnalyses(loopAnalysisManager);
+        passBuilder.crossRegisterProxies(loopAnalysisManager, functionAnalysisManager, cGSCCAnalysisManager,
+                                         moduleAnalysisManager);
+
+        helperAnalyses = std::make_unique<psr::HelperAnalyses>(module.get(), std::vector<std::string>{"main"});
+
+        for (llvm::Function &function : *module) {
+            if (function.isDeclaration()) {
+                continue;
+            }
+
+            auto &loopInfo = functionAnalysisManager.getResult<llvm::LoopAnalysis>(function);
+            for (llvm::Loop *loop : loopInfo.getTopLevelLoops()) {
+                collectLoops(loop);
+            }
+        }
+
+        problem = std::make_unique<LoopBound::LoopBoundIDEAnalysis>(&functionAnalysisManager,
+                                                                    &helperAnalyses->getProjectIRDB(), loops);
+    }
+
+    /**
+     * Get the ICFG of the module, both solvers run on it
+     */
+    psr::LLVMBasedICFG &getICFG() {
+        return helperAnalyses->getICFG();
+    }
+
+    /**
+     * Solve the problem with the Phasar IDE solver
+     * @return Results of the serial solver
+     */
+    LoopBound::ResultsTy solveSerially() {
+        return psr::solveIDEProblem(*problem, getICFG());
+    }
+
+    /**
+     * Compare the values of the parallel or the bottom-up solver with the serial results like the verifyParallel option
+     * does. Every published value has to match, and the values of the counters of a function have to match at all of
+     * its instructions
+     * @param serialResults Results of the Phasar IDE solver
+     * @param solver Solved parallel or bottom-up solver
+     * @return Amount of instruction and fact pairs the solvers disagree on
+     */
+    template <typename SolverT>
+    size_t countMismatches(LoopBound::ResultsTy &serialResults, const SolverT &solver) const {
+        auto normalize = [](const LoopBound::DeltaInterval &value) -> std::optional<LoopBound::DeltaInterval> {
+            if (value.isBottom() || value.isTop() || value.isEmpty()) {
+                return std::nullopt;
+            }
+            return value;
+        };
+
+        size_t mismatches = 0;
+        for (const auto &[instruction, valuesAtInstruction] : solver.getResults()) {
+            for (const auto &[fact, value] : valuesAtInstruction) {
+                if (!(normalize(serialResults.resultAt(instruction, fact)) == normalize(value))) {
+                    mismatches++;
+                }
+            }
+        }
+
+        for (const auto &description : problem->getLoopParameterDescriptions()) {
+            if (!description.function || !description.counterRoot) {
+                continue;
+            }
+
+            const llvm::Value *counter = LoopBound::Util::stripAddr(description.counterRoot);
+            for (const llvm::BasicBlock &block : *description.function) {
+                for (const llvm::Instruction &instruction : block) {
+                    const auto parallelValue = solver.resultAt(&instruction, counter);
+                    const auto serialValue = normalize(serialResults.resultAt(&instruction, counter));
+                    if (!((parallelValue ? normalize(*parallelValue) : std::nullopt) == serialValue)) {
+                        mismatches++;
+                    }
+                }
+            }
+        }
+
+        return mismatches;
+    }
+
+ private:
+    void collectLoops(llvm::Loop *loop) {
+        loops.push_back(loop);
+        for (llvm::Loop *subLoop : loop->getSubLoops()) {
+            collectLoops(subLoop);
+        }
+    }
+};
+
+/**
+ * Find the store writing the value of the given name
+ */
+inline const llvm::StoreInst *findStoreOf(const llvm::Function &function, const std::string &valueName) {
+    for (const llvm::Instruction &instruction : llvm::instructions(function)) {
+        auto *storeInst = llvm::dyn_cast<llvm::StoreInst>(&instruction);
+        if (storeInst && storeInst->getValueOperand()->getName() == valueName) {
+            return storeInst;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Find the alloca of the given name
+ */
+inline const llvm::AllocaInst *findAlloca(const llvm::Function &function, const std::string &name) {
+    for (const llvm::Instruction &instruction : llvm::instructions(function)) {
+        auto *allocaInst = llvm::dyn_cast<llvm::AllocaInst>(&instruction);
+        if (allocaInst && allocaInst->getName() == name) {
+            return allocaInst;
+        }
+    }
+
+    return nullptr;
+}
@@ -4,7 +4,16 @@
  */
 
 #include <catch2/catch_test_macros.hpp>
+
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/Dominators.h>
+
+#include <limits>
+
 #include "../testutils.h"
+#include "analyses/loopbound/LoopBound.h"
+#include "analyses/loopbound/LoopBoundEdgeFunction.h"
 
 TestConfig loopBoundConfig = {.runFeasibilityAnalysis = false, .runLoopBoundAnalysis = true};
 
@@ -200,3 +209,162 @@ TEST_CASE("Arrayreducer_whilenonlinearincrementWithIFOneFamily.ll") {
     REQUIRE(firstClassifier ==
             LoopBound::DeltaInterval::interval(4, 9, LoopBound::DeltaInterval::ValueType::Multiplicative));
 }
+
+TEST_CASE("loopbound_loopfree.ll skips the solver") {
+    auto Run = runSpearOnFile(std::filesystem::path(TEST_INPUT_DIR),
+                              "programs/loopbound/compiled/loopbound_loopfree.ll", loopBoundConfig, false);
+
+    auto classifierMap = Run->phasarHandler.queryLoopBounds();
+
+    // Neither the helper analyses nor the solver are set up for a module without loops
+    REQUIRE(Run->phasarHandler.loopboundwrapper == nullptr);
+    REQUIRE(classifierMap.empty());
+}
+
+TEST_CASE("loopbound_counter_dense.ll") {
+    auto Run = runSpearOnFile(std::filesystem::path(TEST_INPUT_DIR),
+                              "programs/loopbound/compiled/loopbound_counter_dense.ll", loopBoundConfig, false);
+
+    auto classifierMap = Run->phasarHandler.queryLoopBounds();
+
+    // Every check resolves the bound through the store before the first loop
+    auto mainClassifiers = classifierMap["main"];
+    REQUIRE(mainClassifiers.size() == 128);
+    for (const auto &[loopName, classifier] : mainClassifiers) {
+        INFO("Loop " << loopName);
+        REQUIRE(classifier ==
+                LoopBound::DeltaInterval::interval(100, 100, LoopBound::DeltaInterval::ValueType::Additive));
+    }
+}
+
+TEST_CASE("widenEdgeFunction widens growing bounds") {
+    constexpr int64_t NEG_INF = std::numeric_limits<int64_t>::min();
+    constexpr int64_t POS_INF = std::numeric_limits<int64_t>::max();
+    using LoopBound::EF;
+
+    const EF previous(std::in_place_type<LoopBound::DeltaIntervalAdditive>, 1, 2);
+
+    auto stable = LoopBound::widenEdgeFunction(previous, previous);
+    REQUIRE(stable.dyn_cast<LoopBound::DeltaIntervalAdditive>()->lowerBound == 1);
+    REQUIRE(stable.dyn_cast<LoopBound::DeltaIntervalAdditive>()->upperBound == 2);
+
+    auto grownUp = LoopBound::widenEdgeFunction(
+        previous, EF(std::in_place_type<LoopBound::DeltaIntervalAdditive>, 1, 3));
+    REQUIRE(grownUp.dyn_cast<LoopBound::DeltaIntervalAdditive>()->lowerBound == 1);
+    REQUIRE(grownUp.dyn_cast<LoopBound::DeltaIntervalAdditive>()->upperBound == POS_INF);
+
+    auto grownDown = LoopBound::widenEdgeFunction(
+        EF(std::in_place_type<LoopBound::DeltaIntervalMultiplicative>, 2, 4),
+        EF(std::in_place_type<LoopBound::DeltaIntervalMultiplicative>, 1, 4));
+    REQUIRE(grownDown.dyn_cast<LoopBound::DeltaIntervalMultiplicative>()->lowerBound == NEG_INF);
+    REQUIRE(grownDown.dyn_cast<LoopBound::DeltaIntervalMultiplicative>()->upperBound == 4);
+
+    // Jump functions of different kinds are not widened, the join is kept
+    auto mixed = LoopBound::widenEdgeFunction(previous, LoopBound::edgeTop());
+    REQUIRE(mixed.isa<LoopBound::DeltaIntervalTop>());
+}
+
+TEST_CASE("narrowEdgeFunction restores widened bounds") {
+    constexpr int64_t NEG_INF = std::numeric_limits<int64_t>::min();
+    constexpr int64_t POS_INF = std::numeric_limits<int64_t>::max();
+    using LoopBound::EF;
+
+    auto narrowed = LoopBound::narrowEdgeFunction(
+        EF(std::in_place_type<LoopBound::DeltaIntervalAdditive>, NEG_INF, POS_INF),
+        EF(std::in_place_type<LoopBound::DeltaIntervalAdditive>, 1, 3));
+    REQUIRE(narrowed.dyn_cast<LoopBound::DeltaIntervalAdditive>()->lowerBound == 1);
+    REQUIRE(narrowed.dyn_cast<LoopBound::DeltaIntervalAdditive>()->upperBound == 3);
+
+    // Bounds that were not widened are kept
+    auto partial = LoopBound::narrowEdgeFunction(
+        EF(std::in_place_type<LoopBound::DeltaIntervalDivision>, 2, POS_INF),
+        EF(std::in_place_type<LoopBound::DeltaIntervalDivision>, 3, 5));
+    REQUIRE(partial.dyn_cast<LoopBound::DeltaIntervalDivision>()->lowerBound == 2);
+    REQUIRE(partial.dyn_cast<LoopBound::DeltaIntervalDivision>()->upperBound == 5);
+
+    const EF widened(std::in_place_type<LoopBound::DeltaIntervalAdditive>, 1, POS_INF);
+    auto mixed = LoopBound::narrowEdgeFunction(widened, LoopBound::edgeTop());
+    REQUIRE(mixed.dyn_cast<LoopBound::DeltaIntervalAdditive>()->upperBound == POS_INF);
+}
+
+static const char *affineCounterSource = R"(
+define void @counters(i32 %n) {
+entry:
+  %i = alloca i32
+  %j = alloca i32
+  store i32 0, ptr %i
+  store i32 0, ptr %j
+  br label %affine.cond
+affine.cond:
+  %iv = load i32, ptr %i
+  %affine.cmp = icmp slt i32 %iv, 10
+  br i1 %affine.cmp, label %affine.body, label %opaque.cond
+affine.body:
+  %inc = add nsw i32 %iv, 2
+  store i32 %inc, ptr %i
+  br label %affine.cond
+opaque.cond:
+  %jv = load i32, ptr %j
+  %opaque.cmp = icmp slt i32 %jv, 10
+  br i1 %opaque.cmp, label %opaque.body, label %exit
+opaque.body:
+  store i32 %n, ptr %j
+  br label %opaque.cond
+exit:
+  ret void
+}
+)";
+
+TEST_CASE("hasAffineCounter requires a constant increment") {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic error;
+    auto module = llvm::parseAssemblyString(affineCounterSource, error, context);
+    REQUIRE(module != nullptr);
+
+    auto *function = module->getFunction("counters");
+    llvm::DominatorTree dominatorTree(*function);
+    llvm::LoopInfo loopInfo(dominatorTree);
+
+    std::map<std::string, llvm::BasicBlock *> blocks;
+    std::map<std::string, llvm::Value *> cells;
+    for (auto &block : *function) {
+        blocks[block.getName().str()] = &block;
+        for (auto &inst : block) {
+            if (llvm::isa<llvm::AllocaInst>(inst)) {
+                cells[inst.getName().str()] = &inst;
+            }
+        }
+    }
+
+    auto *affineLoop = loopInfo.getLoopFor(blocks["affine.cond"]);
+    auto *opaqueLoop = loopInfo.getLoopFor(blocks["opaque.cond"]);
+    REQUIRE(affineLoop != nullptr);
+    REQUIRE(opaqueLoop != nullptr);
+
+    REQUIRE(LoopBound::LoopBoundIDEAnalysis::hasAffineCounter(affineLoop, cells["i"]));
+    // %j is overwritten by an argument, not incremented
+    REQUIRE_FALSE(LoopBound::LoopBoundIDEAnalysis::hasAffineCounter(opaqueLoop, cells["j"]));
+    // The store to %i is not a store to the counter of the other loop
+    REQUIRE_FALSE(LoopBound::LoopBoundIDEAnalysis::hasAffineCounter(affineLoop, cells["j"]));
+}
+
+TEST_CASE("Widened loops narrow back to their exact bound") {
+    TestConfig widenConfig = loopBoundConfig;
+    widenConfig.loopBoundConfiguration = LoopBoundConfiguration{
+        .threads = 1, .verifyParallel = false, .mode = LoopBoundMode::TOPDOWN, .widenAfter = 1,
+        .narrowingRounds = 5};
+
+    auto Run = runSpearOnFile(std::filesystem::path(TEST_INPUT_DIR),
+                              "programs/loopbound/compiled/arrayReducer_whileif.ll", widenConfig, false);
+
+    auto classifierMap = Run->phasarHandler.queryLoopBounds();
+    auto mainClassifiers = classifierMap["main"];
+    REQUIRE(mainClassifiers.size() == 1);
+
+    // The counter joins both branches of the if, so it is widened after its first join and narrowed afterwards
+    auto firstClassifier = mainClassifiers["while.cond"];
+    INFO("Classifier increment " << "[" << firstClassifier.getLowerBound() << ", " << firstClassifier.getUpperBound()
+                                 << "]");
+    REQUIRE(firstClassifier ==
+            LoopBound::DeltaInterval::interval(2250, 3000, LoopBound::DeltaInterval::ValueType::Additive));
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+#include "loopBoundTestModule.h"
+
+namespace {
+
+/**
+ * Counters modified through calls. The loop in main counts the global g and calls bump, whose loop counts g as well.
+ * rec counts its local i in two loops and calls itself inside the first one, so the second loop of the recursive call
+ * adds to the counter of the first
+ */
+constexpr const char *interproceduralCounterSource = R"(
+@g = global i32 0
+
+define void @bump() {
+entry:
+  br label %cond
+
+cond:
+  %value = load i32, ptr @g
+  %cmp = icmp slt i32 %value, 50
+  br i1 %cmp, label %body, label %exit
+
+body:
+  %old = load i32, ptr @g
+  %inc = add nsw i32 %old, 2
+  store i32 %inc, ptr @g
+  br label %cond
+
+exit:
+  ret void
+}
+
+define void @rec(i32 %depth) {
+entry:
+  %i = alloca i32
+  store i32 0, ptr %i
+  %deeper = icmp sgt i32 %depth, 0
+  br i1 %deeper, label %a.cond, label %exit
+
+a.cond:
+  %a = load i32, ptr %i
+  %a.cmp = icmp slt i32 %a, 10
+  br i1 %a.cmp, label %a.body, label %b.cond
+
+a.body:
+  %next.depth = sub nsw i32 %depth, 1
+  call void @rec(i32 %next.depth)
+  %a.old = load i32, ptr %i
+  %a.inc = add nsw i32 %a.old, 1
+  store i32 %a.inc, ptr %i
+  br label %a.cond
+
+b.cond:
+  %b = load i32, ptr %i
+  %b.cmp = icmp slt i32 %b, 20
+  br i1 %b.cmp, label %b.body, label %exit
+
+b.body:
+  %b.old = load i32, ptr %i
+  %b.inc = add nsw i32 %b.old, 5
+  store i32 %b.inc, ptr %i
+  br label %b.cond
+
+exit:
+  ret void
+}
+
+define i32 @main() {
+entry:
+  store i32 0, ptr @g
+  br label %g.cond
+
+g.cond:
+  %g.value = load i32, ptr @g
+  %g.cmp = icmp slt i32 %g.value, 100
+  br i1 %g.cmp, label %g.body, label %exit
+
+g.body:
+  call void @bump()
+  %g.old = load i32, ptr @g
+  %g.inc = add nsw i32 %g.old, 1
+  store i32 %g.inc, ptr @g
+  br label %g.cond
+
+exit:
+  call void @rec(i32 3)
+  ret i32 0
+}
+)";
+
+}  // namespace
+
+TEST_CASE("ParallelLoopBoundSolver matches the serial solver on interprocedural counters") {
+    LoopBoundTestModule testModule(interproceduralCounterSource);
+    auto serialResults = testModule.solveSerially();
+
+    const llvm::Value *globalCounter = testModule.module->getGlobalVariable("g");
+    const llvm::Value *localCounter = findAlloca(*testModule.module->getFunction("rec"), "i");
+    const llvm::StoreInst *globalIncrement = findStoreOf(*testModule.module->getFunction("main"), "g.inc");
+    const llvm::StoreInst *localIncrement = findStoreOf(*testModule.module->getFunction("rec"), "a.inc");
+    REQUIRE(globalCounter != nullptr);
+    REQUIRE(localCounter != nullptr);
+    REQUIRE(globalIncrement != nullptr);
+    REQUIRE(localIncrement != nullptr);
+
+    // bump adds two to the counter of main per call, the recursive call adds the five of the second loop of rec.
+    // Stepping over the calls would only see the increments of one
+    const auto globalBounds = LoopBound::DeltaInterval::interval(1, 2, LoopBound::DeltaInterval::ValueType::Additive);
+    const auto localBounds = LoopBound::DeltaInterval::interval(1, 5, LoopBound::DeltaInterval::ValueType::Additive);
+    REQUIRE(serialResults.resultAt(globalIncrement, globalCounter) == globalBounds);
+    REQUIRE(serialResults.resultAt(localIncrement, localCounter) == localBounds);
+
+    for (const unsigned threadCount : {1U, 2U, 4U}) {
+        INFO("Threads: " << threadCount);
+
+        LoopBound::ParallelLoopBoundSolver solver(*testModule.problem, testModule.getICFG(), threadCount);
+        solver.solve();
+
+        // One worklist per counter root, the global is tabulated across main and bump
+        REQUIRE(solver.getNumberOfWorklists() == 2);
+        REQUIRE(solver.getStatistics().summaries > 0);
+
+        REQUIRE(solver.resultAt(globalIncrement, globalCounter) == globalBounds);
+        REQUIRE(solver.resultAt(localIncrement, localCounter) == localBounds);
+        REQUIRE(testModule.countMismatches(serialResults, solver) == 0);
+    }
+}
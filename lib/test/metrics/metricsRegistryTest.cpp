@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MetricsRegistry.h"
+
+TEST_CASE("Histogram sums concurrent observations") {
+    Histogram histogram({1.0, 2.0});
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; thread++) {
+        threads.emplace_back([&histogram] {
+            for (int observation = 0; observation < 1000; observation++) {
+                histogram.observe(1.5);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(histogram.getCount() == 4000);
+    REQUIRE(histogram.getSum() == 6000.0);
+    REQUIRE(histogram.getCumulativeCounts() == std::vector<uint64_t>{0, 4000, 4000});
+}
+
+TEST_CASE("MetricsRegistry writes the OpenMetrics text format") {
+    auto &registry = MetricsRegistry::getInstance();
+    registry.counter("test_openmetrics_queries", "Queries", {{"solver", "z3"}}).inc(3);
+    registry.gauge("test_openmetrics_rss", "Resident set size").set(2.5);
+    auto &histogram = registry.histogram("test_openmetrics_latency", "Latency", {0.5, 1.0}, {{"phase", "a\"b"}});
+    histogram.observe(0.25);
+    histogram.observe(0.75);
+    histogram.observe(4.0);
+
+    std::ostringstream stream;
+    registry.writeOpenMetrics(stream);
+    const std::string output = stream.str();
+
+    REQUIRE(output.find("# TYPE test_openmetrics_queries counter\n") != std::string::npos);
+    REQUIRE(output.find("test_openmetrics_queries_total{solver=\"z3\"} 3\n") != std::string::npos);
+    REQUIRE(output.find("# TYPE test_openmetrics_rss gauge\n") != std::string::npos);
+    REQUIRE(output.find("test_openmetrics_rss 2.5\n") != std::string::npos);
+
+    // Buckets are cumulative and label values are escaped
+    REQUIRE(output.find("test_openmetrics_latency_bucket{phase=\"a\\\"b\",le=\"0.5\"} 1\n") != std::string::npos);
+    REQUIRE(output.find("test_openmetrics_latency_bucket{phase=\"a\\\"b\",le=\"1\"} 2\n") != std::string::npos);
+    REQUIRE(output.find("test_openmetrics_latency_bucket{phase=\"a\\\"b\",le=\"+Inf\"} 3\n") != std::string::npos);
+    REQUIRE(output.find("test_openmetrics_latency_sum{phase=\"a\\\"b\"} 5\n") != std::string::npos);
+    REQUIRE(output.find("test_openmetrics_latency_count{phase=\"a\\\"b\"} 3\n") != std::string::npos);
+    REQUIRE(output.size() >= 6);
+    REQUIRE(output.substr(output.size() - 6) == "# EOF\n");
+}
+
+TEST_CASE("MetricsRegistry exports JSON") {
+    auto &registry = MetricsRegistry::getInstance();
+    registry.counter("test_json_queries", "Queries").inc(7);
+    registry.histogram("test_json_latency", "Latency", {1.0}).observe(0.5);
+
+    const auto json = registry.toJson();
+
+    REQUIRE(json["test_json_queries"]["type"] == "counter");
+    REQUIRE(json["test_json_queries"]["metrics"][0]["value"] == 7);
+
+    const auto &histogram = json["test_json_latency"]["metrics"][0];
+    REQUIRE(json["test_json_latency"]["type"] == "histogram");
+    REQUIRE(histogram["buckets"].size() == 2);
+    REQUIRE(histogram["buckets"][0]["le"] == 1.0);
+    REQUIRE(histogram["buckets"][0]["count"] == 1);
+    REQUIRE(histogram["buckets"][1]["le"] == "+Inf");
+    REQUIRE(histogram["sum"] == 0.5);
+    REQUIRE(histogram["count"] == 1);
+}
+
+TEST_CASE("MetricsRegistry merges the metrics of a worker") {
+    auto &registry = MetricsRegistry::getInstance();
+    auto &queries = registry.counter("test_merge_queries", "Queries");
+    auto &rss = registry.gauge("test_merge_rss", "Resident set size");
+    auto &latency = registry.histogram("test_merge_latency", "Latency", {1.0});
+    queries.inc(2);
+    rss.set(10.0);
+    latency.observe(0.5);
+
+    // A worker reports its own share after the registry was reset in the forked process
+    const auto parent = registry.toJson();
+    registry.reset();
+    REQUIRE(queries.get() == 0);
+
+    queries.inc(3);
+    rss.set(4.0);
+    latency.observe(2.0);
+    latency.observe(0.25);
+    const auto worker = registry.toJson();
+
+    registry.reset();
+    registry.merge(parent);
+    registry.merge(worker);
+
+    // Counters and histograms are summed, gauges keep the maximum
+    REQUIRE(queries.get() == 5);
+    REQUIRE(rss.get() == 10.0);
+    REQUIRE(latency.getCount() == 3);
+    REQUIRE(latency.getSum() == 2.75);
+    REQUIRE(latency.getCumulativeCounts() == std::vector<uint64_t>{2, 3});
+
+    // Histograms with other bounds are skipped
+    auto mismatched = worker;
+    mismatched["test_merge_latency"]["metrics"][0]["buckets"][0]["le"] = 5.0;
+    registry.merge(mismatched);
+    REQUIRE(latency.getCount() == 3);
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "profilers/CPUTopology.h"
+
+/**
+ * Temporary sysfs tree that is removed at the end of the test
+ */
+struct FakeSysfs {
+    std::filesystem::path root;
+
+    explicit FakeSysfs(const std::string &name) {
+        root = std::filesystem::temp_directory_path() / ("spear_sysfs_" + name);
+        std::filesystem::remove_all(root);
+        std::filesystem::create_directories(root);
+    }
+
+    ~FakeSysfs() { std::filesystem::remove_all(root); }
+
+    void write(const std::string &relativePath, const std::string &content) const {
+        auto path = root / relativePath;
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream file(path);
+        file << content << "\n";
+    }
+};
+
+TEST_CASE("Parse sysfs cpu lists") {
+    REQUIRE(CPUTopology::parseCpuList("0-3") == std::vector<int>{0, 1, 2, 3});
+    REQUIRE(CPUTopology::parseCpuList("0,2,4-5") == std::vector<int>{0, 2, 4, 5});
+    REQUIRE(CPUTopology::parseCpuList("16-19,8") == std::vector<int>{8, 16, 17, 18, 19});
+    REQUIRE(CPUTopology::parseCpuList("").empty());
+}
+
+TEST_CASE("Detect Intel hybrid core types from the PMU devices") {
+    FakeSysfs sysfs("intel_hybrid");
+    sysfs.write("devices/cpu_core/cpus", "0-7");
+    sysfs.write("devices/cpu_atom/cpus", "8-15");
+    sysfs.write("devices/cpu_lowpower/cpus", "16-17");
+    sysfs.write("devices/system/cpu/online", "0-17");
+
+    auto topology = CPUTopology::detect(sysfs.root);
+
+    REQUIRE(topology.isHybrid());
+    REQUIRE(topology.getCoreTypes().size() == 3);
+    REQUIRE(topology.getCoreTypes()[0].name == "performance");
+    REQUIRE(topology.getCoreTypes()[0].cpus.size() == 8);
+    REQUIRE(topology.getCoreTypes()[1].name == "efficiency");
+    REQUIRE(topology.getCoreTypes()[2].name == "lowpower");
+    REQUIRE(topology.coreTypeOf(9) == "efficiency");
+    REQUIRE(topology.coreTypeOf(17) == "lowpower");
+    REQUIRE(topology.coreTypeOf(42).empty());
+    REQUIRE(topology.allCpus().size() == 18);
+    REQUIRE(topology.toJson()["performance"].size() == 8);
+}
+
+TEST_CASE("Detect core types from the cpu capacity") {
+    FakeSysfs sysfs("capacity");
+    sysfs.write("devices/system/cpu/online", "0-5");
+    for (int cpu = 0; cpu < 6; cpu++) {
+        sysfs.write("devices/system/cpu/cpu" + std::to_string(cpu) + "/cpu_capacity", cpu < 4 ? "446" : "1024");
+    }
+
+    auto topology = CPUTopology::detect(sysfs.root);
+
+    REQUIRE(topology.isHybrid());
+    REQUIRE(topology.getCoreTypes().size() == 2);
+    REQUIRE(topology.getCoreTypes()[0].name == "performance");
+    REQUIRE(topology.getCoreTypes()[0].cpus == std::vector<int>{4, 5});
+    REQUIRE(topology.getCoreTypes()[1].name == "efficiency");
+    REQUIRE(topology.getCoreTypes()[1].cpus == std::vector<int>{0, 1, 2, 3});
+}
+
+TEST_CASE("Fall back to a single core type") {
+    FakeSysfs sysfs("homogeneous");
+    sysfs.write("devices/system/cpu/online", "0-3");
+    for (int cpu = 0; cpu < 4; cpu++) {
+        sysfs.write("devices/system/cpu/cpu" + std::to_string(cpu) + "/cpu_capacity", "1024");
+    }
+
+    auto topology = CPUTopology::detect(sysfs.root);
+
+    REQUIRE_FALSE(topology.isHybrid());
+    REQUIRE(topology.getCoreTypes().size() == 1);
+    REQUIRE(topology.getCoreTypes()[0].name == "default");
+    REQUIRE(topology.getCoreTypes()[0].cpus == std::vector<int>{0, 1, 2, 3});
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+
+#include "EnergyCounterSource.h"
+#include "profilers/SyscallEventConsumer.h"
+
+static void inject(SyscallEventConsumer &consumer, uint64_t ts, uint32_t tid, uint8_t type, uint32_t id = 0) {
+    evt event{ts, tid, id, type};
+    SyscallEventConsumer::onRecord(&consumer, &event, sizeof(event));
+}
+
+TEST_CASE("InflightTable keeps colliding threads after erasing") {
+    InflightTable table(8);
+    REQUIRE(table.getCapacity() == 8);
+
+    for (uint32_t tid = 1; tid <= 6; tid++) {
+        table.findOrInsert(tid * 8)->syscall_id = tid;
+    }
+    REQUIRE(table.size() == 6);
+
+    table.erase(16);
+    table.erase(40);
+    REQUIRE(table.size() == 4);
+
+    for (uint32_t tid : {1, 3, 4, 6}) {
+        REQUIRE(table.findOrInsert(tid * 8)->syscall_id == tid);
+    }
+    REQUIRE(table.findOrInsert(16)->syscall_id == 0);
+    REQUIRE(table.size() == 5);
+
+    // One slot always stays free
+    REQUIRE(table.findOrInsert(1000) != nullptr);
+    REQUIRE(table.findOrInsert(2000) != nullptr);
+    REQUIRE(table.findOrInsert(3000) == nullptr);
+}
+
+TEST_CASE("SyscallEventConsumer interpolates the energy within a batch") {
+    // One Joule per tick, the counter only advances on addEnergy()
+    MockCounterSource source(0, 32, 1.0);
+    SyscallEventConsumer consumer(source, 10, 16);
+
+    // An event of an untracked thread establishes the first reading
+    inject(consumer, 1000, 99, 3);
+    consumer.flush(1000);
+
+    source.addEnergy(100);
+    inject(consumer, 1250, 1, 0, 5);
+    inject(consumer, 1750, 1, 1, 5);
+    consumer.flush(2000);
+
+    REQUIRE(consumer.getCount(5) == 1);
+    REQUIRE(std::fabs(consumer.getEnergy(5) - 50.0) < 1e-9);
+    REQUIRE(consumer.getStats().processed == 3);
+    REQUIRE(consumer.getStats().batches == 2);
+}
+
+TEST_CASE("SyscallEventConsumer excludes the time a thread is switched out") {
+    MockCounterSource source(0, 32, 1.0);
+    SyscallEventConsumer consumer(source, 10, 16);
+
+    inject(consumer, 0, 99, 3);
+    consumer.flush(0);
+
+    source.addEnergy(100);
+    inject(consumer, 0, 1, 0, 3);
+    inject(consumer, 10, 1, 2);
+    inject(consumer, 90, 1, 3);
+    inject(consumer, 100, 1, 1, 3);
+    consumer.flush(100);
+
+    REQUIRE(consumer.getCount(3) == 1);
+    REQUIRE(std::fabs(consumer.getEnergy(3) - 20.0) < 1e-9);
+}
+
+TEST_CASE("SyscallEventConsumer counts ignored and dropped events") {
+    MockCounterSource source(0, 32, 1.0);
+    SyscallEventConsumer consumer(source, 10, 4, 4);
+
+    uint32_t small = 0;
+    SyscallEventConsumer::onRecord(&consumer, &small, sizeof(small));
+    REQUIRE(consumer.getStats().malformed == 1);
+
+    // Unknown syscall ids are ignored, the thread is not tracked
+    inject(consumer, 1, 1, 0, 10);
+
+    // Three threads fill the table of four slots, the fourth overflows. The full batch is handled right away
+    inject(consumer, 2, 2, 0, 1);
+    inject(consumer, 3, 3, 0, 1);
+    inject(consumer, 4, 4, 0, 1);
+    REQUIRE(consumer.getStats().batches == 1);
+
+    inject(consumer, 5, 5, 0, 1);
+    consumer.flush(5);
+
+    consumer.setKernelDrops(7);
+
+    const auto &stats = consumer.getStats();
+    REQUIRE(stats.processed == 5);
+    REQUIRE(stats.unknownSyscalls == 1);
+    REQUIRE(stats.tableOverflows == 1);
+    REQUIRE(stats.dropped() == 9);
+
+    consumer.reset();
+    REQUIRE(consumer.getStats().processed == 0);
+    REQUIRE(consumer.getCount(1) == 0);
+}
+
+TEST_CASE("SyscallEventConsumer interpolates late events against the earlier reading") {
+    MockCounterSource source(0, 32, 1.0);
+    SyscallEventConsumer consumer(source, 10, 16);
+
+    inject(consumer, 0, 99, 3);
+    consumer.flush(0);
+
+    source.addEnergy(100);
+    inject(consumer, 100, 99, 3);
+    consumer.flush(100);
+
+    // The enter was recorded before the reading at 100 but is delivered with the next batch
+    source.addEnergy(100);
+    inject(consumer, 50, 1, 0, 5);
+    inject(consumer, 150, 1, 1, 5);
+    consumer.flush(200);
+
+    REQUIRE(consumer.getCount(5) == 1);
+    REQUIRE(std::fabs(consumer.getEnergy(5) - 100.0) < 1e-9);
+    REQUIRE(consumer.getStats().lateEvents == 0);
+
+    // The interval ending at 100 is no longer retained, the enter is late and its syscall is not counted
+    source.addEnergy(100);
+    inject(consumer, 50, 2, 0, 5);
+    inject(consumer, 250, 2, 1, 5);
+    consumer.flush(300);
+
+    REQUIRE(consumer.getCount(5) == 1);
+    REQUIRE(std::fabs(consumer.getEnergy(5) - 100.0) < 1e-9);
+    REQUIRE(consumer.getStats().lateEvents == 1);
+    REQUIRE(consumer.getStats().dropped() == 1);
+    REQUIRE(consumer.getStats().processed == 6);
+    REQUIRE(consumer.getInflightThreads() == 0);
+}
+
+TEST_CASE("SyscallEventConsumer handles a synthetic event stream") {
+    constexpr uint32_t threads = 64;
+    constexpr uint64_t syscallsPerThread = 1 << 14;
+    constexpr size_t batchSize = 256;
+
+    MockCounterSource source(10.0);
+    SyscallEventConsumer consumer(source, 462, batchSize);
+
+    // Full batches read the counter at the current time, so the events are stamped with the same clock. Every syscall
+    // is interrupted once by the scheduler, like a blocking read
+    for (uint64_t round = 0; round < syscallsPerThread; round++) {
+        for (uint32_t tid = 0; tid < threads; tid++) {
+            const uint32_t id = static_cast<uint32_t>((round + tid) % 462);
+            inject(consumer, SyscallEventConsumer::monotonicNs(), tid, 0, id);
+            inject(consumer, SyscallEventConsumer::monotonicNs(), tid, 2);
+            inject(consumer, SyscallEventConsumer::monotonicNs(), tid, 3);
+            inject(consumer, SyscallEventConsumer::monotonicNs(), tid, 1, id);
+        }
+    }
+    consumer.flush();
+
+    const uint64_t events = 4 * threads * syscallsPerThread;
+    uint64_t completed = 0;
+    for (uint32_t id = 0; id < consumer.getMaxSyscallId(); id++) {
+        completed += consumer.getCount(id);
+    }
+
+    REQUIRE(consumer.getStats().processed == events);
+    REQUIRE(consumer.getStats().batches == (events + batchSize - 1) / batchSize);
+    REQUIRE(consumer.getStats().dropped() == 0);
+    REQUIRE(consumer.getInflightThreads() == 0);
+    REQUIRE(completed == threads * syscallsPerThread);
+
+    // Threads entering a syscall stay tracked until their exit
+    for (uint32_t tid = 0; tid < threads; tid++) {
+        inject(consumer, SyscallEventConsumer::monotonicNs(), tid, 0, 1);
+    }
+    consumer.flush();
+    REQUIRE(consumer.getInflightThreads() == threads);
+    REQUIRE(consumer.getStats().dropped() == 0);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+#include "profilers/SystemMetadata.h"
+
+static const std::filesystem::path fixtureDir = std::filesystem::path(TEST_INPUT_DIR) / "programs" / "metadata";
+
+static SystemMetadataCollector fixtureCollector(const std::string &fixture) {
+    return SystemMetadataCollector(fixtureDir / fixture / "proc", fixtureDir / fixture / "sys", false);
+}
+
+TEST_CASE("Parse the first processor of cpuinfo") {
+    auto fields = SystemMetadataCollector::parseCpuInfo("processor\t: 0\nmodel name\t: First\n\n"
+                                                        "processor\t: 1\nmodel name\t: Second\n");
+
+    REQUIRE(fields["processor"] == "0");
+    REQUIRE(fields["model name"] == "First");
+}
+
+TEST_CASE("Collect the metadata of a hybrid Intel machine") {
+    auto metadata = fixtureCollector("intel_hybrid").collect();
+
+    REQUIRE(metadata["cpu"]["name"] == "12th Gen Intel(R) Core(TM) i7-1260P");
+    REQUIRE(metadata["cpu"]["vendor"] == "GenuineIntel");
+    REQUIRE(metadata["cpu"]["family"] == "6");
+    REQUIRE(metadata["cpu"]["model"] == "154");
+    REQUIRE(metadata["cpu"]["microcode"] == "0x430");
+    REQUIRE(metadata["cpu"]["siblings"] == "6");
+
+    REQUIRE(metadata["topology"]["online"] == 6);
+    REQUIRE(metadata["topology"]["packages"] == 1);
+    REQUIRE(metadata["topology"]["physical_cores"] == 4);
+    REQUIRE(metadata["topology"]["smt"] == "on");
+    REQUIRE(metadata["topology"]["core_types"]["performance"].size() == 4);
+    REQUIRE(metadata["topology"]["core_types"]["efficiency"].size() == 2);
+
+    REQUIRE(metadata["frequency"]["min_khz"] == 400000);
+    REQUIRE(metadata["frequency"]["max_khz"] == 4700000);
+    REQUIRE(metadata["frequency"]["driver"] == "intel_pstate");
+    REQUIRE(metadata["frequency"]["governor"] == "powersave");
+
+    REQUIRE(metadata["kernel"]["release"] == "6.8.0-45-generic");
+    REQUIRE(metadata["kernel"]["boot_id"] == "3c1f5e9a-2b7d-4e61-9a0c-5d8e7f6a1b2c");
+
+    REQUIRE(metadata["cached"] == false);
+    REQUIRE(metadata["collection_us"].get<int64_t>() >= 0);
+}
+
+TEST_CASE("Collect the metadata of a minimal container") {
+    auto metadata = fixtureCollector("container").collect();
+
+    REQUIRE(metadata["cpu"]["name"].is_null());
+    REQUIRE(metadata["cpu"]["vendor"] == "0x41");
+    REQUIRE(metadata["cpu"]["microcode"].is_null());
+    REQUIRE(metadata["topology"]["online"] == 2);
+    REQUIRE(metadata["topology"]["packages"].is_null());
+    REQUIRE(metadata["frequency"]["max_khz"].is_null());
+    REQUIRE(metadata["frequency"]["governor"].is_null());
+    REQUIRE(metadata["kernel"]["release"] == "6.1.0-25-arm64");
+    REQUIRE(metadata["kernel"]["boot_id"].is_null());
+}
+
+TEST_CASE("Cache the metadata per boot") {
+    auto cacheFile = std::filesystem::temp_directory_path() / "spear_metadata_test" / "metadata.json";
+    std::filesystem::remove_all(cacheFile.parent_path());
+
+    auto collector = fixtureCollector("intel_hybrid");
+
+    auto first = collector.collectCached(cacheFile);
+    REQUIRE(first["cached"] == false);
+    REQUIRE(std::filesystem::exists(cacheFile));
+
+    auto second = collector.collectCached(cacheFile);
+    REQUIRE(second["cached"] == true);
+    REQUIRE(second["cpu"] == first["cpu"]);
+
+    // A cache written during another boot is replaced
+    second["kernel"]["boot_id"] = "another-boot";
+    std::ofstream(cacheFile) << second.dump();
+    REQUIRE(collector.collectCached(cacheFile)["cached"] == false);
+
+    // Without a boot id nothing is cached
+    auto containerCache = cacheFile.parent_path() / "container.json";
+    fixtureCollector("container").collectCached(containerCache);
+    REQUIRE_FALSE(std::filesystem::exists(containerCache));
+
+    std::filesystem::remove_all(cacheFile.parent_path());
+}
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <csignal>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "ConfigParser.h"
+#include "ELBs/ELPMapper.h"
+#include "MetricsRegistry.h"
+#include "ShardedAnalysis.h"
+
+static const char *callGraphSource = R"(
+define i32 @leaf(i32 %x) {
+  %y = add i32 %x, 1
+  %z = mul i32 %y, 3
+  ret i32 %z
+}
+
+define i32 @even(i32 %n) {
+  %c = icmp eq i32 %n, 0
+  br i1 %c, label %done, label %rec
+rec:
+  %m = sub i32 %n, 1
+  %r = call i32 @odd(i32 %m)
+  ret i32 %r
+done:
+  %l = call i32 @leaf(i32 %n)
+  ret i32 %l
+}
+
+define i32 @odd(i32 %n) {
+  %c = icmp eq i32 %n, 0
+  br i1 %c, label %done, label %rec
+rec:
+  %m = sub i32 %n, 1
+  %r = call i32 @even(i32 %m)
+  ret i32 %r
+done:
+  ret i32 0
+}
+
+define i32 @main() {
+  %a = call i32 @even(i32 4)
+  %b = call i32 @leaf(i32 %a)
+  %c = add i32 %a, %b
+  ret i32 %c
+}
+)";
+
+// Only main is visible outside of the module, the other functions are not reachable from the external calling node
+static const char *internalCallGraphSource = R"(
+define internal i32 @helper(i32 %x) {
+  %y = add i32 %x, 1
+  ret i32 %y
+}
+
+define internal i32 @ping(i32 %n) {
+  %c = icmp eq i32 %n, 0
+  br i1 %c, label %done, label %rec
+rec:
+  %m = sub i32 %n, 1
+  %r = call i32 @pong(i32 %m)
+  ret i32 %r
+done:
+  ret i32 0
+}
+
+define internal i32 @pong(i32 %n) {
+  %c = icmp eq i32 %n, 0
+  br i1 %c, label %done, label %rec
+rec:
+  %m = sub i32 %n, 1
+  %r = call i32 @ping(i32 %m)
+  ret i32 %r
+done:
+  %h = call i32 @helper(i32 %n)
+  ret i32 %h
+}
+
+define internal i32 @unused() {
+  %r = call i32 @ping(i32 3)
+  ret i32 %r
+}
+
+define i32 @main() {
+  ret i32 0
+}
+)";
+
+static std::unordered_map<std::string, std::size_t> shardOfFunctions(const std::vector<Shard> &shards) {
+    std::unordered_map<std::string, std::size_t> shardOf;
+    for (const auto &shard : shards) {
+        for (const auto &functionName : shard.functions) {
+            shardOf[functionName] = shard.index;
+        }
+    }
+    return shardOf;
+}
+
+/**
+ * Assign every function 1 J plus the summaries of the callees it reaches through declarations
+ */
+static nlohmann::json summingWorker(llvm::Module &module) {
+    nlohmann::json output = nlohmann::json::object();
+    output["analysis"] = "summing";
+    output["functions"] = nlohmann::json::object();
+
+    for (llvm::Function &function : module) {
+        if (function.isDeclaration()) {
+            continue;
+        }
+
+        double energy = 1.0;
+        for (llvm::Instruction &instruction : llvm::instructions(function)) {
+            auto *call = llvm::dyn_cast<llvm::CallInst>(&instruction);
+            if (call != nullptr && call->getCalledFunction()->isDeclaration()) {
+                energy += ELBMapper::getInstance().lookup(call->getCalledFunction()->getName().str()).value_or(0.0);
+            }
+        }
+
+        output["functions"][function.getName().str()] = {{"energy", energy}};
+    }
+
+    return output;
+}
+
+TEST_CASE("Sharded analysis keeps SCCs together and orders shards callees first") {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic error;
+    auto module = llvm::parseAssemblyString(callGraphSource, error, context);
+    REQUIRE(module != nullptr);
+
+    auto shards = ShardedAnalysis::partition(*module, 3);
+    REQUIRE(shards.size() == 3);
+
+    auto shardOf = shardOfFunctions(shards);
+    REQUIRE(shardOf.size() == 4);
+    REQUIRE(shardOf["even"] == shardOf["odd"]);
+    REQUIRE(shardOf["leaf"] < shardOf["even"]);
+    REQUIRE(shardOf["even"] < shardOf["main"]);
+
+    for (const auto &shard : shards) {
+        for (std::size_t dependency : shard.dependencies) {
+            REQUIRE(dependency < shard.index);
+        }
+    }
+
+    auto shardModule = ShardedAnalysis::extractShard(*module, shards[shardOf["main"]]);
+    REQUIRE_FALSE(shardModule->getFunction("main")->isDeclaration());
+    REQUIRE(shardModule->getFunction("even")->isDeclaration());
+    REQUIRE(shardModule->getFunction("leaf")->isDeclaration());
+
+    // More shards than SCCs leave no shard empty
+    REQUIRE(ShardedAnalysis::partition(*module, 16).size() == 3);
+}
+
+TEST_CASE("Sharded analysis keeps unreachable SCCs together and orders them callees first") {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic error;
+    auto module = llvm::parseAssemblyString(internalCallGraphSource, error, context);
+    REQUIRE(module != nullptr);
+
+    auto shards = ShardedAnalysis::partition(*module, 16);
+    auto shardOf = shardOfFunctions(shards);
+    REQUIRE(shardOf.size() == 5);
+    REQUIRE(shardOf["ping"] == shardOf["pong"]);
+    REQUIRE(shardOf["helper"] < shardOf["ping"]);
+    REQUIRE(shardOf["ping"] < shardOf["unused"]);
+
+    for (const auto &shard : shards) {
+        for (std::size_t dependency : shard.dependencies) {
+            REQUIRE(dependency < shard.index);
+        }
+    }
+}
+
+TEST_CASE("Sharded analysis exchanges summaries and survives failing workers") {
+    const std::filesystem::path testroot(TEST_INPUT_DIR);
+    ConfigParser configParser(testroot / "defaultconfig.json");
+    configParser.parse();
+
+    auto outputDirectory = std::filesystem::temp_directory_path() / "spear_sharded_test";
+    std::filesystem::remove_all(outputDirectory);
+
+    // Later tests must not write into the removed output directory
+    const auto savedConfiguration = ConfigParser::getAnalysisConfiguration();
+    auto analysisConfiguration = savedConfiguration;
+    analysisConfiguration.outputDirectory = outputDirectory.string();
+    ConfigParser::overrideAnalysisConfiguration(analysisConfiguration);
+
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic error;
+    auto module = llvm::parseAssemblyString(callGraphSource, error, context);
+    REQUIRE(module != nullptr);
+
+    const ShardingConfiguration shardingConfiguration{true, 3, 2, 0};
+
+    SECTION("Callers see the energies of the callees in other shards") {
+        auto &workerCalls = MetricsRegistry::getInstance().counter("spear_test_worker_calls", "Calls of the worker");
+        const uint64_t callsBefore = workerCalls.get();
+
+        auto output = ShardedAnalysis::run(*module, shardingConfiguration, [](llvm::Module &shardModule,
+                                                                              ShardAttempt) {
+            MetricsRegistry::getInstance().counter("spear_test_worker_calls", "Calls of the worker").inc();
+            return summingWorker(shardModule);
+        });
+
+        // The counters of the workers are merged into the parent
+        REQUIRE(workerCalls.get() == callsBefore + ShardedAnalysis::partition(*module, 3).size());
+
+        REQUIRE(output["analysis"] == "summing");
+        REQUIRE(output["functions"].size() == 4);
+        REQUIRE(output["functions"]["leaf"]["energy"] == 1.0);
+        REQUIRE(output["functions"]["even"]["energy"] == 2.0);
+        REQUIRE(output["functions"]["main"]["energy"] == 4.0);
+
+        for (const auto &shard : output["shards"]) {
+            REQUIRE(shard["attempt"] == "full");
+        }
+    }
+
+    SECTION("A crashing worker is retried and an unanalyzable shard falls back") {
+        auto output = ShardedAnalysis::run(*module, shardingConfiguration, [](llvm::Module &shardModule,
+                                                                              ShardAttempt attempt) {
+            if (!shardModule.getFunction("even")->isDeclaration() && attempt == ShardAttempt::FULL) {
+                std::raise(SIGKILL);
+            }
+            if (!shardModule.getFunction("main")->isDeclaration()) {
+                throw std::runtime_error("unanalyzable");
+            }
+            return summingWorker(shardModule);
+        });
+
+        const double fallbackEnergy = analysisConfiguration.fallback["calls"]["UNKNOWN_FUNCTION"];
+        auto shardOf = shardOfFunctions(ShardedAnalysis::partition(*module, 3));
+
+        REQUIRE(output["functions"].size() == 4);
+        REQUIRE(output["functions"]["leaf"]["energy"] == 1.0);
+        REQUIRE(output["functions"]["odd"]["energy"] == 1.0);
+        REQUIRE(output["functions"]["main"]["energy"] == fallbackEnergy);
+
+        REQUIRE(output["shards"][shardOf["leaf"]]["attempt"] == "full");
+        REQUIRE(output["shards"][shardOf["even"]]["attempt"] == "reduced");
+        REQUIRE(output["shards"][shardOf["even"]]["failures"].size() == 1);
+        REQUIRE(output["shards"][shardOf["main"]]["attempt"] == "fallback");
+        REQUIRE(output["shards"][shardOf["main"]]["failures"].size() == 2);
+    }
+
+    SECTION("Internal mutually recursive functions are analyzed in one shard") {
+        llvm::LLVMContext internalContext;
+        auto internalModule = llvm::parseAssemblyString(internalCallGraphSource, error, internalContext);
+        REQUIRE(internalModule != nullptr);
+
+        auto output = ShardedAnalysis::run(*internalModule, {true, 16, 2, 0}, [](llvm::Module &shardModule,
+                                                                                 ShardAttempt) {
+            return summingWorker(shardModule);
+        });
+
+        REQUIRE(output["functions"].size() == 5);
+        REQUIRE(output["functions"]["helper"]["energy"] == 1.0);
+        REQUIRE(output["functions"]["pong"]["energy"] == 2.0);
+        REQUIRE(output["functions"]["unused"]["energy"] == 2.0);
+
+        for (const auto &shard : output["shards"]) {
+            REQUIRE(shard["attempt"] == "full");
+        }
+    }
+
+    SECTION("Shards waiting for each other fall back instead of waiting forever") {
+        auto shards = ShardedAnalysis::partition(*module, 3);
+        auto shardOf = shardOfFunctions(shards);
+
+        // Let the shard of leaf wait for the shard of main, which waits for leaf's shard through even
+        shards[shardOf["leaf"]].dependencies.push_back(shardOf["main"]);
+
+        auto output = ShardedAnalysis::run(*module, shards, shardingConfiguration, [](llvm::Module &shardModule,
+                                                                                      ShardAttempt) {
+            return summingWorker(shardModule);
+        });
+
+        const double fallbackEnergy = analysisConfiguration.fallback["calls"]["UNKNOWN_FUNCTION"];
+        REQUIRE(output["functions"].size() == 4);
+        for (const auto &[functionName, functionObject] : output["functions"].items()) {
+            REQUIRE(functionObject["energy"] == fallbackEnergy);
+        }
+
+        for (const auto &shard : output["shards"]) {
+            REQUIRE(shard["attempt"] == "fallback");
+            REQUIRE(shard["failures"].size() == 1);
+            REQUIRE(shard["failures"][0]["reason"] == "dependencies can not be analyzed");
+        }
+    }
+
+    ConfigParser::overrideAnalysisConfiguration(savedConfiguration);
+    std::filesystem::remove_all(outputDirectory);
+}
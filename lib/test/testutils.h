@@ -18,6 +18,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_set>
 #include <utility>
@@ -32,6 +33,8 @@
 struct TestConfig {
     bool runFeasibilityAnalysis = false;
     bool runLoopBoundAnalysis = false;
+    // Replaces the loop bound configuration of the default config if set
+    std::optional<LoopBoundConfiguration> loopBoundConfiguration = std::nullopt;
 };
 
 struct SpearRun {
@@ -75,6 +78,11 @@ inline std::unique_ptr<SpearRun> runSpearOnFile(std::filesystem::path testroot,
     ConfigParser configParser(testroot / "defaultconfig.json");
     configParser.parse();
 
+    if (config.loopBoundConfiguration) {
+        auto analysisConfiguration = ConfigParser::getAnalysisConfiguration();
+        analysisConfiguration.loopboundconfig = *config.loopBoundConfiguration;
+        ConfigParser::overrideAnalysisConfiguration(analysisConfiguration);
+    }
 
     auto combined = testroot / strPath;
     std::string combinedAsStr = combined.string();
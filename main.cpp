@@ -6,6 +6,8 @@
 #include <string>
 #include <utility>
 #include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <stdexcept>
 
@@ -22,7 +24,14 @@
 
 #include "CLIHandler.h"
 #include "ConfigParser.h"
+#include "EnergySampler.h"
+#include "HLAC/HLACSnapshot.h"
 #include "Logger.h"
+#include "MetricsRegistry.h"
+#include "OfflineAnalysis.h"
+#include "ProgressReporter.h"
+#include "SelfEnergyMeter.h"
+#include "ShardedAnalysis.h"
 #include "analyses/ResultRegistry.h"
 #include "profilers/CPUProfiler.h"
 #include "profilers/MetaProfiler.h"
@@ -44,7 +53,22 @@ void runProfileRoutine(CLIOptions opts) {
 
     json metaResult = metaprofiler.profile();
 
+    // Optional power timeline of the whole profiling run. Nobody collects the samples while the profilers run, so
+    // the buffer has to hold all of them
+    std::unique_ptr<EnergyCounterSource> timelineSource;
+    std::unique_ptr<EnergySampler> timelineSampler;
+    if (proflingConfig.timelineRate > 0) {
+        try {
+            timelineSource = std::make_unique<RaplCounterSource>();
+            timelineSampler = std::make_unique<EnergySampler>(*timelineSource, proflingConfig.timelineRate, 1 << 20);
+            timelineSampler->start();
+        } catch (const std::exception &exception) {
+            std::cerr << "Energy timeline disabled: " << exception.what() << "\n";
+        }
+    }
+
     metaResult["start"] = metaprofiler.startTime();
+    metaResult["core_types"] = cpuprofiler.getTopology().toJson();
     // Launch the benchmarking
     try {
         json cpuResult;
@@ -69,11 +93,25 @@ void runProfileRoutine(CLIOptions opts) {
 
         if constexpr (!SKIP_CPU_PROFILING) {
             phandler.setOrCreate("cpu", cpuResult);
+
+            json coreTypeResults = cpuprofiler.getCoreTypeProfiles();
+            if (!coreTypeResults.empty()) {
+                phandler.setOrCreate("cpu_types", coreTypeResults);
+            }
         }
 
         phandler.setOrCreate("syscalls", syscallResults);
         phandler.write(outputpath);
 
+        if (timelineSampler) {
+            timelineSampler->stop();
+
+            std::string timelinePath = opts.saveLocation + "/profile_timeline.json";
+            std::cout << "Writing " << timelinePath << "\n";
+            std::ofstream timelineFile(timelinePath);
+            timelineFile << timelineSampler->toJson().dump(4);
+        }
+
         std::cout << "Profiling finished!" << std::endl;
         delete[] outputpath;
     } catch(std::invalid_argument &ia) {
@@ -81,32 +119,31 @@ void runProfileRoutine(CLIOptions opts) {
     }
 }
 
-void runAnalysisRoutine(CLIOptions opts) {
-    llvm::LLVMContext context;
-    llvm::SMDiagnostic error;
-    ResultRegistry resultRegistry;
-
-    auto moduleOriginal = llvm::parseIRFile(opts.programPath, error, context);
-    if (!moduleOriginal) {
-        llvm::errs() << "Failed to parse IR file: " << opts.programPath << "\n";
-        return;
-    }
-
+/**
+ * Run the loop bound analysis on the given module and the feasibility analysis on a canonicalized copy of it
+ * @param module Module to analyze
+ * @param resultRegistry Registry the results are stored in
+ */
+void runPhasarAnalyses(llvm::Module &module, ResultRegistry &resultRegistry) {
     // Separate copy for the optimized/canonicalized pipeline.
-    auto moduleOptimized = llvm::CloneModule(*moduleOriginal);
+    auto moduleOptimized = llvm::CloneModule(module);
 
     // Run lobbound on the original module as we need load/store
     auto startLB = std::chrono::high_resolution_clock::now();
+    SelfEnergyMeter::getInstance().beginPhase("loopbound");
     PhasarHandlerPass loopBoundPhasarHandler(true, false);
-    loopBoundPhasarHandler.runOnModule(*moduleOriginal);
+    loopBoundPhasarHandler.runOnModule(module);
     auto loopboundResults = loopBoundPhasarHandler.queryLoopBounds();
     resultRegistry.storeLoopBoundResults(loopboundResults);
+    SelfEnergyMeter::getInstance().endPhase();
     auto endLB = std::chrono::high_resolution_clock::now();
 
     auto durationLB = std::chrono::duration_cast<std::chrono::microseconds>(endLB - startLB);
     std::cout << "Loopbound took: " << durationLB.count() << " µs\n";
+    MetricsRegistry::getInstance().recordPhaseDuration("loopbound", durationLB);
 
     {
+        SelfEnergyPhase selfEnergyPhase("canonicalization");
         llvm::PassBuilder passBuilder;
         llvm::LoopAnalysisManager loopAnalysisManager;
         llvm::FunctionAnalysisManager functionAnalysisManager;
@@ -139,16 +176,94 @@ void runAnalysisRoutine(CLIOptions opts) {
     // Run feasibility on the optimized module
     if (ConfigParser::getAnalysisConfiguration().feasibilityEnabled) {
         auto startFeas = std::chrono::high_resolution_clock::now();
+        SelfEnergyMeter::getInstance().beginPhase("feasibility");
         PhasarHandlerPass feasibilityPhasarHandler(false, true);
         feasibilityPhasarHandler.runOnModule(*moduleOptimized);
         auto feasibilityResults = feasibilityPhasarHandler.queryFeasibilty();
         resultRegistry.storeFeasibilityResults(feasibilityResults);
+        SelfEnergyMeter::getInstance().endPhase();
         auto endFeas = std::chrono::high_resolution_clock::now();
 
         auto durationFeas = std::chrono::duration_cast<std::chrono::microseconds>(endFeas - startFeas);
         std::cout << "Feasibility took: " << durationFeas.count() << " µs\n";
+        MetricsRegistry::getInstance().recordPhaseDuration("feasibility", durationFeas);
+    }
+}
+
+/**
+ * Analyze the module shard by shard in worker processes and write the merged output
+ * @param opts Options of the analysis
+ * @param module Module to analyze
+ */
+void runShardedAnalysisRoutine(CLIOptions opts, llvm::Module &module) {
+    const auto analysisConfiguration = ConfigParser::getAnalysisConfiguration();
+
+    // The workers run the ILP analyses directly, so the profile is read here instead of by the Energy pass
+    if (llvm::sys::fs::exists(opts.profilePath) && !llvm::sys::fs::is_directory(opts.profilePath)) {
+        ProfileHandler::get_instance().read(opts.profilePath);
+    }
+
+    auto worker = [analysisType = analysisConfiguration.analysisType](llvm::Module &shardModule,
+                                                                      ShardAttempt attempt) -> json {
+        ResultRegistry resultRegistry;
+        if (attempt == ShardAttempt::FULL) {
+            runPhasarAnalyses(shardModule, resultRegistry);
+        }
+
+        llvm::PassBuilder passBuilder;
+        llvm::LoopAnalysisManager loopAnalysisManager;
+        llvm::FunctionAnalysisManager functionAnalysisManager;
+        llvm::CGSCCAnalysisManager cGSCCAnalysisManager;
+        llvm::ModuleAnalysisManager moduleAnalysisManager;
+
+        passBuilder.registerModuleAnalyses(moduleAnalysisManager);
+        passBuilder.registerCGSCCAnalyses(cGSCCAnalysisManager);
+        passBuilder.registerFunctionAnalyses(functionAnalysisManager);
+        passBuilder.registerLoopAnalyses(loopAnalysisManager);
+        passBuilder.crossRegisterProxies(loopAnalysisManager,
+                                         functionAnalysisManager,
+                                         cGSCCAnalysisManager,
+                                         moduleAnalysisManager);
+
+        if (analysisType == AnalysisType::CLUSTERED) {
+            return PassUtil::runClusteredOnModule(shardModule, functionAnalysisManager, resultRegistry);
+        }
+        return PassUtil::runMonolithicOnModule(shardModule, functionAnalysisManager, resultRegistry);
+    };
+
+    auto output = ShardedAnalysis::run(module, analysisConfiguration.shardingconfig, worker);
+    auto filename = PassUtil::extractFileNameWithoutExtension(module.getName().str());
+
+    if (analysisConfiguration.analysisOutputMode == AnalysisOutputMode::ELB) {
+        OutputHandler::writeELBOutput(filename, Energy::extractFunctionEnergyMap(output));
+    } else {
+        OutputHandler::writeJsonOutput(filename, output);
+    }
+}
+
+void runAnalysisRoutine(CLIOptions opts) {
+    llvm::LLVMContext context;
+    llvm::SMDiagnostic error;
+    ResultRegistry resultRegistry;
+
+    auto moduleOriginal = llvm::parseIRFile(opts.programPath, error, context);
+    if (!moduleOriginal) {
+        llvm::errs() << "Failed to parse IR file: " << opts.programPath << "\n";
+        return;
     }
 
+    const auto analysisConfiguration = ConfigParser::getAnalysisConfiguration();
+    if (analysisConfiguration.shardingconfig.enabled) {
+        if (analysisConfiguration.analysisType == AnalysisType::MONOLITHIC ||
+            analysisConfiguration.analysisType == AnalysisType::CLUSTERED) {
+            runShardedAnalysisRoutine(opts, *moduleOriginal);
+            return;
+        }
+
+        std::cerr << "Sharding supports the monolithic and clustered analysis only, analyzing in one process\n";
+    }
+
+    runPhasarAnalyses(*moduleOriginal, resultRegistry);
 
     // Run energy on the original module
     {
@@ -174,6 +289,65 @@ void runAnalysisRoutine(CLIOptions opts) {
     }
 }
 
+void runRecostRoutine(CLIOptions opts) {
+    // Only the profile, the ELBs and the snapshot are needed. The IR is not parsed again
+    ProfileHandler::get_instance().read(opts.profilePath);
+
+    for (const auto &elbfile : ConfigParser::getAnalysisConfiguration().elbfiles) {
+        ELBMapper::getInstance().deferMapping(elbfile);
+    }
+
+    auto snapshot = HLAC::HLACSnapshot::read(opts.snapshotPath);
+    if (!snapshot.has_value()) {
+        std::cerr << "Failed to read snapshot: " << opts.snapshotPath << "\n";
+        return;
+    }
+
+    auto output = OfflineAnalysis::run(snapshot.value(), SHOWTIMINGS);
+    auto filename = PassUtil::extractFileNameWithoutExtension(opts.snapshotPath) + "_offline";
+
+    if (ConfigParser::getAnalysisConfiguration().analysisOutputMode == AnalysisOutputMode::ELB) {
+        OutputHandler::writeELBOutput(filename, Energy::extractFunctionEnergyMap(output));
+    } else {
+        OutputHandler::writeJsonOutput(filename, output);
+    }
+}
+
+void writeMetrics() {
+    if (!ConfigParser::getAnalysisConfiguration().metricsEnabled) {
+        return;
+    }
+
+    auto &metrics = MetricsRegistry::getInstance();
+    metrics.collectProcessMetrics();
+
+    const std::filesystem::path outputDirectoryPath(ConfigParser::getAnalysisConfiguration().outputDirectory);
+    std::filesystem::create_directories(outputDirectoryPath);
+
+    std::ofstream openMetricsFile(outputDirectoryPath / "metrics.prom");
+    if (!openMetricsFile.is_open()) {
+        std::cerr << "Failed to write metrics to " << outputDirectoryPath.string() << "\n";
+        return;
+    }
+    metrics.writeOpenMetrics(openMetricsFile);
+
+    OutputHandler::writeJsonOutput("metrics", metrics.toJson());
+}
+
+void writeSelfEnergy() {
+    auto &selfEnergyMeter = SelfEnergyMeter::getInstance();
+    if (!selfEnergyMeter.isEnabled()) {
+        return;
+    }
+
+    selfEnergyMeter.stop();
+    OutputHandler::writeJsonOutput("selfenergy", selfEnergyMeter.toJson());
+
+    auto timeline = selfEnergyMeter.timelineToJson();
+    if (!timeline.is_null()) {
+        OutputHandler::writeJsonOutput("selfenergy_timeline", timeline);
+    }
+}
 
 int main(int argc, char *argv[]) {
     std::string helpString = R"(Usage: spear <option> <arguments>
@@ -191,6 +365,12 @@ int main(int argc, char *argv[]) {
                    --program       Path to the program to analyze (path)
                    --config        Configuration file for the analysis (path)
 
+        recost     Re-run the ILP stage on a HLAC snapshot written by analyze
+                   (analysis.writeSnapshot) without parsing the program again:
+                   --profile       Path to the profile to use for the analysis (path)
+                   --snapshot      Path to the snapshot to re-cost (path)
+                   --config        Configuration file for the analysis (path)
+
     )";
 
     if (argc > 1) {
@@ -232,7 +412,15 @@ int main(int argc, char *argv[]) {
                     if (hasProfilePath && hasProgramPath) {
                         // std::cout << "Options valid" << std::endl;
                         Logger::getInstance().setLogLevel(LOGLEVEL::ERROR);
+                        ProgressReporter::getInstance().setEnabled(
+                            ConfigParser::getAnalysisConfiguration().progressEnabled);
+                        ProfileHandler::get_instance().selectCoreType(
+                            ConfigParser::getAnalysisConfiguration().coreType);
+                        SelfEnergyMeter::getInstance().configure(
+                            ConfigParser::getAnalysisConfiguration().selfenergyconfig);
                         runAnalysisRoutine(opts);
+                        writeSelfEnergy();
+                        writeMetrics();
                         return 0;
                     } else {
                         std::string profileHelpMsg =
@@ -257,6 +445,48 @@ int main(int argc, char *argv[]) {
                             std::cerr << "Error: Program path is missing. Please specify --program <path>\n";
                         }
 
+                        std::cerr << std::endl;
+                        return 1;
+                    }
+                } else if (opts.operation == Operation::RECOST) {
+                    bool hasProfilePath = !opts.profilePath.empty();
+                    bool hasSnapshotPath = !opts.snapshotPath.empty();
+
+                    if (hasProfilePath && hasSnapshotPath) {
+                        Logger::getInstance().setLogLevel(LOGLEVEL::ERROR);
+                        ProgressReporter::getInstance().setEnabled(
+                            ConfigParser::getAnalysisConfiguration().progressEnabled);
+                        ProfileHandler::get_instance().selectCoreType(
+                            ConfigParser::getAnalysisConfiguration().coreType);
+                        SelfEnergyMeter::getInstance().configure(
+                            ConfigParser::getAnalysisConfiguration().selfenergyconfig);
+                        runRecostRoutine(opts);
+                        writeSelfEnergy();
+                        writeMetrics();
+                        return 0;
+                    } else {
+                        std::string recostHelpMsg =
+                        R"(Usage: spear recost <arguments>
+                        =================================
+                        Arguments:
+
+                            Re-costs a HLAC snapshot with the given profile. Further parameters are required:
+                                --profile        Path to the profile to use for the analysis (path)
+                                --snapshot       Path to the snapshot to re-cost (path)
+                                --config         Configuration file for the analysis (path)
+
+                        )";
+
+
+                        std::cerr << recostHelpMsg;
+
+                        if (!hasProfilePath) {
+                            std::cerr << "Error: Profile path is missing. Please specify --profile <path>\n";
+                        }
+                        if (!hasSnapshotPath) {
+                            std::cerr << "Error: Snapshot path is missing. Please specify --snapshot <path>\n";
+                        }
+
                         std::cerr << std::endl;
                         return 1;
                     }
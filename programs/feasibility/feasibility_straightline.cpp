@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+int scale(int value, int factor) {
+    return value * factor + 1;
+}
+
+int main() {
+    int length = 9;
+    int cheese = scale(length, 3);
+
+    length = scale(cheese, length);
+
+    return 0;
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+// Two nested loops with a branch in the inner body, expanded into a single function with 256 loop nests
+#define NEST(i)                                  \
+    for (int a = 0; a < 10; a++) {               \
+        for (int b = 0; b < 10; b++) {           \
+            if ((a + b + (i)) % 3 == 0) {        \
+                sum += a * b;                    \
+            } else {                             \
+                sum -= b;                        \
+            }                                    \
+        }                                        \
+    }
+
+#define NEST4(i) NEST(i) NEST((i) + 1) NEST((i) + 2) NEST((i) + 3)
+#define NEST16(i) NEST4(i) NEST4((i) + 4) NEST4((i) + 8) NEST4((i) + 12)
+#define NEST64(i) NEST16(i) NEST16((i) + 16) NEST16((i) + 32) NEST16((i) + 48)
+
+int main() {
+    int sum = 0;
+
+    NEST64(0)
+    NEST64(64)
+    NEST64(128)
+    NEST64(192)
+
+    return sum;
+}
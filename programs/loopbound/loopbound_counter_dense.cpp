@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+// 128 counting loops in one function, every check loads the bound that is stored once before the first loop
+#define COUNT                              \
+    for (int i = 0; i < length; i++) {    \
+        sum += i;                          \
+    }
+
+#define COUNT4 COUNT COUNT COUNT COUNT
+#define COUNT16 COUNT4 COUNT4 COUNT4 COUNT4
+#define COUNT64 COUNT16 COUNT16 COUNT16 COUNT16
+
+int main() {
+    int length = 100;
+    long sum = 0;
+
+    COUNT64
+    COUNT64
+
+    return sum > 0 ? 0 : 1;
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+int main(int argc, char *argv[]) {
+    int result = 0;
+
+    if (argc > 2) {
+        result = 3;
+    } else {
+        result = 4;
+    }
+
+    return result;
+}
@@ -0,0 +1,37 @@
+// Seed of util/perffuzzer: Deeply nested loops for the ILP and the loop bound analysis
+
+volatile int sink = 0;
+
+int fuzz0(int x) {
+    int v = x;
+    for (int i1 = 0; i1 < 10; i1++) {
+        v += i1;
+        for (int i2 = 0; i2 < 10; i2++) {
+            v += i2;
+            for (int i3 = 0; i3 < 10; i3++) {
+                v += i3;
+                for (int i4 = 0; i4 < 10; i4++) {
+                    v += i4;
+                    for (int i5 = 0; i5 < 10; i5++) {
+                        v += i5;
+                        for (int i6 = 0; i6 < 10; i6++) {
+                            v += i6;
+                            v = v * 3 + 0;
+                            v = v * 4 + 1;
+                            v = v * 5 + 2;
+                            v = v * 6 + 3;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return v;
+}
+
+int main() {
+    int result = 0;
+    result += fuzz0(sink);
+    sink = result;
+    return 0;
+}
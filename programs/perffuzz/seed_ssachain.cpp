@@ -0,0 +1,518 @@
+// Seed of util/perffuzzer: Long SSA chain with dependent branches for the feasibility analysis
+
+volatile int sink = 0;
+
+int fuzz0(int x) {
+    int v = x;
+    v = v * 3 + 0;
+    v = v * 4 + 1;
+    v = v * 5 + 2;
+    v = v * 6 + 3;
+    v = v * 7 + 4;
+    v = v * 3 + 5;
+    v = v * 4 + 6;
+    v = v * 5 + 7;
+    v = v * 6 + 8;
+    v = v * 7 + 9;
+    v = v * 3 + 10;
+    v = v * 4 + 11;
+    v = v * 5 + 12;
+    v = v * 6 + 13;
+    v = v * 7 + 14;
+    v = v * 3 + 15;
+    v = v * 4 + 16;
+    v = v * 5 + 17;
+    v = v * 6 + 18;
+    v = v * 7 + 19;
+    v = v * 3 + 20;
+    v = v * 4 + 21;
+    v = v * 5 + 22;
+    v = v * 6 + 23;
+    v = v * 7 + 24;
+    v = v * 3 + 25;
+    v = v * 4 + 26;
+    v = v * 5 + 27;
+    v = v * 6 + 28;
+    v = v * 7 + 29;
+    v = v * 3 + 30;
+    v = v * 4 + 31;
+    v = v * 5 + 32;
+    v = v * 6 + 33;
+    v = v * 7 + 34;
+    v = v * 3 + 35;
+    v = v * 4 + 36;
+    v = v * 5 + 37;
+    v = v * 6 + 38;
+    v = v * 7 + 39;
+    v = v * 3 + 40;
+    v = v * 4 + 41;
+    v = v * 5 + 42;
+    v = v * 6 + 43;
+    v = v * 7 + 44;
+    v = v * 3 + 45;
+    v = v * 4 + 46;
+    v = v * 5 + 47;
+    v = v * 6 + 48;
+    v = v * 7 + 49;
+    v = v * 3 + 50;
+    v = v * 4 + 51;
+    v = v * 5 + 52;
+    v = v * 6 + 53;
+    v = v * 7 + 54;
+    v = v * 3 + 55;
+    v = v * 4 + 56;
+    v = v * 5 + 57;
+    v = v * 6 + 58;
+    v = v * 7 + 59;
+    v = v * 3 + 60;
+    v = v * 4 + 61;
+    v = v * 5 + 62;
+    v = v * 6 + 63;
+    v = v * 7 + 64;
+    v = v * 3 + 65;
+    v = v * 4 + 66;
+    v = v * 5 + 67;
+    v = v * 6 + 68;
+    v = v * 7 + 69;
+    v = v * 3 + 70;
+    v = v * 4 + 71;
+    v = v * 5 + 72;
+    v = v * 6 + 73;
+    v = v * 7 + 74;
+    v = v * 3 + 75;
+    v = v * 4 + 76;
+    v = v * 5 + 77;
+    v = v * 6 + 78;
+    v = v * 7 + 79;
+    v = v * 3 + 80;
+    v = v * 4 + 81;
+    v = v * 5 + 82;
+    v = v * 6 + 83;
+    v = v * 7 + 84;
+    v = v * 3 + 85;
+    v = v * 4 + 86;
+    v = v * 5 + 87;
+    v = v * 6 + 88;
+    v = v * 7 + 89;
+    v = v * 3 + 90;
+    v = v * 4 + 91;
+    v = v * 5 + 92;
+    v = v * 6 + 93;
+    v = v * 7 + 94;
+    v = v * 3 + 95;
+    v = v * 4 + 96;
+    v = v * 5 + 97;
+    v = v * 6 + 98;
+    v = v * 7 + 99;
+    v = v * 3 + 100;
+    v = v * 4 + 101;
+    v = v * 5 + 102;
+    v = v * 6 + 103;
+    v = v * 7 + 104;
+    v = v * 3 + 105;
+    v = v * 4 + 106;
+    v = v * 5 + 107;
+    v = v * 6 + 108;
+    v = v * 7 + 109;
+    v = v * 3 + 110;
+    v = v * 4 + 111;
+    v = v * 5 + 112;
+    v = v * 6 + 113;
+    v = v * 7 + 114;
+    v = v * 3 + 115;
+    v = v * 4 + 116;
+    v = v * 5 + 117;
+    v = v * 6 + 118;
+    v = v * 7 + 119;
+    v = v * 3 + 120;
+    v = v * 4 + 121;
+    v = v * 5 + 122;
+    v = v * 6 + 123;
+    v = v * 7 + 124;
+    v = v * 3 + 125;
+    v = v * 4 + 126;
+    v = v * 5 + 127;
+    v = v * 6 + 128;
+    v = v * 7 + 129;
+    v = v * 3 + 130;
+    v = v * 4 + 131;
+    v = v * 5 + 132;
+    v = v * 6 + 133;
+    v = v * 7 + 134;
+    v = v * 3 + 135;
+    v = v * 4 + 136;
+    v = v * 5 + 137;
+    v = v * 6 + 138;
+    v = v * 7 + 139;
+    v = v * 3 + 140;
+    v = v * 4 + 141;
+    v = v * 5 + 142;
+    v = v * 6 + 143;
+    v = v * 7 + 144;
+    v = v * 3 + 145;
+    v = v * 4 + 146;
+    v = v * 5 + 147;
+    v = v * 6 + 148;
+    v = v * 7 + 149;
+    v = v * 3 + 150;
+    v = v * 4 + 151;
+    v = v * 5 + 152;
+    v = v * 6 + 153;
+    v = v * 7 + 154;
+    v = v * 3 + 155;
+    v = v * 4 + 156;
+    v = v * 5 + 157;
+    v = v * 6 + 158;
+    v = v * 7 + 159;
+    v = v * 3 + 160;
+    v = v * 4 + 161;
+    v = v * 5 + 162;
+    v = v * 6 + 163;
+    v = v * 7 + 164;
+    v = v * 3 + 165;
+    v = v * 4 + 166;
+    v = v * 5 + 167;
+    v = v * 6 + 168;
+    v = v * 7 + 169;
+    v = v * 3 + 170;
+    v = v * 4 + 171;
+    v = v * 5 + 172;
+    v = v * 6 + 173;
+    v = v * 7 + 174;
+    v = v * 3 + 175;
+    v = v * 4 + 176;
+    v = v * 5 + 177;
+    v = v * 6 + 178;
+    v = v * 7 + 179;
+    v = v * 3 + 180;
+    v = v * 4 + 181;
+    v = v * 5 + 182;
+    v = v * 6 + 183;
+    v = v * 7 + 184;
+    v = v * 3 + 185;
+    v = v * 4 + 186;
+    v = v * 5 + 187;
+    v = v * 6 + 188;
+    v = v * 7 + 189;
+    v = v * 3 + 190;
+    v = v * 4 + 191;
+    v = v * 5 + 192;
+    v = v * 6 + 193;
+    v = v * 7 + 194;
+    v = v * 3 + 195;
+    v = v * 4 + 196;
+    v = v * 5 + 197;
+    v = v * 6 + 198;
+    v = v * 7 + 199;
+    if (v % 3 == 2) {
+        v = v * 3 + 0;
+        v = v * 4 + 1;
+        v = v * 5 + 2;
+        v = v * 6 + 3;
+        v = v * 7 + 4;
+        v = v * 3 + 5;
+        v = v * 4 + 6;
+        v = v * 5 + 7;
+        v = v * 6 + 8;
+        v = v * 7 + 9;
+        v = v * 3 + 10;
+        v = v * 4 + 11;
+        v = v * 5 + 12;
+        v = v * 6 + 13;
+        v = v * 7 + 14;
+        v = v * 3 + 15;
+        v = v * 4 + 16;
+        v = v * 5 + 17;
+        v = v * 6 + 18;
+        v = v * 7 + 19;
+        v = v * 3 + 20;
+        v = v * 4 + 21;
+        v = v * 5 + 22;
+        v = v * 6 + 23;
+        v = v * 7 + 24;
+        v = v * 3 + 25;
+        v = v * 4 + 26;
+        v = v * 5 + 27;
+        v = v * 6 + 28;
+        v = v * 7 + 29;
+        v = v * 3 + 30;
+        v = v * 4 + 31;
+        v = v * 5 + 32;
+        v = v * 6 + 33;
+        v = v * 7 + 34;
+        v = v * 3 + 35;
+        v = v * 4 + 36;
+        v = v * 5 + 37;
+        v = v * 6 + 38;
+        v = v * 7 + 39;
+        v = v * 3 + 40;
+        v = v * 4 + 41;
+        v = v * 5 + 42;
+        v = v * 6 + 43;
+        v = v * 7 + 44;
+        v = v * 3 + 45;
+        v = v * 4 + 46;
+        v = v * 5 + 47;
+        v = v * 6 + 48;
+        v = v * 7 + 49;
+    } else {
+        v = v * 3 + 0;
+        v = v * 4 + 1;
+        v = v * 5 + 2;
+        v = v * 6 + 3;
+        v = v * 7 + 4;
+        v = v * 3 + 5;
+        v = v * 4 + 6;
+        v = v * 5 + 7;
+        v = v * 6 + 8;
+        v = v * 7 + 9;
+        v = v * 3 + 10;
+        v = v * 4 + 11;
+        v = v * 5 + 12;
+        v = v * 6 + 13;
+        v = v * 7 + 14;
+        v = v * 3 + 15;
+        v = v * 4 + 16;
+        v = v * 5 + 17;
+        v = v * 6 + 18;
+        v = v * 7 + 19;
+        v = v * 3 + 20;
+        v = v * 4 + 21;
+        v = v * 5 + 22;
+        v = v * 6 + 23;
+        v = v * 7 + 24;
+        v = v * 3 + 25;
+        v = v * 4 + 26;
+        v = v * 5 + 27;
+        v = v * 6 + 28;
+        v = v * 7 + 29;
+        v = v * 3 + 30;
+        v = v * 4 + 31;
+        v = v * 5 + 32;
+        v = v * 6 + 33;
+        v = v * 7 + 34;
+        v = v * 3 + 35;
+        v = v * 4 + 36;
+        v = v * 5 + 37;
+        v = v * 6 + 38;
+        v = v * 7 + 39;
+        v = v * 3 + 40;
+        v = v * 4 + 41;
+        v = v * 5 + 42;
+        v = v * 6 + 43;
+        v = v * 7 + 44;
+        v = v * 3 + 45;
+        v = v * 4 + 46;
+        v = v * 5 + 47;
+        v = v * 6 + 48;
+        v = v * 7 + 49;
+    }
+    v = v * 3 + 0;
+    v = v * 4 + 1;
+    v = v * 5 + 2;
+    v = v * 6 + 3;
+    v = v * 7 + 4;
+    v = v * 3 + 5;
+    v = v * 4 + 6;
+    v = v * 5 + 7;
+    v = v * 6 + 8;
+    v = v * 7 + 9;
+    v = v * 3 + 10;
+    v = v * 4 + 11;
+    v = v * 5 + 12;
+    v = v * 6 + 13;
+    v = v * 7 + 14;
+    v = v * 3 + 15;
+    v = v * 4 + 16;
+    v = v * 5 + 17;
+    v = v * 6 + 18;
+    v = v * 7 + 19;
+    v = v * 3 + 20;
+    v = v * 4 + 21;
+    v = v * 5 + 22;
+    v = v * 6 + 23;
+    v = v * 7 + 24;
+    v = v * 3 + 25;
+    v = v * 4 + 26;
+    v = v * 5 + 27;
+    v = v * 6 + 28;
+    v = v * 7 + 29;
+    v = v * 3 + 30;
+    v = v * 4 + 31;
+    v = v * 5 + 32;
+    v = v * 6 + 33;
+    v = v * 7 + 34;
+    v = v * 3 + 35;
+    v = v * 4 + 36;
+    v = v * 5 + 37;
+    v = v * 6 + 38;
+    v = v * 7 + 39;
+    v = v * 3 + 40;
+    v = v * 4 + 41;
+    v = v * 5 + 42;
+    v = v * 6 + 43;
+    v = v * 7 + 44;
+    v = v * 3 + 45;
+    v = v * 4 + 46;
+    v = v * 5 + 47;
+    v = v * 6 + 48;
+    v = v * 7 + 49;
+    v = v * 3 + 50;
+    v = v * 4 + 51;
+    v = v * 5 + 52;
+    v = v * 6 + 53;
+    v = v * 7 + 54;
+    v = v * 3 + 55;
+    v = v * 4 + 56;
+    v = v * 5 + 57;
+    v = v * 6 + 58;
+    v = v * 7 + 59;
+    v = v * 3 + 60;
+    v = v * 4 + 61;
+    v = v * 5 + 62;
+    v = v * 6 + 63;
+    v = v * 7 + 64;
+    v = v * 3 + 65;
+    v = v * 4 + 66;
+    v = v * 5 + 67;
+    v = v * 6 + 68;
+    v = v * 7 + 69;
+    v = v * 3 + 70;
+    v = v * 4 + 71;
+    v = v * 5 + 72;
+    v = v * 6 + 73;
+    v = v * 7 + 74;
+    v = v * 3 + 75;
+    v = v * 4 + 76;
+    v = v * 5 + 77;
+    v = v * 6 + 78;
+    v = v * 7 + 79;
+    v = v * 3 + 80;
+    v = v * 4 + 81;
+    v = v * 5 + 82;
+    v = v * 6 + 83;
+    v = v * 7 + 84;
+    v = v * 3 + 85;
+    v = v * 4 + 86;
+    v = v * 5 + 87;
+    v = v * 6 + 88;
+    v = v * 7 + 89;
+    v = v * 3 + 90;
+    v = v * 4 + 91;
+    v = v * 5 + 92;
+    v = v * 6 + 93;
+    v = v * 7 + 94;
+    v = v * 3 + 95;
+    v = v * 4 + 96;
+    v = v * 5 + 97;
+    v = v * 6 + 98;
+    v = v * 7 + 99;
+    v = v * 3 + 100;
+    v = v * 4 + 101;
+    v = v * 5 + 102;
+    v = v * 6 + 103;
+    v = v * 7 + 104;
+    v = v * 3 + 105;
+    v = v * 4 + 106;
+    v = v * 5 + 107;
+    v = v * 6 + 108;
+    v = v * 7 + 109;
+    v = v * 3 + 110;
+    v = v * 4 + 111;
+    v = v * 5 + 112;
+    v = v * 6 + 113;
+    v = v * 7 + 114;
+    v = v * 3 + 115;
+    v = v * 4 + 116;
+    v = v * 5 + 117;
+    v = v * 6 + 118;
+    v = v * 7 + 119;
+    v = v * 3 + 120;
+    v = v * 4 + 121;
+    v = v * 5 + 122;
+    v = v * 6 + 123;
+    v = v * 7 + 124;
+    v = v * 3 + 125;
+    v = v * 4 + 126;
+    v = v * 5 + 127;
+    v = v * 6 + 128;
+    v = v * 7 + 129;
+    v = v * 3 + 130;
+    v = v * 4 + 131;
+    v = v * 5 + 132;
+    v = v * 6 + 133;
+    v = v * 7 + 134;
+    v = v * 3 + 135;
+    v = v * 4 + 136;
+    v = v * 5 + 137;
+    v = v * 6 + 138;
+    v = v * 7 + 139;
+    v = v * 3 + 140;
+    v = v * 4 + 141;
+    v = v * 5 + 142;
+    v = v * 6 + 143;
+    v = v * 7 + 144;
+    v = v * 3 + 145;
+    v = v * 4 + 146;
+    v = v * 5 + 147;
+    v = v * 6 + 148;
+    v = v * 7 + 149;
+    v = v * 3 + 150;
+    v = v * 4 + 151;
+    v = v * 5 + 152;
+    v = v * 6 + 153;
+    v = v * 7 + 154;
+    v = v * 3 + 155;
+    v = v * 4 + 156;
+    v = v * 5 + 157;
+    v = v * 6 + 158;
+    v = v * 7 + 159;
+    v = v * 3 + 160;
+    v = v * 4 + 161;
+    v = v * 5 + 162;
+    v = v * 6 + 163;
+    v = v * 7 + 164;
+    v = v * 3 + 165;
+    v = v * 4 + 166;
+    v = v * 5 + 167;
+    v = v * 6 + 168;
+    v = v * 7 + 169;
+    v = v * 3 + 170;
+    v = v * 4 + 171;
+    v = v * 5 + 172;
+    v = v * 6 + 173;
+    v = v * 7 + 174;
+    v = v * 3 + 175;
+    v = v * 4 + 176;
+    v = v * 5 + 177;
+    v = v * 6 + 178;
+    v = v * 7 + 179;
+    v = v * 3 + 180;
+    v = v * 4 + 181;
+    v = v * 5 + 182;
+    v = v * 6 + 183;
+    v = v * 7 + 184;
+    v = v * 3 + 185;
+    v = v * 4 + 186;
+    v = v * 5 + 187;
+    v = v * 6 + 188;
+    v = v * 7 + 189;
+    v = v * 3 + 190;
+    v = v * 4 + 191;
+    v = v * 5 + 192;
+    v = v * 6 + 193;
+    v = v * 7 + 194;
+    v = v * 3 + 195;
+    v = v * 4 + 196;
+    v = v * 5 + 197;
+    v = v * 6 + 198;
+    v = v * 7 + 199;
+    return v;
+}
+
+int main() {
+    int result = 0;
+    result += fuzz0(sink);
+    sink = result;
+    return 0;
+}
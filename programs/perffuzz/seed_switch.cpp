@@ -0,0 +1,530 @@
+// Seed of util/perffuzzer: Huge switch for Phasar
+
+volatile int sink = 0;
+
+int fuzz0(int x) {
+    int v = x;
+    switch (v % 512) {
+        case 0: v += 1; sink = v; break;
+        case 1: v += 8; sink = v; break;
+        case 2: v += 15; sink = v; break;
+        case 3: v += 22; sink = v; break;
+        case 4: v += 29; sink = v; break;
+        case 5: v += 36; sink = v; break;
+        case 6: v += 43; sink = v; break;
+        case 7: v += 50; sink = v; break;
+        case 8: v += 57; sink = v; break;
+        case 9: v += 64; sink = v; break;
+        case 10: v += 71; sink = v; break;
+        case 11: v += 78; sink = v; break;
+        case 12: v += 85; sink = v; break;
+        case 13: v += 92; sink = v; break;
+        case 14: v += 99; sink = v; break;
+        case 15: v += 106; sink = v; break;
+        case 16: v += 113; sink = v; break;
+        case 17: v += 120; sink = v; break;
+        case 18: v += 127; sink = v; break;
+        case 19: v += 134; sink = v; break;
+        case 20: v += 141; sink = v; break;
+        case 21: v += 148; sink = v; break;
+        case 22: v += 155; sink = v; break;
+        case 23: v += 162; sink = v; break;
+        case 24: v += 169; sink = v; break;
+        case 25: v += 176; sink = v; break;
+        case 26: v += 183; sink = v; break;
+        case 27: v += 190; sink = v; break;
+        case 28: v += 197; sink = v; break;
+        case 29: v += 204; sink = v; break;
+        case 30: v += 211; sink = v; break;
+        case 31: v += 218; sink = v; break;
+        case 32: v += 225; sink = v; break;
+        case 33: v += 232; sink = v; break;
+        case 34: v += 239; sink = v; break;
+        case 35: v += 246; sink = v; break;
+        case 36: v += 253; sink = v; break;
+        case 37: v += 260; sink = v; break;
+        case 38: v += 267; sink = v; break;
+        case 39: v += 274; sink = v; break;
+        case 40: v += 281; sink = v; break;
+        case 41: v += 288; sink = v; break;
+        case 42: v += 295; sink = v; break;
+        case 43: v += 302; sink = v; break;
+        case 44: v += 309; sink = v; break;
+        case 45: v += 316; sink = v; break;
+        case 46: v += 323; sink = v; break;
+        case 47: v += 330; sink = v; break;
+        case 48: v += 337; sink = v; break;
+        case 49: v += 344; sink = v; break;
+        case 50: v += 351; sink = v; break;
+        case 51: v += 358; sink = v; break;
+        case 52: v += 365; sink = v; break;
+        case 53: v += 372; sink = v; break;
+        case 54: v += 379; sink = v; break;
+        case 55: v += 386; sink = v; break;
+        case 56: v += 393; sink = v; break;
+        case 57: v += 400; sink = v; break;
+        case 58: v += 407; sink = v; break;
+        case 59: v += 414; sink = v; break;
+        case 60: v += 421; sink = v; break;
+        case 61: v += 428; sink = v; break;
+        case 62: v += 435; sink = v; break;
+        case 63: v += 442; sink = v; break;
+        case 64: v += 449; sink = v; break;
+        case 65: v += 456; sink = v; break;
+        case 66: v += 463; sink = v; break;
+        case 67: v += 470; sink = v; break;
+        case 68: v += 477; sink = v; break;
+        case 69: v += 484; sink = v; break;
+        case 70: v += 491; sink = v; break;
+        case 71: v += 498; sink = v; break;
+        case 72: v += 505; sink = v; break;
+        case 73: v += 512; sink = v; break;
+        case 74: v += 519; sink = v; break;
+        case 75: v += 526; sink = v; break;
+        case 76: v += 533; sink = v; break;
+        case 77: v += 540; sink = v; break;
+        case 78: v += 547; sink = v; break;
+        case 79: v += 554; sink = v; break;
+        case 80: v += 561; sink = v; break;
+        case 81: v += 568; sink = v; break;
+        case 82: v += 575; sink = v; break;
+        case 83: v += 582; sink = v; break;
+        case 84: v += 589; sink = v; break;
+        case 85: v += 596; sink = v; break;
+        case 86: v += 603; sink = v; break;
+        case 87: v += 610; sink = v; break;
+        case 88: v += 617; sink = v; break;
+        case 89: v += 624; sink = v; break;
+        case 90: v += 631; sink = v; break;
+        case 91: v += 638; sink = v; break;
+        case 92: v += 645; sink = v; break;
+        case 93: v += 652; sink = v; break;
+        case 94: v += 659; sink = v; break;
+        case 95: v += 666; sink = v; break;
+        case 96: v += 673; sink = v; break;
+        case 97: v += 680; sink = v; break;
+        case 98: v += 687; sink = v; break;
+        case 99: v += 694; sink = v; break;
+        case 100: v += 701; sink = v; break;
+        case 101: v += 708; sink = v; break;
+        case 102: v += 715; sink = v; break;
+        case 103: v += 722; sink = v; break;
+        case 104: v += 729; sink = v; break;
+        case 105: v += 736; sink = v; break;
+        case 106: v += 743; sink = v; break;
+        case 107: v += 750; sink = v; break;
+        case 108: v += 757; sink = v; break;
+        case 109: v += 764; sink = v; break;
+        case 110: v += 771; sink = v; break;
+        case 111: v += 778; sink = v; break;
+        case 112: v += 785; sink = v; break;
+        case 113: v += 792; sink = v; break;
+        case 114: v += 799; sink = v; break;
+        case 115: v += 806; sink = v; break;
+        case 116: v += 813; sink = v; break;
+        case 117: v += 820; sink = v; break;
+        case 118: v += 827; sink = v; break;
+        case 119: v += 834; sink = v; break;
+        case 120: v += 841; sink = v; break;
+        case 121: v += 848; sink = v; break;
+        case 122: v += 855; sink = v; break;
+        case 123: v += 862; sink = v; break;
+        case 124: v += 869; sink = v; break;
+        case 125: v += 876; sink = v; break;
+        case 126: v += 883; sink = v; break;
+        case 127: v += 890; sink = v; break;
+        case 128: v += 897; sink = v; break;
+        case 129: v += 904; sink = v; break;
+        case 130: v += 911; sink = v; break;
+        case 131: v += 918; sink = v; break;
+        case 132: v += 925; sink = v; break;
+        case 133: v += 932; sink = v; break;
+        case 134: v += 939; sink = v; break;
+        case 135: v += 946; sink = v; break;
+        case 136: v += 953; sink = v; break;
+        case 137: v += 960; sink = v; break;
+        case 138: v += 967; sink = v; break;
+        case 139: v += 974; sink = v; break;
+        case 140: v += 981; sink = v; break;
+        case 141: v += 988; sink = v; break;
+        case 142: v += 995; sink = v; break;
+        case 143: v += 1002; sink = v; break;
+        case 144: v += 1009; sink = v; break;
+        case 145: v += 1016; sink = v; break;
+        case 146: v += 1023; sink = v; break;
+        case 147: v += 1030; sink = v; break;
+        case 148: v += 1037; sink = v; break;
+        case 149: v += 1044; sink = v; break;
+        case 150: v += 1051; sink = v; break;
+        case 151: v += 1058; sink = v; break;
+        case 152: v += 1065; sink = v; break;
+        case 153: v += 1072; sink = v; break;
+        case 154: v += 1079; sink = v; break;
+        case 155: v += 1086; sink = v; break;
+        case 156: v += 1093; sink = v; break;
+        case 157: v += 1100; sink = v; break;
+        case 158: v += 1107; sink = v; break;
+        case 159: v += 1114; sink = v; break;
+        case 160: v += 1121; sink = v; break;
+        case 161: v += 1128; sink = v; break;
+        case 162: v += 1135; sink = v; break;
+        case 163: v += 1142; sink = v; break;
+        case 164: v += 1149; sink = v; break;
+        case 165: v += 1156; sink = v; break;
+        case 166: v += 1163; sink = v; break;
+        case 167: v += 1170; sink = v; break;
+        case 168: v += 1177; sink = v; break;
+        case 169: v += 1184; sink = v; break;
+        case 170: v += 1191; sink = v; break;
+        case 171: v += 1198; sink = v; break;
+        case 172: v += 1205; sink = v; break;
+        case 173: v += 1212; sink = v; break;
+        case 174: v += 1219; sink = v; break;
+        case 175: v += 1226; sink = v; break;
+        case 176: v += 1233; sink = v; break;
+        case 177: v += 1240; sink = v; break;
+        case 178: v += 1247; sink = v; break;
+        case 179: v += 1254; sink = v; break;
+        case 180: v += 1261; sink = v; break;
+        case 181: v += 1268; sink = v; break;
+        case 182: v += 1275; sink = v; break;
+        case 183: v += 1282; sink = v; break;
+        case 184: v += 1289; sink = v; break;
+        case 185: v += 1296; sink = v; break;
+        case 186: v += 1303; sink = v; break;
+        case 187: v += 1310; sink = v; break;
+        case 188: v += 1317; sink = v; break;
+        case 189: v += 1324; sink = v; break;
+        case 190: v += 1331; sink = v; break;
+        case 191: v += 1338; sink = v; break;
+        case 192: v += 1345; sink = v; break;
+        case 193: v += 1352; sink = v; break;
+        case 194: v += 1359; sink = v; break;
+        case 195: v += 1366; sink = v; break;
+        case 196: v += 1373; sink = v; break;
+        case 197: v += 1380; sink = v; break;
+        case 198: v += 1387; sink = v; break;
+        case 199: v += 1394; sink = v; break;
+        case 200: v += 1401; sink = v; break;
+        case 201: v += 1408; sink = v; break;
+        case 202: v += 1415; sink = v; break;
+        case 203: v += 1422; sink = v; break;
+        case 204: v += 1429; sink = v; break;
+        case 205: v += 1436; sink = v; break;
+        case 206: v += 1443; sink = v; break;
+        case 207: v += 1450; sink = v; break;
+        case 208: v += 1457; sink = v; break;
+        case 209: v += 1464; sink = v; break;
+        case 210: v += 1471; sink = v; break;
+        case 211: v += 1478; sink = v; break;
+        case 212: v += 1485; sink = v; break;
+        case 213: v += 1492; sink = v; break;
+        case 214: v += 1499; sink = v; break;
+        case 215: v += 1506; sink = v; break;
+        case 216: v += 1513; sink = v; break;
+        case 217: v += 1520; sink = v; break;
+        case 218: v += 1527; sink = v; break;
+        case 219: v += 1534; sink = v; break;
+        case 220: v += 1541; sink = v; break;
+        case 221: v += 1548; sink = v; break;
+        case 222: v += 1555; sink = v; break;
+        case 223: v += 1562; sink = v; break;
+        case 224: v += 1569; sink = v; break;
+        case 225: v += 1576; sink = v; break;
+        case 226: v += 1583; sink = v; break;
+        case 227: v += 1590; sink = v; break;
+        case 228: v += 1597; sink = v; break;
+        case 229: v += 1604; sink = v; break;
+        case 230: v += 1611; sink = v; break;
+        case 231: v += 1618; sink = v; break;
+        case 232: v += 1625; sink = v; break;
+        case 233: v += 1632; sink = v; break;
+        case 234: v += 1639; sink = v; break;
+        case 235: v += 1646; sink = v; break;
+        case 236: v += 1653; sink = v; break;
+        case 237: v += 1660; sink = v; break;
+        case 238: v += 1667; sink = v; break;
+        case 239: v += 1674; sink = v; break;
+        case 240: v += 1681; sink = v; break;
+        case 241: v += 1688; sink = v; break;
+        case 242: v += 1695; sink = v; break;
+        case 243: v += 1702; sink = v; break;
+        case 244: v += 1709; sink = v; break;
+        case 245: v += 1716; sink = v; break;
+        case 246: v += 1723; sink = v; break;
+        case 247: v += 1730; sink = v; break;
+        case 248: v += 1737; sink = v; break;
+        case 249: v += 1744; sink = v; break;
+        case 250: v += 1751; sink = v; break;
+        case 251: v += 1758; sink = v; break;
+        case 252: v += 1765; sink = v; break;
+        case 253: v += 1772; sink = v; break;
+        case 254: v += 1779; sink = v; break;
+        case 255: v += 1786; sink = v; break;
+        case 256: v += 1793; sink = v; break;
+        case 257: v += 1800; sink = v; break;
+        case 258: v += 1807; sink = v; break;
+        case 259: v += 1814; sink = v; break;
+        case 260: v += 1821; sink = v; break;
+        case 261: v += 1828; sink = v; break;
+        case 262: v += 1835; sink = v; break;
+        case 263: v += 1842; sink = v; break;
+        case 264: v += 1849; sink = v; break;
+        case 265: v += 1856; sink = v; break;
+        case 266: v += 1863; sink = v; break;
+        case 267: v += 1870; sink = v; break;
+        case 268: v += 1877; sink = v; break;
+        case 269: v += 1884; sink = v; break;
+        case 270: v += 1891; sink = v; break;
+        case 271: v += 1898; sink = v; break;
+        case 272: v += 1905; sink = v; break;
+        case 273: v += 1912; sink = v; break;
+        case 274: v += 1919; sink = v; break;
+        case 275: v += 1926; sink = v; break;
+        case 276: v += 1933; sink = v; break;
+        case 277: v += 1940; sink = v; break;
+        case 278: v += 1947; sink = v; break;
+        case 279: v += 1954; sink = v; break;
+        case 280: v += 1961; sink = v; break;
+        case 281: v += 1968; sink = v; break;
+        case 282: v += 1975; sink = v; break;
+        case 283: v += 1982; sink = v; break;
+        case 284: v += 1989; sink = v; break;
+        case 285: v += 1996; sink = v; break;
+        case 286: v += 2003; sink = v; break;
+        case 287: v += 2010; sink = v; break;
+        case 288: v += 2017; sink = v; break;
+        case 289: v += 2024; sink = v; break;
+        case 290: v += 2031; sink = v; break;
+        case 291: v += 2038; sink = v; break;
+        case 292: v += 2045; sink = v; break;
+        case 293: v += 2052; sink = v; break;
+        case 294: v += 2059; sink = v; break;
+        case 295: v += 2066; sink = v; break;
+        case 296: v += 2073; sink = v; break;
+        case 297: v += 2080; sink = v; break;
+        case 298: v += 2087; sink = v; break;
+        case 299: v += 2094; sink = v; break;
+        case 300: v += 2101; sink = v; break;
+        case 301: v += 2108; sink = v; break;
+        case 302: v += 2115; sink = v; break;
+        case 303: v += 2122; sink = v; break;
+        case 304: v += 2129; sink = v; break;
+        case 305: v += 2136; sink = v; break;
+        case 306: v += 2143; sink = v; break;
+        case 307: v += 2150; sink = v; break;
+        case 308: v += 2157; sink = v; break;
+        case 309: v += 2164; sink = v; break;
+        case 310: v += 2171; sink = v; break;
+        case 311: v += 2178; sink = v; break;
+        case 312: v += 2185; sink = v; break;
+        case 313: v += 2192; sink = v; break;
+        case 314: v += 2199; sink = v; break;
+        case 315: v += 2206; sink = v; break;
+        case 316: v += 2213; sink = v; break;
+        case 317: v += 2220; sink = v; break;
+        case 318: v += 2227; sink = v; break;
+        case 319: v += 2234; sink = v; break;
+        case 320: v += 2241; sink = v; break;
+        case 321: v += 2248; sink = v; break;
+        case 322: v += 2255; sink = v; break;
+        case 323: v += 2262; sink = v; break;
+        case 324: v += 2269; sink = v; break;
+        case 325: v += 2276; sink = v; break;
+        case 326: v += 2283; sink = v; break;
+        case 327: v += 2290; sink = v; break;
+        case 328: v += 2297; sink = v; break;
+        case 329: v += 2304; sink = v; break;
+        case 330: v += 2311; sink = v; break;
+        case 331: v += 2318; sink = v; break;
+        case 332: v += 2325; sink = v; break;
+        case 333: v += 2332; sink = v; break;
+        case 334: v += 2339; sink = v; break;
+        case 335: v += 2346; sink = v; break;
+        case 336: v += 2353; sink = v; break;
+        case 337: v += 2360; sink = v; break;
+        case 338: v += 2367; sink = v; break;
+        case 339: v += 2374; sink = v; break;
+        case 340: v += 2381; sink = v; break;
+        case 341: v += 2388; sink = v; break;
+        case 342: v += 2395; sink = v; break;
+        case 343: v += 2402; sink = v; break;
+        case 344: v += 2409; sink = v; break;
+        case 345: v += 2416; sink = v; break;
+        case 346: v += 2423; sink = v; break;
+        case 347: v += 2430; sink = v; break;
+        case 348: v += 2437; sink = v; break;
+        case 349: v += 2444; sink = v; break;
+        case 350: v += 2451; sink = v; break;
+        case 351: v += 2458; sink = v; break;
+        case 352: v += 2465; sink = v; break;
+        case 353: v += 2472; sink = v; break;
+        case 354: v += 2479; sink = v; break;
+        case 355: v += 2486; sink = v; break;
+        case 356: v += 2493; sink = v; break;
+        case 357: v += 2500; sink = v; break;
+        case 358: v += 2507; sink = v; break;
+        case 359: v += 2514; sink = v; break;
+        case 360: v += 2521; sink = v; break;
+        case 361: v += 2528; sink = v; break;
+        case 362: v += 2535; sink = v; break;
+        case 363: v += 2542; sink = v; break;
+        case 364: v += 2549; sink = v; break;
+        case 365: v += 2556; sink = v; break;
+        case 366: v += 2563; sink = v; break;
+        case 367: v += 2570; sink = v; break;
+        case 368: v += 2577; sink = v; break;
+        case 369: v += 2584; sink = v; break;
+        case 370: v += 2591; sink = v; break;
+        case 371: v += 2598; sink = v; break;
+        case 372: v += 2605; sink = v; break;
+        case 373: v += 2612; sink = v; break;
+        case 374: v += 2619; sink = v; break;
+        case 375: v += 2626; sink = v; break;
+        case 376: v += 2633; sink = v; break;
+        case 377: v += 2640; sink = v; break;
+        case 378: v += 2647; sink = v; break;
+        case 379: v += 2654; sink = v; break;
+        case 380: v += 2661; sink = v; break;
+        case 381: v += 2668; sink = v; break;
+        case 382: v += 2675; sink = v; break;
+        case 383: v += 2682; sink = v; break;
+        case 384: v += 2689; sink = v; break;
+        case 385: v += 2696; sink = v; break;
+        case 386: v += 2703; sink = v; break;
+        case 387: v += 2710; sink = v; break;
+        case 388: v += 2717; sink = v; break;
+        case 389: v += 2724; sink = v; break;
+        case 390: v += 2731; sink = v; break;
+        case 391: v += 2738; sink = v; break;
+        case 392: v += 2745; sink = v; break;
+        case 393: v += 2752; sink = v; break;
+        case 394: v += 2759; sink = v; break;
+        case 395: v += 2766; sink = v; break;
+        case 396: v += 2773; sink = v; break;
+        case 397: v += 2780; sink = v; break;
+        case 398: v += 2787; sink = v; break;
+        case 399: v += 2794; sink = v; break;
+        case 400: v += 2801; sink = v; break;
+        case 401: v += 2808; sink = v; break;
+        case 402: v += 2815; sink = v; break;
+        case 403: v += 2822; sink = v; break;
+        case 404: v += 2829; sink = v; break;
+        case 405: v += 2836; sink = v; break;
+        case 406: v += 2843; sink = v; break;
+        case 407: v += 2850; sink = v; break;
+        case 408: v += 2857; sink = v; break;
+        case 409: v += 2864; sink = v; break;
+        case 410: v += 2871; sink = v; break;
+        case 411: v += 2878; sink = v; break;
+        case 412: v += 2885; sink = v; break;
+        case 413: v += 2892; sink = v; break;
+        case 414: v += 2899; sink = v; break;
+        case 415: v += 2906; sink = v; break;
+        case 416: v += 2913; sink = v; break;
+        case 417: v += 2920; sink = v; break;
+        case 418: v += 2927; sink = v; break;
+        case 419: v += 2934; sink = v; break;
+        case 420: v += 2941; sink = v; break;
+        case 421: v += 2948; sink = v; break;
+        case 422: v += 2955; sink = v; break;
+        case 423: v += 2962; sink = v; break;
+        case 424: v += 2969; sink = v; break;
+        case 425: v += 2976; sink = v; break;
+        case 426: v += 2983; sink = v; break;
+        case 427: v += 2990; sink = v; break;
+        case 428: v += 2997; sink = v; break;
+        case 429: v += 3004; sink = v; break;
+        case 430: v += 3011; sink = v; break;
+        case 431: v += 3018; sink = v; break;
+        case 432: v += 3025; sink = v; break;
+        case 433: v += 3032; sink = v; break;
+        case 434: v += 3039; sink = v; break;
+        case 435: v += 3046; sink = v; break;
+        case 436: v += 3053; sink = v; break;
+        case 437: v += 3060; sink = v; break;
+        case 438: v += 3067; sink = v; break;
+        case 439: v += 3074; sink = v; break;
+        case 440: v += 3081; sink = v; break;
+        case 441: v += 3088; sink = v; break;
+        case 442: v += 3095; sink = v; break;
+        case 443: v += 3102; sink = v; break;
+        case 444: v += 3109; sink = v; break;
+        case 445: v += 3116; sink = v; break;
+        case 446: v += 3123; sink = v; break;
+        case 447: v += 3130; sink = v; break;
+        case 448: v += 3137; sink = v; break;
+        case 449: v += 3144; sink = v; break;
+        case 450: v += 3151; sink = v; break;
+        case 451: v += 3158; sink = v; break;
+        case 452: v += 3165; sink = v; break;
+        case 453: v += 3172; sink = v; break;
+        case 454: v += 3179; sink = v; break;
+        case 455: v += 3186; sink = v; break;
+        case 456: v += 3193; sink = v; break;
+        case 457: v += 3200; sink = v; break;
+        case 458: v += 3207; sink = v; break;
+        case 459: v += 3214; sink = v; break;
+        case 460: v += 3221; sink = v; break;
+        case 461: v += 3228; sink = v; break;
+        case 462: v += 3235; sink = v; break;
+        case 463: v += 3242; sink = v; break;
+        case 464: v += 3249; sink = v; break;
+        case 465: v += 3256; sink = v; break;
+        case 466: v += 3263; sink = v; break;
+        case 467: v += 3270; sink = v; break;
+        case 468: v += 3277; sink = v; break;
+        case 469: v += 3284; sink = v; break;
+        case 470: v += 3291; sink = v; break;
+        case 471: v += 3298; sink = v; break;
+        case 472: v += 3305; sink = v; break;
+        case 473: v += 3312; sink = v; break;
+        case 474: v += 3319; sink = v; break;
+        case 475: v += 3326; sink = v; break;
+        case 476: v += 3333; sink = v; break;
+        case 477: v += 3340; sink = v; break;
+        case 478: v += 3347; sink = v; break;
+        case 479: v += 3354; sink = v; break;
+        case 480: v += 3361; sink = v; break;
+        case 481: v += 3368; sink = v; break;
+        case 482: v += 3375; sink = v; break;
+        case 483: v += 3382; sink = v; break;
+        case 484: v += 3389; sink = v; break;
+        case 485: v += 3396; sink = v; break;
+        case 486: v += 3403; sink = v; break;
+        case 487: v += 3410; sink = v; break;
+        case 488: v += 3417; sink = v; break;
+        case 489: v += 3424; sink = v; break;
+        case 490: v += 3431; sink = v; break;
+        case 491: v += 3438; sink = v; break;
+        case 492: v += 3445; sink = v; break;
+        case 493: v += 3452; sink = v; break;
+        case 494: v += 3459; sink = v; break;
+        case 495: v += 3466; sink = v; break;
+        case 496: v += 3473; sink = v; break;
+        case 497: v += 3480; sink = v; break;
+        case 498: v += 3487; sink = v; break;
+        case 499: v += 3494; sink = v; break;
+        case 500: v += 3501; sink = v; break;
+        case 501: v += 3508; sink = v; break;
+        case 502: v += 3515; sink = v; break;
+        case 503: v += 3522; sink = v; break;
+        case 504: v += 3529; sink = v; break;
+        case 505: v += 3536; sink = v; break;
+        case 506: v += 3543; sink = v; break;
+        case 507: v += 3550; sink = v; break;
+        case 508: v += 3557; sink = v; break;
+        case 509: v += 3564; sink = v; break;
+        case 510: v += 3571; sink = v; break;
+        case 511: v += 3578; sink = v; break;
+        default: break;
+    }
+    return v;
+}
+
+int main() {
+    int result = 0;
+    result += fuzz0(sink);
+    sink = result;
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#ifndef SPEAR_OFFLINEANALYSIS_H
+#define SPEAR_OFFLINEANALYSIS_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "HLAC/HLACSnapshot.h"
+#include "ILP/ILPTypes.h"
+#include "nlohmann/json.hpp"
+
+/**
+ * OfflineAnalysis class
+ *
+ * Re-runs the monolithic ILP stage on a persisted HLACSnapshot. The structure, loop bounds and feasibility of the
+ * snapshot are reused as they are, only the energy of the nodes is recalculated from the currently loaded profile and
+ * ELB mappings. Neither LLVM nor Phasar are involved.
+ */
+class OfflineAnalysis {
+ public:
+    /**
+     * Re-cost the given snapshot
+     * @param snapshot Snapshot of an initialized HLAC graph
+     * @param showTimings Log the time needed for the re-costing
+     * @return JSON object in the format of the monolithic analysis
+     */
+    static nlohmann::json run(const HLAC::HLACSnapshot &snapshot, bool showTimings);
+
+ private:
+    /**
+     * Build the monolithic ILP of the given function, mirroring ILPBuilder::buildMonolithicILP
+     * @param snapshotFunction Function to build the ILP for
+     * @param instructionEnergy Energy of each opcode in HLACSnapshot::opcodeNames
+     * @param functionEnergyCache Energy of all functions analyzed so far
+     * @return Constructed model
+     */
+    static ILPModel buildModel(const HLAC::SnapshotFunction &snapshotFunction,
+                               const std::vector<double> &instructionEnergy,
+                               const std::map<std::string, double> &functionEnergyCache);
+
+    /**
+     * Describe the scopes of the given function as the flow graph ILPBuilder::appendFlowConstraints consumes
+     * @param snapshotFunction Function to describe
+     * @param scopeColumns First column of each scope
+     * @return Flow graph with the function body as scope 0
+     */
+    static ILPFlowGraph buildFlowGraph(const HLAC::SnapshotFunction &snapshotFunction,
+                                       const std::vector<int> &scopeColumns);
+
+    /**
+     * Calculate the energy of a single node under the currently loaded profile
+     * @param node Node to calculate the energy for
+     * @param isRecursive True if the function containing the node is recursive
+     * @param instructionEnergy Energy of each opcode in HLACSnapshot::opcodeNames
+     * @param functionEnergyCache Energy of all functions analyzed so far
+     * @return Energy of the node in Joule
+     */
+    static double getNodeEnergy(const HLAC::SnapshotNode &node, bool isRecursive,
+                                const std::vector<double> &instructionEnergy,
+                                const std::map<std::string, double> &functionEnergyCache);
+
+    /**
+     * Return the fallback energy of a function, including the program offset for main
+     * @param functionName Name of the function
+     * @return Fallback energy in Joule
+     */
+    static double getFallbackEnergy(const std::string &functionName);
+};
+
+#endif  // SPEAR_OFFLINEANALYSIS_H
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#ifndef SPEAR_SHARDEDANALYSIS_H
+#define SPEAR_SHARDEDANALYSIS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <llvm/IR/Module.h>
+#include <nlohmann/json.hpp>
+
+#include "configuration/configurationobjects.h"
+
+/**
+ * Describes how thoroughly a shard is analyzed. A shard that fails is retried on the next level
+ */
+enum class ShardAttempt {
+    FULL,       // Loop bound and feasibility analysis, then the ILP analysis
+    REDUCED,    // ILP analysis only, loops are bounded by the fallback values
+    FALLBACK    // No worker runs, every function is assigned the fallback energy of unknown functions
+};
+
+/**
+ * Set of whole call graph SCCs analyzed by one worker process
+ */
+struct Shard {
+    std::size_t index;
+
+    /**
+     * Names of the defined functions of the shard, callees first
+     */
+    std::vector<std::string> functions;
+
+    /**
+     * Estimated cost of the analysis, the instructions of all functions
+     */
+    uint64_t cost = 0;
+
+    /**
+     * Indices of the shards containing callees of this shard. Always smaller than the index of the shard
+     */
+    std::vector<std::size_t> dependencies;
+};
+
+/**
+ * ShardedAnalysis class
+ *
+ * Splits the call graph of a module into shards of roughly equal cost without splitting SCCs and analyzes every
+ * shard in a forked worker process, so a worker exhausting its memory or crashing does not take the run down. A
+ * worker only sees the functions of its shard, all other functions are declarations. The energies of the callees are
+ * taken from the ELB files written for the shards analyzed before. A failed shard is retried with a reduced analysis
+ * and finally assigned fallback energies, the other shards are not affected.
+ */
+class ShardedAnalysis {
+ public:
+    /**
+     * Analysis run by a worker on the module of its shard, returning the JSON output of the analysis
+     */
+    using Worker = std::function<nlohmann::json(llvm::Module &module, ShardAttempt attempt)>;
+
+    /**
+     * Split the call graph of the module into shards. SCCs are visited callees first and appended to the current
+     * shard as long as it stays below the average cost
+     * @param module Module to split
+     * @param shardCount Maximal amount of shards
+     * @return Shards in an order in which every shard follows the shards of its callees
+     */
+    static std::vector<Shard> partition(llvm::Module &module, std::size_t shardCount);
+
+    /**
+     * Clone the module keeping only the definitions of the functions of the shard
+     * @param module Module to clone
+     * @param shard Shard to keep
+     * @return Module in which all functions outside of the shard are declarations
+     */
+    static std::unique_ptr<llvm::Module> extractShard(const llvm::Module &module, const Shard &shard);
+
+    /**
+     * Analyze the module shard by shard and merge the outputs of the workers
+     * @param module Module to analyze
+     * @param configuration Sharding configuration
+     * @param worker Analysis to run on the module of every shard
+     * @return Output with the merged functions of all shards and the outcome of every shard under "shards"
+     */
+    static nlohmann::json run(llvm::Module &module, const ShardingConfiguration &configuration,
+                              const Worker &worker);
+
+    /**
+     * Analyze the module with the given shards. Shards that wait for each other are assigned the fallback energy
+     * @param module Module to analyze
+     * @param shards Shards of the module, the index of a shard is its position
+     * @param configuration Sharding configuration
+     * @param worker Analysis to run on the module of every shard
+     * @return Output with the merged functions of all shards and the outcome of every shard under "shards"
+     */
+    static nlohmann::json run(llvm::Module &module, const std::vector<Shard> &shards,
+                              const ShardingConfiguration &configuration, const Worker &worker);
+
+ private:
+    /**
+     * Entry point of a forked worker, never returns. Besides its output, the worker writes its metrics and self-energy
+     * measurements to shard_<index>.metrics.json, which the parent merges into its own
+     * @param module Module to analyze
+     * @param shard Shard of the worker
+     * @param attempt Level of the analysis
+     * @param summaries ELB files of the shards the shard depends on
+     * @param shardDirectory Directory the output of the worker is written to
+     * @param configuration Sharding configuration
+     * @param worker Analysis to run
+     */
+    [[noreturn]] static void runWorker(llvm::Module &module, const Shard &shard, ShardAttempt attempt,
+                                       const std::vector<std::string> &summaries,
+                                       const std::filesystem::path &shardDirectory,
+                                       const ShardingConfiguration &configuration, const Worker &worker);
+
+    /**
+     * Assign the fallback energy of unknown functions to all functions of the shard
+     * @param shard Shard that could not be analyzed
+     * @return Output in the format of the analyses
+     */
+    static nlohmann::json fallbackOutput(const Shard &shard);
+};
+
+#endif  // SPEAR_SHARDEDANALYSIS_H
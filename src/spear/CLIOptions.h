@@ -14,7 +14,8 @@
 enum class Operation {
     UNDEFINED,
     ANALYZE,
-    PROFILE
+    PROFILE,
+    RECOST
 };
 
 
@@ -53,6 +54,11 @@ class CLIOptions {
      */
     std::string codePath;
 
+    /**
+     * Path where the HLAC snapshot should be read from
+     */
+    std::string snapshotPath;
+
     /**
      * Construct a new CLIOptions object
      * 
@@ -78,5 +84,14 @@ class AnalysisOptions : public CLIOptions{
     AnalysisOptions(std::string profilePath, std::string configPath, std::string programPath);
 };
 
+/**
+ * Subclass to distinguish options related to the offline re-costing of a snapshot
+ *
+ */
+class RecostOptions : public CLIOptions{
+ public:
+    RecostOptions(std::string profilePath, std::string configPath, std::string snapshotPath);
+};
+
 
 #endif  // SRC_SPEAR_CLIOPTIONS_H_
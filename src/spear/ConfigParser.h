@@ -54,6 +54,13 @@ class ConfigParser {
      */
     static AnalysisConfiguration getAnalysisConfiguration();
 
+    /**
+     * Get the portfolio configuration of the parsed analysis configuration without copying the whole configuration.
+     *
+     * @return SatPortfolioConfiguration instance
+     */
+    static SatPortfolioConfiguration getSatPortfolioConfiguration();
+
     /**
      * Get the parsed profiling configuration.
      *
@@ -61,6 +68,13 @@ class ConfigParser {
      */
     static ProfilingConfiguration getProfilingConfiguration();
 
+    /**
+     * Replace the parsed analysis configuration, e.g. to degrade the analysis of a worker process.
+     *
+     * @param configuration AnalysisConfiguration to use from now on
+     */
+    static void overrideAnalysisConfiguration(const AnalysisConfiguration &configuration);
+
     /**
      * Parse the loaded JSON into typed configuration structs.
      */
@@ -96,6 +110,64 @@ class ConfigParser {
      */
     bool fallbackValid(json object);
 
+    /**
+     * Validate the optional sweep configuration section.
+     *
+     * @param object JSON object containing sweep data
+     * @return True if valid or absent, otherwise false
+     */
+    bool sweepValid(json object);
+
+    /**
+     * Validate the optional loop bound solver configuration section.
+     *
+     * @param object JSON object containing loop bound data
+     * @return True if valid or absent, otherwise false
+     */
+    bool loopboundValid(json object);
+
+    /**
+     * Validate the optional sat portfolio configuration section.
+     *
+     * @param object JSON object containing sat portfolio data
+     * @return True if valid or absent, otherwise false
+     */
+    bool satPortfolioValid(json object);
+
+    /**
+     * Validate the optional self energy measurement configuration section.
+     *
+     * @param object JSON object containing self energy data
+     * @return True if valid or absent, otherwise false
+     */
+    bool selfEnergyValid(json object);
+
+    /**
+     * Validate the optional sharding configuration section.
+     *
+     * @param object JSON object containing sharding data
+     * @return True if valid or absent, otherwise false
+     */
+    bool shardingValid(json object);
+
+    /**
+     * Validate an optional boolean property of the given section.
+     *
+     * @param object JSON object containing the property
+     * @param key Name of the property
+     * @return True if the property is absent or a boolean, otherwise false
+     */
+    bool optionalBooleanValid(json object, const std::string& key);
+
+    /**
+     * Validate an optional string property of the given section.
+     *
+     * @param object JSON object containing the property
+     * @param key Name of the property
+     * @return True if the property is absent or a string, otherwise false
+     */
+    bool optionalStringValid(json object, const std::string& key);
+
     /**
      * Validate the analysis mode configuration section.
      *
@@ -138,6 +210,7 @@ class ConfigParser {
     bool minInstructionEnergy(json object);
     bool CPURegressionValid(json object);
     bool SyscallProfilingConfigValid(json object);
+    bool timelineRateValid(json object);
 };
 
 #endif  // SRC_SPEAR_CONFIGPARSER_H_
@@ -7,9 +7,12 @@
 #ifndef SRC_SPEAR_ELBS_ELPMAPPER_H_
 #define SRC_SPEAR_ELBS_ELPMAPPER_H_
 
+#include <atomic>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 using ELBMapping = std::unordered_map<std::string, double>;
 
@@ -32,6 +35,13 @@ class ELBMapper {
      */
     void useMapping(const std::string &filename);
 
+    /**
+     * Register a mapping file that is parsed on the first lookup. Runs that never resolve an external call do not pay
+     * for parsing the ELB files. Files are applied in the order they were registered, after all eagerly loaded ones
+     * @param filename Name of the file to parse the mapping from
+     */
+    void deferMapping(const std::string &filename);
+
     /**
      * Get ELBValue for a given function name from the internal mapping if it exists
      * @param fname Name of the function to look up
@@ -56,6 +66,26 @@ class ELBMapper {
      */
     ELBMapping mapping;
 
+    /**
+     * Files registered by deferMapping() that have not been parsed yet
+     */
+    std::vector<std::string> pendingFiles;
+
+    /**
+     * Set while pendingFiles is not empty, allows lookups to skip the lock
+     */
+    std::atomic<bool> hasPendingFiles = false;
+
+    /**
+     * Guards pendingFiles and the mapping while the pending files are parsed
+     */
+    std::mutex loadMutex;
+
+    /**
+     * Parse all pending files into the mapping
+     */
+    void loadPendingFiles();
+
     /**
      * Private constructor to prevent direct instantiation
      */
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#ifndef SRC_SPEAR_ENERGYCOUNTERSOURCE_H_
+#define SRC_SPEAR_ENERGYCOUNTERSOURCE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "RegisterReader.h"
+#include "configuration/valuespace.h"
+
+/**
+ * Monotonic hardware energy counter of limited width, e.g. the RAPL energy status register.
+ * The counter wraps around after 2^getCounterBits() ticks.
+ */
+class EnergyCounterSource {
+ public:
+    virtual ~EnergyCounterSource() = default;
+
+    /**
+     * Read the current value of the counter
+     * @return Counter value in ticks, only the lowest getCounterBits() bits are valid
+     */
+    virtual uint64_t readCounter() = 0;
+
+    /**
+     * Return the energy of a single tick
+     * @return Energy per tick in Joule
+     */
+    virtual double getEnergyUnit() const = 0;
+
+    /**
+     * Return the width of the counter
+     * @return Amount of valid bits of the counter
+     */
+    virtual unsigned getCounterBits() const = 0;
+
+    /**
+     * Return the name of the source used in reports
+     * @return Name of the source
+     */
+    virtual std::string getName() const = 0;
+
+    /**
+     * Calculate the ticks between two reads of a counter with the given width, tolerating a single wraparound
+     * @param previous Earlier counter value
+     * @param current Later counter value
+     * @param counterBits Width of the counter
+     * @return Elapsed ticks
+     */
+    static uint64_t counterDelta(uint64_t previous, uint64_t current, unsigned counterBits);
+
+    /**
+     * Create a counter source
+     * @param source Requested source, AUTO falls back to the mock source if RAPL is not accessible
+     * @param mockWatts Constant power of the mock source
+     * @return Created source
+     */
+    static std::unique_ptr<EnergyCounterSource> create(EnergySource source, double mockWatts);
+};
+
+/**
+ * RAPL energy status register of core 0
+ */
+class RaplCounterSource : public EnergyCounterSource {
+ public:
+    RaplCounterSource();
+
+    uint64_t readCounter() override;
+
+    double getEnergyUnit() const override { return energyUnit; }
+
+    unsigned getCounterBits() const override { return 32; }
+
+    std::string getName() const override { return "rapl"; }
+
+ private:
+    RegisterReader reader;
+
+    /**
+     * Energy unit read once on construction, it is fixed per package
+     */
+    double energyUnit;
+};
+
+/**
+ * Deterministic counter for machines without RAPL access. The counter advances with the wall time at a constant power,
+ * energy can additionally be injected to simulate load.
+ */
+class MockCounterSource : public EnergyCounterSource {
+ public:
+    /**
+     * Create a mock counter
+     * @param watts Constant power the counter advances with, 0 to only advance on addEnergy()
+     * @param counterBits Width of the counter, RAPL uses 32 bits
+     * @param energyUnit Energy per tick, RAPL commonly uses 2^-14 J
+     */
+    explicit MockCounterSource(double watts, unsigned counterBits = 32, double energyUnit = 1.0 / 16384.0);
+
+    uint64_t readCounter() override;
+
+    double getEnergyUnit() const override { return energyUnit; }
+
+    unsigned getCounterBits() const override { return counterBits; }
+
+    std::string getName() const override { return "mock"; }
+
+    /**
+     * Advance the counter by the given energy. Safe to call while another thread reads the counter
+     * @param joules Energy to add
+     */
+    void addEnergy(double joules);
+
+ private:
+    double watts;
+    unsigned counterBits;
+    double energyUnit;
+    std::atomic<double> injectedJoules{0};
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif  // SRC_SPEAR_ENERGYCOUNTERSOURCE_H_
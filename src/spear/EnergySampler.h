@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#ifndef SRC_SPEAR_ENERGYSAMPLER_H_
+#define SRC_SPEAR_ENERGYSAMPLER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "EnergyCounterSource.h"
+#include "nlohmann/json.hpp"
+
+/**
+ * Single timestamped reading of the sampler
+ */
+struct EnergySample {
+    /**
+     * Time since the sampler was started in nanoseconds
+     */
+    uint64_t timeNs;
+
+    /**
+     * Counter value extended to 64 bits, in ticks of the energy unit of the source
+     */
+    uint64_t ticks;
+};
+
+/**
+ * Extends a wrapping counter of limited width to 64 bits. The extension is correct as long as the counter is read at
+ * least once per wraparound period.
+ */
+class CounterExtender {
+ public:
+    explicit CounterExtender(unsigned counterBits) : counterBits(counterBits) {}
+
+    /**
+     * Feed the next raw reading of the counter
+     * @param raw Raw counter value
+     * @return Ticks elapsed since the first reading, never wrapping in practice
+     */
+    uint64_t extend(uint64_t raw);
+
+    /**
+     * Return the amount of detected wraparounds
+     * @return Wraparounds of the raw counter
+     */
+    uint64_t getWraparounds() const { return wraparounds; }
+
+ private:
+    unsigned counterBits;
+    bool initialized = false;
+    uint64_t lastRaw = 0;
+    uint64_t extended = 0;
+    uint64_t wraparounds = 0;
+};
+
+/**
+ * Bounded lock-free ring buffer of samples for exactly one producer and one consumer. The producer never blocks, a
+ * sample that does not fit is dropped and counted.
+ */
+class SampleRingBuffer {
+ public:
+    /**
+     * Create a buffer
+     * @param capacity Minimal amount of samples the buffer can hold, rounded up to a power of two
+     */
+    explicit SampleRingBuffer(size_t capacity);
+
+    /**
+     * Append a sample. Must only be called by the producer
+     * @param sample Sample to append
+     * @return False if the buffer was full and the sample was dropped
+     */
+    bool push(const EnergySample &sample);
+
+    /**
+     * Move all buffered samples to the given vector. Must only be called by the consumer
+     * @param target Vector the samples are appended to
+     * @return Amount of moved samples
+     */
+    size_t drain(std::vector<EnergySample> &target);
+
+    size_t getCapacity() const { return slots.size(); }
+
+    /**
+     * Return the amount of buffered samples. Exact for the producer and the consumer, an estimate for other threads
+     * @return Samples pushed and not drained yet
+     */
+    size_t size() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+
+    uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+ private:
+    std::vector<EnergySample> slots;
+    size_t mask;
+
+    /**
+     * Producer and consumer positions on separate cache lines, so the two threads do not contend on every sample
+     */
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+    std::atomic<uint64_t> dropped{0};
+};
+
+/**
+ * EnergySampler class
+ *
+ * Background thread reading an energy counter source at a fixed rate. Each reading is extended to 64 bits and stored
+ * with its timestamp in a lock-free ring buffer, which can be collected while sampling and exported as a timeline.
+ * The sampler thread moves the buffered samples to the timeline itself once the buffer is half full, so long phases
+ * without a collection do not drop samples. The sampler thread is the only reader of the source while running.
+ */
+class EnergySampler {
+ public:
+    /**
+     * Create a sampler
+     * @param source Source to read, must outlive the sampler
+     * @param rateHz Samples per second
+     * @param capacity Samples the buffer can hold, the sampler thread collects them when half of it is used
+     */
+    EnergySampler(EnergyCounterSource &source, unsigned rateHz, size_t capacity = 1 << 16);
+
+    ~EnergySampler();
+
+    EnergySampler(const EnergySampler &) = delete;
+    EnergySampler &operator=(const EnergySampler &) = delete;
+
+    /**
+     * Take the first sample and start the sampler thread. A stopped sampler can be started again, its timeline is
+     * continued
+     */
+    void start();
+
+    /**
+     * Take a last sample and join the sampler thread
+     */
+    void stop();
+
+    bool isRunning() const { return running.load(std::memory_order_relaxed); }
+
+    /**
+     * Read the source once and record the sample. Called by the sampler thread, tests may call it instead of start()
+     */
+    void sample();
+
+    /**
+     * Return the latest extended counter value
+     * @return Ticks since the sampler was started, at most one sampling period old
+     */
+    uint64_t getLatestTicks() const { return latestTicks.load(std::memory_order_acquire); }
+
+    /**
+     * Move the buffered samples into the timeline. The sampler thread collects on its own, calling this is only
+     * needed to see the latest samples
+     */
+    void collect();
+
+    /**
+     * Return the collected timeline
+     * @return All samples collected so far
+     */
+    std::vector<EnergySample> getTimeline();
+
+    uint64_t getDroppedSamples() const { return buffer.getDropped(); }
+
+    uint64_t getWraparounds() const { return wraparounds.load(std::memory_order_relaxed); }
+
+    /**
+     * Export the timeline
+     * @return JSON object with the sampling metadata and one [seconds, joules, watts] entry per sample
+     */
+    nlohmann::json toJson();
+
+ private:
+    void run();
+
+    EnergyCounterSource &source;
+    std::chrono::nanoseconds period;
+    std::chrono::steady_clock::time_point startTime;
+    bool started = false;
+
+    /**
+     * Only accessed by the thread calling sample()
+     */
+    CounterExtender extender;
+
+    SampleRingBuffer buffer;
+    std::atomic<uint64_t> latestTicks{0};
+    std::atomic<uint64_t> wraparounds{0};
+    std::atomic<bool> running{false};
+    std::thread samplerThread;
+
+    /**
+     * Lock for concurrent consumers of the buffer
+     */
+    std::mutex timelineMutex;
+    std::vector<EnergySample> timeline;
+};
+
+#endif  // SRC_SPEAR_ENERGYSAMPLER_H_
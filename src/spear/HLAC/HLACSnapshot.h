@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#ifndef SRC_SPEAR_HLAC_HLACSNAPSHOT_H_
+#define SRC_SPEAR_HLAC_HLACSNAPSHOT_H_
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace HLAC {
+
+class hlac;
+class Edge;
+class GenericNode;
+
+/**
+ * Node of a snapshot scope. Depending on the node type only a subset of the fields is used.
+ */
+struct SnapshotNode {
+    // Type of the node, stored as the value of HLAC::NodeType
+    uint8_t nodeType = 0;
+
+    // VIRTUALNODE: Kind of the virtual node, stored as the value of HLAC::VirtualNodeKind
+    uint8_t virtualNodeKind = 0;
+
+    // NODE: Pairs of (index into HLACSnapshot::opcodeNames, occurrences) of the represented basic block
+    std::vector<std::pair<uint32_t, uint32_t>> opcodeCounts;
+
+    // CALLNODE: Name of the called function and the meta flags of the call
+    std::string calleeName;
+    bool isSyscall = false;
+    bool isLinkerFunction = false;
+    bool isDebugFunction = false;
+    int64_t syscallId = -1;
+
+    // LOOPNODE: Bounds of the loop and the index of the scope containing the loop body
+    int64_t lowerBound = 0;
+    int64_t upperBound = 0;
+    uint32_t bodyScope = 0;
+};
+
+/**
+ * Edge of a snapshot scope. Source and destination are indices into the nodes of the same scope.
+ */
+struct SnapshotEdge {
+    uint32_t source = 0;
+    uint32_t destination = 0;
+    bool feasibility = true;
+    bool isBackEdge = false;
+};
+
+/**
+ * Nodes and edges of a function body or a loop body
+ */
+struct SnapshotScope {
+    std::vector<SnapshotNode> nodes;
+    std::vector<SnapshotEdge> edges;
+};
+
+/**
+ * Snapshot of a single FunctionNode. Scope 0 is the function body, loop bodies follow in the order the ILP columns
+ * are assigned by ILPUtil::assignEdgeIndicesFunction.
+ */
+struct SnapshotFunction {
+    std::string name;
+    bool isGotoFunction = false;
+    bool isIllFormatted = false;
+    bool isRecursive = false;
+
+    // Set if the function could not be captured completely. Such functions are costed with the fallback energy
+    bool isIncomplete = false;
+
+    std::vector<SnapshotScope> scopes;
+};
+
+/**
+ * HLACSnapshot class
+ *
+ * Compact, LLVM free representation of an initialized HLAC graph. The snapshot contains everything the ILP stage
+ * needs to re-cost the program under a different profile or ELB set: nodes, edges, loop bounds, feasibility, the
+ * opcode counts of each basic block and the callees of all call nodes.
+ *
+ * The binary format starts with the magic "SPEARHLC" and a format version. All integers are written in the byte order
+ * of the host, strings are prefixed with their length.
+ */
+class HLACSnapshot {
+ public:
+    /**
+     * Current version of the binary format
+     */
+    static constexpr uint32_t formatVersion = 1;
+
+    /**
+     * Opcode names referenced by the opcode counts of the nodes
+     */
+    std::vector<std::string> opcodeNames;
+
+    /**
+     * Captured functions in the analysis order of the HLAC (callees before callers)
+     */
+    std::vector<SnapshotFunction> functions;
+
+    /**
+     * Capture the given initialized HLAC graph
+     * @param graph Graph to capture
+     * @return Snapshot of the graph
+     */
+    static HLACSnapshot capture(hlac &graph);
+
+    /**
+     * Write the snapshot to the given path
+     * @param path Path of the snapshot file
+     */
+    void write(const std::string &path) const;
+
+    /**
+     * Read a snapshot from the given path
+     * @param path Path of the snapshot file
+     * @return Read snapshot, std::nullopt if the file does not exist or is malformed
+     */
+    static std::optional<HLACSnapshot> read(const std::string &path);
+
+ private:
+    /**
+     * Capture the given nodes and edges as new scope of the function. Loop bodies are captured recursively after the
+     * scope itself, mirroring the column order of the ILP
+     * @param snapshotFunction Function the scope belongs to
+     * @param nodes Nodes of the scope
+     * @param edges Edges of the scope
+     * @param backEdges Backedges of the loop the scope represents, nullptr for the function body
+     * @return Index of the captured scope
+     */
+    uint32_t captureScope(SnapshotFunction &snapshotFunction, const std::vector<std::unique_ptr<GenericNode>> &nodes,
+                          const std::vector<std::unique_ptr<Edge>> &edges,
+                          const std::vector<Edge *> *backEdges);
+
+    /**
+     * Capture a single node
+     * @param node Node to capture
+     * @return Captured node. Loop bodies are not captured by this function
+     */
+    SnapshotNode captureNode(GenericNode *node);
+
+    /**
+     * Return the index of the given opcode name, adding it to the opcode names if necessary
+     * @param opcodeName Name of the opcode
+     * @return Index of the opcode in opcodeNames
+     */
+    uint32_t getOpcodeIndex(const std::string &opcodeName);
+
+    /**
+     * Serialize a single function
+     * @param outputStream Stream to write to
+     * @param snapshotFunction Function to write
+     */
+    static void writeFunction(std::ostream &outputStream, const SnapshotFunction &snapshotFunction);
+
+    /**
+     * Deserialize a single function
+     * @param inputStream Stream to read from
+     * @param snapshotFunction Function to read into
+     * @return true if the function could be read, false otherwise
+     */
+    static bool readFunction(std::istream &inputStream, SnapshotFunction &snapshotFunction);
+
+    /**
+     * Index of each opcode name in opcodeNames
+     */
+    std::unordered_map<std::string, uint32_t> opcodeIndices;
+};
+
+}  // namespace HLAC
+
+#endif  // SRC_SPEAR_HLAC_HLACSNAPSHOT_H_
@@ -12,6 +12,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <string>
 #include <unordered_map>
@@ -306,6 +307,32 @@ class Node : public GenericNode {
     std::string calculateHash() override;
 };
 
+/**
+ * Nodes and edges of a function sorted by the innermost loop that owns them. The partition is computed once per
+ * function in a single pass over its nodes and edges, the LoopNodes take their share from it instead of searching the
+ * function for every loop and subloop.
+ */
+struct LoopPartition {
+    /**
+     * Nodes of the basic blocks of each loop, excluding the blocks of its subloops
+     */
+    std::unordered_map<const llvm::Loop *, std::vector<std::unique_ptr<GenericNode>>> nodes;
+
+    /**
+     * Edges whose source and destination are owned by the same loop
+     */
+    std::unordered_map<const llvm::Loop *, std::vector<std::unique_ptr<Edge>>> edges;
+
+    /**
+     * Move all nodes and edges owned by the given loops or their subloops out of the FunctionNode. The order of the
+     * moved and of the remaining entries is kept.
+     * @param functionNode FunctionNode to take the nodes and edges from
+     * @param loops Top-level loops of the function
+     * @return Partition of the moved nodes and edges
+     */
+    static LoopPartition build(FunctionNode *functionNode, const std::vector<llvm::Loop *> &loops);
+};
+
 /**
  * LoopNode that represents loops inside our HLAC graph
  * Can contain other Nodes and Edges
@@ -363,17 +390,20 @@ class LoopNode : public GenericNode {
      * Constructor to create a new LoopNode
      * @param loop loop that should be represented by the LoopNOde
      * @param function_node FunctionNode, the LoopNode is contained in
+     * @param partition Partition of the function, the nodes and edges of the loop and its subloops are taken from it
      */
-    LoopNode(llvm::Loop *loop, FunctionNode *function_node, ResultRegistry registry, FunctionNode *parentFunctionNode);
+    LoopNode(llvm::Loop *loop, FunctionNode *function_node, ResultRegistry registry, FunctionNode *parentFunctionNode,
+             LoopPartition &partition);
 
     /**
      * Creates a new LoopNode and returns it
      * @param loop Loop that should be converted to a LoopNOde
      * @param function_node FunctionNode the LoopNode should be contained in
+     * @param partition Partition of the function, the nodes and edges of the loop and its subloops are taken from it
      * @return Returns unique pointer to the constructed LoopNode
      */
     static std::unique_ptr<LoopNode> makeNode(llvm::Loop *loop, FunctionNode *function_node, ResultRegistry registry,
-                                              FunctionNode *parentFunctionNode);
+                                              FunctionNode *parentFunctionNode, LoopPartition &partition);
 
     /**
      * Takes the given list of edges and rewrites all entities that interact with loops inside this loop node
@@ -749,6 +779,20 @@ class CallNode : public GenericNode {
      */
     double getEnergy() override;
 
+    /**
+     * Return the energy of a call that is not priced by an analyzed callee. Syscalls are priced by the profile, linker
+     * functions by the ELBs or the fallback energy of unknown functions. Shared with the offline analysis of snapshots
+     * @param isSyscall True if the call is a syscall
+     * @param syscallId Id of the syscall, std::nullopt if unknown
+     * @param isLinkerFunction True if the body of the callee is not available
+     * @param calleeName Name of the called function
+     * @param resolvedByELB Set to true if the energy was taken from the ELBs, may be nullptr
+     * @return Energy of the call, std::nullopt if the call is priced by the energy of the analyzed callee
+     */
+    static std::optional<double> getUnanalyzedCallEnergy(bool isSyscall, std::optional<size_t> syscallId,
+                                                         bool isLinkerFunction, const std::string &calleeName,
+                                                         bool *resolvedByELB = nullptr);
+
     /**
      * Calculate the hash of the node
      * @return Hash as string
@@ -841,6 +885,16 @@ class hlac {
      */
     double getEnergyPerFunction(std::string functionName, bool isRecursive);
 
+    /**
+     * Return the energy of a given function from the given cache. Shared with the offline analysis of snapshots
+     * @param functionEnergyCache Energy of the functions analyzed so far
+     * @param functionName Name of the function to analyze
+     * @param isRecursive Flag if we are calling recursively
+     * @return Energy of the function, 0.0 if the function has not been analyzed yet
+     */
+    static double getEnergyPerFunction(const std::map<std::string, double> &functionEnergyCache,
+                                       const std::string &functionName, bool isRecursive);
+
     /**
      * Return the energy of the contained functions
      * @return Mapping between function name and energy as double value
@@ -9,7 +9,9 @@
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/Function.h>
 
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
@@ -29,6 +31,64 @@ struct LoopNodeEdgeSummary {
     std::size_t outgoingEdgeCount = 0;
 };
 
+/**
+ * Lookup tables over a list of edges, replacing the linear searches for the edge between two nodes and for the edge
+ * of an ILP index. If several edges match, the first one of the list is found, like the linear searches did.
+ */
+class EdgeIndex {
+ public:
+    EdgeIndex() = default;
+
+    /**
+     * Index the given edges
+     * @param edges Edges to index, null entries are skipped
+     */
+    explicit EdgeIndex(const std::vector<std::unique_ptr<Edge>> &edges);
+
+    /**
+     * Index the given edges
+     * @param edges Edges to index, null entries are skipped
+     */
+    explicit EdgeIndex(const std::vector<Edge *> &edges);
+
+    /**
+     * Add an edge to the index. Already indexed edges with the same endpoints or ILP index take precedence
+     * @param edge Edge to add
+     */
+    void add(Edge *edge);
+
+    /**
+     * Find the edge from source to destination
+     * @param source Source node of the edge
+     * @param destination Destination node of the edge
+     * @return Pointer to the found edge. Nullptr if no edge could be found
+     */
+    Edge *find(const GenericNode *source, const GenericNode *destination) const;
+
+    /**
+     * Find the edge with the given ILP index
+     * @param ilpIndex Index to search for
+     * @return Pointer to the found edge. Nullptr if no edge could be found
+     */
+    Edge *findByIlpIndex(int ilpIndex) const;
+
+ private:
+    using Endpoints = std::pair<const GenericNode *, const GenericNode *>;
+
+    struct EndpointsHash {
+        std::size_t operator()(const Endpoints &endpoints) const noexcept {
+            std::size_t hashValue = std::hash<const void *>{}(endpoints.first);
+            hashValue ^= std::hash<const void *>{}(endpoints.second) + 0x9e3779b97f4a7c15ULL + (hashValue << 6) +
+                         (hashValue >> 2);
+            return hashValue;
+        }
+    };
+
+    std::unordered_map<Endpoints, Edge *, EndpointsHash> byEndpoints;
+
+    std::unordered_map<int, Edge *> byIlpIndex;
+};
+
 /**
  * Util class to implement utility functions for HLACS
  */
@@ -146,7 +206,8 @@ class Util {
 
     /**
      * Traces the given predecessor list beginning in the entryNode until NULL is reached.
-     * Stores all found edges along the way and returns them
+     * Stores all found edges along the way and returns them. The edges are indexed once, so the reconstruction is
+     * linear in the length of the path and the ILP variables of the loops on it.
      * @param entryNode Node to start from
      * @param predecessors Predecessor list
      * @param edges Existing edges
@@ -6,6 +6,7 @@
 #ifndef SRC_SPEAR_ILP_ILPBUILDER_H_
 #define SRC_SPEAR_ILP_ILPBUILDER_H_
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <unordered_map>
@@ -39,18 +40,6 @@ class ILPBuilder {
      */
     static ILPModel buildMonolithicILP(HLAC::LoopNode *loop);
 
-    /**
-     * Collect column variables that lead to the given loopnode
-     * @param loopNode LoopNode to consider
-     * @param parentEdges Edges in the parent node
-     * @param incomingColumns Vector of already determined possible incoming columns
-     * @return Calculated columns variables that resemble and invocation of the given loopnode
-     */
-    static std::vector<int>
-    collectExternalLoopInvocationColumns(HLAC::LoopNode *loopNode,
-                                         const std::vector<std::unique_ptr<HLAC::Edge>> &parentEdges,
-                                         const std::vector<int> &incomingColumns);
-
     /**
      * Construct a clustered ILP from the given functionNode pointer
      * @param func FunctionNode pointer to calculate the clustered ILP for
@@ -74,6 +63,24 @@ class ILPBuilder {
      */
     static std::optional<ILPResult> solveClusteredLoopModel(const ILPModel &ilpModel, HLAC::LoopNode *loopNode);
 
+    /**
+     * Add information about the edge behaviour of the given scope of the flow graph.
+     * We encode edges as edge constrains in the graph. For each node we have to guarantee, that the amount of
+     * executions from incoming edges is equal to the amount of executions from the outgoing edges.
+     * For example:
+     *  x_1 + x_2 = x_3 + x_5
+     *
+     * Loop bodies are added recursively together with their loop bound constraints. The flow graph is built from the
+     * HLAC graph by ILPUtil::buildFlowGraph or from an HLAC snapshot, so both share the same rows
+     *
+     * @param model ILPModel to inser the constrains to
+     * @param graph Flow graph of the function or loop under analysis
+     * @param scope Scope of the flow graph to add the constraints for
+     * @param invocationCols Optional pointer to ILP column indices representing how often
+     * this subgraph is entered from the parent graph. If nullptr, the subgraph is treated as top-level.
+     */
+    static void appendFlowConstraints(ILPModel &model, const ILPFlowGraph &graph, std::size_t scope,
+                                      const std::vector<int> *invocationCols);
 
  private:
     /**
@@ -94,23 +101,6 @@ class ILPBuilder {
      */
     static void applyEdgeFeasibilityBounds(ILPModel &model, HLAC::LoopNode *loopNode);
 
-    /**
-     * Add information about the edge behaviour of the hlac represented by the given nodes and edges.
-     * We encode edges as edge constrains in the graph. For each node we have to guarantee, that the amount of
-     * executions from incoming edges is equal to the amount of executions from the outgoing edges.
-     * For example:
-     *  x_1 + x_2 = x_3 + x_5
-     *
-     * @param model ILPModel to inser the constrains to
-     * @param nodes Nodes from the HLAC graph under analysis
-     * @param edges Edges from the HLAC graph under analysis
-     * @param invocationCols Optional pointer to ILP column indices representing how often
-     * this subgraph is entered from the parent graph. If nullptr, the subgraph is treated as top-level.
-     */
-    static void appendGraphConstraints(ILPModel &model, const std::vector<std::unique_ptr<HLAC::GenericNode>> &nodes,
-                                       const std::vector<std::unique_ptr<HLAC::Edge>> &edges,
-                                       const std::vector<int> *invocationCols);
-
     /**
      * Add a loop bound constraint for the given loop node to the ILP model.
      *
@@ -133,11 +123,12 @@ class ILPBuilder {
      * counts to the loop body.
      *
      * @param model ILPModel to insert the constraint into
-     * @param loopNode Loop node whose bound should be encoded
+     * @param graph Flow graph containing the body of the loop
+     * @param loop Loop node whose bound should be encoded
      * @param invocationCols ILP column indices representing how often the loop is entered
      * from the surrounding graph
      */
-    static void appendLoopBoundConstraint(ILPModel &model, HLAC::LoopNode *loopNode,
+    static void appendLoopBoundConstraint(ILPModel &model, const ILPFlowGraph &graph, const ILPFlowNode &loop,
                                           const std::vector<int> &invocationCols);
 
 
@@ -167,6 +158,14 @@ class ILPBuilder {
      * @param loopNode LoopNode to extract the energy values from
      */
     static void fillObjectiveFunction(ILPModel &model, HLAC::LoopNode *loopNode);
+
+    /**
+     * Record the column of the edge in ILPModel::callColumns if the edge leads into a call of an analyzed function
+     *
+     * @param model Model the column belongs to
+     * @param edge Edge whose destination is checked
+     */
+    static void recordCallColumn(ILPModel &model, HLAC::Edge *edge);
 };
 
 #endif  // SRC_SPEAR_ILP_ILPBUILDER_H_
@@ -15,6 +15,12 @@
 #include <OsiClpSolverInterface.hpp>
 #include "ILPBuilder.h"
 
+/**
+ * Scaling factor to the objective function values.
+ * Reduces errors where the solver returns a solution that is slightly worse than the optimal solution due to numerical
+ */
+inline constexpr double objectiveScalingFactor = 1.0e15;
+
 enum ILPSolverStatus {
     INFEASIBLE,
     UNBOUNDED,
@@ -66,6 +72,21 @@ class ILPSolver {
      */
     std::string getStatusString() const;
 
+    /**
+     * Calculate the sensitivity of the worst case energy with respect to the loop bound rows of the given model.
+     *
+     * The duals of the loop bound rows are taken from the LP relaxation of the model. As the loop bound is encoded as
+     * coefficient of the invocation column, one additional iteration shifts the row by the amount of loop invocations.
+     * The marginal energy per iteration therefore is dual * invocations. The valid range is derived from the primal
+     * ranging of the row slacks, i.e. the interval of the bound in which the optimal basis does not change.
+     *
+     * @param model Model containing the loop bound rows generated by the ILPBuilder
+     * @param integerResult Optimal integer solution of the model
+     * @return One ILPLoopBoundSensitivity per loop bound row of the model
+     */
+    static std::vector<ILPLoopBoundSensitivity> calculateLoopBoundSensitivity(const ILPModel &model,
+                                                                              const ILPResult &integerResult);
+
  private:
     /**
      * Model the solver was build upon
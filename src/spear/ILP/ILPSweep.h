@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#ifndef SRC_SPEAR_ILP_ILPSWEEP_H_
+#define SRC_SPEAR_ILP_ILPSWEEP_H_
+
+#include <optional>
+#include <vector>
+
+#include "ILPTypes.h"
+#include "configuration/valuespace.h"
+
+/**
+ * ILPSweep class that provides static methods to evaluate an already built ILP model over a grid of loop bounds.
+ *
+ * Instead of rebuilding and resolving the whole model for each bound setting, the model is loaded into the solver
+ * once. For each grid point only the loop bound rows recorded in ILPModel::loopBoundRows are modified and the LP
+ * relaxation is re-solved with the dual simplex starting from the optimal basis of the previous grid point.
+ * The integer solution is then searched by branch and bound starting from the warm started relaxation.
+ *
+ * Functions are swept callees first. The objective coefficients of the calls recorded in ILPModel::callColumns are
+ * replaced by the swept energies of the callees at the same grid point, so the loops of the callees are scaled
+ * together with the loops of the caller.
+ */
+class ILPSweep {
+ public:
+    /**
+     * Evaluate the given model for each value of the grid.
+     *
+     * In SweepMode::FALLBACK each grid value replaces the bound of all loops that are bounded by a fallback value.
+     * In SweepMode::SCALE each grid value is used as factor that scales the bounds of all loops in the model.
+     *
+     * @param model Model to evaluate. The model has to contain the loop bound rows generated by the ILPBuilder
+     * @param grid Values to evaluate the model for
+     * @param mode Mode that defines how the grid values are applied to the loop bound rows
+     * @param calleeEnergies Swept energies of the callees analyzed before. Callees without an entry keep their
+     * nominal energy
+     * @return Vector containing one ILPSweepPoint per grid value in the order of the grid
+     */
+    static std::vector<ILPSweepPoint> sweepLoopBounds(const ILPModel &model, const std::vector<double> &grid,
+                                                      SweepMode mode, const ILPSweepEnergies &calleeEnergies);
+
+    /**
+     * Check if the energy of the model changes over the grid, i.e. if it has loop bound rows or calls a swept callee
+     * @param model Model to check
+     * @param calleeEnergies Swept energies of the callees analyzed before
+     * @return True if the model has to be swept
+     */
+    static bool isAffectedBySweep(const ILPModel &model, const ILPSweepEnergies &calleeEnergies);
+
+    /**
+     * Calculate the factor of the invocation column for the given loop bound row under the given grid value.
+     * @param loopBoundRow Row to calculate the factor for
+     * @param gridValue Current value of the grid
+     * @param mode Mode that defines how the grid value is applied
+     * @return Backedge factor (bound - 1) of the row, or std::nullopt if the row is not affected by the sweep
+     */
+    static std::optional<double> backedgeFactorForGridValue(const ILPLoopBoundRow &loopBoundRow, double gridValue,
+                                                            SweepMode mode);
+};
+
+#endif  // SRC_SPEAR_ILP_ILPSWEEP_H_
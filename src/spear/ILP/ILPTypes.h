@@ -10,6 +10,10 @@
 #include <unordered_map>
 #include <vector>
 #include <map>
+#include <optional>
+#include <cstddef>
+#include <cstdint>
+#include <string>
 
 #include <CoinPackedMatrix.hpp>
 
@@ -25,6 +29,98 @@ class Edge;
 class GenericNode;
 }  // namespace HLAC
 
+/**
+ * Description of a single loop bound row inserted by ILPBuilder::appendLoopBoundConstraint.
+ * The bound of the loop is encoded as the coefficient of the invocation column in the row
+ *      backedges - (bound - 1) * invocations >= 0   (lower bound row)
+ *      backedges - (bound - 1) * invocations <= 0   (upper bound row)
+ */
+struct ILPLoopBoundRow {
+    // Loop node the row bounds, nullptr if the model was not built from an HLAC graph
+    HLAC::LoopNode *loopNode;
+
+    // Index of the row inside the constraint matrix
+    int row;
+
+    // Column counting the invocations of the loop
+    int invocationColumn;
+
+    // True if the row encodes the upper bound of the loop, false if it encodes the lower bound
+    bool isUpperBound;
+};
+
+/**
+ * Kind of an ILPFlowNode, deciding which rows are emitted for it
+ */
+enum class ILPFlowNodeKind {
+    // Virtual entry node, its outgoing edges are taken once per invocation of the scope
+    ENTRY,
+    // Virtual normal exit node, its incoming edges are taken once per invocation of the scope
+    EXIT,
+    // Loop node, its body is a separate scope bounded by the loop bound
+    LOOP,
+    // Any other node, the flow into the node equals the flow out of it
+    OTHER
+};
+
+/**
+ * Node of an ILPFlowScope reduced to the columns of its edges
+ */
+struct ILPFlowNode {
+    ILPFlowNodeKind kind = ILPFlowNodeKind::OTHER;
+
+    // Columns of the edges entering and leaving the node
+    std::vector<int> incomingColumns;
+    std::vector<int> outgoingColumns;
+
+    // LOOP: Incoming columns that do not originate from the loop itself, i.e. the invocations of the loop
+    std::vector<int> invocationColumns;
+
+    // LOOP: Index of the scope of the loop body
+    std::size_t bodyScope = 0;
+
+    // LOOP: Bounds of the loop
+    double lowerBound = 0.0;
+    double upperBound = 0.0;
+
+    // LOOP: Loop node of the HLAC graph, nullptr if the flow graph was not built from an HLAC graph
+    HLAC::LoopNode *loopNode = nullptr;
+
+    // LOOP: Name of the loop used in diagnostics
+    std::string name;
+};
+
+/**
+ * Nodes of a function body or a loop body
+ */
+struct ILPFlowScope {
+    std::vector<ILPFlowNode> nodes;
+
+    // Columns of the backedges if the scope is the body of a loop
+    std::vector<int> backEdgeColumns;
+};
+
+/**
+ * Control flow of a function or a loop reduced to what the flow and loop bound rows of the ILP need. Scope 0 is the
+ * outermost scope. It is built from the HLAC graph as well as from HLAC snapshots, so both emit their rows through
+ * ILPBuilder::appendFlowConstraints
+ */
+struct ILPFlowGraph {
+    std::vector<ILPFlowScope> scopes;
+};
+
+/**
+ * Column of an edge into a call of an analyzed function. The objective coefficient of the column is the energy of the
+ * callee, which allows to replace it by the energy of the callee under a different setting
+ */
+struct ILPCallColumn {
+    // Index of the column
+    int column;
+
+    // Name of the called function
+    std::string calleeName;
+};
+
 /**
  * Helper struct that represents a CBC ILP
  */
@@ -49,8 +145,18 @@ struct ILPModel {
 
     // Mapping from column index to corresponding HLAC edge
     std::vector<HLAC::Edge*> colToEdge;
+
+    // Rows encoding loop bounds. Allows to modify the bounds of an already built model
+    std::vector<ILPLoopBoundRow> loopBoundRows;
+
+    // Columns whose objective coefficient is the energy of an analyzed callee
+    std::vector<ILPCallColumn> callColumns;
 };
 
+// Type alias for the swept energies of the analyzed functions, one entry per grid value. std::nullopt marks grid values
+// the model of the function could not be solved for
+using ILPSweepEnergies = std::unordered_map<std::string, std::vector<std::optional<double>>>;
+
 // Type alias for a mapping from LoopNode pointers to their corresponding ILP models in the clustered ILP construction.
 using ClusteredILPModel = std::unordered_map<HLAC::LoopNode *, ILPModel>;
 
@@ -95,6 +201,46 @@ struct DAGLongestPathSolution {
     std::vector<HLAC::Edge *> longestPath;
 };
 
+/**
+ * Result of a single grid point of a loop bound sweep
+ */
+struct ILPSweepPoint {
+    // Grid value the loop bounds were set to
+    double gridValue;
+
+    // Worst case energy under the given grid value. std::nullopt if the model could not be solved
+    std::optional<double> energy;
+
+    // Time needed to re-solve the model for this grid point in microseconds
+    int64_t duration;
+};
+
+/**
+ * Sensitivity of the worst case energy of a model with respect to a single loop bound row
+ */
+struct ILPLoopBoundSensitivity {
+    // Loop node the row bounds
+    HLAC::LoopNode *loopNode;
+
+    // True if the row encodes the upper bound of the loop, false if it encodes the lower bound
+    bool isUpperBound;
+
+    // True if the row is binding in the optimal solution, i.e. has a non zero dual value
+    bool binding;
+
+    // Change of the worst case energy per additional iteration allowed by the bound in Joule
+    double marginalEnergy;
+
+    // Lowest loop bound for which the marginal energy stays valid
+    double validFrom;
+
+    // Highest loop bound for which the marginal energy stays valid
+    double validTo;
+
+    // True if the relaxation the duals are taken from has the same optimum as the integer model
+    bool exact;
+};
+
 // Adjacent representation of the HLAC graph, mapping from node to its adjacent edges.
 using HLACAdjacentRepresentation = std::map<HLAC::GenericNode *, std::vector<HLAC::Edge *>>;
 
@@ -6,6 +6,7 @@
 #ifndef SRC_SPEAR_ILP_ILPUTIL_H_
 #define SRC_SPEAR_ILP_ILPUTIL_H_
 
+#include <cstddef>
 #include <string>
 #include <unordered_set>
 #include <unordered_map>
@@ -61,6 +62,31 @@ class ILPUtil {
         std::unordered_map<HLAC::GenericNode*, std::vector<int>>& outgoing,
         int numberOfVariables);
 
+    /**
+     * Reduce the HLAC graph of the function to the flow graph the ILP rows are built from. Expects the ILP indices of
+     * the edges to be assigned
+     * @param func Function to reduce, its body becomes scope 0
+     * @param numberOfVariables Amount of columns of the model
+     * @return Flow graph of the function
+     */
+    static ILPFlowGraph buildFlowGraph(HLAC::FunctionNode *func, int numberOfVariables);
+
+    /**
+     * Reduce the body of the loop to the flow graph the ILP rows are built from
+     * @param loopNode Loop to reduce, its body becomes scope 0
+     * @param numberOfVariables Amount of columns of the model
+     * @return Flow graph of the loop body
+     */
+    static ILPFlowGraph buildFlowGraph(HLAC::LoopNode *loopNode, int numberOfVariables);
+
+    /**
+     * Describe the given loop as node of a flow graph
+     * @param loopNode Loop to describe
+     * @param bodyScope Scope of the loop body in the flow graph
+     * @return Loop node without incident columns
+     */
+    static ILPFlowNode describeLoop(HLAC::LoopNode *loopNode, std::size_t bodyScope);
+
     /**
      * Iterate over the edges in the function and assign them a unique ID, which we call the ILPIndex
      * @param func Function, for which edges should be assigned an ID
@@ -122,6 +148,20 @@ class ILPUtil {
     static CoinPackedVector createRowFromCoefficients(const std::unordered_map<int, double> &coefficientsByColumn);
 
  private:
+    /**
+     * Append the given nodes and edges as new scope of the flow graph, followed by the bodies of the contained loops
+     * @param graph Flow graph to append to
+     * @param nodes Nodes of the scope
+     * @param edges Edges of the scope
+     * @param loopNode Loop the scope is the body of, nullptr for a function body
+     * @param numberOfVariables Amount of columns of the model
+     * @return Index of the appended scope
+     */
+    static std::size_t appendFlowScope(ILPFlowGraph &graph,
+                                       const std::vector<std::unique_ptr<HLAC::GenericNode>> &nodes,
+                                       const std::vector<std::unique_ptr<HLAC::Edge>> &edges,
+                                       HLAC::LoopNode *loopNode, int numberOfVariables);
+
     /**
      * Return the given double value of a bound to a string with fixed precission.
      * Used for ILP printing
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#ifndef SRC_SPEAR_METRICSREGISTRY_H_
+#define SRC_SPEAR_METRICSREGISTRY_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+/**
+ * Label set of a single metric, e.g. {"phase": "loopbound"}
+ */
+using MetricLabels = std::map<std::string, std::string>;
+
+/**
+ * Monotonically increasing value
+ */
+class Counter {
+ public:
+    /**
+     * Increase the counter
+     * @param value Amount to add
+     */
+    void inc(uint64_t value = 1) { this->value.fetch_add(value, std::memory_order_relaxed); }
+
+    uint64_t get() const { return value.load(std::memory_order_relaxed); }
+
+    void reset() { value.store(0, std::memory_order_relaxed); }
+
+ private:
+    std::atomic<uint64_t> value{0};
+};
+
+/**
+ * Value that can go up and down
+ */
+class Gauge {
+ public:
+    void set(double value) { this->value.store(value, std::memory_order_relaxed); }
+
+    /**
+     * Set the gauge to the given value if it is larger than the current one
+     * @param value Candidate value
+     */
+    void setMax(double value);
+
+    double get() const { return value.load(std::memory_order_relaxed); }
+
+    void reset() { set(0); }
+
+ private:
+    std::atomic<double> value{0};
+};
+
+/**
+ * Distribution of observed values over fixed buckets
+ */
+class Histogram {
+ public:
+    /**
+     * Create a histogram
+     * @param bounds Sorted upper bounds of the buckets, the +Inf bucket is added implicitly
+     */
+    explicit Histogram(std::vector<double> bounds);
+
+    /**
+     * Record a single value
+     * @param value Observed value
+     */
+    void observe(double value);
+
+    const std::vector<double> &getBounds() const { return bounds; }
+
+    /**
+     * Return the cumulative count of each bucket, the last entry is the +Inf bucket
+     * @return Cumulative bucket counts
+     */
+    std::vector<uint64_t> getCumulativeCounts() const;
+
+    double getSum() const { return sum.load(std::memory_order_relaxed); }
+
+    uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+
+    /**
+     * Add the observations of another histogram with the same bounds
+     * @param cumulativeCounts Cumulative count of each bucket, the last entry is the +Inf bucket
+     * @param sum Sum of the observed values
+     * @param count Amount of observed values
+     */
+    void merge(const std::vector<uint64_t> &cumulativeCounts, double sum, uint64_t count);
+
+    void reset();
+
+    /**
+     * Create exponentially growing bucket bounds
+     * @param start Upper bound of the first bucket
+     * @param factor Factor between two consecutive bounds
+     * @param bucketCount Amount of buckets
+     * @return Bucket bounds
+     */
+    static std::vector<double> exponentialBuckets(double start, double factor, size_t bucketCount);
+
+ private:
+    std::vector<double> bounds;
+
+    /**
+     * Non-cumulative count per bucket, the last entry is the +Inf bucket
+     */
+    std::unique_ptr<std::atomic<uint64_t>[]> bucketCounts;
+
+    std::atomic<double> sum{0};
+    std::atomic<uint64_t> count{0};
+};
+
+/**
+ * Records the time from construction to destruction in seconds into a histogram
+ */
+class ScopedMetricsTimer {
+ public:
+    explicit ScopedMetricsTimer(Histogram &histogram)
+        : histogram(histogram), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedMetricsTimer() {
+        histogram.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    ScopedMetricsTimer(const ScopedMetricsTimer &) = delete;
+    ScopedMetricsTimer &operator=(const ScopedMetricsTimer &) = delete;
+
+ private:
+    Histogram &histogram;
+    std::chrono::steady_clock::time_point start;
+};
+
+enum class MetricType { COUNTER, GAUGE, HISTOGRAM };
+
+/**
+ * MetricsRegistry class
+ *
+ * Process-wide registry of the performance metrics of a run. Metrics are registered by name and label set, the
+ * returned references stay valid for the lifetime of the process. Hot paths should look up their metric once, e.g. in a
+ * function-local static, and only update it afterwards, which is a single relaxed atomic operation.
+ */
+class MetricsRegistry {
+ public:
+    // Access the singleton instance
+    static MetricsRegistry &getInstance();
+
+    // Deleted copy/move to enforce singleton
+    MetricsRegistry(const MetricsRegistry &) = delete;
+    MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+    MetricsRegistry(MetricsRegistry &&) = delete;
+    MetricsRegistry &operator=(MetricsRegistry &&) = delete;
+
+    /**
+     * Get or register a counter
+     * @param name Name of the metric family
+     * @param help Description of the metric family
+     * @param labels Labels of the counter
+     * @return Registered counter
+     */
+    Counter &counter(const std::string &name, const std::string &help, const MetricLabels &labels = {});
+
+    /**
+     * Get or register a gauge
+     * @param name Name of the metric family
+     * @param help Description of the metric family
+     * @param labels Labels of the gauge
+     * @return Registered gauge
+     */
+    Gauge &gauge(const std::string &name, const std::string &help, const MetricLabels &labels = {});
+
+    /**
+     * Get or register a histogram
+     * @param name Name of the metric family
+     * @param help Description of the metric family
+     * @param bounds Upper bounds of the buckets, only used on the first registration of the family
+     * @param labels Labels of the histogram
+     * @return Registered histogram
+     */
+    Histogram &histogram(const std::string &name, const std::string &help, const std::vector<double> &bounds,
+                         const MetricLabels &labels = {});
+
+    /**
+     * Record the duration of an analysis phase
+     * @param phase Name of the phase
+     * @param duration Duration of the phase
+     */
+    void recordPhaseDuration(const std::string &phase, std::chrono::microseconds duration);
+
+    /**
+     * Update the process metrics (peak RSS) to their current values
+     */
+    void collectProcessMetrics();
+
+    /**
+     * Write all metrics in the OpenMetrics text format
+     * @param outputStream Stream to write to
+     */
+    void writeOpenMetrics(std::ostream &outputStream);
+
+    /**
+     * Return all metrics as JSON object
+     * @return Metric families by name
+     */
+    nlohmann::json toJson();
+
+    /**
+     * Zero all registered metrics, the registrations and the returned references stay valid. Used by forked workers
+     * to report only their own share of the metrics
+     */
+    void reset();
+
+    /**
+     * Add metrics in the format of toJson, e.g. the metrics of a worker process. Counters and histograms are summed,
+     * gauges keep the maximum. Histograms whose bounds differ from the registered ones are skipped
+     * @param metrics Metric families by name
+     */
+    void merge(const nlohmann::json &metrics);
+
+ private:
+    MetricsRegistry() = default;
+
+    struct MetricFamily {
+        MetricType type;
+        std::string help;
+        std::vector<double> bounds;
+        std::map<MetricLabels, std::unique_ptr<Counter>> counters;
+        std::map<MetricLabels, std::unique_ptr<Gauge>> gauges;
+        std::map<MetricLabels, std::unique_ptr<Histogram>> histograms;
+    };
+
+    /**
+     * Get or create the family with the given name. Throws if the family exists with another type
+     * @param name Name of the family
+     * @param help Description of the family
+     * @param type Type of the family
+     * @return Family with the given name
+     */
+    MetricFamily &getFamily(const std::string &name, const std::string &help, MetricType type);
+
+    /**
+     * Format the labels in the OpenMetrics exposition format
+     * @param labels Labels to format
+     * @param extraLabel Additional preformatted label (e.g. le="0.5"), may be empty
+     * @return Formatted label set including the braces, empty if there are no labels
+     */
+    static std::string formatLabels(const MetricLabels &labels, const std::string &extraLabel = "");
+
+    /**
+     * Format a number in the OpenMetrics exposition format
+     * @param value Number to format
+     * @return Formatted number
+     */
+    static std::string formatNumber(double value);
+
+    /**
+     * Lock protecting the families. Not needed to update a registered metric
+     */
+    std::mutex registryMutex;
+
+    std::map<std::string, MetricFamily> families;
+};
+
+#endif  // SRC_SPEAR_METRICSREGISTRY_H_
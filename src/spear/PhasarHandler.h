@@ -153,6 +153,12 @@ class PhasarHandlerPass : public llvm::PassInfoMixin<PhasarHandlerPass> {
      */
     std::shared_ptr<psr::HelperAnalyses> HA;
 
+    /**
+     * Set if the feasibility analysis was not run because no function of the module branches. All blocks reachable
+     * from the function entries are feasible then.
+     */
+    bool feasibilitySkipped = false;
+
     /**
      * Internal results of the loop bound analysis
      */
@@ -162,9 +168,7 @@ class PhasarHandlerPass : public llvm::PassInfoMixin<PhasarHandlerPass> {
     /**
     * Internal results of the feasibility analysis
     */
-    std::unique_ptr<psr::OwningSolverResults<const llvm::Instruction *, const llvm::Value *,
-    Feasibility::FeasibilityElement>>
-    FeasibilityResult;
+    std::unique_ptr<Feasibility::ResultsTy> FeasibilityResult;
 
     /**
      * Execute the analysis on the given module, using the provided FunctionAnalysisManager to
@@ -174,6 +178,37 @@ class PhasarHandlerPass : public llvm::PassInfoMixin<PhasarHandlerPass> {
      */
     void runAnalysis(llvm::Module &M, llvm::FunctionAnalysisManager *FAM);
 
+    /**
+     * Build the PhASAR helper analyses on first use. Constructing the ICFG and the points-to information dominates the
+     * runtime on small modules, so it is deferred until an analysis actually needs it.
+     * @return Helper analyses of the module under analysis
+     */
+    std::shared_ptr<psr::HelperAnalyses> getHelperAnalyses();
+
+    /**
+     * Check whether any defined function of the module contains a loop
+     * @param M Module to check
+     * @param FAM FunctionAnalysisManager to retrieve the loop info from
+     * @return true if at least one loop exists
+     */
+    static bool moduleHasLoops(llvm::Module &M, llvm::FunctionAnalysisManager *FAM);
+
+    /**
+     * Check whether any defined function of the module contains a terminator with more than one successor. Without
+     * such a terminator no path condition can arise, so every reachable block is feasible.
+     * @param M Module to check
+     * @return true if at least one block branches
+     */
+    static bool moduleHasBranches(llvm::Module &M);
+
+    /**
+     * Build the feasibility information of a function that was not analyzed because no function of the module
+     * branches
+     * @param Func Function to build the information for
+     * @return Map marking every block reachable from the entry as feasible
+     */
+    static Feasibility::BlockFeasibilityMap trivialFeasibilityOfFunction(llvm::Function *Func);
+
     /**
      * Get the name of the given basic block.
      * @param BB Basic block to get the name of
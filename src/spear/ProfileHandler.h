@@ -77,6 +77,13 @@ class ProfileHandler {
      */
     void read(const std::string& filename);
 
+    /**
+     * Select the cost table of a core type of a hybrid CPU. Profiles read afterwards use the table of this core type
+     * as their "cpu" table, if they contain one.
+     * @param coreType Name of the core type, empty for the default table
+     */
+    void selectCoreType(const std::string &coreType);
+
     /**
      * Query the local _profile variable
      */
@@ -97,6 +104,11 @@ class ProfileHandler {
      * Internal profile storage
      */
     json _profile;
+
+    /**
+     * Selected core type, empty for the default table
+     */
+    std::string _coreType;
 };
 
 #endif  // SRC_SPEAR_PROFILEHANDLER_H_
@@ -11,6 +11,7 @@
 #include <string>
 #include <utility>
 #include <map>
+#include <unordered_map>
 #include "LoopTree.h"
 #include "AnalysisStrategy.h"
 #include "llvm/IR/BasicBlock.h"
@@ -242,7 +243,8 @@ class ProgramGraph {
     std::vector<Node *> nodes;
 
     /**
-     * Vector containing references to the edges of the graph
+     * Vector containing references to the edges of the graph. Changes have to go through the methods of the graph, so
+     * the edge index stays up to date
      */
     std::vector<Edge *> edges;
 
@@ -294,11 +296,17 @@ class ProgramGraph {
     Node *findBlock(llvm::BasicBlock *basicBlock);
 
     /**
-     * Calculates the edges going outwards from the given node.
+     * Looks up the edges going outwards from the given node.
      * @param sourceNode A reference to the Node the edges are extending from
-     * @return Returns a vector of references to the edges
+     * @return Returns a vector of references to the edges, ordered like the edges of the graph
      */
-    std::vector<Edge *> findEdgesStartingAtNode(Node *sourceNode);
+    const std::vector<Edge *> &findEdgesStartingAtNode(Node *sourceNode) const;
+
+    /**
+     * Removes all edges starting at the given Node from this ProgramGraph
+     * @param sourceNode A reference to the Node the edges are extending from
+     */
+    void removeEdgesStartingAtNode(Node *sourceNode);
 
     /**
      * Removes the given Node from this ProgramTre
@@ -343,6 +351,22 @@ class ProgramGraph {
     std::string getNodeColor(double nodeEnergy, double maxEng);
 
     json populateJsonRepresentation(json functionObject);
+
+ private:
+    /**
+     * Maps the BasicBlocks of this graph to the Nodes holding them. LoopNodes hold no block and are not indexed
+     */
+    std::unordered_map<llvm::BasicBlock *, Node *> blockIndex;
+
+    /**
+     * Maps the Nodes of this graph to the edges starting at them
+     */
+    std::unordered_map<Node *, std::vector<Edge *>> outgoingEdges;
+
+    /**
+     * Rebuilds the outgoing edges of all nodes from the edges of the graph
+     */
+    void indexEdges();
 };
 
 
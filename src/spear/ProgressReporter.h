@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#ifndef SRC_SPEAR_PROGRESSREPORTER_H_
+#define SRC_SPEAR_PROGRESSREPORTER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * ProgressReporter class
+ *
+ * Tracks the work units of the currently running phase (e.g. functions solved or bytes written) and reports the
+ * progress, the rate and the estimated remaining time on stderr. On a terminal a single status line is redrawn,
+ * otherwise a machine-readable JSON record is emitted periodically.
+ *
+ * Phases nest: a phase begun while another one is running suspends the outer phase until it ends, e.g. the output
+ * written at the end of an analysis or the solving of a single analysis inside the whole run. advance() always
+ * applies to the innermost phase.
+ *
+ * advance() is safe to call from multiple threads. It only performs an atomic increment and a clock read unless a
+ * report is due, so it can be called once per work unit.
+ */
+class ProgressReporter {
+ public:
+    // Access the singleton instance
+    static ProgressReporter &getInstance();
+
+    // Deleted copy/move to enforce singleton
+    ProgressReporter(const ProgressReporter &) = delete;
+    ProgressReporter &operator=(const ProgressReporter &) = delete;
+    ProgressReporter(ProgressReporter &&) = delete;
+    ProgressReporter &operator=(ProgressReporter &&) = delete;
+
+    /**
+     * Enable or disable the reporting. Disabling discards the running phases without a final report
+     * @param enabled True to report the progress
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * Start a new phase. A phase that is still running is suspended until the new phase ends
+     * @param phase Name of the phase
+     * @param unit Name of the work units of the phase
+     * @param totalUnits Amount of work units of the phase, 0 if unknown
+     * @return True if the phase was started, false if the reporting is disabled
+     */
+    bool beginPhase(const std::string &phase, const std::string &unit, uint64_t totalUnits);
+
+    /**
+     * Mark work units of the current phase as done
+     * @param units Amount of finished work units
+     */
+    void advance(uint64_t units = 1);
+
+    /**
+     * Finish the current phase, report its final state and resume the phase it suspended
+     */
+    void endPhase();
+
+ private:
+    ProgressReporter();
+
+    /**
+     * Phase suspended by a nested phase
+     */
+    struct SuspendedPhase {
+        std::string name;
+        std::string unit;
+        uint64_t completedUnits;
+        uint64_t totalUnits;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /**
+     * Minimal time between two reports on a terminal
+     */
+    static constexpr std::chrono::milliseconds ttyInterval{200};
+
+    /**
+     * Minimal time between two machine-readable records
+     */
+    static constexpr std::chrono::milliseconds recordInterval{5000};
+
+    /**
+     * Write the current state of the phase. Expects the phase lock to be held
+     * @param final True if the phase is finished
+     */
+    void report(bool final);
+
+    /**
+     * Schedule the next report of the current phase one interval from now
+     */
+    void scheduleNextReport();
+
+    std::atomic<bool> enabled{false};
+
+    /**
+     * True if stderr is connected to a terminal
+     */
+    bool isTTY = false;
+
+    /**
+     * True while a phase is running
+     */
+    std::atomic<bool> phaseActive{false};
+
+    std::atomic<uint64_t> completedUnits{0};
+    uint64_t totalUnits = 0;
+
+    /**
+     * Time of the next report in ns of the steady clock
+     */
+    std::atomic<int64_t> nextReport{0};
+
+    /**
+     * Lock protecting the phase description and the output
+     */
+    std::mutex phaseMutex;
+
+    std::string phaseName;
+    std::string unitName;
+    std::chrono::steady_clock::time_point phaseStart;
+
+    /**
+     * Phases suspended by the current phase, the innermost last
+     */
+    std::vector<SuspendedPhase> suspendedPhases;
+};
+
+/**
+ * Scoped phase of the ProgressReporter. Begins the phase on construction and ends it on destruction
+ */
+class ProgressPhase {
+ public:
+    ProgressPhase(const std::string &phase, const std::string &unit, uint64_t totalUnits)
+        : started(ProgressReporter::getInstance().beginPhase(phase, unit, totalUnits)) {}
+
+    ~ProgressPhase() {
+        // A phase that was never started must not end the phase it would have been nested in
+        if (started) {
+            ProgressReporter::getInstance().endPhase();
+        }
+    }
+
+    ProgressPhase(const ProgressPhase &) = delete;
+    ProgressPhase &operator=(const ProgressPhase &) = delete;
+
+ private:
+    bool started;
+};
+
+#endif  // SRC_SPEAR_PROGRESSREPORTER_H_
@@ -41,6 +41,23 @@ class RegisterReader {
          * @return The current multiplier used for the energy-counter
          */
         double readMultiplier();
+        /**
+         * Method to read the raw value of the energy-counter without applying the energy-unit
+         * @return The current energy-counter in ticks of the energy-unit
+         */
+        uint64_t readEnergyCounter();
+        /**
+         * Checks if the register file of the given core can be read
+         * @param core The core to check
+         * @return True if the rapl registers of the core are readable
+         */
+        static bool isAccessible(int core);
+        /**
+         * Checks if the energy-counter read by this class is separate for every core. Only then can the energy of
+         * programs running concurrently on different cores be told apart
+         * @return True if every core has its own energy-counter
+         */
+        static bool hasPerCoreCounter();
 
  private:
         /**
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#ifndef SRC_SPEAR_SELFENERGYMETER_H_
+#define SRC_SPEAR_SELFENERGYMETER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "EnergyCounterSource.h"
+#include "EnergySampler.h"
+#include "configuration/configurationobjects.h"
+#include "nlohmann/json.hpp"
+
+/**
+ * SelfEnergyMeter class
+ *
+ * Measures the energy SPEAR itself consumes. The configured counter source is read at every phase boundary and, in the
+ * expensive phases, at the boundaries of every analyzed function. The package counter cannot separate concurrent work,
+ * so functions are only attributed in phases that process them sequentially.
+ * With a sampling rate, a background EnergySampler reads the source instead. It extends the counter to 64 bits, which
+ * keeps long phases correct across wraparounds, and records the power timeline of the whole run.
+ */
+class SelfEnergyMeter {
+ public:
+    // Access the singleton instance
+    static SelfEnergyMeter &getInstance();
+
+    // Deleted copy/move to enforce singleton
+    SelfEnergyMeter(const SelfEnergyMeter &) = delete;
+    SelfEnergyMeter &operator=(const SelfEnergyMeter &) = delete;
+    SelfEnergyMeter(SelfEnergyMeter &&) = delete;
+    SelfEnergyMeter &operator=(SelfEnergyMeter &&) = delete;
+
+    /**
+     * Enable the measurement with the given configuration
+     * @param configuration Self energy configuration of the analysis
+     */
+    void configure(const SelfEnergyConfiguration &configuration);
+
+    /**
+     * Enable the measurement with the given source
+     * @param counterSource Source to read the energy from
+     * @param samplingRate Samples per second of the background sampler, 0 to read the source at the boundaries only
+     */
+    void configure(std::unique_ptr<EnergyCounterSource> counterSource, unsigned samplingRate = 0);
+
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * Start measuring a phase. A phase that is still running is finished first
+     * @param phase Name of the phase
+     */
+    void beginPhase(const std::string &phase);
+
+    /**
+     * Finish the current phase
+     */
+    void endPhase();
+
+    /**
+     * Start attributing the energy of the current phase to a function
+     * @param functionName Name of the function
+     */
+    void beginFunction(const std::string &functionName);
+
+    /**
+     * Finish the attribution to the current function
+     */
+    void endFunction();
+
+    /**
+     * Finish the current phase and stop the background sampler
+     */
+    void stop();
+
+    /**
+     * Stop the background sampler until resumeSampler is called. A forked process only inherits the thread calling
+     * fork, so the sampler has to be stopped before forking and resumed in the parent and the child
+     */
+    void suspendSampler();
+
+    /**
+     * Restart a sampler stopped by suspendSampler
+     */
+    void resumeSampler();
+
+    /**
+     * Discard all measurements and the running phase, the source and the sampler are kept. Used by forked workers to
+     * report only their own measurements
+     */
+    void reset();
+
+    /**
+     * Add measurements in the format of toJson, e.g. the measurements of a worker process. The phases are added to
+     * the phases of the same name
+     * @param measurements JSON object returned by toJson
+     */
+    void merge(const nlohmann::json &measurements);
+
+    /**
+     * Return all measurements
+     * @return JSON object with the energy and wall time per phase and per function
+     */
+    nlohmann::json toJson();
+
+    /**
+     * Return the power timeline recorded by the background sampler
+     * @return JSON timeline of the sampler or null if the meter does not sample
+     */
+    nlohmann::json timelineToJson();
+
+ private:
+    SelfEnergyMeter() = default;
+
+    struct Reading {
+        uint64_t counter;
+        std::chrono::steady_clock::time_point time;
+    };
+
+    struct Measurement {
+        double joules = 0;
+        double seconds = 0;
+        uint64_t count = 0;
+    };
+
+    struct PhaseMeasurement {
+        Measurement total;
+        std::unordered_map<std::string, Measurement> functions;
+    };
+
+    /**
+     * Read the counter source. Expects the lock to be held
+     * @return Current reading
+     */
+    Reading read();
+
+    /**
+     * Add the difference between two readings to a measurement. Expects the lock to be held
+     * @param measurement Measurement to add to
+     * @param start Earlier reading
+     * @param end Later reading
+     */
+    void accumulate(Measurement &measurement, const Reading &start, const Reading &end) const;
+
+    bool enabled = false;
+
+    std::unique_ptr<EnergyCounterSource> source;
+    std::unique_ptr<EnergySampler> sampler;
+    bool samplerSuspended = false;
+
+    /**
+     * Lock protecting the source and the measurements
+     */
+    std::mutex meterMutex;
+
+    /**
+     * Phases in the order they were first measured
+     */
+    std::vector<std::string> phaseOrder;
+    std::unordered_map<std::string, PhaseMeasurement> phases;
+
+    bool phaseActive = false;
+    std::string currentPhase;
+    Reading phaseStart{};
+
+    bool functionActive = false;
+    std::string currentFunction;
+    Reading functionStart{};
+};
+
+/**
+ * Scoped phase of the SelfEnergyMeter
+ */
+class SelfEnergyPhase {
+ public:
+    explicit SelfEnergyPhase(const std::string &phase) { SelfEnergyMeter::getInstance().beginPhase(phase); }
+
+    ~SelfEnergyPhase() { SelfEnergyMeter::getInstance().endPhase(); }
+
+    SelfEnergyPhase(const SelfEnergyPhase &) = delete;
+    SelfEnergyPhase &operator=(const SelfEnergyPhase &) = delete;
+};
+
+/**
+ * Scoped function attribution of the SelfEnergyMeter
+ */
+class SelfEnergyFunction {
+ public:
+    explicit SelfEnergyFunction(const std::string &functionName) {
+        SelfEnergyMeter::getInstance().beginFunction(functionName);
+    }
+
+    ~SelfEnergyFunction() { SelfEnergyMeter::getInstance().endFunction(); }
+
+    SelfEnergyFunction(const SelfEnergyFunction &) = delete;
+    SelfEnergyFunction &operator=(const SelfEnergyFunction &) = delete;
+};
+
+#endif  // SRC_SPEAR_SELFENERGYMETER_H_
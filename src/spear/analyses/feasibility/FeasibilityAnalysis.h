@@ -112,6 +112,23 @@ class FeasibilityAnalysis final  : public psr::IDETabulationProblem<FeasibilityD
      */
     EdgeFunctionType getNormalEdgeFunction(n_t Curr, d_t CurrNode, n_t Succ, d_t SuccNode) override;
 
+    /**
+     * Get the manager holding the formula sets and environments of the analysis
+     * @return Manager of the analysis
+     */
+    FeasibilityAnalysisManager *getManager() const noexcept {
+        return manager.get();
+    }
+
+    /**
+     * Restrict the initial seeds to a single function. As no facts cross call edges, solving the problem then
+     * computes the values of this function only
+     * @param function Function to seed, nullptr seeds all entry points
+     */
+    void setSeedFunction(const llvm::Function *function) noexcept {
+        seedFunction = function;
+    }
+
  private:
     /**
      * Manager component of the analysis, responsible for managing the state of the analysis, including
@@ -126,6 +143,11 @@ class FeasibilityAnalysis final  : public psr::IDETabulationProblem<FeasibilityD
      */
     const psr::LLVMBasedICFG *ICFG = nullptr;
 
+    /**
+     * Function the seeds are restricted to, nullptr if all entry points are seeded
+     */
+    const llvm::Function *seedFunction = nullptr;
+
     /**
      * Generates the initial seeds for the analysis, which are the starting points for the data flow analysis.
      * @return Set of initial seeds, where each seed is a pair of a node and a set of facts.
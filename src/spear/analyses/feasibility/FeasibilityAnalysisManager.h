@@ -9,13 +9,17 @@
 #include "FeasibilityElement.h"
 #include "FeasibilityEnvironment.h"
 
+#include <llvm/ADT/APInt.h>
 #include <llvm/ADT/SmallPtrSet.h>
 #include <phasar/DataFlow/IfdsIde/EdgeFunction.h>
 
+#include <atomic>
 #include <deque>
+#include <map>
 #include <set>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Feasibility {
@@ -33,6 +37,100 @@ struct ExpressionComperator {
     }
 };
 
+/**
+ * Inclusive range [low, high] of consecutive case values of a switch, compared unsigned
+ */
+struct SwitchCaseRange {
+    llvm::APInt low;
+    llvm::APInt high;
+};
+
+/**
+ * Condition of a single switch edge in compressed form. The edge is taken if the condition lies in one of the ranges,
+ * or, for the default edge, if it lies in none of them.
+ */
+struct SwitchEdgeRanges {
+    /**
+     * Sorted, disjoint and non-adjacent ranges of case values
+     */
+    std::vector<SwitchCaseRange> ranges;
+
+    /**
+     * True if the edge is the default edge and the ranges hold the values of all cases leaving to other blocks
+     */
+    bool complement = false;
+
+    /**
+     * Amount of case values the ranges were merged from
+     */
+    size_t caseCount = 0;
+};
+
+/**
+ * Size and lookup cost of the environments of a manager
+ */
+struct EnvironmentStatistics {
+    /**
+     * Environments created, excluding the empty environment
+     */
+    size_t environments = 0;
+
+    /**
+     * Bindings stored over all environment nodes
+     */
+    size_t bindings = 0;
+
+    /**
+     * Longest chain of nodes from an environment to the root
+     */
+    uint32_t maxDepth = 0;
+
+    /**
+     * Lookups of a key in an environment
+     */
+    uint64_t lookups = 0;
+
+    /**
+     * Environment nodes searched by all lookups
+     */
+    uint64_t visitedNodes = 0;
+};
+
+/**
+ * Outcome of a collection of the formula sets and environments that no live element references any more
+ */
+struct PoolCollectionStatistics {
+    /**
+     * Sets stored before the collection, excluding top and bottom
+     */
+    size_t sets = 0;
+
+    /**
+     * Sets whose storage was released
+     */
+    size_t reclaimedSets = 0;
+
+    /**
+     * Atoms held by the released sets
+     */
+    size_t reclaimedAtoms = 0;
+
+    /**
+     * Environments stored before the collection, excluding the empty environment
+     */
+    size_t environments = 0;
+
+    /**
+     * Environments whose node was released
+     */
+    size_t reclaimedEnvironments = 0;
+
+    /**
+     * Duration of the collection in microseconds
+     */
+    uint64_t durationUs = 0;
+};
+
 /**
  * FeasibilityAnalysisManager is the central component for managing the state of the feasibility analysis, including
  * the storage of formulas (as sets of atomic formulas) and environments (variable bindings). It
@@ -116,6 +214,15 @@ class FeasibilityAnalysisManager {
      */
     uint32_t addAtom(uint32_t baseId, const z3::expr &atom);
 
+    /**
+     * Add several atomic formulas to the set represented by baseId at once. Only the resulting set is interned, none
+     * of the sets in between.
+     * @param baseId Base ID representing the original set of formulas.
+     * @param atoms Atoms to add to the set represented by baseId.
+     * @return Unique ID representing the new set of formulas that includes all atoms.
+     */
+    uint32_t addAtoms(uint32_t baseId, const std::vector<z3::expr> &atoms);
+
     /**
      * Calculate the intersection of the sets represented by aId and bId, and return the ID of the resulting set.
      * @param aId Id representing the first set of formulas.
@@ -153,9 +260,19 @@ class FeasibilityAnalysisManager {
      */
     uint32_t extendEnv(uint32_t baseEnvId, const llvm::Value *key, const llvm::Value *val);
 
+    /**
+     * Extend the environment represented by baseEnvId with all given bindings at once. The bindings are stored in a
+     * single environment node, so lookups walk one node instead of one node per binding.
+     * @param baseEnvId Environment ID representing environment to extend.
+     * @param bindings Bindings to add. Self-bindings are dropped, for duplicate keys the last binding wins.
+     * @return Id of the new environment. If an identical environment already exists, returns the existing Id.
+     */
+    uint32_t extendEnvBindings(uint32_t baseEnvId, EnvBindings bindings);
+
     /**
      * Apply the effects of PHI nodes at the successor block (succ) on the environment represented by inEnvId,
-     * and return the Id of the resulting environment.
+     * and return the Id of the resulting environment. All phis of the edge are bound together in one environment
+     * node. Their incoming values are resolved in the input environment, as phis are evaluated in parallel.
      * @param inEnvId Environment ID representing the input environment before applying PHI node effects.
      * @param pred Predecessor BasicBlock from which the control flow is coming.
      * This is used to determine the incoming values for PHI nodes in the successor block.
@@ -165,6 +282,22 @@ class FeasibilityAnalysisManager {
      */
     uint32_t applyPhiPack(uint32_t inEnvId, const llvm::BasicBlock *pred, const llvm::BasicBlock *succ);
 
+    /**
+     * Get the case values of the given switch that lead to succ, merged into ranges of consecutive values.
+     * The ranges only depend on the CFG, so they are computed once per edge and cached.
+     * @param switchInst Switch the edge leaves
+     * @param succ Successor BasicBlock the edge leads to
+     * @return Compressed condition of the edge
+     */
+    const SwitchEdgeRanges &getSwitchRanges(const llvm::SwitchInst *switchInst, const llvm::BasicBlock *succ);
+
+    /**
+     * Merge the given case values into sorted ranges of consecutive values
+     * @param values Case values, all of the same bit width. Duplicates are allowed
+     * @return Sorted, disjoint and non-adjacent ranges covering exactly the given values
+     */
+    static std::vector<SwitchCaseRange> compressCaseValues(std::vector<llvm::APInt> values);
+
     /**
      * Get the set of atomic formulas corresponding to the given ID.
      * This is a wrapper around getSet that returns a vector instead of a set.
@@ -181,6 +314,40 @@ class FeasibilityAnalysisManager {
      */
     SetKey makeSetKey(const ExprSet &set) const;
 
+    /**
+     * Calculate the size and lookup cost of the environments created so far
+     * @return Environment statistics
+     */
+    EnvironmentStatistics getEnvironmentStatistics() const;
+
+    /**
+     * Log the environment statistics and export them as metrics
+     */
+    void logEnvironmentStatistics() const;
+
+    /**
+     * Release all sets and environments that are not referenced by the given elements. The ids of the surviving
+     * entries do not change, released ids are reused by later sets and environments. The environments a live
+     * environment extends are kept as well. Must not run while an analysis is using the manager.
+     * @param liveElements Elements that are still in use, e.g. the values stored in the solver results
+     * @return Amount of released entries and the duration of the collection
+     */
+    PoolCollectionStatistics collectGarbage(const std::vector<FeasibilityElement> &liveElements);
+
+    /**
+     * Get the statistics of the last collection
+     * @return Statistics of the last collectGarbage() call, empty if no collection ran
+     */
+    const PoolCollectionStatistics &getLastCollection() const {
+        return LastCollection;
+    }
+
+    /**
+     * Count the formula sets currently stored, excluding top, bottom and released sets
+     * @return Amount of stored sets
+     */
+    size_t getStoredSetCount() const;
+
  private:
     /**
      * Internal storage for the Z3 context used by this manager.
@@ -212,11 +379,21 @@ class FeasibilityAnalysisManager {
 
     /**
      * Environment cache map. This map is used to efficiently check for the existence of environments and to avoid
-     * creating duplicate environments. The key is an EnvKey, which represents a single variable binding
+     * creating duplicate environments. The key is an EnvKey, which represents the bindings of a node
      * in the environment, and the value is the ID of the environment that contains this binding.
      */
     std::unordered_map<EnvKey, uint32_t, EnvKeyHash> EnvCache;
 
+    /**
+     * Lookups of a key in an environment, counted for the environment statistics
+     */
+    mutable std::atomic<uint64_t> EnvLookups{0};
+
+    /**
+     * Environment nodes searched by all lookups, counted for the environment statistics
+     */
+    mutable std::atomic<uint64_t> EnvVisitedNodes{0};
+
     /**
      * Mutex to ensures mutual exclusion when accessing the environment cache
      */
@@ -229,11 +406,37 @@ class FeasibilityAnalysisManager {
      */
     std::unordered_map<SetKey, uint32_t, SetKeyHash> CanonicalSetCache;
 
+    /**
+     * Ids of released sets that can be handed out again
+     */
+    std::vector<uint32_t> FreeSetIds;
+
+    /**
+     * Ids of released environments that can be handed out again. Their nodes stay in EnvPool and are overwritten
+     */
+    std::vector<uint32_t> FreeEnvIds;
+
+    /**
+     * Statistics of the last collection
+     */
+    PoolCollectionStatistics LastCollection;
+
     /**
      * Mutex to ensure mutual exclusion when accessing the set cache
      */
     mutable std::mutex SetsMutex;
 
+    /**
+     * Cache of the compressed switch edge conditions, keyed by the switch and the successor of the edge. Entries are
+     * handed out by reference, so the container must keep them in place on insertion
+     */
+    std::map<std::pair<const llvm::SwitchInst *, const llvm::BasicBlock *>, SwitchEdgeRanges> SwitchRangeCache;
+
+    /**
+     * Mutex to ensure mutual exclusion when accessing the switch range cache
+     */
+    std::mutex SwitchRangeMutex;
+
     /**
      * Cache the given set of atomic formulas, and return a unique ID representing this set.
      * If an identical set is already present, returns the existing ID for that set.
@@ -109,6 +109,21 @@ struct FeasibilityAddAtomsEF {
         atoms.emplace_back(predecessor, sucessor, icmp, areWeOnTheTrueEdge);
     }
 
+    /**
+     * Create the EF with a single new atom for the edge from a switch to one of its successors.
+     * @param manager Manager the EF operates on
+     * @param predecessor BasicBlock containing the switch
+     * @param sucessor Successor BasicBlock of the EF
+     * @param switchInst Switch instruction the edge is based upon
+     */
+    FeasibilityAddAtomsEF(FeasibilityAnalysisManager *manager,
+                          const llvm::BasicBlock *predecessor,
+                          const llvm::BasicBlock *sucessor,
+                          const llvm::SwitchInst *switchInst)
+    : manager(manager) {
+        atoms.emplace_back(predecessor, sucessor, switchInst);
+    }
+
     /**
      * Update the lattice element
      * @param source Current state of the lattice element
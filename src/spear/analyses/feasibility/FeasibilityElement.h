@@ -23,7 +23,7 @@ class FeasibilityAnalysisManager;
 /**
 * ICMP and phi aware propagation atom
   * Each LazyAtom carries the CFG edge (Pred->Succ) whose PHIs must be applied
-  * before evaluating the ICmp atom.
+  * before evaluating the ICmp atom. Atoms of switch edges carry the switch instead of an ICmp.
   */
 struct LazyAtom {
   /**
@@ -46,6 +46,12 @@ struct LazyAtom {
    */
   bool TrueEdge = true;
 
+  /**
+   * Switch instruction realizing the comparison if the edge leaves a switch, the case values leading to SuccBB are
+   * encoded as ranges
+   */
+  const llvm::SwitchInst *switchInst = nullptr;
+
   /**
    * Dummy default constructor
    */
@@ -65,6 +71,18 @@ struct LazyAtom {
     bool areWeOnTheTrueEdge)
   : PredBB(predecessorBlock), SuccBB(successorBlock), icmp(icmpInstruction), TrueEdge(areWeOnTheTrueEdge) {}
 
+  /**
+   * Create a new LazyAtom for the edge from a switch to one of its successors
+   * @param predecessorBlock BasicBlock containing the switch
+   * @param successorBlock BasicBlock the edge leads to
+   * @param switchInstruction Pointer to the switch instruction the atom is build upon
+   */
+  LazyAtom(
+    const llvm::BasicBlock *predecessorBlock,
+    const llvm::BasicBlock *successorBlock,
+    const llvm::SwitchInst *switchInstruction)
+  : PredBB(predecessorBlock), SuccBB(successorBlock), switchInst(switchInstruction) {}
+
   /**
    * Comparison operator. Check equality of LazyAtoms depending on blocks, underlying ICMP instruction and the
    * underlying edge boolean state.
@@ -72,7 +90,8 @@ struct LazyAtom {
    * @return
    */
   bool operator==(const LazyAtom &other) const noexcept {
-    return PredBB == other.PredBB && SuccBB == other.SuccBB && icmp == other.icmp && TrueEdge == other.TrueEdge;
+    return PredBB == other.PredBB && SuccBB == other.SuccBB && icmp == other.icmp && TrueEdge == other.TrueEdge &&
+           switchInst == other.switchInst;
   }
 };
 
@@ -12,13 +12,28 @@
 #ifndef SRC_SPEAR_ANALYSES_FEASIBILITY_FEASIBILITYENVIRONMENT_H_
 #define SRC_SPEAR_ANALYSES_FEASIBILITY_FEASIBILITYENVIRONMENT_H_
 
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/IR/Value.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
 namespace Feasibility {
 
+/**
+ * A single variable binding (key-value pair). The key is typically a phi node, the value its incoming value.
+ */
+using EnvBinding = std::pair<const llvm::Value *, const llvm::Value *>;
+
+/**
+ * Flat list of bindings sorted by the address of their key, without duplicate keys
+ */
+using EnvBindings = llvm::SmallVector<EnvBinding, 4>;
+
 /**
  * Main component of the environment. Represents a linked list of variable bindings,
- * where each node represents a single binding (key-value pair).
+ * where each node holds the bindings installed together, e.g. all phis of a CFG edge.
  * The linking between the nodes represents the nesting of environments as phi nodes also might be nested.
  */
 class EnvNode {
@@ -29,19 +44,36 @@ class EnvNode {
     const EnvNode *parent = nullptr;
 
     /**
-     * The key of the binding represented by this node. This is typically an LLVM value (e.g., a variable).
+     * Id of the parent environment, 0 if this is the root node
      */
-    const llvm::Value *key = nullptr;
+    uint32_t parentId = 0;
 
     /**
-     * The value of the binding represented by this node. This is typically an LLVM value (e.g., a variable or a constant).
+     * The bindings of this node, sorted by key
      */
-    const llvm::Value *val = nullptr;
+    EnvBindings bindings;
+
+    /**
+     * Amount of nodes from this node to the root, including this node
+     */
+    uint32_t depth = 1;
+
+    /**
+     * Search the bindings of this node for the given key
+     * @param key Key to search for
+     * @return Bound value, nullptr if this node does not bind the key
+     */
+    const llvm::Value *find(const llvm::Value *key) const {
+        auto it = std::lower_bound(bindings.begin(), bindings.end(), key,
+                                   [](const EnvBinding &binding, const llvm::Value *k) { return binding.first < k; });
+        return it != bindings.end() && it->first == key ? it->second : nullptr;
+    }
 };
 
 /**
- * Key for the environment map, representing a single binding in the environment.
- * This struct is used as the key in the environment map to allow for efficient lookup of bindings based on the environment ID and the key-value pair.
+ * Key for the environment map, representing the bindings a node adds to a base environment.
+ * This struct is used as the key in the environment map to allow for efficient lookup of bindings based on the
+ * environment ID and the key-value pairs.
  */
 struct EnvKey {
     /**
@@ -51,36 +83,31 @@ struct EnvKey {
     uint32_t Base = 0;
 
     /**
-     * The key of the binding represented by this struct.
-     */
-    const llvm::Value *key = nullptr;
-
-    /**
-     * The underlying value of the binding represented by this struct.
+     * The bindings added to the base environment, sorted by key.
      */
-    const llvm::Value *value = nullptr;
+    EnvBindings bindings;
 
     /**
      * Comparison operator for EnvKey, used for equality comparison in the environment map.
-     * Equality is established over base id, key and value, as these three components uniquely
-     * identify a binding in the environment.
+     * Equality is established over base id and bindings, as these components uniquely
+     * identify a node in the environment.
      * @param other other element to check equality against
-     * @return true if the two EnvKey instances represent the same binding in the same environment, false otherwise
+     * @return true if the two EnvKey instances represent the same bindings in the same environment, false otherwise
      */
     bool operator==(const EnvKey &other) const noexcept {
-        return Base == other.Base && key == other.key && value == other.value;
+        return Base == other.Base && bindings == other.bindings;
     }
 };
 
 /**
  * Hash function for EnvKey, used for hashing in the environment map.
- * The hash is computed based on the base id, key and value of the EnvKey,
- * as these three components uniquely identify a binding in the environment.
+ * The hash is computed based on the base id and all bindings of the EnvKey,
+ * as these components uniquely identify a node in the environment.
  */
 struct EnvKeyHash {
     /**
      * Hash function for EnvKey, used for hashing in the environment map.
-     * Uses Fibonacci hashing to combine the hash values of the base id, key and value of the EnvKey.
+     * Uses Fibonacci hashing to combine the hash values of the base id, keys and values of the EnvKey.
      *
      * @param k the EnvKey to hash
      * @return the hash value for the given EnvKey
@@ -90,8 +117,10 @@ struct EnvKeyHash {
         auto mix = [&](std::size_t x) {
             h ^= x + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
         };
-        mix(std::hash<const void *>{}(static_cast<const void *>(k.key)));
-        mix(std::hash<const void *>{}(static_cast<const void *>(k.value)));
+        for (const auto &[key, value] : k.bindings) {
+            mix(std::hash<const void *>{}(static_cast<const void *>(key)));
+            mix(std::hash<const void *>{}(static_cast<const void *>(value)));
+        }
         return h;
     }
 };
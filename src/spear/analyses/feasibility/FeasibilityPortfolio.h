@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+ */
+
+#ifndef SRC_SPEAR_ANALYSES_FEASIBILITY_FEASIBILITYPORTFOLIO_H_
+#define SRC_SPEAR_ANALYSES_FEASIBILITY_FEASIBILITYPORTFOLIO_H_
+
+#include <z3++.h>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "configuration/configurationobjects.h"
+
+namespace Feasibility {
+
+/**
+ * Latency statistics of all satisfiability queries
+ */
+struct SatLatencyReport {
+    size_t queries;
+    size_t escalatedQueries;
+    int64_t median;
+    int64_t p99;
+    int64_t max;
+};
+
+/**
+ * SatPortfolio class
+ *
+ * Checks sets of formulas for satisfiability. Each query is first solved by the default solver within a short
+ * initial budget. Queries that exceed the budget are escalated to a portfolio of diverse solver configurations that
+ * run in parallel. The first configuration that answers wins, all other configurations are interrupted.
+ *
+ * Z3 contexts are not thread safe, so every configuration works on its own context. The formulas are translated into
+ * these contexts before any thread is started.
+ */
+class SatPortfolio {
+ public:
+    /**
+     * Check the given set of formulas for satisfiability
+     * @param set Formulas to check
+     * @param ctx Context the formulas belong to
+     * @param configuration Portfolio configuration
+     * @return false if the set is unsat, true if it is sat or could not be decided
+     */
+    static bool isSat(const std::vector<z3::expr> &set, z3::context *ctx,
+                      const SatPortfolioConfiguration &configuration);
+
+    /**
+     * Calculate the latency statistics of all queries recorded so far. Median and p99 are estimated from a uniform
+     * sample of at most latencySampleSize queries, the amount of queries and the maximum are exact
+     * @return Latency report in µs
+     */
+    static SatLatencyReport getLatencyReport();
+
+    /**
+     * Log the latency statistics of all queries recorded so far
+     */
+    static void logLatencyReport();
+
+ private:
+    /**
+     * Names of the solver configurations used by the portfolio
+     */
+    static const std::vector<std::string> portfolioConfigurations;
+
+    /**
+     * Lock protecting the recorded latencies
+     */
+    static std::mutex statisticsMutex;
+
+    /**
+     * Maximal amount of latencies kept for the percentiles
+     */
+    static constexpr size_t latencySampleSize = 4096;
+
+    /**
+     * Reservoir sample of the latencies of all queries in µs
+     */
+    static std::vector<int64_t> latencies;
+
+    /**
+     * Amount of queries recorded so far
+     */
+    static size_t recordedQueries;
+
+    /**
+     * Highest latency recorded so far in µs
+     */
+    static int64_t maxLatency;
+
+    /**
+     * Amount of queries that exceeded the initial budget
+     */
+    static size_t escalatedQueries;
+
+    /**
+     * Solve the set with the default solver of the given context
+     * @param set Formulas to check
+     * @param ctx Context the formulas belong to
+     * @param timeout Timeout in ms, 0 disables the timeout
+     * @return Result of the check
+     */
+    static z3::check_result checkDefault(const std::vector<z3::expr> &set, z3::context *ctx, unsigned timeout);
+
+    /**
+     * Solve the set in parallel with all portfolio configurations
+     * @param set Formulas to check
+     * @param ctx Context the formulas belong to
+     * @param timeout Timeout of every configuration in ms, 0 disables the timeout
+     * @return Result of the first configuration that answered with sat or unsat, z3::unknown if none did
+     */
+    static z3::check_result checkPortfolio(const std::vector<z3::expr> &set, z3::context *ctx, unsigned timeout);
+
+    /**
+     * Create the solver for the given portfolio configuration
+     * @param configuration Name of the configuration
+     * @param ctx Context to create the solver in
+     * @return Configured solver
+     */
+    static z3::solver makeSolver(const std::string &configuration, z3::context &ctx);
+
+    /**
+     * Record the latency of a query
+     * @param latency Latency in µs
+     * @param escalated True if the query was escalated to the portfolio
+     */
+    static void recordLatency(int64_t latency, bool escalated);
+};
+
+}  // namespace Feasibility
+
+#endif  // SRC_SPEAR_ANALYSES_FEASIBILITY_FEASIBILITYPORTFOLIO_H_
@@ -8,21 +8,20 @@
 
 #include <llvm/IR/PassManager.h>
 #include <phasar/PhasarLLVM/HelperAnalyses.h>
-#include <phasar/DataFlow/IfdsIde/SolverResults.h>
 
 #include "FeasibilityAnalysis.h"
 
+#include <cstddef>
 #include <memory>
+#include <unordered_map>
 
 namespace Feasibility {
 
 /**
- * Resulttype of the analysis, which is a mapping from instructions to their corresponding feasibility elements.
+ * Resulttype of the analysis, which is a mapping from the terminators of all reached blocks to the feasibility element
+ * of the zero value at the terminator.
  */
-using ResultsTy = psr::OwningSolverResults<
-const llvm::Instruction *,
-const llvm::Value *,
-Feasibility::FeasibilityElement>;
+using ResultsTy = std::unordered_map<const llvm::Instruction *, Feasibility::FeasibilityElement>;
 
 /**
  * FeasibilityWrapper class
@@ -54,9 +53,19 @@ class FeasibilityWrapper {
     std::shared_ptr<Feasibility::FeasibilityAnalysis> problem;
 
  private:
+    /**
+     * Stored sets below which the pools are not collected during the solve
+     */
+    static constexpr size_t minimumCollectionSets = 4096;
+
     // Internal storage of the analysis results calculated by phasar
     std::unique_ptr<ResultsTy> cachedResults;
 
+    /**
+     * Release all sets and environments not referenced by the stored results
+     */
+    void collectGarbage();
+
     // Internal storage of the analysis manager so we can access llvms analysis information later on without
     // passing it down to our functions
     llvm::FunctionAnalysisManager *FAM = nullptr;
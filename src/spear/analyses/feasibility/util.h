@@ -98,10 +98,35 @@ class Util {
                                              uint32_t envId);
 
     /**
-     * Check if a set of z3 expressions is satisfiable.
+     * Create a new z3 expression representing the constraint the edge from a switch to succ imposes on the path
+     * condition. Consecutive case values are merged into ranges, each range costs a single unsigned comparison.
+     * @param manager The manager of the analysis, used to access the current environment and variable bindings.
+     * @param switchInst The switch instruction the edge leaves.
+     * @param succ The successor block the edge leads to.
+     * @param envId The ID of the environment to use for looking up variable bindings in the manager.
+     * @return A z3 expression that holds iff the switch condition selects the edge to succ
+     */
+    static z3::expr createConstraintFromSwitch(FeasibilityAnalysisManager *manager,
+                                               const llvm::SwitchInst *switchInst,
+                                               const llvm::BasicBlock *succ,
+                                               uint32_t envId);
+
+    /**
+     * Create a z3 expression that holds iff the given condition selects the given switch edge
+     * @param context The z3 context to create the expression in.
+     * @param condition Bit vector the switch branches on.
+     * @param edge Compressed case values of the edge.
+     * @return A z3 expression with one unsigned comparison per range of the edge
+     */
+    static z3::expr createConstraintFromRanges(z3::context &context, const z3::expr &condition,
+                                               const SwitchEdgeRanges &edge);
+
+    /**
+     * Check if a set of z3 expressions is satisfiable. Sets the solver cannot decide within the budgets of the
+     * configured portfolio count as satisfiable, see SatPortfolio::isSat
      * @param set Set to check for satisfiability
      * @param ctx Context to use for checking satisfiability
-     * @return true if the set is sat false otherwise
+     * @return false if the set is unsat, true otherwise
      */
     static bool setSat(std::vector<z3::expr> set, z3::context *ctx);
 
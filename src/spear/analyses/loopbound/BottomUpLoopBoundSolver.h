@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+*/
+
+#ifndef SRC_SPEAR_ANALYSES_LOOPBOUND_BOTTOMUPLOOPBOUNDSOLVER_H_
+#define SRC_SPEAR_ANALYSES_LOOPBOUND_BOTTOMUPLOOPBOUNDSOLVER_H_
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instruction.h>
+#include <llvm/IR/Module.h>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "LoopBound.h"
+#include "LoopBoundEdgeFunction.h"
+#include "ParallelLoopBoundSolver.h"
+
+namespace LoopBound {
+
+/**
+ * BottomUpLoopBoundSolver class
+ *
+ * Solves the LoopBoundIDEAnalysis bottom-up over the call graph and calculates the same values as the Phasar IDE
+ * solver. Instead of propagating every counter through the callees once per calling context, each function is
+ * summarized once per counter it can modify:
+ *
+ * - The call graph is ordered into strongly connected components in post-order, callees before their callers.
+ * - A function is tabulated intraprocedurally for every counter counted by a loop in it or in one of its transitive
+ *   callees. At a call, the summaries of the callees are composed with the call and return edge functions and applied
+ *   to the return sites, the call-to-return edge is always taken. The summary of the function is the jump function at
+ *   each of its return statements.
+ * - Functions of a recursive component are tabulated again until the summaries of the component stop changing.
+ * - Afterwards the counters are instantiated top-down: starting at the seeds, the values are passed from the calls
+ *   into the start points of the callees and every node applies its jump function to the value at the start point of
+ *   its function, like the two phases of the Phasar solver.
+ *
+ * DeltaInterval joins by hull, so the tabulation of a function terminates without widening.
+ */
+class BottomUpLoopBoundSolver {
+ public:
+    using n_t = LoopBoundIDEAnalysis::n_t;
+    using d_t = LoopBoundIDEAnalysis::d_t;
+    using l_t = LoopBoundIDEAnalysis::l_t;
+
+    /**
+     * Create a new bottom-up solver for the given problem
+     * @param problem Problem to solve
+     * @param interproceduralCFG ICFG of the program under analysis, only queried during construction
+     * @param module Module under analysis
+     */
+    BottomUpLoopBoundSolver(LoopBoundIDEAnalysis &problem, psr::LLVMBasedICFG &interproceduralCFG,
+                            llvm::Module &module);
+
+    /**
+     * Summarize all functions in call graph post-order and instantiate the summaries for every counter
+     */
+    void solve();
+
+    /**
+     * Query the value of the given fact at the given instruction
+     * @param instruction Instruction to query
+     * @param fact Fact to query
+     * @return Value of the fact if it reaches the instruction, std::nullopt otherwise
+     */
+    std::optional<DeltaInterval> resultAt(const llvm::Instruction *instruction, const llvm::Value *fact) const;
+
+    /**
+     * Return all values calculated by the solver
+     * @return Table mapping instruction -> fact -> value
+     */
+    const ParallelResultTable &getResults() const;
+
+    /**
+     * Return the amount of strongly connected components of the call graph the functions were summarized in
+     * @return Amount of components
+     */
+    size_t getNumberOfComponents() const;
+
+    /**
+     * Return the work performed by the last call to solve(). Widening is not used, so no widenings and narrowing
+     * rounds are reported
+     * @return Statistics of the summary and the instantiation phase
+     */
+    LoopBoundSolverStatistics getStatistics() const;
+
+ private:
+    /**
+     * Maps a node to the edge function from the start nodes of its function to it
+     */
+    using JumpFunctionTable = llvm::DenseMap<n_t, EF>;
+
+    /**
+     * Intraprocedural tabulation of a single counter in a single function
+     */
+    struct CounterTable {
+        JumpFunctionTable jumpFunctions;
+        // Summary of the function, maps each reached return statement to its jump function
+        llvm::DenseMap<n_t, EF> endSummaries;
+    };
+
+    /**
+     * Problem under analysis
+     */
+    LoopBoundIDEAnalysis &problem;
+
+    /**
+     * Strongly connected components of the call graph in post-order, containing only defined functions
+     */
+    std::vector<std::vector<const llvm::Function *>> components;
+
+    /**
+     * Initial seeds of every counter
+     */
+    llvm::DenseMap<d_t, std::vector<std::pair<n_t, l_t>>> counterSeeds;
+
+    /**
+     * Nodes carrying an initial seed of any fact. Phasar propagates values from them like from start points
+     */
+    llvm::DenseSet<n_t> seedNodes;
+
+    /**
+     * Defined callees of every call site, taken from the ICFG once
+     */
+    llvm::DenseMap<n_t, std::vector<const llvm::Function *>> calleesAt;
+
+    /**
+     * Counters every function is summarized for: counters of its own loops and of the loops of its transitive callees
+     */
+    llvm::DenseMap<const llvm::Function *, std::vector<d_t>> functionCounters;
+
+    /**
+     * Functions every counter is summarized in, the inverse of functionCounters
+     */
+    llvm::DenseMap<d_t, llvm::DenseSet<const llvm::Function *>> counterFunctions;
+
+    /**
+     * Summaries of all functions, tabulated with their start point and their seeds as start nodes
+     */
+    llvm::DenseMap<const llvm::Function *, llvm::DenseMap<d_t, CounterTable>> summaries;
+
+    /**
+     * Values of all counters, maps instruction -> fact -> value
+     */
+    ParallelResultTable results;
+
+    /**
+     * Statistics of the last solve
+     */
+    LoopBoundSolverStatistics statistics;
+
+    /**
+     * Store the seeds of the problem per counter
+     */
+    void collectSeeds();
+
+    /**
+     * Store the defined callees of every call site of the module
+     * @param interproceduralCFG ICFG to take the callees from
+     * @param module Module under analysis
+     */
+    void collectCallees(psr::LLVMBasedICFG &interproceduralCFG, llvm::Module &module);
+
+    /**
+     * Order the call graph into strongly connected components in post-order. Calls resolved by the ICFG are added to
+     * the LLVM call graph, so indirect calls are ordered like direct ones
+     * @param module Module under analysis
+     */
+    void orderComponents(llvm::Module &module);
+
+    /**
+     * Collect the counters every function is summarized for
+     */
+    void collectCounters();
+
+    /**
+     * Summarize the functions of the given component. Recursive components are tabulated until their summaries are
+     * stable
+     * @param component Functions of the component
+     */
+    void summarizeComponent(const std::vector<const llvm::Function *> &component);
+
+    /**
+     * Tabulate a counter within a single function, applying the summaries of the callees at its calls
+     * @param function Function to tabulate
+     * @param fact Counter to tabulate
+     * @param fromStartPoint True if the function is entered at its start point, false if only its seeds start paths
+     * @return Jump functions and end summaries of the function
+     */
+    CounterTable tabulate(const llvm::Function *function, d_t fact, bool fromStartPoint);
+
+    /**
+     * Calculate the values of a counter from its seeds and the summaries and store them in the result table
+     * @param fact Counter to instantiate
+     * @param seeds Initial seeds of the counter
+     */
+    void instantiate(d_t fact, const std::vector<std::pair<n_t, l_t>> &seeds);
+
+    /**
+     * Check if the given counter is summarized in the given function
+     * @param function Function to check
+     * @param fact Counter to check
+     * @return True if calls of the function pass the counter into it
+     */
+    bool isSummarized(const llvm::Function *function, d_t fact) const;
+
+    /**
+     * Compose the end summary of a callee with the call and return edge functions of the given call
+     * @param fact Counter under tabulation
+     * @param callSite Call entering the callee
+     * @param callee Function the summary belongs to
+     * @param exitNode Return statement the summary was published at
+     * @param summary Jump function at the return statement
+     * @param returnSite Return site of the call
+     * @return Edge function from the call to the return site
+     */
+    EF summaryEdgeFunction(d_t fact, n_t callSite, const llvm::Function *callee, n_t exitNode, const EF &summary,
+                           n_t returnSite);
+};
+
+}  // namespace LoopBound
+
+#endif  // SRC_SPEAR_ANALYSES_LOOPBOUND_BOTTOMUPLOOPBOUNDSOLVER_H_
@@ -109,6 +109,12 @@ class DeltaInterval {
      */
     bool isEmpty() const noexcept;
 
+    /**
+     * Check if an additive, multiplicative or division interval was widened to the int64 range
+     * @return true if one of the bounds is the minimum or maximum int64 value, false otherwise
+     */
+    bool isUnbounded() const noexcept;
+
     /**
      * Return the lower bound of the represented interval
      * @return Lower bound
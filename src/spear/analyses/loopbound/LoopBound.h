@@ -75,6 +75,8 @@ struct LoopBoundIncrementInstance {
     DeltaInterval::ValueType type;
 };
 
+class ParallelLoopBoundSolver;
+
 /**
  * LoopBoundIDEAnalysis class
  * Implements the LoopBound analysis
@@ -129,6 +131,15 @@ class LoopBoundIDEAnalysis final  : public psr::IDETabulationProblem<LoopBoundDo
     static std::optional<LoopBoundIncrementInstance> extractConstIncFromStore(
     const llvm::StoreInst *storeInst, const llvm::Value *counterRoot);
 
+    /**
+     * Checks if any store inside the loop changes the counter by a constant, i.e. if the analysis can find an
+     * increment at all. Loops without such a store are not seeded and end up as UNKNOWN_LOOP.
+     * @param loop Loop to check
+     * @param counterRoot Counter of the loop
+     * @return True if extractConstIncFromStore succeeds for a store in the loop, false otherwise
+     */
+    static bool hasAffineCounter(llvm::Loop *loop, const llvm::Value *counterRoot);
+
     /**
      * Getter to return the internal list of LoopParamterDescriptions
      * @return Returns a vector of the descriptions.
@@ -151,6 +162,9 @@ class LoopBoundIDEAnalysis final  : public psr::IDETabulationProblem<LoopBoundDo
     static std::optional<LoopCounterICMP> findCounterFromICMP(llvm::ICmpInst *inst, llvm::Loop *loop);
 
  private:
+    // The parallel solver drives the flow and edge functions of the problem just like the Phasar solver does
+    friend class ParallelLoopBoundSolver;
+
     // Loops found by llvm in the current program
     std::vector<llvm::Loop *> loops;
 
@@ -403,6 +403,25 @@ EF edgeIdentity();
  */
 EF edgeTop();
 
+/**
+ * Widen a jump function that keeps growing. Every bound of an additive, multiplicative or division function that
+ * grew from previous to joined jumps to the minimum or maximum int64 value, so the function cannot grow any further.
+ * Other functions form chains of finite height and are returned unchanged.
+ * @param previous Jump function before the join
+ * @param joined Result of the join
+ * @return Widened jump function
+ */
+EF widenEdgeFunction(const EF &previous, const EF &joined);
+
+/**
+ * Narrow a widened jump function. Bounds at the minimum or maximum int64 value are replaced by the bounds of the
+ * recomputed function, all other bounds are kept.
+ * @param current Widened jump function
+ * @param recomputed Jump function recomputed from the predecessors
+ * @return Narrowed jump function
+ */
+EF narrowEdgeFunction(const EF &current, const EF &recomputed);
+
 }  // namespace LoopBound
 
 #endif  // SRC_SPEAR_ANALYSES_LOOPBOUND_LOOPBOUNDEDGEFUNCTION_H_
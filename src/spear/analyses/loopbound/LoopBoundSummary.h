@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+*/
+
+#ifndef SRC_SPEAR_ANALYSES_LOOPBOUND_LOOPBOUNDSUMMARY_H_
+#define SRC_SPEAR_ANALYSES_LOOPBOUND_LOOPBOUNDSUMMARY_H_
+
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+
+#include <memory>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "CheckExpr.h"
+#include "LoopClassifier.h"
+
+namespace LoopBound {
+
+struct LoopCache;
+
+/**
+ * Parameterized part of a loop bound summary. Describes a counting loop with a symbolic bound, whose check value is an
+ * affine expression over one argument of the function the loop is located in.
+ */
+struct ArgumentCheck {
+    // Index of the classifier of the loop in the classifier list of the LoopBoundWrapper
+    size_t classifierIndex;
+
+    // Index of the function argument the check is based on
+    unsigned argumentIndex;
+
+    // Affine expression that maps the argument value to the check value
+    CheckExpr check;
+};
+
+/**
+ * LoopBoundSummaries class
+ *
+ * Implements the instantiation of the bottom-up loop bound mode. The increments of the counters are summarized per
+ * function by the BottomUpLoopBoundSolver. Loops whose check depends on a function argument are kept parameterized as
+ * ArgumentCheck.
+ *
+ * The call graph of the module is ordered in post-order. Walking it in reverse, callers are visited before their
+ * callees, so the constant values every argument receives at its call sites can be collected in a single pass. Values
+ * that are only forwarded from the arguments of the caller are resolved from the caller's already collected values.
+ * Finally, the parameterized summaries are instantiated with the collected values.
+ */
+class LoopBoundSummaries {
+ public:
+    /**
+     * Create the call graph ordering of the given module
+     * @param module Module under analysis
+     */
+    explicit LoopBoundSummaries(llvm::Module &module);
+
+    /**
+     * Search the argument the given check expression is based on
+     * @param check Check expression of a loop
+     * @param loopCache Analysis cache of the function of the loop
+     * @return Index of the argument if the check loads a value that was initialized with an argument
+     */
+    static std::optional<unsigned> findCheckArgument(const CheckExpr &check, LoopCache &loopCache);
+
+    /**
+     * Instantiate the parameterized summaries with the values collected at the call sites and update the bounds of the
+     * corresponding classifiers
+     * @param classifiers Classifiers of all loops
+     * @param argumentChecks Parameterized loops
+     * @return Amount of loops that could be bounded by instantiation
+     */
+    size_t instantiate(std::vector<LoopClassifier> &classifiers, const std::vector<ArgumentCheck> &argumentChecks);
+
+ private:
+    /**
+     * Upper limit for the number of distinct values tracked per argument
+     */
+    static constexpr size_t maxArgumentValues = 64;
+
+    /**
+     * Values an argument can receive. std::nullopt if the values are unknown
+     */
+    using ArgumentValues = std::optional<std::set<int64_t>>;
+
+    /**
+     * Functions of the module in call graph post-order (callees before callers)
+     */
+    std::vector<llvm::Function *> postOrder;
+
+    /**
+     * Functions that are part of a recursive call graph cycle
+     */
+    std::unordered_set<const llvm::Function *> recursiveFunctions;
+
+    /**
+     * Collected values of the arguments of each function
+     */
+    std::unordered_map<const llvm::Function *, std::vector<ArgumentValues>> argumentValues;
+
+    /**
+     * Dominator trees and loop infos of the callers, created on first use
+     */
+    using CallerCacheMap = std::unordered_map<const llvm::Function *, std::unique_ptr<LoopCache>>;
+
+    /**
+     * Collect the values of all function arguments in reverse post-order
+     */
+    void collectArgumentValues();
+
+    /**
+     * Calculate the values of all arguments of the given function from its call sites
+     * @param function Function to calculate the argument values for
+     * @param callerCaches Analysis caches of the callers
+     * @return Values of each argument of the function
+     */
+    std::vector<ArgumentValues> valuesAtCallSites(const llvm::Function &function, CallerCacheMap &callerCaches);
+
+    /**
+     * Resolve the values of an actual argument passed at a call site
+     * @param actual Value passed at the call site
+     * @param callerCache Analysis cache of the caller
+     * @return Values the actual argument can hold
+     */
+    ArgumentValues resolveActual(const llvm::Value *actual, LoopCache &callerCache);
+
+    /**
+     * Return the value stored by the store dominating the given load. Loads from memory that is written in any loop
+     * enclosing the load are not resolved.
+     * @param loadInst Load to resolve
+     * @param callerCache Analysis cache of the function of the load
+     * @return Value stored into the loaded memory, nullptr if it cannot be determined
+     */
+    static const llvm::Value *resolveStoredValue(const llvm::LoadInst *loadInst, LoopCache &callerCache);
+
+    /**
+     * Apply the affine check expression to the given argument value
+     * @param check Check expression
+     * @param argumentValue Value of the argument
+     * @return Check value
+     */
+    static int64_t evaluateCheck(const CheckExpr &check, int64_t argumentValue);
+};
+
+}  // namespace LoopBound
+
+#endif  // SRC_SPEAR_ANALYSES_LOOPBOUND_LOOPBOUNDSUMMARY_H_
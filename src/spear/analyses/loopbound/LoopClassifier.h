@@ -36,6 +36,7 @@ struct LoopParameterDescription {
     const llvm::Value *counterRoot = nullptr;  // The instruction defining the counter of the loop
     std::optional<int64_t> init = std::nullopt;  // Initial value of the loop
     LoopType type = LoopType::UNKNOWN_LOOP;
+    bool hasAffineCounter = true;  // A store in the loop adds to, multiplies or divides the counter by a constant
 };
 
 /**
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+*/
+
+#ifndef SRC_SPEAR_ANALYSES_LOOPBOUND_PARALLELLOOPBOUNDSOLVER_H_
+#define SRC_SPEAR_ANALYSES_LOOPBOUND_PARALLELLOOPBOUNDSOLVER_H_
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instruction.h>
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "LoopBound.h"
+#include "LoopBoundEdgeFunction.h"
+
+namespace LoopBound {
+
+/**
+ * Result table of the parallel solver. Maps instruction -> fact -> value
+ */
+using ParallelResultTable = std::unordered_map<const llvm::Instruction *,
+std::unordered_map<const llvm::Value *, DeltaInterval>>;
+
+/**
+ * Work performed by the parallel solver, summed over all counter worklists
+ */
+struct LoopBoundSolverStatistics {
+    /**
+     * Path edges taken from the worklists
+     */
+    uint64_t iterations = 0;
+
+    /**
+     * Joins that changed a jump function
+     */
+    uint64_t joins = 0;
+
+    /**
+     * Joins replaced by a widening
+     */
+    uint64_t widenings = 0;
+
+    /**
+     * Rounds performed to narrow widened jump functions
+     */
+    uint64_t narrowingRounds = 0;
+
+    /**
+     * End summaries published at the return statements of callees
+     */
+    uint64_t summaries = 0;
+};
+
+/**
+ * ParallelLoopBoundSolver class
+ *
+ * Solves the LoopBoundIDEAnalysis with multiple threads and calculates the same values as the Phasar IDE solver.
+ * All flow functions of the analysis are the identity, so a counter root never generates or kills another fact and
+ * every counter root is an IDE problem of its own:
+ *
+ * - Seeds are partitioned by their counter root. Each counter root forms its own worklist, a global counter used by
+ *   loops in several functions is a single worklist.
+ * - Each thread pulls worklists from the shared list and tabulates them with thread-local jump function and summary
+ *   tables, using the flow and edge functions of the underlying problem.
+ * - At a call, the counter is passed into every callee that can reach a loop counting it. The callee publishes an end
+ *   summary at each of its return statements, which is composed with the call and return edge functions and joined
+ *   into the return sites of all calls that entered it. Summaries published later are applied to the waiting calls
+ *   just like Phasar does. Callees that cannot reach such a loop leave the counter unchanged, they are stepped over
+ *   with the call-to-return edge only.
+ * - Once the worklist is drained, the values are computed in the two phases of the Phasar solver and published into
+ *   the shared result table under a lock.
+ *
+ * Summary tables belong to the worklist of their counter root, the shared result table is the only state the threads
+ * synchronize on.
+ *
+ * Optionally, a jump function that changed more than widenAfter times is widened: its growing bounds jump to the int64
+ * range, which ends the iteration on irregular loops early. A narrowing pass afterwards recomputes the widened
+ * functions from their predecessors to recover precise bounds where possible.
+ */
+class ParallelLoopBoundSolver {
+ public:
+    using n_t = LoopBoundIDEAnalysis::n_t;
+    using d_t = LoopBoundIDEAnalysis::d_t;
+    using l_t = LoopBoundIDEAnalysis::l_t;
+
+    /**
+     * Create a new parallel solver for the given problem
+     * @param problem Problem to solve
+     * @param interproceduralCFG ICFG of the program under analysis, only queried during construction
+     * @param threadCount Amount of threads used for solving
+     * @param widenAfter Joins of a jump function after which it is widened, 0 disables widening
+     * @param narrowingRounds Maximal amount of narrowing rounds after widening
+     */
+    ParallelLoopBoundSolver(LoopBoundIDEAnalysis &problem, psr::LLVMBasedICFG &interproceduralCFG,
+                            unsigned threadCount, unsigned widenAfter = 0, unsigned narrowingRounds = 0);
+
+    /**
+     * Solve the problem. Blocks until all counter worklists are drained.
+     */
+    void solve();
+
+    /**
+     * Query the value of the given fact at the given instruction
+     * @param instruction Instruction to query
+     * @param fact Fact to query
+     * @return Value of the fact if it reaches the instruction, std::nullopt otherwise
+     */
+    std::optional<DeltaInterval> resultAt(const llvm::Instruction *instruction, const llvm::Value *fact) const;
+
+    /**
+     * Return all values calculated by the solver
+     * @return Table mapping instruction -> fact -> value
+     */
+    const ParallelResultTable &getResults() const;
+
+    /**
+     * Return the amount of counter worklists the problem was partitioned into
+     * @return Amount of worklists
+     */
+    size_t getNumberOfWorklists() const;
+
+    /**
+     * Return the work performed by the last call to solve()
+     * @return Summed statistics of all worklists
+     */
+    LoopBoundSolverStatistics getStatistics() const;
+
+    /**
+     * Calculate the intraprocedural successors of the given instruction in the same way the Phasar ICFG does,
+     * i.e. ignoring debug intrinsics
+     * @param instruction Instruction to calculate the successors for
+     * @return Successor instructions
+     */
+    static std::vector<n_t> successorsOf(n_t instruction);
+
+    /**
+     * Calculate the start point of the given function in the same way the Phasar ICFG does
+     * @param function Function to calculate the start point for
+     * @return First instruction of the entry block that is no debug intrinsic, nullptr for declarations
+     */
+    static n_t startPointOf(const llvm::Function *function);
+
+ private:
+    /**
+     * Seeds of a single counter root and the functions the counter is propagated into
+     */
+    struct CounterWorklist {
+        d_t fact;
+        std::vector<std::pair<n_t, l_t>> seeds;
+        // Functions containing a loop counted by the fact and all their transitive callers
+        llvm::DenseSet<const llvm::Function *> functions;
+        // Instructions of all functions, used to schedule the largest worklists first
+        size_t instructionCount = 0;
+    };
+
+    /**
+     * Thread-local jump function table. Maps a node to the edge function from the start nodes of the worklist to it
+     */
+    using JumpFunctionTable = llvm::DenseMap<n_t, EF>;
+
+    /**
+     * Incoming edges of a path edge: the predecessor node and the edge function leading from it
+     */
+    using IncomingEdgeTable = llvm::DenseMap<n_t, std::vector<std::pair<n_t, EF>>>;
+
+    /**
+     * Tabulation state of a single worklist, only accessed by the thread solving it
+     */
+    struct TabulationState {
+        JumpFunctionTable jumpFunctions;
+        std::deque<n_t> pathEdges;
+        // Seeds and start points of entered callees, their jump function starts at the identity
+        llvm::DenseSet<n_t> startNodes;
+        // Calls that passed the counter into a callee
+        llvm::DenseMap<const llvm::Function *, std::vector<n_t>> incomingCalls;
+        // End summaries of the entered callees, maps return statement to its jump function
+        llvm::DenseMap<const llvm::Function *, llvm::DenseMap<n_t, EF>> endSummaries;
+        // Widening state, only filled if widening is enabled
+        llvm::DenseMap<n_t, unsigned> joinCounts;
+        llvm::DenseSet<n_t> expanded;
+        IncomingEdgeTable incoming;
+        std::vector<n_t> discoveryOrder;
+        LoopBoundSolverStatistics statistics;
+    };
+
+    /**
+     * Problem under analysis
+     */
+    LoopBoundIDEAnalysis &problem;
+
+    /**
+     * Amount of threads used for solving
+     */
+    unsigned threadCount;
+
+    /**
+     * Joins of a jump function after which it is widened, 0 disables widening
+     */
+    unsigned widenAfter;
+
+    /**
+     * Maximal amount of narrowing rounds after widening
+     */
+    unsigned narrowingRounds;
+
+    /**
+     * Counter partitioned worklists
+     */
+    std::vector<CounterWorklist> worklists;
+
+    /**
+     * Nodes carrying an initial seed of any fact. Phasar propagates values from them like from start points
+     */
+    llvm::DenseSet<n_t> seedNodes;
+
+    /**
+     * Defined callees of every call site, taken from the ICFG once so the threads never query it
+     */
+    llvm::DenseMap<n_t, std::vector<const llvm::Function *>> calleesAt;
+
+    /**
+     * Lock protecting the shared result table
+     */
+    mutable std::mutex resultMutex;
+
+    /**
+     * Shared result table all threads publish their values into
+     */
+    ParallelResultTable results;
+
+    /**
+     * Statistics of all worklists, protected by the result lock
+     */
+    LoopBoundSolverStatistics statistics;
+
+    /**
+     * Partition the initial seeds of the problem into the counter worklists
+     */
+    void partitionSeeds();
+
+    /**
+     * Store the defined callees of every call site of the module
+     * @param interproceduralCFG ICFG to take the callees from
+     */
+    void collectCallees(psr::LLVMBasedICFG &interproceduralCFG);
+
+    /**
+     * Collect the functions every counter is propagated into and order the worklists by their size
+     */
+    void collectFunctions();
+
+    /**
+     * Tabulate all seeds of the given worklist until the fixed point is reached and publish the values
+     * @param worklist Worklist to solve
+     */
+    void solveWorklist(const CounterWorklist &worklist);
+
+    /**
+     * Pass the counter into the callees of the given call and apply their published summaries to the return sites.
+     * The call-to-return edge is always taken.
+     * @param worklist Worklist under tabulation
+     * @param state Tabulation state of the worklist
+     * @param callSite Call to process
+     * @param jumpFunction Jump function at the call
+     * @param recordIncoming True if the incoming edges of the call-to-return edge are recorded for the narrowing
+     */
+    void processCall(const CounterWorklist &worklist, TabulationState &state, n_t callSite, const EF &jumpFunction,
+                     bool recordIncoming);
+
+    /**
+     * Publish the jump function at the given return statement as end summary of its function and apply it to the
+     * return sites of all calls that entered the function
+     * @param worklist Worklist under tabulation
+     * @param state Tabulation state of the worklist
+     * @param exitNode Return statement to process
+     * @param jumpFunction Jump function at the return statement
+     */
+    void processExit(const CounterWorklist &worklist, TabulationState &state, n_t exitNode, const EF &jumpFunction);
+
+    /**
+     * Compose the end summary of a callee with the call and return edge functions of the given call
+     * @param fact Counter root of the worklist
+     * @param callSite Call entering the callee
+     * @param callee Function the summary belongs to
+     * @param exitNode Return statement the summary was published at
+     * @param summary Jump function at the return statement
+     * @param returnSite Return site of the call
+     * @return Edge function from the call to the return site
+     */
+    EF summaryEdgeFunction(d_t fact, n_t callSite, const llvm::Function *callee, n_t exitNode, const EF &summary,
+                           n_t returnSite);
+
+    /**
+     * Propagate the jump function of the predecessor along the given edge
+     * @param state Tabulation state of the worklist
+     * @param predecessor Node the edge starts at
+     * @param predecessorFunction Jump function of the predecessor
+     * @param target Node the edge leads to
+     * @param edgeFunction Edge function of the edge
+     * @param recordIncoming True if the edge is recorded for the narrowing
+     */
+    void propagate(TabulationState &state, n_t predecessor, const EF &predecessorFunction, n_t target,
+                   const EF &edgeFunction, bool recordIncoming);
+
+    /**
+     * Join the given function into the jump function of the node, widening it if it changed too often. The node is
+     * added to the path edges if its jump function changed
+     * @param state Tabulation state of the worklist
+     * @param node Node to update
+     * @param function Function to join
+     */
+    void addPathEdge(TabulationState &state, n_t node, const EF &function);
+
+    /**
+     * Narrow the widened jump functions. All path edges with a widened bound are reset and recomputed from their
+     * predecessors without widening, visiting them in discovery order. If the recomputation converges within
+     * narrowingRounds rounds, the widened bounds are replaced by the recomputed ones
+     * @param state Tabulation state of the worklist, its jump functions are narrowed in place
+     * @return Amount of performed rounds
+     */
+    unsigned narrow(TabulationState &state) const;
+
+    /**
+     * Compute the values of the tabulated jump functions and publish them into the shared result table
+     * @param worklist Worklist the table was calculated for
+     * @param state Tabulation state of the worklist
+     */
+    void publishValues(const CounterWorklist &worklist, const TabulationState &state);
+};
+
+}  // namespace LoopBound
+
+#endif  // SRC_SPEAR_ANALYSES_LOOPBOUND_PARALLELLOOPBOUNDSOLVER_H_
@@ -12,26 +12,34 @@
 #include <phasar/DataFlow/IfdsIde/SolverResults.h>
 #include <phasar/PhasarLLVM/HelperAnalyses.h>
 
+#include <chrono>
 #include <memory>
 #include <vector>
 #include <string>
 #include <unordered_map>
 
+#include "BottomUpLoopBoundSolver.h"
 #include "LoopBound.h"
+#include "LoopBoundSummary.h"
+#include "ParallelLoopBoundSolver.h"
+#include "util.h"
 
 namespace LoopBound {
 
 /**
  * LoopCache struct
- * Caches the dominator tree and loop info for a function to avoid recalculating it multiple times during our analysis
+ * Caches the dominator tree, loop info and memory accesses for a function to avoid recalculating them multiple times
+ * during our analysis
  */
 struct LoopCache {
     // Dominator tree of the function
     llvm::DominatorTree DT;
     // Loop info of the function
     llvm::LoopInfo LI;
+    // Stores and loads of the function grouped by their underlying object
+    Util::MemoryAccessIndex Accesses;
 
-    explicit LoopCache(llvm::Function &F) : DT(F), LI(DT) {}
+    explicit LoopCache(llvm::Function &F) : DT(F), LI(DT), Accesses(F, DT) {}
 };
 
 /**
@@ -124,18 +132,83 @@ class LoopBoundWrapper {
      */
     std::unique_ptr<ResultsTy> cachedResults;
 
+    /**
+     * Internal storage of the parallel solver. Only set if the analysis was solved with more than one thread. If set,
+     * all queries are answered from the parallel solver instead of the cached Phasar results.
+     */
+    std::unique_ptr<ParallelLoopBoundSolver> parallelSolver;
+
+    /**
+     * Internal storage of the bottom-up solver. Only set in the bottom-up mode, all queries are answered from its
+     * instantiated summaries then.
+     */
+    std::unique_ptr<BottomUpLoopBoundSolver> bottomUpSolver;
+
     /**
      * Internal storage of our constructed loop classifiers, which contain the information about the loops and their
      * parameters found by our analysis
      */
     std::vector<LoopClassifier> loopClassifiers;
 
+    /**
+     * Time the parallel or the bottom-up solver spent in its last solve
+     */
+    std::chrono::microseconds solverDuration{0};
+
+    /**
+     * Loops the last buildClassifiers() call classified as UNKNOWN_LOOP because their increment was widened
+     */
+    size_t widenedLoops = 0;
+
     /**
      * Internal storage of the analysis manager so we can access llvms analysis information later on without
      * passing it down to our functions
      */
     llvm::FunctionAnalysisManager *FAM;
 
+    /**
+     * Solve the loop bound problem. Depending on the configuration the problem is solved serially by Phasar or by the
+     * ParallelLoopBoundSolver. If the verification is enabled, both solvers are run and their results are compared.
+     * @param interproceduralCFG ICFG of the program under analysis
+     */
+    void solveProblem(psr::LLVMBasedICFG &interproceduralCFG);
+
+    /**
+     * Solve the loop bound problem bottom-up. Each function is summarized once in call graph post-order, the summaries
+     * are applied at the call sites and loops that depend on function arguments are instantiated with the values
+     * passed at their call sites.
+     * @param interproceduralCFG ICFG of the program under analysis
+     * @param module Module under analysis
+     */
+    void solveBottomUp(psr::LLVMBasedICFG &interproceduralCFG, llvm::Module &module);
+
+    /**
+     * Run the top-down and the bottom-up mode, log the differences in bounds and runtime and keep the top-down results
+     * @param interproceduralCFG ICFG of the program under analysis
+     * @param module Module under analysis
+     */
+    void compareModes(psr::LLVMBasedICFG &interproceduralCFG, llvm::Module &module);
+
+    /**
+     * Construct the loop classifiers from the solved problem
+     * @param argumentChecks If not nullptr, symbolic loops whose check depends on a function argument are stored here
+     * @return Classifiers of all loops with a detected counter
+     */
+    std::vector<LoopClassifier> buildClassifiers(std::vector<ArgumentCheck> *argumentChecks);
+
+    /**
+     * Log how fast the solver converged, the loops that were not seeded and the loops lost to widening
+     */
+    void logConvergence() const;
+
+    /**
+     * Compare the values calculated by the parallel solver with the values of the serial Phasar solver in both
+     * directions. Values the serial solver computes for the counters of a function are expected in the parallel results
+     * as well, values of counters carried through callees are not queried and therefore ignored
+     * @return Amount of instruction and fact pairs the solvers disagree on
+     */
+    size_t verifyParallelResults() const;
+
     /**
      * Searches the loop defined by the given LoopDescription for the store instruction that saves any increment to the
      * counter.
@@ -161,6 +234,15 @@ class LoopBoundWrapper {
     std::optional<LoopBound::DeltaInterval> queryIntervalAtInstuction(const llvm::Instruction *inst,
     const llvm::Value *fact);
 
+    /**
+     * Query the solver that replaced the Phasar results, either the parallel or the bottom-up solver
+     * @param instruction Instruction to query
+     * @param fact Counter root to query
+     * @return Value of the solver, std::nullopt if no such solver is set or the fact does not reach the instruction
+     */
+    std::optional<LoopBound::DeltaInterval> solverResultAt(const llvm::Instruction *instruction,
+                                                           const llvm::Value *fact) const;
+
     /**
      * Print the internally safed loop classifiers
      */
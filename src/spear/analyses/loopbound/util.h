@@ -6,13 +6,16 @@
 #ifndef SRC_SPEAR_ANALYSES_LOOPBOUND_UTIL_H_
 #define SRC_SPEAR_ANALYSES_LOOPBOUND_UTIL_H_
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/Dominators.h>
 #include <llvm/IR/Instructions.h>
+#include <llvm/IR/PassManager.h>
 
 #include <atomic>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "LoopBound.h"
 #include "LoopBoundEdgeFunction.h"
@@ -72,23 +75,101 @@ void dumpEF(const LoopBound::EF &edgeFunction);
 const llvm::Value *getUnderlyingObject(const llvm::Value *Ptr);
 
 /**
- * Tries to infer an integer from the given value.
- * @param val Value to infer from
- * @return
+ * MemoryAccessIndex class
+ *
+ * Stores and loads of a function grouped by the underlying object they access. The index is built once per function
+ * and shared by all queries, instead of scanning the whole function for every load that is resolved. The accesses of
+ * an object are ordered by a preorder walk of the dominator tree, so an access never dominates one listed before it.
+ * Accesses in unreachable blocks are listed last.
  */
-const llvm::ConstantInt *tryEvalToConstInt(const llvm::Value *val);
+class MemoryAccessIndex {
+ public:
+    /**
+     * Index the memory accesses of the given function
+     * @param function Function to index
+     * @param dominatorTree Dominator tree of the function
+     */
+    MemoryAccessIndex(const llvm::Function &function, const llvm::DominatorTree &dominatorTree);
+
+    /**
+     * Return the stores to the given object
+     * @param object Underlying object as returned by getUnderlyingObject
+     * @return Stores in dominance order
+     */
+    const std::vector<const llvm::StoreInst *> &getStores(const llvm::Value *object) const;
+
+    /**
+     * Return the loads from the given object
+     * @param object Underlying object as returned by getUnderlyingObject
+     * @return Loads in dominance order
+     */
+    const std::vector<const llvm::LoadInst *> &getLoads(const llvm::Value *object) const;
+
+    /**
+     * Check whether the given object is stored to inside the given loop
+     * @param object Underlying object as returned by getUnderlyingObject
+     * @param loop Loop to inspect, including its subloops
+     * @return True if a store to the object is located in the loop
+     */
+    bool isWrittenInLoop(const llvm::Value *object, const llvm::Loop *loop) const;
+
+    /**
+     * Finds the store to the given object that is executed last before the given load on every path. This is the last
+     * dominating store in dominance order.
+     *
+     * @param loadInst Load instruction the store happens before
+     * @param object Underlying object the store is referring to
+     * @param dominatorTree Dominator tree of the function
+     * @return Store instruction if found, nullptr in any other case
+     */
+    const llvm::StoreInst *findDominatingStore(const llvm::LoadInst *loadInst, const llvm::Value *object,
+                                               const llvm::DominatorTree &dominatorTree) const;
+
+    /**
+     * Needed by the FunctionAnalysisManager, the index is invalidated together with the dominator tree
+     */
+    bool invalidate(llvm::Function &function, const llvm::PreservedAnalyses &preservedAnalyses,
+                    llvm::FunctionAnalysisManager::Invalidator &invalidator);
+
+ private:
+    void indexBlock(const llvm::BasicBlock &basicBlock);
+
+    llvm::DenseMap<const llvm::Value *, std::vector<const llvm::StoreInst *>> storesByObject;
+    llvm::DenseMap<const llvm::Value *, std::vector<const llvm::LoadInst *>> loadsByObject;
+};
 
 /**
- * Finds the most fitting store instruction corresponding to the given object before the given load happens
+ * MemoryAccessAnalysis class
  *
- * @param LI Load instruction the store happends before
- * @param Obj Object the store is referring to
- * @param DT DominatorTree
- * @return Store instruction if found, nullptr in any other case
+ * Function analysis providing the MemoryAccessIndex of a function through the FunctionAnalysisManager
  */
-const llvm::StoreInst *findDominatingStoreToObject(const llvm::LoadInst *LI,
-                                                   const llvm::Value *Obj,
-                                                   llvm::DominatorTree &DT);
+class MemoryAccessAnalysis : public llvm::AnalysisInfoMixin<MemoryAccessAnalysis> {
+ public:
+    using Result = MemoryAccessIndex;
+
+    Result run(llvm::Function &function, llvm::FunctionAnalysisManager &analysisManager);
+
+ private:
+    friend llvm::AnalysisInfoMixin<MemoryAccessAnalysis>;
+    static llvm::AnalysisKey Key;
+};
+
+/**
+ * Return the memory access index of the given function. Registers the MemoryAccessAnalysis on first use, so callers
+ * do not depend on how the analysis manager was set up.
+ * @param function Function to return the index for
+ * @param analysisManager FunctionAnalysisManager caching the index
+ * @return Index of the memory accesses of the function
+ */
+const MemoryAccessIndex &getMemoryAccessIndex(llvm::Function &function,
+                                              llvm::FunctionAnalysisManager &analysisManager);
+
+/**
+ * Tries to infer an integer from the given value.
+ * @param val Value to infer from
+ * @return
+ */
+const llvm::ConstantInt *tryEvalToConstInt(const llvm::Value *val);
 
 /**
  * Tries to infer the ICMP value from the given llvm value
@@ -108,10 +189,12 @@ const llvm::Value *getMemRootFromValue(const llvm::Value *val);
  * Infer the constant integer value from the given load instruction if it loads a constant
  * @param LI Load instruction to infer from
  * @param DT DominatorTree
+ * @param LIInfo LoopInfo
+ * @param accesses Memory access index of the function of the load
  * @return Optional value representing the constant integer value
  */
 std::optional<int64_t> tryDeduceConstFromLoad(
-const llvm::LoadInst *LI, llvm::DominatorTree &DT, llvm::LoopInfo &LIInfo);
+const llvm::LoadInst *LI, llvm::DominatorTree &DT, llvm::LoopInfo &LIInfo, const MemoryAccessIndex &accesses);
 
 /**
  * Convert a given predicate to a string
@@ -52,6 +52,30 @@ class ConfigurationUtils {
      */
     static AnalysisOutputMode strToAnalysisOutputmode(const std::string &str);
 
+    /**
+     * Convert a string to a sweep mode enum type
+     *
+     * @param str String to convert
+     * @return SweepMode enum type
+     */
+    static SweepMode strToSweepMode(const std::string &str);
+
+    /**
+     * Convert a string to a loop bound mode enum type
+     *
+     * @param str String to convert
+     * @return LoopBoundMode enum type
+     */
+    static LoopBoundMode strToLoopBoundMode(const std::string &str);
+
+    /**
+     * Convert a string to an energy source enum type
+     *
+     * @param str String to convert
+     * @return EnergySource enum type
+     */
+    static EnergySource strToEnergySource(const std::string &str);
+
     /**
      * Convert a given string to lower case format
      * @param inputString
@@ -24,6 +24,81 @@ struct SyscallProfilingConfig {
     int runtime;
     double defaultEnergy;
     int maxSyscallId;
+    /**
+     * Events handled per energy reading of the ring buffer consumer
+     */
+    int batchSize;
+    /**
+     * Spin on the ring buffer instead of waiting for events
+     */
+    bool busyPoll;
+};
+
+/**
+ * Holds the configuration of the loop bound sweep mode
+ */
+struct SweepConfiguration {
+    bool enabled;
+    SweepMode mode;
+    std::vector<double> grid;
+};
+
+/**
+ * Holds the configuration of the loop bound solver
+ */
+struct LoopBoundConfiguration {
+    int threads;
+    bool verifyParallel;
+    LoopBoundMode mode;
+    /**
+     * Joins of a jump function after which growing bounds are widened, 0 disables widening
+     */
+    int widenAfter;
+    /**
+     * Rounds of the narrowing pass recovering the bounds lost by widening
+     */
+    int narrowingRounds;
+};
+
+/**
+ * Holds the configuration of the portfolio used for hard feasibility queries
+ */
+struct SatPortfolioConfiguration {
+    bool enabled;
+    unsigned initialBudget;
+    /**
+     * Timeout of every portfolio configuration in ms
+     */
+    unsigned portfolioBudget;
+};
+
+/**
+ * Holds the configuration of the sharded analysis, which analyzes parts of the call graph in separate processes
+ */
+struct ShardingConfiguration {
+    bool enabled;
+    /**
+     * Shards the call graph is split into
+     */
+    int shards;
+    /**
+     * Worker processes running at the same time
+     */
+    int workers;
+    /**
+     * Address space limit of a worker in MiB, 0 disables the limit
+     */
+    int memoryLimit;
+};
+
+/**
+ * Holds the configuration of the energy measurement of SPEAR itself
+ */
+struct SelfEnergyConfiguration {
+    bool enabled;
+    EnergySource source;
+    double mockWatts;
+    unsigned samplingRate;
 };
 
 /**
@@ -34,6 +109,7 @@ struct ProfilingConfiguration {
     double min_instruction_energy;
     std::vector<int> cpuregression;
     SyscallProfilingConfig syscallconfig;
+    unsigned timelineRate;
 };
 
 /**
@@ -47,7 +123,17 @@ struct AnalysisConfiguration {
     bool feasibilityEnabled;
     bool writeDotFiles;
     bool elbMappingActivated;
+    bool sensitivityReportEnabled;
+    bool writeSnapshot;
+    bool progressEnabled;
+    bool metricsEnabled;
+    std::string coreType;
     LegacyAnalysisConfiguration legacyconfig;
+    SweepConfiguration sweepconfig;
+    LoopBoundConfiguration loopboundconfig;
+    SatPortfolioConfiguration satportfolioconfig;
+    SelfEnergyConfiguration selfenergyconfig;
+    ShardingConfiguration shardingconfig;
     std::unordered_map<std::string, std::unordered_map<std::string, double>> fallback;
     std::vector<std::string> elbfiles;
 };
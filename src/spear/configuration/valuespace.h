@@ -60,5 +60,34 @@ enum class AnalysisOutputMode {
     ELB
 };
 
+/**
+ * Enum describing how the values of a loop bound sweep grid are applied to the loops
+ */
+enum class SweepMode {
+    UNDEFINED,
+    FALLBACK,  // Grid values replace the bounds of loops bounded by a fallback value
+    SCALE      // Grid values scale the bounds of all loops
+};
+
+/**
+ * Enum describing how the interprocedural loop bound analysis is performed
+ */
+enum class LoopBoundMode {
+    UNDEFINED,
+    TOPDOWN,   // Solve the whole program from the entry points
+    BOTTOMUP,  // Summarize each function once and instantiate the summaries at the call sites
+    COMPARE    // Run both modes, report the differences and use the top-down results
+};
+
+/**
+ * Enum describing which energy counter is read to measure SPEAR itself
+ */
+enum class EnergySource {
+    UNDEFINED,
+    AUTO,  // Read RAPL if it is accessible, otherwise fall back to the mock counter
+    RAPL,  // Read the RAPL energy counter of core 0
+    MOCK   // Derive the energy from the wall time and a constant power
+};
+
 
 #endif  // SRC_SPEAR_CONFIGURATION_VALUESPACE_H_
@@ -14,6 +14,7 @@
 #include <utility>
 
 #include "Profiler.h"
+#include "CPUTopology.h"
 using json = nlohmann::json;
 
 /**
@@ -108,12 +109,23 @@ class CPUProfiler : public Profiler {
             throw std::runtime_error("CPU profiler: Metadata file malformed!");
         }
 
-        this->programiterations = metadata["repeated_executions"];
+        // Loop kernels run whole iterations of their unrolled body, which can exceed the requested repetitions
+        const uint64_t unroll = metadata.value("unroll", 0);
+        if (unroll > 0 && metadata.contains("iterations")) {
+            this->programiterations = unroll * metadata["iterations"].get<uint64_t>();
+        } else {
+            this->programiterations = metadata["repeated_executions"];
+        }
 
         this->log(std::string("repeated_executions ") + std::to_string(this->programiterations));
 
         this->number_of_cores = std::thread::hardware_concurrency();
         this->log(std::string("number of cores ") + std::to_string(this->number_of_cores));
+
+        this->topology = CPUTopology::detect();
+        for (const auto& coreType : topology.getCoreTypes()) {
+            this->log("core type " + coreType.name + " with " + std::to_string(coreType.cpus.size()) + " cores");
+        }
     }
 
      /**
@@ -161,6 +173,18 @@ class CPUProfiler : public Profiler {
      */
     json profile() override;
 
+    /**
+     * Return the detected core type topology
+     * @return Topology of the CPU
+     */
+    const CPUTopology& getTopology() const { return topology; }
+
+    /**
+     * Return the cost tables of the individual core types of a hybrid CPU, available after profile()
+     * @return Mapping between core type name and cost table, empty on CPUs with a single core type
+     */
+    const json& getCoreTypeProfiles() const { return coreTypeProfiles; }
+
  private:
     /**
      * How many times each instruction is repeated inside each profile program.
@@ -172,6 +196,16 @@ class CPUProfiler : public Profiler {
     */
     unsigned int number_of_cores;
 
+    /**
+     * Core types of the CPU
+     */
+    CPUTopology topology;
+
+    /**
+     * Cost table per core type of a hybrid CPU
+     */
+    json coreTypeProfiles = json::object();
+
     /**
      * Mapping of instruction names to profile program paths
      */
@@ -184,6 +218,26 @@ class CPUProfiler : public Profiler {
      */
     [[nodiscard]] std::vector<double> _measureFile(const std::string& file, uint64_t runtime = -1) const;
 
+    /**
+     * Measure a given file on groups of cores at the same time. Every core runs one instance of the file per iteration
+     * @param file Path the file is stored at
+     * @param runtime Amount of iterations
+     * @param clusters Cores of each group
+     * @param perCoreCounters Attribute the energy using the counter of each core instead of the shared package counter
+     * @return Returns the recorded measurement values per group
+     */
+    [[nodiscard]] std::vector<std::vector<double>> _measureClusters(const std::string& file, uint64_t runtime,
+                                                                    const std::vector<std::vector<int>>& clusters,
+                                                                    bool perCoreCounters) const;
+
+    /**
+     * Create the cost table of the instructions from the measurements of all k values
+     * @param allResults Median energy per instruction for each k value
+     * @param ks Evaluated k values
+     * @return Cost table mapping instruction names to their energy
+     */
+    json _costTable(const std::vector<std::map<std::string, double>>& allResults, const std::vector<int>& ks);
+
     /**
      * Calculates a moving average on the given data with the specified window
      * @param data Raw data the average will be calculated on
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+*/
+
+#ifndef SRC_SPEAR_PROFILERS_CPUTOPOLOGY_H_
+#define SRC_SPEAR_PROFILERS_CPUTOPOLOGY_H_
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+/**
+ * Group of cores sharing the same microarchitecture, e.g. the performance cores of a hybrid CPU
+ */
+struct CoreType {
+    /**
+     * Name of the core type used as key in the profile
+     */
+    std::string name;
+
+    /**
+     * Logical CPUs of this type in ascending order
+     */
+    std::vector<int> cpus;
+};
+
+/**
+ * Core type topology of the CPU read from sysfs.
+ *
+ * Intel hybrid CPUs expose a perf PMU per core type (/sys/devices/cpu_core, cpu_atom, cpu_lowpower) listing its CPUs.
+ * Other hybrid CPUs are grouped by /sys/devices/system/cpu/cpuN/cpu_capacity. CPUs without core types form a single
+ * "default" type.
+ */
+class CPUTopology {
+ public:
+    /**
+     * Detect the topology
+     * @param sysfsRoot Root of the sysfs tree, tests pass a fake tree
+     * @return Detected topology, core types ordered from the fastest to the slowest
+     */
+    static CPUTopology detect(const std::filesystem::path &sysfsRoot = "/sys");
+
+    /**
+     * Parse a sysfs CPU list like "0-3,8,10-11"
+     * @param cpuList List to parse
+     * @return Listed CPUs in ascending order
+     */
+    static std::vector<int> parseCpuList(const std::string &cpuList);
+
+    const std::vector<CoreType> &getCoreTypes() const { return coreTypes; }
+
+    /**
+     * Check if the CPU has more than one core type
+     * @return True for hybrid CPUs
+     */
+    bool isHybrid() const { return coreTypes.size() > 1; }
+
+    /**
+     * Return the core type of a CPU
+     * @param cpu Logical CPU
+     * @return Name of the core type or an empty string for unknown CPUs
+     */
+    std::string coreTypeOf(int cpu) const;
+
+    /**
+     * Return all CPUs of all core types
+     * @return Logical CPUs in ascending order
+     */
+    std::vector<int> allCpus() const;
+
+    /**
+     * Return the topology as mapping between core type name and CPUs
+     * @return JSON object of the topology
+     */
+    json toJson() const;
+
+ private:
+    std::vector<CoreType> coreTypes;
+
+    /**
+     * Read the first line of a sysfs file
+     * @param path File to read
+     * @param content Read line
+     * @return False if the file could not be read
+     */
+    static bool readLine(const std::filesystem::path &path, std::string &content);
+
+    bool detectPmuCoreTypes(const std::filesystem::path &sysfsRoot);
+
+    bool detectCapacityCoreTypes(const std::filesystem::path &sysfsRoot);
+
+    void detectDefaultCoreType(const std::filesystem::path &sysfsRoot);
+};
+
+#endif  // SRC_SPEAR_PROFILERS_CPUTOPOLOGY_H_
@@ -10,7 +10,8 @@
 #include "profilers/Profiler.h"
 
 /**
- * Component to gather system specific information based on the profiler architecture
+ * Component to gather system specific information based on the profiler architecture. The machine metadata is read by
+ * the SystemMetadataCollector and cached per boot.
  */
 class MetaProfiler : public Profiler {
  public:
@@ -38,36 +39,12 @@ class MetaProfiler : public Profiler {
     std::string stopTime();
 
  private:
-    /**
-     * Parse the cpuinfo file in linux and return the CPU name
-     * @return String representing the CPU name
-     */
-    static std::string _getCPUName();
-
-    /**
-     * Parse the cpuinfo file in linux and return the architecture
-     * @return String representing the architecture name
-     */
-    static std::string _getArchitecture();
-
-    /**
-     * Parse the cpuinfo file in linux and return the number of cores
-     * @return String representing the number of cores
-     */
-    static std::string _getNumberOfCores();
-
     /**
      * Analyse the RAPL interface and retrieve the used energy increment unit
      * @return String representing the rapl unit
      */
     static double _getRaplUnit();
 
-    /**
-     * Read the given system file
-     * @return
-     */
-    static std::string _readSystemFile(std::string file);
-
     /**
      * Create current timestanmp and return it as string
      * @return String representation of the timestamp
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+*/
+
+#ifndef SRC_SPEAR_PROFILERS_SYSCALLEVENTCONSUMER_H_
+#define SRC_SPEAR_PROFILERS_SYSCALLEVENTCONSUMER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "EnergyCounterSource.h"
+#include "EnergySampler.h"
+
+/**
+ * Event struct to handle syscall events, layout shared with syscall_trace.bpf.c
+ */
+struct evt {
+    uint64_t ts;    // bpf_ktime_get_ns() when the event was recorded
+    uint32_t tid;
+    uint32_t id;    // syscall id for enter/exit, unused for switch
+    uint8_t  type;  // 0 enter, 1 exit, 2 switch_out, 3 switch_in
+};
+
+/**
+ * Per-TID inflight state
+ */
+struct Inflight {
+    uint32_t syscall_id = 0;
+    double start_energy = 0.0;  // valid only while "running" segment is active
+    bool in_syscall = false;    // between sys_enter and sys_exit
+    bool running = false;       // currently on CPU segment we are measuring
+};
+
+/**
+ * Open addressing hash table mapping thread ids to their inflight state. All slots are allocated on construction, so
+ * handling an event never allocates.
+ */
+class InflightTable {
+ public:
+    /**
+     * Create a table
+     * @param capacity Minimal amount of threads the table can track, rounded up to a power of two
+     */
+    explicit InflightTable(size_t capacity);
+
+    /**
+     * Return the state of a thread, inserting an empty state if the thread is unknown
+     * @param tid Thread id
+     * @return State of the thread, nullptr if the table is full
+     */
+    Inflight *findOrInsert(uint32_t tid);
+
+    /**
+     * Remove the state of a thread
+     * @param tid Thread id
+     */
+    void erase(uint32_t tid);
+
+    void clear();
+
+    size_t size() const { return used; }
+
+    size_t getCapacity() const { return slots.size(); }
+
+ private:
+    struct Slot {
+        uint32_t tid = 0;
+        bool occupied = false;
+        Inflight state;
+    };
+
+    size_t indexOf(uint32_t tid) const;
+
+    std::vector<Slot> slots;
+    size_t mask;
+    size_t used = 0;
+};
+
+/**
+ * Statistics of a consumer run
+ */
+struct SyscallConsumerStats {
+    /**
+     * Events handled by the consumer
+     */
+    uint64_t processed = 0;
+
+    /**
+     * Batches the events were handled in, every batch reads the energy counter once
+     */
+    uint64_t batches = 0;
+
+    /**
+     * Records smaller than an event
+     */
+    uint64_t malformed = 0;
+
+    /**
+     * sys_enter events with an id of maxSyscallId or above
+     */
+    uint64_t unknownSyscalls = 0;
+
+    /**
+     * Events of threads that did not fit into the inflight table
+     */
+    uint64_t tableOverflows = 0;
+
+    /**
+     * Events the kernel could not reserve space for in the ring buffer
+     */
+    uint64_t kernelDrops = 0;
+
+    /**
+     * Events recorded before the reading preceding the previous one, no energy interval covers them anymore
+     */
+    uint64_t lateEvents = 0;
+
+    /**
+     * Return the amount of events that were lost before or during handling
+     * @return Sum of all drop counters
+     */
+    uint64_t dropped() const { return malformed + tableOverflows + kernelDrops + lateEvents; }
+};
+
+/**
+ * SyscallEventConsumer class
+ *
+ * Consumes the events of the syscall tracer. Records are copied into a preallocated batch by the ring buffer callback
+ * and handled together once the batch is full or the ring buffer is drained. Per batch, the energy counter is read a
+ * single time and the energy at every event is interpolated from the timestamps the kernel attached, instead of
+ * reading RAPL for every record. Energy and completions are accumulated in flat slots indexed by the syscall id.
+ * Events the ring buffer delivers after the reading following them are interpolated against the interval before, as
+ * long as it is retained. Older events are counted as late and end the measurement of their thread.
+ */
+class SyscallEventConsumer {
+ public:
+    /**
+     * Create a consumer
+     * @param source Energy counter to read, must outlive the consumer
+     * @param maxSyscallId Amount of syscall slots, events with larger ids are ignored
+     * @param batchSize Events handled per energy reading
+     * @param threadCapacity Threads that can be inside a syscall at the same time
+     */
+    SyscallEventConsumer(EnergyCounterSource &source, uint32_t maxSyscallId, size_t batchSize = 256,
+                         size_t threadCapacity = 1 << 16);
+
+    /**
+     * Ring buffer callback, ctx is the consumer
+     * @param ctx Consumer receiving the record
+     * @param data Record inserted into the ring buffer
+     * @param size Size of the record
+     * @return Returns 0
+     */
+    static int onRecord(void *ctx, void *data, size_t size);
+
+    /**
+     * Queue a record, handles the batch if it is full
+     * @param data Record inserted into the ring buffer
+     * @param size Size of the record
+     */
+    void push(const void *data, size_t size);
+
+    /**
+     * Handle all queued events, reading the energy counter at the current CLOCK_MONOTONIC time
+     */
+    void flush();
+
+    /**
+     * Handle all queued events with an energy reading taken at the given time
+     * @param nowNs CLOCK_MONOTONIC time of the energy reading in nanoseconds
+     */
+    void flush(uint64_t nowNs);
+
+    /**
+     * Drop all accumulated results and inflight state
+     */
+    void reset();
+
+    /**
+     * Set the amount of events the kernel dropped, which is only known to the BPF program
+     * @param drops Dropped events
+     */
+    void setKernelDrops(uint64_t drops) { stats.kernelDrops = drops; }
+
+    double getEnergy(uint32_t syscallId) const { return energyPerSyscall[syscallId]; }
+
+    uint64_t getCount(uint32_t syscallId) const { return countPerSyscall[syscallId]; }
+
+    uint32_t getMaxSyscallId() const { return maxSyscallId; }
+
+    /**
+     * Return the amount of threads currently tracked inside a syscall or between switches
+     * @return Occupied slots of the inflight table
+     */
+    size_t getInflightThreads() const { return inflight.size(); }
+
+    const SyscallConsumerStats &getStats() const { return stats; }
+
+    /**
+     * Return the current CLOCK_MONOTONIC time, the clock of bpf_ktime_get_ns()
+     * @return Time in nanoseconds
+     */
+    static uint64_t monotonicNs();
+
+ private:
+    /**
+     * Interpolate the energy at the given time between the two readings around it. Times before the first reading
+     * are clamped to the first reading
+     * @param ts Time of the event
+     * @return Energy in Joule since the first reading
+     */
+    double energyAt(uint64_t ts) const;
+
+    /**
+     * Check whether the given time lies before all retained readings but after the first one
+     * @param ts Time of the event
+     * @return True if the energy at the time can no longer be interpolated
+     */
+    bool isLate(uint64_t ts) const;
+
+    void handle(const evt &event);
+
+    EnergyCounterSource &source;
+    CounterExtender extender;
+    double energyUnit;
+    uint32_t maxSyscallId;
+
+    std::vector<evt> batch;
+    size_t batchSize;
+
+    InflightTable inflight;
+    std::vector<double> energyPerSyscall;
+    std::vector<uint64_t> countPerSyscall;
+
+    bool hasReading = false;
+    uint64_t firstNs = 0;
+    uint64_t olderNs = 0;
+    double olderEnergy = 0.0;
+    uint64_t previousNs = 0;
+    double previousEnergy = 0.0;
+    uint64_t currentNs = 0;
+    double currentEnergy = 0.0;
+
+    SyscallConsumerStats stats;
+};
+
+#endif  // SRC_SPEAR_PROFILERS_SYSCALLEVENTCONSUMER_H_
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 Maximilian Krebs
+ * All rights reserved.
+*/
+
+#ifndef SRC_SPEAR_PROFILERS_SYSTEMMETADATA_H_
+#define SRC_SPEAR_PROFILERS_SYSTEMMETADATA_H_
+
+#include <filesystem>
+#include <map>
+#include <string>
+
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+/**
+ * Collects the metadata of the machine a profile is recorded on by reading procfs and sysfs directly, without spawning
+ * processes. On x86 the cpuid instruction fills in the CPU name and vendor if procfs does not provide them.
+ *
+ * The metadata only changes with a reboot, so it is cached in a file keyed by the boot id of the kernel.
+ */
+class SystemMetadataCollector {
+ public:
+    /**
+     * Create a collector
+     * @param procRoot Root of procfs, tests pass a fixture directory
+     * @param sysfsRoot Root of sysfs, tests pass a fixture directory
+     * @param useCpuid Query cpuid for values missing in procfs
+     */
+    explicit SystemMetadataCollector(std::filesystem::path procRoot = "/proc",
+                                     std::filesystem::path sysfsRoot = "/sys", bool useCpuid = true);
+
+    /**
+     * Collect the metadata
+     * @return JSON object with the CPU model, microcode, core topology, frequency limits, governor and kernel version
+     */
+    json collect() const;
+
+    /**
+     * Return the metadata from the cache file if it was written during the current boot, collect and cache it
+     * otherwise
+     * @param cacheFile Path of the cache file
+     * @return Metadata, "cached" tells if it was read from the cache
+     */
+    json collectCached(const std::filesystem::path &cacheFile) const;
+
+    /**
+     * Return the default location of the cache file
+     * @return $XDG_CACHE_HOME/spear/metadata.json, ~/.cache/spear/metadata.json or a file in the temp directory
+     */
+    static std::filesystem::path defaultCacheFile();
+
+    /**
+     * Parse the first processor entry of /proc/cpuinfo
+     * @param content Content of the cpuinfo file
+     * @return Mapping between field name and value
+     */
+    static std::map<std::string, std::string> parseCpuInfo(const std::string &content);
+
+ private:
+    std::filesystem::path procRoot;
+    std::filesystem::path sysfsRoot;
+    bool useCpuid;
+
+    /**
+     * Read a whole file
+     * @param path File to read
+     * @param content Content of the file
+     * @return False if the file could not be read
+     */
+    static bool readFile(const std::filesystem::path &path, std::string &content);
+
+    /**
+     * Read the first line of a file without the trailing whitespace
+     * @param path File to read
+     * @return First line, empty if the file could not be read
+     */
+    static std::string readLine(const std::filesystem::path &path);
+
+    /**
+     * Read the boot id of the kernel
+     * @return Boot id, empty if unknown
+     */
+    std::string bootId() const;
+
+    json collectCpu() const;
+
+    json collectTopology() const;
+
+    json collectFrequency() const;
+
+    json collectKernel() const;
+
+    /**
+     * Query the CPU vendor and brand string with cpuid
+     * @param vendor Vendor string
+     * @param brand Brand string
+     * @return False if cpuid is unavailable
+     */
+    static bool cpuid(std::string &vendor, std::string &brand);
+};
+
+#endif  // SRC_SPEAR_PROFILERS_SYSTEMMETADATA_H_
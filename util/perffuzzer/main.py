@@ -0,0 +1,34 @@
+import argparse
+from pathlib import Path
+
+from perffuzzer.fuzzer import Fuzzer
+from perffuzzer.runner import Runner
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Search for inputs that maximize the work per instruction of SPEAR.")
+    parser.add_argument("spear", type=Path, help="Path to the spear binary")
+    parser.add_argument("profile", type=Path, help="Path to the profile used for the analysis")
+    parser.add_argument("config", type=Path, help="Path to the configuration used for the analysis")
+    parser.add_argument("--iterations", type=int, default=200, help="Amount of generated inputs")
+    parser.add_argument("--time-limit", type=float, default=60.0, help="Time limit per input in seconds")
+    parser.add_argument("--clang", default="clang++-17", help="Clang used to compile the inputs to LLVM IR")
+    parser.add_argument("--corpus", type=Path, default=Path(__file__).resolve().parents[2] / "programs" / "perffuzz",
+                        help="Regression corpus the minimized findings are stored in")
+    parser.add_argument("--seed", type=int, default=0, help="Seed of the random mutations")
+
+    args = parser.parse_args()
+
+    runner = Runner(str(args.spear), args.clang, str(args.profile), args.config, args.time_limit)
+    fuzzer = Fuzzer(runner, args.corpus, args.seed)
+    fuzzer.fuzz(args.iterations)
+
+    for phase, finding in sorted(fuzzer.findings.items()):
+        minimized = fuzzer.minimize(finding)
+        name = fuzzer.save(minimized)
+        print("Saved {} ({} instructions, {:.3e} per instruction)".format(
+            name, minimized.result.instructions, minimized.score))
+
+
+if __name__ == "__main__":
+    main()
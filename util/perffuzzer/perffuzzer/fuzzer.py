@@ -0,0 +1,223 @@
+import hashlib
+import json
+import random
+from pathlib import Path
+from typing import Dict, List, Tuple
+
+from .program import Program, Statement
+from .runner import Runner, RunResult
+
+
+class Finding:
+    """
+    Input that maximizes the work per instruction of one phase
+    """
+    phase: str
+    score: float
+    program: Program
+    result: RunResult
+
+    def __init__(self, phase, score, program, result):
+        self.phase = phase
+        self.score = score
+        self.program = program
+        self.result = result
+
+
+class Fuzzer:
+    """
+    Feedback-driven search for inputs that make a single phase of SPEAR explode. Programs are mutated from a population
+    of interesting inputs; an input becomes interesting if it raises the highest time per instruction of any phase or
+    the highest peak RSS per instruction seen so far.
+    """
+    runner: Runner
+    rng: random.Random
+    corpus_dir: Path
+    population: List[Program]
+    findings: Dict[str, Finding]
+
+    # Ratio of the original score an input has to keep while being minimized
+    MINIMIZE_KEEP = 0.8
+    MINIMIZE_MAX_RUNS = 64
+    MEMORY_PHASE = "peak_rss"
+
+    def __init__(self, runner, corpus_dir, seed):
+        self.runner = runner
+        self.rng = random.Random(seed)
+        self.corpus_dir = Path(corpus_dir)
+        self.population = []
+        self.findings = {}
+
+        for program in self.load_corpus():
+            self.population.append(program)
+
+        if not self.population:
+            self.population.append(Program.generate(self.rng))
+
+    def fuzz(self, iterations):
+        for iteration in range(iterations):
+            parent = self.rng.choice(self.population)
+            child = parent.clone()
+            for _ in range(self.rng.randint(1, 4)):
+                child.mutate(self.rng)
+
+            result = self.runner.run(child.render())
+            improved = self.record(child, result)
+
+            if improved:
+                self.population.append(child)
+
+            phase, score = result.work_per_instruction()
+            print("[{}/{}] {} instructions, {} {} {:.3e} s/instruction{}".format(
+                iteration + 1, iterations, result.instructions, result.status, phase, score,
+                " (new maximum: {})".format(", ".join(improved)) if improved else ""))
+
+    def record(self, program: Program, result: RunResult) -> List[str]:
+        """
+        Update the findings with the given result
+        @return Phases for which the input is a new maximum
+        """
+        improved = []
+
+        phase, score = result.work_per_instruction()
+        if phase is not None and (phase not in self.findings or score > self.findings[phase].score):
+            self.findings[phase] = Finding(phase, score, program, result)
+            improved.append(phase)
+
+        memory = result.memory_per_instruction()
+        if memory > 0 and (Fuzzer.MEMORY_PHASE not in self.findings or
+                           memory > self.findings[Fuzzer.MEMORY_PHASE].score):
+            self.findings[Fuzzer.MEMORY_PHASE] = Finding(Fuzzer.MEMORY_PHASE, memory, program, result)
+            improved.append(Fuzzer.MEMORY_PHASE)
+
+        return improved
+
+    def score_of(self, phase: str, result: RunResult) -> float:
+        if phase == Fuzzer.MEMORY_PHASE:
+            return result.memory_per_instruction()
+
+        slowest_phase, score = result.work_per_instruction()
+        return score if slowest_phase == phase else 0.0
+
+    def minimize(self, finding: Finding) -> Finding:
+        """
+        Greedily shrink the program of a finding while the same phase stays the bottleneck
+        """
+        current = finding
+        runs = 0
+        progress = True
+
+        while progress and runs < Fuzzer.MINIMIZE_MAX_RUNS:
+            progress = False
+            for candidate in Fuzzer.reductions(current.program):
+                if runs >= Fuzzer.MINIMIZE_MAX_RUNS:
+                    break
+                runs += 1
+
+                result = self.runner.run(candidate.render())
+                score = self.score_of(finding.phase, result)
+                if score >= finding.score * Fuzzer.MINIMIZE_KEEP:
+                    current = Finding(finding.phase, score, candidate, result)
+                    progress = True
+                    break
+
+        return current
+
+    @staticmethod
+    def reductions(program: Program):
+        """
+        Yield all programs that are one reduction step smaller than the given one
+        """
+        # Drop trailing functions nobody calls
+        called = {statement.callee for statement in program.statements() if statement.kind == "call"}
+        if len(program.functions) > 1 and len(program.functions) - 1 not in called:
+            reduced = program.clone()
+            reduced.functions.pop()
+            yield reduced
+
+        for path in Fuzzer.statement_paths(program):
+            reduced = program.clone()
+            statements, index = Fuzzer.resolve(reduced, path)
+            del statements[index]
+            yield reduced
+
+            reduced = program.clone()
+            statements, index = Fuzzer.resolve(reduced, path)
+            statement = statements[index]
+            if statement.size > 1 and statement.kind != "branch":
+                statement.size //= 2
+                yield reduced
+
+            reduced = program.clone()
+            statements, index = Fuzzer.resolve(reduced, path)
+            statement = statements[index]
+            if statement.kind in ("loop", "branch"):
+                statements[index:index + 1] = statement.body
+                yield reduced
+
+    @staticmethod
+    def statement_paths(program: Program) -> List[Tuple]:
+        paths = []
+
+        def visit(statements, prefix):
+            for index, statement in enumerate(statements):
+                paths.append(prefix + (index,))
+                visit(statement.body, prefix + (index, "body"))
+                visit(statement.alternative, prefix + (index, "alternative"))
+
+        for function_index, function in enumerate(program.functions):
+            visit(function, (function_index,))
+
+        return paths
+
+    @staticmethod
+    def resolve(program: Program, path: Tuple):
+        statements = program.functions[path[0]]
+        position = 1
+        while position + 2 <= len(path) - 1:
+            statement: Statement = statements[path[position]]
+            statements = getattr(statement, path[position + 1])
+            position += 2
+        return statements, path[position]
+
+    def load_corpus(self) -> List[Program]:
+        index_path = self.corpus_dir / "corpus.json"
+        if not index_path.exists():
+            return []
+
+        with open(index_path) as index_file:
+            entries = json.load(index_file)
+
+        return [Program.from_dict(entry["program"]) for entry in entries.values()]
+
+    def save(self, finding: Finding):
+        """
+        Store the finding as regression input in the corpus directory
+        """
+        self.corpus_dir.mkdir(parents=True, exist_ok=True)
+
+        source = finding.program.render()
+        digest = hashlib.sha1(source.encode()).hexdigest()[:10]
+        name = "{}_{}".format(finding.phase, digest)
+
+        header = "// Generated by util/perffuzzer: {} {:.3e} per instruction ({} instructions)\n\n".format(
+            finding.phase, finding.score, finding.result.instructions)
+        (self.corpus_dir / "{}.cpp".format(name)).write_text(header + source)
+
+        index_path = self.corpus_dir / "corpus.json"
+        entries = {}
+        if index_path.exists():
+            with open(index_path) as index_file:
+                entries = json.load(index_file)
+
+        entries[name] = {
+            "phase": finding.phase,
+            "score": finding.score,
+            "result": finding.result.to_dict(),
+            "program": finding.program.to_dict(),
+        }
+
+        with open(index_path, "w") as index_file:
+            json.dump(entries, index_file, indent=2, sort_keys=True)
+
+        return name
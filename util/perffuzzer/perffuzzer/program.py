@@ -0,0 +1,214 @@
+import copy
+import random
+from typing import List, Optional
+
+
+class Statement:
+    """
+    Node of the program genome. Each statement kind stresses another phase of SPEAR:
+    loops the ILP and the loop bound analysis, chains and branches the feasibility analysis and switches Phasar.
+    """
+    kind: str
+    size: int
+    body: List["Statement"]
+    alternative: List["Statement"]
+    callee: Optional[int]
+
+    def __init__(self, kind, size=1, body=None, alternative=None, callee=None):
+        self.kind = kind
+        self.size = size
+        self.body = body if body is not None else []
+        self.alternative = alternative if alternative is not None else []
+        self.callee = callee
+
+    def to_dict(self):
+        return {
+            "kind": self.kind,
+            "size": self.size,
+            "body": [statement.to_dict() for statement in self.body],
+            "alternative": [statement.to_dict() for statement in self.alternative],
+            "callee": self.callee,
+        }
+
+    @staticmethod
+    def from_dict(data):
+        return Statement(data["kind"], data["size"],
+                         [Statement.from_dict(statement) for statement in data["body"]],
+                         [Statement.from_dict(statement) for statement in data["alternative"]],
+                         data["callee"])
+
+
+class Program:
+    """
+    Genome of a generated program: a list of functions, each a list of statements.
+    Function i may only call functions with a smaller index, so the call graph stays acyclic.
+    """
+    functions: List[List[Statement]]
+
+    # Upper limits keep a single input within the per-input time limit of a typical run
+    MAX_SIZE = {"loop": 1000, "chain": 400, "switch": 512, "branch": 1}
+    MAX_DEPTH = 8
+    MAX_FUNCTIONS = 16
+
+    def __init__(self, functions=None):
+        self.functions = functions if functions is not None else [[]]
+
+    @staticmethod
+    def generate(rng: random.Random):
+        program = Program([[] for _ in range(rng.randint(1, 3))])
+        for _ in range(rng.randint(1, 4)):
+            program.mutate(rng)
+        return program
+
+    def clone(self):
+        return copy.deepcopy(self)
+
+    def to_dict(self):
+        return {"functions": [[statement.to_dict() for statement in function] for function in self.functions]}
+
+    @staticmethod
+    def from_dict(data):
+        return Program([[Statement.from_dict(statement) for statement in function] for function in data["functions"]])
+
+    def statement_lists(self):
+        """
+        Return all statement lists of the program together with their nesting depth
+        """
+        lists = []
+        worklist = [(function, 0) for function in self.functions]
+        while worklist:
+            statements, depth = worklist.pop()
+            lists.append((statements, depth))
+            for statement in statements:
+                if statement.kind in ("loop", "branch"):
+                    worklist.append((statement.body, depth + 1))
+                if statement.kind == "branch":
+                    worklist.append((statement.alternative, depth + 1))
+        return lists
+
+    def statements(self):
+        return [statement for statements, _ in self.statement_lists() for statement in statements]
+
+    def _random_statement(self, rng: random.Random, function_index: int):
+        kind = rng.choice(["loop", "chain", "switch", "branch", "call"])
+        if kind == "call":
+            if function_index == 0:
+                kind = "chain"
+            else:
+                return Statement("call", callee=rng.randrange(function_index))
+        if kind == "loop":
+            return Statement("loop", rng.choice([2, 10, 100]), [Statement("chain", rng.randint(1, 8))])
+        if kind == "chain":
+            return Statement("chain", rng.randint(1, 32))
+        if kind == "switch":
+            return Statement("switch", rng.choice([4, 16, 64]))
+        return Statement("branch", 1, [Statement("chain", 2)], [Statement("chain", 2)])
+
+    def mutate(self, rng: random.Random):
+        """
+        Apply a single random mutation in place
+        """
+        mutation = rng.choice(["insert", "insert", "grow", "grow", "nest", "delete", "function"])
+
+        if mutation == "function" and len(self.functions) < Program.MAX_FUNCTIONS:
+            self.functions.append([Statement("call", callee=rng.randrange(len(self.functions)))])
+            return
+
+        candidates = self.statements()
+
+        if mutation == "grow" and candidates:
+            statement = rng.choice(candidates)
+            if statement.kind in Program.MAX_SIZE:
+                statement.size = min(Program.MAX_SIZE[statement.kind], statement.size * rng.choice([2, 4]))
+            return
+
+        if mutation == "nest" and candidates:
+            # Wrap an existing statement into a loop to deepen the loop nest
+            statements, depth = rng.choice(self.statement_lists())
+            if statements and depth < Program.MAX_DEPTH:
+                index = rng.randrange(len(statements))
+                statements[index] = Statement("loop", rng.choice([2, 10, 100]), [statements[index]])
+            return
+
+        if mutation == "delete" and candidates:
+            statements, _ = rng.choice(self.statement_lists())
+            if statements:
+                del statements[rng.randrange(len(statements))]
+            return
+
+        function_index = rng.randrange(len(self.functions))
+        lists = [(statements, depth) for statements, depth in self.statement_lists() if depth < Program.MAX_DEPTH]
+        statements, _ = rng.choice(lists) if lists else (self.functions[function_index], 0)
+        owner = self._owning_function(statements)
+        statements.insert(rng.randint(0, len(statements)), self._random_statement(rng, owner))
+
+    def _owning_function(self, statements):
+        for function_index, function in enumerate(self.functions):
+            worklist = [function]
+            while worklist:
+                current = worklist.pop()
+                if current is statements:
+                    return function_index
+                for statement in current:
+                    worklist.append(statement.body)
+                    worklist.append(statement.alternative)
+        return 0
+
+    def render(self):
+        """
+        Render the program as C++ source
+        """
+        lines = ["volatile int sink = 0;", ""]
+
+        for function_index, function in enumerate(self.functions):
+            lines.append("int fuzz{}(int x) {{".format(function_index))
+            lines.append("    int v = x;")
+            counter = [0]
+            for statement in function:
+                self._render_statement(statement, lines, 1, counter)
+            lines.append("    return v;")
+            lines.append("}")
+            lines.append("")
+
+        lines.append("int main() {")
+        lines.append("    int result = 0;")
+        for function_index in range(len(self.functions)):
+            lines.append("    result += fuzz{}(sink);".format(function_index))
+        lines.append("    sink = result;")
+        lines.append("    return 0;")
+        lines.append("}")
+        lines.append("")
+
+        return "\n".join(lines)
+
+    def _render_statement(self, statement, lines, depth, counter):
+        indent = "    " * depth
+        counter[0] += 1
+        name = counter[0]
+
+        if statement.kind == "loop":
+            lines.append("{}for (int i{} = 0; i{} < {}; i{}++) {{".format(indent, name, name, statement.size, name))
+            lines.append("{}    v += i{};".format(indent, name))
+            for child in statement.body:
+                self._render_statement(child, lines, depth + 1, counter)
+            lines.append("{}}}".format(indent))
+        elif statement.kind == "chain":
+            # Every value depends on the previous one, which yields a long SSA chain at -O0 after mem2reg
+            for index in range(statement.size):
+                lines.append("{}v = v * {} + {};".format(indent, 3 + index % 5, index))
+        elif statement.kind == "switch":
+            lines.append("{}switch (v % {}) {{".format(indent, statement.size))
+            for case in range(statement.size):
+                lines.append("{}    case {}: v += {}; sink = v; break;".format(indent, case, case * 7 + 1))
+            lines.append("{}    default: break;".format(indent))
+            lines.append("{}}}".format(indent))
+        elif statement.kind == "branch":
+            lines.append("{}if (v % 3 == {}) {{".format(indent, name % 3))
+            for child in statement.body:
+                self._render_statement(child, lines, depth + 1, counter)
+            lines.append("{}}} else {{".format(indent))
+            for child in statement.alternative:
+                self._render_statement(child, lines, depth + 1, counter)
+            lines.append("{}}}".format(indent))
+        elif statement.kind == "call":
+            lines.append("{}v += fuzz{}(v);".format(indent, statement.callee))
@@ -0,0 +1,155 @@
+import json
+import re
+import subprocess
+import tempfile
+from pathlib import Path
+from typing import Dict, Optional
+
+# Same flags as documented in the README for analyzable programs
+CLANG_FLAGS = ["-g", "-O0", "-Xclang", "-disable-O0-optnone", "-fno-discard-value-names", "-S", "-emit-llvm"]
+
+INSTRUCTION_PATTERN = re.compile(r"^\s+(%[\w.]+ = )?[a-z]+")
+
+
+class RunResult:
+    """
+    Outcome of analyzing a single input
+    """
+    status: str
+    instructions: int
+    phases: Dict[str, float]
+    peak_rss: float
+    wall_time: float
+
+    def __init__(self, status, instructions=0, phases=None, peak_rss=0.0, wall_time=0.0):
+        self.status = status
+        self.instructions = instructions
+        self.phases = phases if phases is not None else {}
+        self.peak_rss = peak_rss
+        self.wall_time = wall_time
+
+    def work_per_instruction(self):
+        """
+        Return the slowest phase and its time per instruction. Inputs running into the time limit always rank first
+        """
+        if self.status == "timeout":
+            return "timeout", float("inf")
+        if self.status != "ok" or not self.phases or self.instructions == 0:
+            return None, 0.0
+
+        phase = max(self.phases, key=self.phases.get)
+        return phase, self.phases[phase] / self.instructions
+
+    def memory_per_instruction(self):
+        if self.status != "ok" or self.instructions == 0:
+            return 0.0
+        return self.peak_rss / self.instructions
+
+    def to_dict(self):
+        return {
+            "status": self.status,
+            "instructions": self.instructions,
+            "phases": self.phases,
+            "peak_rss": self.peak_rss,
+            "wall_time": self.wall_time,
+        }
+
+
+class Runner:
+    """
+    Compiles a C++ input with clang and analyzes it with SPEAR. The per-phase durations and the peak RSS are read from
+    the metrics SPEAR writes when analysis.metrics is enabled.
+    """
+    spear: str
+    clang: str
+    profile: str
+    config: dict
+    time_limit: float
+
+    def __init__(self, spear, clang, profile, config_path, time_limit):
+        self.spear = spear
+        self.clang = clang
+        self.profile = profile
+        self.time_limit = time_limit
+
+        with open(config_path) as config_file:
+            self.config = json.load(config_file)
+
+        # The fuzzer only needs the timings, the dot files would dominate the output of large inputs
+        self.config["analysis"]["metrics"] = True
+        self.config["analysis"]["progress"] = False
+        self.config["analysis"]["writeDotFiles"] = False
+
+    def run(self, source: str) -> RunResult:
+        with tempfile.TemporaryDirectory(prefix="spear-perffuzz-") as workdir:
+            workpath = Path(workdir)
+            source_path = workpath / "input.cpp"
+            ir_path = workpath / "input.ll"
+            config_path = workpath / "config.json"
+            output_path = workpath / "output"
+
+            source_path.write_text(source)
+
+            config = json.loads(json.dumps(self.config))
+            config["analysis"]["outputDirectory"] = str(output_path)
+            config_path.write_text(json.dumps(config))
+
+            compiled = subprocess.run([self.clang] + CLANG_FLAGS + ["-o", str(ir_path), str(source_path)],
+                                      stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+            if compiled.returncode != 0:
+                return RunResult("compile-error")
+
+            instructions = Runner.count_instructions(ir_path)
+
+            command = [self.spear, "analyze", "--profile", self.profile, "--config", str(config_path),
+                       "--program", str(ir_path)]
+            try:
+                completed = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL,
+                                           timeout=self.time_limit)
+            except subprocess.TimeoutExpired:
+                return RunResult("timeout", instructions, wall_time=self.time_limit)
+
+            if completed.returncode != 0:
+                return RunResult("crash", instructions)
+
+            metrics = Runner.read_metrics(output_path / "metrics.json")
+            if metrics is None:
+                return RunResult("no-metrics", instructions)
+
+            phases, peak_rss = metrics
+            return RunResult("ok", instructions, phases, peak_rss, sum(phases.values()))
+
+    @staticmethod
+    def count_instructions(ir_path: Path) -> int:
+        count = 0
+        inside_function = False
+        with open(ir_path) as ir_file:
+            for line in ir_file:
+                if line.startswith("define "):
+                    inside_function = True
+                elif line.startswith("}"):
+                    inside_function = False
+                elif inside_function and INSTRUCTION_PATTERN.match(line) and "call void @llvm.dbg" not in line:
+                    count += 1
+        return count
+
+    @staticmethod
+    def read_metrics(metrics_path: Path) -> Optional[tuple]:
+        if not metrics_path.exists():
+            return None
+
+        with open(metrics_path) as metrics_file:
+            metrics = json.load(metrics_file)
+
+        phases = {}
+        for metric in metrics.get("spear_phase_duration_seconds", {}).get("metrics", []):
+            phase = metric["labels"].get("phase", "")
+            # The totals contain the other phases of the same analysis
+            if not phase.endswith("_total"):
+                phases[phase] = metric["value"]
+
+        peak_rss = 0.0
+        for metric in metrics.get("spear_peak_rss_bytes", {}).get("metrics", []):
+            peak_rss = max(peak_rss, metric["value"])
+
+        return phases, peak_rss
@@ -56,17 +56,27 @@ def main():
     parser = argparse.ArgumentParser(description="Process a path input.")
     parser.add_argument("path", type=Path, help="Path to a file or directory")
     parser.add_argument("repetitions", type=int, help="Amount of instruction repetitions")
+    parser.add_argument("--unroll", type=int, default=0,
+                        help="Repeat the instruction this often inside a loop instead of unrolling all repetitions")
+    parser.add_argument("--chain", action="store_true",
+                        help="Load the operands at runtime and chain dependent instructions to prevent folding")
+    parser.add_argument("--calibrate", action="store_true",
+                        help="Emit the _overhead kernel the profiler subtracts from every instruction")
 
     args = parser.parse_args()
     input_path = args.path
     reps = args.repetitions
 
+    if args.unroll < 0:
+        print("Unroll factor must not be negative")
+        return
+
     # Always create the directory if needed
     input_path.mkdir(parents=True, exist_ok=True)
 
 
     if reps > 0:
-        gen = Generator(worklist, input_path, reps)
+        gen = Generator(worklist, input_path, reps, args.unroll, args.chain, args.calibrate)
         gen.generate()
         gen.create_meta_file()
     else:
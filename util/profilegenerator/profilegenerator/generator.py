@@ -2,19 +2,41 @@ from typing import List
 from .instruction import Instruction
 from pathlib import Path
 from .util import Util
+from .kernel import KernelWriter
 import json
 
 class Generator:
     instlist: List[Instruction]
     baseloc: str
     repetitions: int
+    unroll: int
+    chain: bool
+    calibrate: bool
 
-    def __init__(self, instlist, baseloc, reps):
+    def __init__(self, instlist, baseloc, reps, unroll=0, chain=False, calibrate=False):
         self.instlist = instlist
         self.baseloc = baseloc
         self.repetitions = reps
+        self.unroll = unroll
+        self.chain = chain
+        self.calibrate = calibrate
+
+    def uses_kernels(self):
+        """
+        Check if the programs are written by the KernelWriter instead of the default fully unrolled templates
+        """
+        return self.unroll > 0 or self.chain or self.calibrate
 
     def generate(self):
+        if self.uses_kernels():
+            writer = KernelWriter(self.repetitions, self.unroll, self.chain)
+            for inst in self.instlist:
+                writer.write(inst, Path(self.baseloc) / f"{inst.get_opcode()}.ll")
+
+            if self.calibrate:
+                writer.write(None, Path(self.baseloc) / f"{KernelWriter.OVERHEAD_NAME}.ll")
+            return
+
         for inst in self.instlist:
             opcode = inst.get_opcode()
             ty = inst.get_type()
@@ -169,6 +191,14 @@ class Generator:
             "repeated_executions": self.repetitions
         }
 
+        if self.uses_kernels():
+            writer = KernelWriter(self.repetitions, self.unroll, self.chain)
+            meta["repeated_executions"] = writer.executions()
+            meta["unroll"] = self.unroll
+            meta["iterations"] = writer.iterations()
+            meta["chain"] = self.chain
+            meta["calibrated"] = self.calibrate
+
         json_meta = json.dumps(meta)
         filename = Path(self.baseloc) / "meta.json"
 
@@ -3,6 +3,9 @@ from .util import Util
 
 
 class Instruction:
+    # Opcodes whose result can be fed back as first operand without the latency depending on the value
+    CHAINABLE = {"add", "sub", "mul", "and", "or", "xor", "shl", "lshr", "ashr", "fadd", "fsub", "fmul"}
+
     opcode: str
     type: str
     args: List[str]
@@ -36,6 +39,12 @@ class Instruction:
         return inst
 
 
+    def is_chainable(self):
+        """
+        Check if the instruction can form a register-dependency chain
+        """
+        return not self.is_complex and self.sideeffecttype is None and self.opcode in Instruction.CHAINABLE
+
     def get_opcode(self):
         return self.opcode
 
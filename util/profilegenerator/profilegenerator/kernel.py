@@ -0,0 +1,235 @@
+import math
+import re
+from typing import List, Optional, Tuple
+
+from .instruction import Instruction
+from .util import Util
+
+
+class KernelWriter:
+    """
+    Writes profile programs with a lower measurement overhead than the fully unrolled default programs.
+
+    - unroll > 0: the instruction is repeated `unroll` times inside a loop instead of being unrolled completely. The
+      program stays small enough for the instruction cache, the loop control is amortized over `unroll` instructions.
+    - chain: operands are loaded at runtime, so the compiler cannot fold the instruction. Instructions whose latency
+      does not depend on their operands additionally form a register-dependency chain, every instance consumes the
+      result of the previous one.
+
+    The overhead kernel is the chain kernel with an empty body: the same operand loads, the same %acc phi and the same
+    sink, but no instruction. Its energy is subtracted from every instruction by the CPU profiler.
+    """
+    repetitions: int
+    unroll: int
+    chain: bool
+
+    OVERHEAD_NAME = "_overhead"
+
+    def __init__(self, repetitions, unroll, chain):
+        self.repetitions = repetitions
+        self.unroll = unroll
+        self.chain = chain
+
+    def body_size(self):
+        return self.unroll if self.unroll > 0 else self.repetitions
+
+    def iterations(self):
+        return math.ceil(self.repetitions / self.unroll) if self.unroll > 0 else 1
+
+    def executions(self):
+        """
+        Return how often every instruction is executed by one run of a program
+        """
+        return self.body_size() * self.iterations()
+
+    def write(self, inst: Optional[Instruction], filename):
+        """
+        Write the kernel of the given instruction, None writes the overhead kernel
+        """
+        header, prologue, body, carried, footer = self._parts(inst)
+
+        lines = []
+        for line in dict.fromkeys(header):
+            lines.append(line)
+        lines.append("")
+        lines.append("define i32 @main() #0 {")
+        lines.append("entry:")
+        lines.extend("  " + line for line in prologue)
+
+        if self.unroll > 0:
+            lines.append("  br label %loop")
+            lines.append("")
+            lines.append("loop:")
+            lines.append("  %iter = phi i64 [ 0, %entry ], [ %iter.next, %latch ]")
+            if carried is not None:
+                ty, initial, last = carried
+                lines.append(f"  %acc = phi {ty} [ {initial}, %entry ], [ {last}, %latch ]")
+            lines.append("  br label %body")
+            lines.append("")
+            lines.append("body:")
+            lines.extend(self._indent(body("latch")))
+            lines.append("")
+            lines.append("latch:")
+            lines.append("  %iter.next = add i64 %iter, 1")
+            lines.append(f"  %done = icmp eq i64 %iter.next, {self.iterations()}")
+            lines.append("  br i1 %done, label %exit, label %loop")
+            lines.append("")
+            lines.append("exit:")
+        else:
+            lines.append("  br label %body")
+            lines.append("")
+            lines.append("body:")
+            lines.extend(self._indent(body("exit")))
+            lines.append("")
+            lines.append("exit:")
+
+        lines.extend("  " + line for line in footer)
+        lines.append("  ret i32 0")
+        lines.append("}")
+        lines.append("")
+
+        with open(filename, "w") as f:
+            f.write("\n".join(lines))
+
+    @staticmethod
+    def _indent(lines: List[str]):
+        # Labels stay unindented
+        return [line if line.endswith(":") or line == "" else "  " + line for line in lines]
+
+    def _parts(self, inst: Optional[Instruction]) -> Tuple:
+        """
+        Split the kernel of an instruction into its globals, the code before the loop, a function writing the
+        unrolled body that ends with a jump to the given label, an optional value carried across loop iterations as
+        (type, initial value, last value) and the code after the loop
+        """
+        count = self.body_size()
+
+        if inst is None:
+            return self._accumulator_parts(None, "i32", ["42", "311"])
+
+        opcode = inst.get_opcode()
+        ty = inst.get_type()
+
+        if opcode == "br":
+            def branch_body(next_label):
+                lines = ["br label %block0", ""]
+                for i in range(count):
+                    following = f"block{i + 1}" if i + 1 < count else next_label
+                    lines.append(f"block{i}:")
+                    lines.append(f"%v{i} = and i32 %lhs, 311")
+                    lines.append(f"br i1 %cond, label %then{i}, label %else{i}")
+                    lines.append("")
+                    for side in ("then", "else"):
+                        lines.append(f"{side}{i}:")
+                        lines.append(f"store volatile i32 %v{i}, i32* @global")
+                        lines.append(f"br label %{following}")
+                        lines.append("")
+                return lines
+
+            return (["@lhs = global i32 42", "@cond = global i1 true", "@global = global i32 0"],
+                    ["%lhs = load volatile i32, i32* @lhs", "%cond = load volatile i1, i1* @cond"],
+                    branch_body, None, [])
+
+        if opcode == "switch":
+            def switch_body(next_label):
+                lines = ["br label %block0", ""]
+                for i in range(count):
+                    following = f"block{i + 1}" if i + 1 < count else next_label
+                    lines.append(f"block{i}:")
+                    lines.append(f"%v{i} = and i32 %lhs, 3")
+                    lines.append(f"switch i32 %v{i}, label %default{i} [")
+                    for case in range(3):
+                        lines.append(f"  i32 {case}, label %case{case}_{i}")
+                    lines.append("]")
+                    lines.append("")
+                    for target in [f"case{case}_{i}" for case in range(3)] + [f"default{i}"]:
+                        lines.append(f"{target}:")
+                        lines.append(f"store volatile i32 %v{i}, i32* @global")
+                        lines.append(f"br label %{following}")
+                        lines.append("")
+                return lines
+
+            return (["@lhs = global i32 42", "@global = global i32 0"],
+                    ["%lhs = load volatile i32, i32* @lhs"],
+                    switch_body, None, [])
+
+        if opcode == "frem":
+            operands = inst.args
+
+            def frem_body(next_label):
+                lines = []
+                for i in range(count):
+                    lines.append(f"%x{i} = load volatile {ty}, {ty}* @c42")
+                    lines.append(f"%y{i} = load volatile {ty}, {ty}* @c3")
+                    lines.append(f"%r{i} = frem {ty} %x{i}, %y{i}")
+                    lines.append(f'call void asm sideeffect "", "x"({ty} %r{i})')
+                return lines + [f"br label %{next_label}"]
+
+            return ([f"@c42 = global {ty} {operands[0]}", f"@c3  = global {ty} {operands[1]}"],
+                    [], frem_body, None,
+                    [f"store volatile {ty} %r0, {ty}* @c42"])
+
+        if inst.is_complex:
+            def complex_body(next_label):
+                lines = []
+                for i in range(count):
+                    block = inst.cpx_exec_block
+                    if inst.cpx_use_counter:
+                        block = block.replace("COUNTER", f"%v{i}")
+                        block = f"%v{i} = {block}"
+                    lines.extend(line.strip() for line in block.split("\n"))
+                return lines + [f"br label %{next_label}"]
+
+            # The footer refers to the result of the second instance
+            footer = re.sub(r"%1\b", "%v1" if count > 1 else "%v0", inst.cpx_footer_block)
+            return ([inst.cpx_header_block] if inst.cpx_header_block else [],
+                    [line.strip() for line in inst.cpx_pretext.split("\n") if line.strip()],
+                    complex_body, None,
+                    [footer] if footer else [])
+
+        result_ty = inst.sideeffecttype if inst.sideeffecttype is not None else ty
+        operands = inst.args
+        globals_ = [f"@global = global {result_ty} {Util.get_type_default(ty)}"]
+
+        if self.chain:
+            globals_ += [f"@lhs = global {ty} {operands[0]}", f"@rhs = global {ty} {operands[1]}"]
+            prologue = [f"%lhs = load volatile {ty}, {ty}* @lhs", f"%rhs = load volatile {ty}, {ty}* @rhs"]
+        else:
+            prologue = []
+
+        if self.chain and inst.is_chainable():
+            return self._accumulator_parts(opcode, ty, operands)
+
+        arguments = f"{ty} %lhs, %rhs" if self.chain else f"{ty} {inst.get_args()}"
+
+        def independent_body(next_label):
+            lines = []
+            for i in range(count):
+                lines.append(f"%r{i} = {opcode} {arguments}")
+                lines.append(f'call void asm sideeffect "", "r"({result_ty} %r{i})')
+            return lines + [f"br label %{next_label}"]
+
+        return (globals_, prologue, independent_body, None,
+                [f"store volatile {result_ty} %r0, {result_ty}* @global"])
+
+    def _accumulator_parts(self, opcode: Optional[str], ty, operands) -> Tuple:
+        """
+        Parts of a kernel that carries %acc across the loop iterations into the sink. Every instance of the opcode
+        consumes the result of the previous one, without an opcode the body is empty, which gives the overhead kernel
+        """
+        count = self.body_size() if opcode is not None else 0
+        previous = "%acc" if self.unroll > 0 else "%lhs"
+
+        lines = []
+        for i in range(count):
+            lines.append(f"%c{i} = {opcode} {ty} {previous}, %rhs")
+            previous = f"%c{i}"
+
+        def accumulator_body(next_label):
+            return lines + [f"br label %{next_label}"]
+
+        return ([f"@global = global {ty} {Util.get_type_default(ty)}",
+                 f"@lhs = global {ty} {operands[0]}", f"@rhs = global {ty} {operands[1]}"],
+                [f"%lhs = load volatile {ty}, {ty}* @lhs", f"%rhs = load volatile {ty}, {ty}* @rhs"],
+                accumulator_body, (ty, "%lhs", previous) if self.unroll > 0 else None,
+                [f"store volatile {ty} {previous}, {ty}* @global"])
@@ -0,0 +1,140 @@
+import json
+import shutil
+import subprocess
+import sys
+import tempfile
+import unittest
+from pathlib import Path
+
+from profilegenerator.instruction import Instruction
+from profilegenerator.kernel import KernelWriter
+
+MAIN = Path(__file__).resolve().parent.parent / "main.py"
+
+
+def write_kernel(writer: KernelWriter, inst, directory):
+    filename = Path(directory) / "kernel.ll"
+    writer.write(inst, filename)
+    return filename.read_text().splitlines()
+
+
+class KernelTest(unittest.TestCase):
+    def setUp(self):
+        self.directory = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.directory)
+
+    def test_unroll_repeats_the_body_inside_a_loop(self):
+        writer = KernelWriter(1000, 64, False)
+        lines = write_kernel(writer, Instruction("add", "i32", ["42", "311"]), self.directory)
+
+        self.assertEqual(writer.iterations(), 16)
+        self.assertEqual(writer.executions(), 1024)
+        self.assertEqual(sum(line.startswith("  %r") for line in lines), 64)
+        self.assertIn("  %done = icmp eq i64 %iter.next, 16", lines)
+
+    def test_without_unroll_the_body_is_written_once(self):
+        writer = KernelWriter(1000, 0, False)
+        lines = write_kernel(writer, Instruction("add", "i32", ["42", "311"]), self.directory)
+
+        self.assertEqual(writer.executions(), 1000)
+        self.assertEqual(sum(line.startswith("  %r") for line in lines), 1000)
+        self.assertNotIn("loop:", lines)
+
+    def test_chain_feeds_every_instance_into_the_next(self):
+        lines = write_kernel(KernelWriter(1000, 4, True), Instruction("add", "i32", ["42", "311"]), self.directory)
+
+        self.assertIn("  %lhs = load volatile i32, i32* @lhs", lines)
+        self.assertIn("  %rhs = load volatile i32, i32* @rhs", lines)
+        self.assertIn("  %acc = phi i32 [ %lhs, %entry ], [ %c3, %latch ]", lines)
+        self.assertEqual([line for line in lines if line.startswith("  %c")],
+                         ["  %c0 = add i32 %acc, %rhs", "  %c1 = add i32 %c0, %rhs",
+                          "  %c2 = add i32 %c1, %rhs", "  %c3 = add i32 %c2, %rhs"])
+        self.assertIn("  store volatile i32 %c3, i32* @global", lines)
+
+    def test_chain_keeps_operand_dependent_instructions_independent(self):
+        lines = write_kernel(KernelWriter(1000, 4, True), Instruction("sdiv", "i32", ["42", "3"]), self.directory)
+
+        self.assertNotIn("%acc", "\n".join(lines))
+        self.assertEqual(sum(line == f"  %r{i} = sdiv i32 %lhs, %rhs" for i in range(4) for line in lines), 4)
+
+    def test_overhead_is_the_chain_kernel_without_instructions(self):
+        for unroll in (0, 64):
+            writer = KernelWriter(1000, unroll, True)
+            chain = write_kernel(writer, Instruction("add", "i32", ["42", "311"]), self.directory)
+            overhead = write_kernel(writer, None, self.directory)
+
+            # Dropping the instructions from the chain kernel leaves the overhead kernel, the sink then stores the
+            # value that entered the body
+            last = f"%c{writer.body_size() - 1}"
+            entered = "%acc" if unroll > 0 else "%lhs"
+            expected = [line.replace(last, entered) for line in chain if not line.startswith("  %c")]
+            self.assertEqual(overhead, expected)
+
+    def test_overhead_does_not_depend_on_chaining(self):
+        chained = write_kernel(KernelWriter(1000, 64, True), None, self.directory)
+        independent = write_kernel(KernelWriter(1000, 64, False), None, self.directory)
+
+        self.assertEqual(chained, independent)
+
+    @unittest.skipUnless(shutil.which("llvm-as"), "llvm-as is not installed")
+    def test_kernels_assemble(self):
+        instructions = [None, Instruction("add", "i32", ["42", "311"]), Instruction("fmul", "float", ["42.0", "3.0"]),
+                        Instruction("sdiv", "i32", ["42", "3"]), Instruction("icmp eq", "i32", ["252", "42"], "i1"),
+                        Instruction("br", "i32", []), Instruction("switch", "i32", []),
+                        Instruction("frem", "float", ["42.0", "3.0"])]
+
+        for unroll in (0, 7):
+            for chain in (False, True):
+                writer = KernelWriter(20, unroll, chain)
+                for inst in instructions:
+                    filename = Path(self.directory) / "kernel.ll"
+                    writer.write(inst, filename)
+                    result = subprocess.run(["llvm-as", str(filename), "-o", "/dev/null"], capture_output=True,
+                                            text=True)
+                    self.assertEqual(result.returncode, 0, result.stderr)
+
+
+class MainTest(unittest.TestCase):
+    def setUp(self):
+        self.directory = Path(tempfile.mkdtemp())
+
+    def tearDown(self):
+        shutil.rmtree(self.directory)
+
+    def run_main(self, *options):
+        subprocess.run([sys.executable, str(MAIN), str(self.directory), "1000", *options], check=True,
+                       capture_output=True)
+        return json.loads((self.directory / "meta.json").read_text())
+
+    def test_defaults_write_the_unrolled_programs(self):
+        meta = self.run_main()
+
+        self.assertEqual(meta, {"repeated_executions": 1000})
+        self.assertFalse((self.directory / "_overhead.ll").exists())
+
+    def test_unroll_reports_the_executions_of_the_loop(self):
+        meta = self.run_main("--unroll", "64")
+
+        self.assertEqual(meta["repeated_executions"], 1024)
+        self.assertEqual(meta["unroll"], 64)
+        self.assertEqual(meta["iterations"], 16)
+        self.assertFalse(meta["chain"])
+        self.assertIn("loop:", (self.directory / "add.ll").read_text())
+
+    def test_chain_loads_the_operands(self):
+        meta = self.run_main("--chain")
+
+        self.assertTrue(meta["chain"])
+        self.assertIn("%c0 = add i32 %lhs, %rhs", (self.directory / "add.ll").read_text())
+
+    def test_calibrate_writes_the_overhead_kernel(self):
+        meta = self.run_main("--unroll", "64", "--chain", "--calibrate")
+
+        self.assertTrue(meta["calibrated"])
+        self.assertTrue((self.directory / f"{KernelWriter.OVERHEAD_NAME}.ll").exists())
+
+
+if __name__ == "__main__":
+    unittest.main()